@@ -65,6 +65,7 @@ bool AppBasketTrading::OnInit() {
     m_dtLatestEod = boost::posix_time::ptime( config.dateHistory, time_duration( 23, 59, 59 ) );
     m_vSymbol = std::move( config.vSymbol );
     m_tws->SetClientId( config.ib_client_id );
+    m_nInstrumentCacheDays = config.nInstrumentCacheDays;
 
     Init();
 
@@ -80,6 +81,13 @@ void AppBasketTrading::Init() {
 
   m_sDbName = "BasketTrading.db";
   m_sStateFileName = "BasketTrading.state";
+  m_sInstrumentCacheFileName = "BasketTrading.instruments";
+
+  if ( 0 < m_nInstrumentCacheDays ) {
+    // resolved instruments carry over between sessions, BuildInstrument skips the fundamentals and contract round trips on a hit
+    ou::tf::InstrumentManager::GlobalInstance().SetCache(
+      std::make_shared<ou::tf::InstrumentCache>( m_sInstrumentCacheFileName, true, m_nInstrumentCacheDays ) );
+  }
 
   m_pFrameMain = new FrameMain( 0, wxID_ANY, "Basket Trading" );
   wxWindowID idFrameMain = m_pFrameMain->GetId();
@@ -421,6 +429,12 @@ void AppBasketTrading::OnClose( wxCloseEvent& event ) {
 
   m_pMasterPortfolio.reset();
 
+  ou::tf::InstrumentManager::pInstrumentCache_t pCache( ou::tf::InstrumentManager::GlobalInstance().GetCache() );
+  if ( pCache ) {
+    pCache->Save();
+    ou::tf::InstrumentManager::GlobalInstance().SetCache( nullptr );
+  }
+
   if ( m_db.IsOpen() ) m_db.Close();
 
   event.Skip();  // auto followed by Destroy();
@@ -90,6 +90,9 @@ private:
   std::string m_sStateFileName;
   ou::tf::DBOps m_db;
 
+  std::string m_sInstrumentCacheFileName;
+  unsigned int m_nInstrumentCacheDays;
+
   std::string m_sPortfolioStrategyAggregate;
 
   std::unique_ptr<MasterPortfolio> m_pMasterPortfolio;
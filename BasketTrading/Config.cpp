@@ -42,6 +42,7 @@ namespace {
   static const std::string sOption_StochasticPeriods( "stochastic_periods" );
   static const std::string sOption_TelegramToken( "telegram_token" );
   static const std::string sOption_TelegramChatId( "telegram_chat_id" );
+  static const std::string sOption_InstrumentCacheDays( "instrument_cache_days" );
 
   template<typename T>
   bool parse( const std::string& sFileName, po::variables_map& vm, const std::string& name, bool bRequired, T& dest ) {
@@ -85,6 +86,7 @@ bool Load( Options& options ) {
       ( sOption_StochasticPeriods.c_str(), po::value<size_t>(&options.nStochasticPeriods), "stochastic (#periods)" )
       ( sOption_TelegramToken.c_str(), po::value<std::string>(&options.sTelegramToken)->default_value( "" ), "telegram token" )
       ( sOption_TelegramChatId.c_str(), po::value<uint64_t>(&options.idTelegramChat)->default_value( 0 ), "telegram chat id" )
+      ( sOption_InstrumentCacheDays.c_str(), po::value<unsigned int>(&options.nInstrumentCacheDays)->default_value( 30 ), "instrument cache entry maximum age (days), 0 to disable" )
       ;
     po::variables_map vm;
     //po::store( po::parse_command_line( argc, argv, config ), vm );
@@ -152,6 +154,7 @@ bool Load( Options& options ) {
 
     bOk &= parse<typeof options.sTelegramToken>( sFilename, vm, sOption_TelegramToken, true, options.sTelegramToken );
     bOk &= parse<typeof options.idTelegramChat>( sFilename, vm, sOption_TelegramChatId, true, options.idTelegramChat );
+    bOk &= parse<typeof options.nInstrumentCacheDays>( sFilename, vm, sOption_InstrumentCacheDays, false, options.nInstrumentCacheDays );
 
   }
   catch( std::exception& e ) {
@@ -46,12 +46,15 @@ struct Options {
   std::string sTelegramToken;
   uint64_t idTelegramChat;
 
+  unsigned int nInstrumentCacheDays; // 0 disables the instrument cache
+
   Options()
   : nDaysFront( 1 ), nDaysBack( 7 )
   , ib_client_id( 1 )
   , nPeriodWidth( 7 )
   , nStochasticPeriods( 300 )
   , idTelegramChat {}
+  , nInstrumentCacheDays( 30 )
    {}
 
 };
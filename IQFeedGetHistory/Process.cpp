@@ -34,9 +34,9 @@ Process::Process(
   ou::tf::iqfeed::InMemoryMktSymbolList& list,
   const std::string& sPrefixPath,
 	size_t nDatums )
-: ou::tf::iqfeed::HistoryBulkQuery<Process>(),
-	m_list( list ),
-  m_sPrefixPath( sPrefixPath ), m_nDatums( nDatums )
+: m_list( list ),
+  m_sPrefixPath( sPrefixPath ), m_nDatums( nDatums ),
+  m_nActive {}
   //m_cntBars( 25 )
 //  m_cntBars( 0 ) // 2013/09/17
 {
@@ -93,68 +93,114 @@ void Process::Start() {
   m_list.SelectSymbolsByExchange( m_vExchanges.begin(), m_vExchanges.end(), SelectSymbols( setSelected ) );
   std::cout << "# symbols selected: " << setSelected.size() << std::endl;
 
-  SetMaxSimultaneousQueries( 15 );
-  SetSymbols( setSelected.begin(), setSelected.end() );
-  DailyBars( m_nDatums );
-  Block();
+  m_vSymbols.assign( setSelected.begin(), setSelected.end() );
 
+  for ( size_t round = 0; ( round < c_nRounds ) && !m_vSymbols.empty(); ++round ) {
+    if ( 0 < round ) {
+      std::cout << "retrying " << m_vSymbols.size() << " symbols" << std::endl;
+    }
+    Round();
+    m_vSymbols.swap( m_vRetry );
+    m_vRetry.clear();
+  }
+
+  if ( !m_vSymbols.empty() ) {
+    std::cout << m_vSymbols.size() << " symbols not retrieved:";
+    for ( const std::string& sSymbol: m_vSymbols ) std::cout << ' ' << sSymbol;
+    std::cout << std::endl;
+    m_vSymbols.clear();
+  }
+
+  std::cout << "Downloads complete." << std::endl;
   std::cout << "Process complete." << std::endl;
 
 }
 
-void Process::OnBars( inherited_t::structResultBar* bars ) {
+void Process::Round() {
 
-  // warning:  this section is re-entrant from multiple threads
+  m_iterSymbols = m_vSymbols.begin();
 
-  // save the data
+  m_nActive = std::min( c_nSimultaneousQueries, m_vSymbols.size() );
+  for ( size_t ix = 0; ix < m_nActive; ++ix ) {
+    m_vQuery.emplace_back( std::make_unique<Query>( *this ) );
+  }
+  for ( pQuery_t& pQuery: m_vQuery ) {
+    pQuery->Connect(); // OnHistoryConnected issues its first request
+  }
 
-  boost::mutex::scoped_lock lock( m_mutexProcessResults );
+  {
+    std::unique_lock<std::mutex> lock( m_mutexSymbols );
+    m_cvComplete.wait( lock, [this]{ return 0 == m_nActive; } );
+    m_vRetry.insert( m_vRetry.end(), m_iterSymbols, m_vSymbols.cend() ); // when every connection failed
+  }
 
-  assert( bars->sSymbol.length() > 0 );
+  for ( pQuery_t& pQuery: m_vQuery ) {
+    pQuery->Disconnect();
+  }
+  m_vQuery.clear();
+}
 
-  std::cout << bars->sSymbol << ": " << bars->bars.Size();
+void Process::Next( Query& query ) {
 
-  if ( 0 != bars->bars.Size() ) {
+  {
+    std::lock_guard<std::mutex> lock( m_mutexSymbols );
+    if ( !query.m_bActive ) return;
+    if ( m_vSymbols.end() == m_iterSymbols ) {
+      Deactivate( query );
+      return;
+    }
+    query.m_sSymbol = *m_iterSymbols;
+    ++m_iterSymbols;
+  }
 
-    std::string sPath;
+  query.m_bars.Clear();
+  query.RetrieveNEndOfDays( query.m_sSymbol, m_nDatums, query.m_bars );
+}
 
-    ou::tf::HDF5DataManager::DailyBarPath( bars->sSymbol, sPath );  // build hierarchical path based upon symbol name
+void Process::Done( Query& query, bool bOk ) {
 
-    ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RDWR );
-    ou::tf::HDF5WriteTimeSeries<ou::tf::Bars> wts( dm, false, true, 0, 64 );
-    wts.Write( sPath, &bars->bars );
-  }
+  // warning:  this section is re-entrant from multiple threads
 
-  ReQueueBars( bars );
+  // save the data
 
-  std::cout << "." << std::endl;
+  {
+    boost::mutex::scoped_lock lock( m_mutexProcessResults );
 
-}
+    assert( query.m_sSymbol.length() > 0 );
 
-void Process::OnTicks( inherited_t::structResultTicks* ticks ) {
+    std::cout << query.m_sSymbol << ": " << query.m_bars.Size();
 
-  boost::mutex::scoped_lock lock( m_mutexProcessResults );
+    if ( bOk && ( 0 != query.m_bars.Size() ) ) {
 
-  assert( ticks->sSymbol.length() > 0 );
+      std::string sPath;
 
-  ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RDWR );
+      ou::tf::HDF5DataManager::DailyBarPath( query.m_sSymbol, sPath );  // build hierarchical path based upon symbol name
 
-  if ( 0 != ticks->trades.Size() ) {
-    std::string sPath( "/optionables/trade/" + ticks->sSymbol );
-    ou::tf::HDF5WriteTimeSeries<ou::tf::Trades> wtst( dm );
-    wtst.Write( sPath, &ticks->trades );
-  }
+      ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RDWR );
+      ou::tf::HDF5WriteTimeSeries<ou::tf::Bars> wts( dm, false, true, 0, 64 );
+      wts.Write( sPath, &query.m_bars );
+    }
 
-  if ( 0 != ticks->quotes.Size() ) {
-    std::string sPath( "/optionables/quote/" + ticks->sSymbol );
-    ou::tf::HDF5WriteTimeSeries<ou::tf::Quotes> wtsq( dm );
-    wtsq.Write( sPath, &ticks->quotes );
+    std::cout << "." << std::endl;
   }
 
-  ReQueueTicks( ticks );
+  query.m_sSymbol.clear();
+  Next( query );
 }
 
-void Process::OnCompletion() {
-  std::cout << "Downloads complete." << std::endl;
+void Process::Error( Query& query, size_t e ) {
+  std::cout << "history connection error " << e << ( query.m_sSymbol.empty() ? "" : " on " ) << query.m_sSymbol << std::endl;
+  std::lock_guard<std::mutex> lock( m_mutexSymbols );
+  if ( !query.m_sSymbol.empty() ) {
+    m_vRetry.push_back( query.m_sSymbol ); // its request did not complete
+    query.m_sSymbol.clear();
+  }
+  if ( query.m_bActive ) Deactivate( query ); // the connection can not continue, the remaining symbols go to the others
 }
 
+void Process::Deactivate( Query& query ) {
+  query.m_bActive = false;
+  assert( 0 < m_nActive );
+  --m_nActive;
+  if ( 0 == m_nActive ) m_cvComplete.notify_one();
+}
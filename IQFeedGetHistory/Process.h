@@ -22,21 +22,24 @@
 */
 
 #include <set>
+#include <mutex>
+#include <memory>
 #include <string>
+#include <vector>
+#include <condition_variable>
 
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/locks.hpp>
 
-#include <TFIQFeed/HistoryBulkQuery.h>
+#include <TFIQFeed/HistoryFill.h>
 #include <TFIQFeed/InMemoryMktSymbolList.h>
 
-class Process:
-  public ou::tf::iqfeed::HistoryBulkQuery<Process>
-{
-  friend ou::tf::iqfeed::HistoryBulkQuery<Process>;
-public:
+// 2026/10/17 daily bars are retrieved with HistoryFill connections, in place of HistoryBulkQuery:
+//   each connection decodes its responses straight into its own Bars, then asks for the next symbol;
+//   a symbol in flight on a connection which fails is retried in a following round
 
-  typedef ou::tf::iqfeed::HistoryBulkQuery<Process> inherited_t;
+class Process {
+public:
 
   Process(
     ou::tf::iqfeed::InMemoryMktSymbolList&,
@@ -47,26 +50,24 @@ public:
   void Start();
 
 protected:
-
-  // CRTP from HistoryBulkQuery<CProcess>
-  void OnBars( inherited_t::structResultBar* bars );
-  void OnTicks( inherited_t::structResultTicks* ticks );
-  void OnCompletion();
-
-  void OnBarsForDarvas( inherited_t::structResultBar* bars );
-
-  // CRTP prototypes
-  //void OnHistoryConnected( structQueryState* pqs );  // optional
-  //void OnHistoryDisconnected( structQueryState* pqs ); // optional
-  //void OnHistoryError( structQueryState* pqs, size_t e ); // optional
-  //void OnHistorySendDone( structQueryState* pqs ); // otional
-  //void OnHistoryTickDataPoint( structQueryState* pqs, ou::tf::iqfeed::HistoryStructs::structTickDataPoint* pDP ); // for per tick processing
-  //void OnHistoryIntervalData( structQueryState* pqs, ou::tf::iqfeed::HistoryStructs::structInterval* pDP ); // for per bar processing
-  //void OnHistorySummaryData( structQueryState* pqs, ou::tf::iqfeed::HistoryStructs::structSummary* pDP ); // for per bar processing
-  //void OnHistoryRequestDone( structQueryState* pqs ); // for processing finished ticks, bars
-
 private:
 
+  class Query: public ou::tf::iqfeed::HistoryFill<Query> { // one connection, requests run back to back
+    friend ou::tf::iqfeed::HistoryFill<Query>;
+  public:
+    Query( Process& process ): m_bActive( true ), m_process( process ) {}
+    std::string m_sSymbol; // in flight, empty when none
+    ou::tf::Bars m_bars;
+    bool m_bActive; // guarded by Process::m_mutexSymbols
+  protected:
+    // CRTP from HistoryFill<Query>
+    void OnHistoryConnected() { m_process.Next( *this ); }
+    void OnHistoryError( size_t e ) { m_process.Error( *this, e ); }
+    void OnHistoryRequestDone( bool bOk ) { m_process.Done( *this, bOk ); }
+  private:
+    Process& m_process;
+  };
+
   ou::tf::iqfeed::InMemoryMktSymbolList& m_list;
 
   boost::mutex m_mutexProcessResults;
@@ -75,11 +76,30 @@ private:
   const size_t m_nDatums;
 
   std::set<std::string> m_vExchanges;  // list of exchanges to be scanned to create:
-  std::set<std::string> m_vSymbols;  // list of symbols to be scanned
+
+  using vSymbols_t = std::vector<std::string>;
+  vSymbols_t m_vSymbols;  // list of symbols to be scanned
+  vSymbols_t::const_iterator m_iterSymbols;
+  vSymbols_t m_vRetry; // symbols in flight on a failed connection, for the next round
+
+  std::mutex m_mutexSymbols;
+  std::condition_variable m_cvComplete;
+  size_t m_nActive; // queries with symbols still to retrieve
+
+  using pQuery_t = std::unique_ptr<Query>;
+  std::vector<pQuery_t> m_vQuery;
+
+  static constexpr size_t c_nSimultaneousQueries = 15;
+  static constexpr size_t c_nRounds = 3; // the first pass, then retries
 
   static const size_t m_BarWindow = 20;  // number of bars to examine
 
   //const size_t m_cntBars;
 
-};
+  void Round(); // retrieve m_vSymbols, failures collect in m_vRetry
+  void Next( Query& );
+  void Done( Query&, bool bOk );
+  void Error( Query&, size_t e );
+  void Deactivate( Query& ); // with m_mutexSymbols held
 
+};
@@ -20,7 +20,7 @@
 
 #include <TFStatistics/Pivot.h>
 
-#include <TFBitsNPieces/InstrumentFilter.h>
+#include <TFBitsNPieces/InstrumentScanner.h>
 
 #include "Scanner.h"
 
@@ -93,14 +93,13 @@ public:
   operator ou::tf::Bar::volume_t() { return m_nTotalVolume / m_nNumberOfValues; };
 };
 
-bool AppScanner::HandleCallBackUseGroup( s_t&, const std::string& sPath, const std::string& sGroup ) {
+bool AppScanner::HandleCallBackUseGroup( const std::string& sPath, const std::string& sGroup ) {
   return true;
 }
 
-bool AppScanner::HandleCallBackFilter( s_t& data, const std::string& sObject, const ou::tf::Bars& bars ) {
+bool AppScanner::HandleCallBackFilter( s_t& data, const std::string& sObject, const ou::tf::Bars& bars ) { // on a scanner worker
 
   bool b( false );
-  data.nEnteredFilter++;
   data.nAverageVolume = std::for_each( bars.begin(), bars.end(), AverageVolume() );
 //  std::cout << sObject << ": " << bars.Last()->DateTime() << " - " << m_dtEnd << std::endl;
   if ( ( 1000000 < data.nAverageVolume )
@@ -109,7 +108,6 @@ bool AppScanner::HandleCallBackFilter( s_t& data, const std::string& sObject, co
     && ( m_nMinBarCount <= bars.Size() )
     && ( m_dtEnd.date() == bars.last().DateTime().date() )
     ) {
-      data.nPassedFilter++;
       b = true;
   }
   return b;
@@ -133,8 +131,6 @@ void AppScanner::HandleCallBackResults( s_t& data, const std::string& sPath, con
   std::cout
     << sObject << ","
     << data.nAverageVolume << ","
-    << data.nEnteredFilter << ","
-    << data.nPassedFilter << ","
     << data.nUpAndR1Crossings << ","
     << data.nPVAndR1Crossings << ","
     << data.nPVCrossings << ","
@@ -148,10 +144,11 @@ void AppScanner::ScanBars() {
   m_nMinBarCount = 20;  // tie this approx to the date range below
   s_t s;
   try {
-    ou::tf::InstrumentFilter<s_t,ou::tf::Bars> filter(
+    // 50 calendar days hold fewer than 40 daily bars, so the window does not change the result
+    ou::tf::InstrumentScanner<s_t,ou::tf::Bars> scanner(
       "/bar/86400",
-      m_dtBegin, m_dtEnd, 20, s,
-      std::bind( &AppScanner::HandleCallBackUseGroup, this, ph::_1, ph::_2, ph::_3 ),
+      m_dtBegin, m_dtEnd, 20, 40, s,
+      std::bind( &AppScanner::HandleCallBackUseGroup, this, ph::_1, ph::_2 ),
       std::bind( &AppScanner::HandleCallBackFilter,   this, ph::_1, ph::_2, ph::_3 ),
       std::bind( &AppScanner::HandleCallBackResults,  this, ph::_1, ph::_2, ph::_3, ph::_4 )
       );
@@ -49,14 +49,12 @@ private:
 
   struct s_t {
     ou::tf::Bar::volume_t nAverageVolume;
-    size_t nEnteredFilter;
-    size_t nPassedFilter;
     double nPVCrossings;
     double nUpAndR1Crossings;
     double nPVAndR1Crossings;
     double nPVAndS1Crossings;
     double nDnAndS1Crossings;
-    s_t( void ): nAverageVolume( 0 ), nEnteredFilter( 0 ), nPassedFilter( 0 ),
+    s_t( void ): nAverageVolume( 0 ),
                  nPVCrossings{},
                  nUpAndR1Crossings {}, nPVAndR1Crossings {}, nPVAndS1Crossings {}, nDnAndS1Crossings {}
     {};
@@ -64,7 +62,7 @@ private:
 
   void HandleMenuActionScan();
   void ScanBars();
-  bool HandleCallBackUseGroup( s_t&, const std::string& sPath, const std::string& sGroup );
+  bool HandleCallBackUseGroup( const std::string& sPath, const std::string& sGroup );
   bool HandleCallBackFilter( s_t&, const std::string& sObject, const ou::tf::Bars& bars );
   void HandleCallBackResults( s_t&, const std::string& sPath, const std::string& sObject, const ou::tf::Bars& bars );
 
@@ -66,7 +66,7 @@ void ChartEntryBars::ClearQueue() {
 }
 
 void ChartEntryBars::Pop( const ou::tf::Bar& bar ) {
-  ChartEntryTime::AppendFg( bar.DateTime() );
+  ChartEntryTime::AppendFg( bar.DateTime(), bar.Low(), bar.High() );
   m_vOpen.push_back( bar.Open() );
   m_vHigh.push_back( bar.High() );
   m_vLow.push_back( bar.Low() );
@@ -88,12 +88,44 @@ bool ChartEntryBars::AddEntryToChart( XYChart *pXY, structChartAttributes *pAttr
     DoubleArray daXData = ChartEntryTime::GetDateTimes();
     // this should be replicated to the other Entry Types.
 
+    DoubleArray daHigh;
+    DoubleArray daLow;
+    DoubleArray daOpen;
+    DoubleArray daClose;
+
+    if ( ChartEntryTime::Decimate( pAttributes->nPixels ) ) { // merge each span into a single candle
+      m_vDecimatedTime.clear();
+      m_vDecimatedOpen.clear();
+      m_vDecimatedHigh.clear();
+      m_vDecimatedLow.clear();
+      m_vDecimatedClose.clear();
+      for ( const Span& span: ChartEntryTime::Spans() ) {
+        m_vDecimatedTime.push_back( ChartEntryTime::ChartTime( span.ixFirst ) );
+        m_vDecimatedOpen.push_back( m_vOpen[ span.ixFirst ] );
+        m_vDecimatedHigh.push_back( m_vHigh[ span.ixHigh ] );
+        m_vDecimatedLow.push_back( m_vLow[ span.ixLow ] );
+        m_vDecimatedClose.push_back( m_vClose[ span.ixLast ] );
+      }
+      const int n( (int)m_vDecimatedTime.size() );
+      daXData = DoubleArray( m_vDecimatedTime.data(), n );
+      daHigh = DoubleArray( m_vDecimatedHigh.data(), n );
+      daLow = DoubleArray( m_vDecimatedLow.data(), n );
+      daOpen = DoubleArray( m_vDecimatedOpen.data(), n );
+      daClose = DoubleArray( m_vDecimatedClose.data(), n );
+    }
+    else {
+      daHigh = GetHigh();
+      daLow = GetLow();
+      daOpen = GetOpen();
+      daClose = GetClose();
+    }
+
     if ( 0 != daXData.len ) {
       CandleStickLayer *candle = pXY->addCandleStickLayer(
-        this->GetHigh(),
-        this->GetLow(),
-        this->GetOpen(),
-        this->GetClose(),
+        daHigh,
+        daLow,
+        daOpen,
+        daClose,
   //      0x0000ff00, 0x00ff0000, 0xff000000
         0x0000ff00, 0x00ff0000, 0xFFFF0001
         );
@@ -121,6 +153,11 @@ void ChartEntryBars::Clear() {
   m_vHigh.clear();
   m_vLow.clear();
   m_vClose.clear();
+  m_vDecimatedTime.clear();
+  m_vDecimatedOpen.clear();
+  m_vDecimatedHigh.clear();
+  m_vDecimatedLow.clear();
+  m_vDecimatedClose.clear();
   ChartEntryTime::Clear();
 }
 
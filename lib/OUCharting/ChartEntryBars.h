@@ -55,6 +55,14 @@ protected:
     return DoubleArray( &m_vClose[ IxStart() ], CntElements() );
   }
 private:
+
+  // decimated viewport:  one candle per span, held while ChartDirector references it
+  std::vector<double> m_vDecimatedTime;
+  std::vector<double> m_vDecimatedOpen;
+  std::vector<double> m_vDecimatedHigh;
+  std::vector<double> m_vDecimatedLow;
+  std::vector<double> m_vDecimatedClose;
+
   //boost::lockfree::spsc_queue<ou::tf::Bar, boost::lockfree::capacity<lockfreesize> > m_lfBar;
 
   std::vector<double> m_vOpen;
@@ -11,6 +11,7 @@
  * See the file LICENSE.txt for redistribution information.             *
  ************************************************************************/
 
+#include <cmath>
 #include <memory>
 #include <algorithm>
 
@@ -80,6 +81,8 @@ ChartEntryTime::ChartEntryTime( ChartEntryTime&& rhs )
 , m_vDateTime( std::move( rhs.m_vDateTime ) )
 , m_vChartTime( std::move( rhs.m_vChartTime ) )
 , m_queue( std::move( rhs.m_queue ) )
+, m_vLevel( std::move( rhs.m_vLevel ) )
+, m_vSpan( std::move( rhs.m_vSpan ) )
 {
 }
 
@@ -166,6 +169,111 @@ void ChartEntryTime::AppendFg( boost::posix_time::ptime dt ) {
   }
 }
 
+void ChartEntryTime::AppendFg( boost::posix_time::ptime dt, double dblLow, double dblHigh ) {
+
+  const size_type ix( m_vDateTime.size() );
+  AppendFg( dt );
+  if ( ix == m_vDateTime.size() ) return; // rejected
+
+  if ( m_vLevel.empty() ) m_vLevel.resize( 1 );
+
+  for ( size_type ixLevel = 0; ixLevel < m_vLevel.size(); ixLevel++ ) {
+    vBucket_t& vBucket( m_vLevel[ ixLevel ] );
+    const size_type ixBucket( ix >> ( nShift0 + ixLevel ) );
+    if ( vBucket.size() == ixBucket ) {
+      vBucket.push_back( Bucket{ ix, ix, dblLow, dblHigh } );
+    }
+    else {
+      Bucket& bucket( vBucket.back() );
+      if ( ( dblLow < bucket.dblLow ) || std::isnan( bucket.dblLow ) ) {
+        bucket.dblLow = dblLow;
+        bucket.ixLow = ix;
+      }
+      if ( ( dblHigh > bucket.dblHigh ) || std::isnan( bucket.dblHigh ) ) {
+        bucket.dblHigh = dblHigh;
+        bucket.ixHigh = ix;
+      }
+    }
+  }
+
+  if ( 2 < m_vLevel.back().size() ) { // open the next coarser level, merging pairs from the one below
+    const vBucket_t& vBelow( m_vLevel.back() );
+    vBucket_t vBucket;
+    vBucket.reserve( ( vBelow.size() + 1 ) / 2 );
+    for ( size_type ixBelow = 0; ixBelow < vBelow.size(); ixBelow += 2 ) {
+      Bucket bucket( vBelow[ ixBelow ] );
+      if ( ( ixBelow + 1 ) < vBelow.size() ) {
+        const Bucket& right( vBelow[ ixBelow + 1 ] );
+        if ( ( right.dblLow < bucket.dblLow ) || std::isnan( bucket.dblLow ) ) {
+          bucket.dblLow = right.dblLow;
+          bucket.ixLow = right.ixLow;
+        }
+        if ( ( right.dblHigh > bucket.dblHigh ) || std::isnan( bucket.dblHigh ) ) {
+          bucket.dblHigh = right.dblHigh;
+          bucket.ixHigh = right.ixHigh;
+        }
+      }
+      vBucket.push_back( bucket );
+    }
+    m_vLevel.push_back( std::move( vBucket ) );
+  }
+}
+
+// select the coarsest level with at least one bucket per pixel, it yields between one and two spans per pixel
+bool ChartEntryTime::Decimate( int nPixels ) {
+
+  m_vSpan.clear();
+
+  if ( ( 0 >= nPixels ) || m_vLevel.empty() || ( 0 >= CntElements() ) ) return false;
+
+  const size_type nElements( CntElements() );
+  const size_type nPerPixel( nElements / nPixels );
+  if ( ( (size_type)1 << nShift0 ) > nPerPixel ) return false; // sparse enough to draw as is
+
+  int ixLevel( 0 );
+  while (
+    ( ( ixLevel + 1 ) < (int)m_vLevel.size() )
+    && ( ( (size_type)1 << ( nShift0 + ixLevel + 1 ) ) <= nPerPixel )
+  ) {
+    ixLevel++;
+  }
+
+  m_vSpan.reserve( 2 * nPixels + 2 * ( ixLevel + 1 + ( 1 << nShift0 ) ) );
+  Cover( IxStart(), IxStart() + nElements, ixLevel );
+
+  return true;
+}
+
+// whole buckets from this level, the unaligned ends from the finer levels, then single points
+void ChartEntryTime::Cover( size_type ixBegin, size_type ixEnd, int ixLevel ) {
+
+  if ( ixBegin >= ixEnd ) return;
+
+  if ( 0 > ixLevel ) {
+    for ( size_type ix = ixBegin; ix < ixEnd; ix++ ) {
+      m_vSpan.push_back( Span{ ix, ix, ix, ix } );
+    }
+    return;
+  }
+
+  const size_type nShift( nShift0 + ixLevel );
+  const size_type ixBucketBegin( ( ixBegin + ( (size_type)1 << nShift ) - 1 ) >> nShift );
+  const size_type ixBucketEnd( ixEnd >> nShift ); // buckets before this one are complete
+
+  if ( ixBucketBegin >= ixBucketEnd ) {
+    Cover( ixBegin, ixEnd, ixLevel - 1 );
+  }
+  else {
+    Cover( ixBegin, ixBucketBegin << nShift, ixLevel - 1 );
+    const vBucket_t& vBucket( m_vLevel[ ixLevel ] );
+    for ( size_type ixBucket = ixBucketBegin; ixBucket < ixBucketEnd; ixBucket++ ) {
+      const Bucket& bucket( vBucket[ ixBucket ] );
+      m_vSpan.push_back( Span{ ixBucket << nShift, bucket.ixLow, bucket.ixHigh, ( ( ixBucket + 1 ) << nShift ) - 1 } );
+    }
+    Cover( ixBucketEnd << nShift, ixEnd, ixLevel - 1 );
+  }
+}
+
 // called from WinChartView::ThreadDrawChart1 -> ChartDataView::SetViewPort
 void ChartEntryTime::SetViewPort( boost::posix_time::ptime dtBegin, boost::posix_time::ptime dtEnd ) {
   SetViewPort( range_t( dtBegin, dtEnd ) );
@@ -238,14 +346,15 @@ boost::posix_time::ptime ChartEntryTime::GetExtentEnd() const {
 
 // there are out-of-order issues or loss-of-data issues if m_bUseThreadSafety is changed while something is in the Queue
 void ChartEntryTime::ClearQueue( void ) {
-  namespace args = std::placeholders;
-  m_queue.Sync( std::bind( &ChartEntryTime::AppendFg, this, args::_1 ) );
+  m_queue.Sync( [this]( boost::posix_time::ptime dt ){ AppendFg( dt ); } );
 }
 
 void ChartEntryTime::Clear( void ) {
   ChartEntryBase::Clear();
   m_vDateTime.clear();
   m_vChartTime.clear();
+  m_vLevel.clear();
+  m_vSpan.clear();
   ChartEntryBase::Clear();
 }
 
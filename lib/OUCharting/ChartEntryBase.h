@@ -51,7 +51,8 @@ public:
     double dblXMax;
     double dblYMin;
     double dblYMax;
-    structChartAttributes() : dblXMin( 0 ), dblXMax( 0 ), dblYMin( 0 ), dblYMax( 0 ) {};
+    int nPixels; // width of the plot area, entries may decimate to this, 0 to draw every point
+    structChartAttributes() : dblXMin( 0 ), dblXMax( 0 ), dblYMin( 0 ), dblYMax( 0 ), nPixels( 0 ) {};
   };
 
   ChartEntryBase();
@@ -151,6 +152,24 @@ protected:
   range_t m_rangeViewPort;
 
   void AppendFg( boost::posix_time::ptime dt ); // foreground append
+  void AppendFg( boost::posix_time::ptime dt, double dblLow, double dblHigh ); // foreground append, maintains decimation
+
+  // decimation:  a viewport holding many more points than the plot has pixels is handed to
+  //   ChartDirector as spans, each summarizing a run of points by its first, last, low and high,
+  //   so a redraw costs O(pixels) rather than O(points in the viewport).
+  //   Runs are taken from a pyramid of power of two buckets, updated on each AppendFg( dt, low, high )
+  struct Span {
+    size_type ixFirst;
+    size_type ixLow;
+    size_type ixHigh;
+    size_type ixLast;
+  };
+  using vSpan_t = std::vector<Span>;
+
+  bool Decimate( int nPixels ); // true: Spans() covers the viewport, false: draw the viewport as is
+  const vSpan_t& Spans() const { return m_vSpan; }
+
+  double ChartTime( size_type ix ) const { return m_vChartTime[ ix ]; }
 
   // need to get to top of call hierarchy and only call when m_nElements is non-zero
   DoubleArray GetDateTimes() const {
@@ -184,6 +203,23 @@ private:
   vDateTime_t m_vDateTime;
   vChartTime_t m_vChartTime;  // used by ChartDir, double version of m_vDateTime
 
+  struct Bucket {
+    size_type ixLow;
+    size_type ixHigh;
+    double dblLow;
+    double dblHigh;
+  };
+
+  using vBucket_t = std::vector<Bucket>;
+  using vLevel_t = std::vector<vBucket_t>;
+
+  static const size_type nShift0 = 3; // level n buckets hold 2^(nShift0+n) points
+
+  vLevel_t m_vLevel;
+  vSpan_t m_vSpan;
+
+  void Cover( size_type ixBegin, size_type ixEnd, int ixLevel );
+
 };
 
 } // namespace ou
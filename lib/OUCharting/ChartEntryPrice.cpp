@@ -18,6 +18,8 @@
  * Created on May 6, 2017, 7:03 PM
  */
 
+#include <algorithm>
+
 #include <boost/phoenix/core.hpp>
 #include <boost/phoenix/bind/bind_member_function.hpp>
 
@@ -44,6 +46,8 @@ void ChartEntryPrice::Reserve( size_type nSize ) {
 
 void ChartEntryPrice::Clear() {
   m_vDouble.clear();
+  m_vDecimatedTime.clear();
+  m_vDecimatedPrice.clear();
   ChartEntryTime::Clear();
 }
 
@@ -61,17 +65,68 @@ void ChartEntryPrice::ClearQueue() {
 }
 
 void ChartEntryPrice::Pop( const ou::tf::Price& price ) {
-  ChartEntryTime::AppendFg( price.DateTime() );
+  ChartEntryTime::AppendFg( price.DateTime(), price.Value(), price.Value() );
   m_vDouble.push_back( price.Value() );
 }
 
+void ChartEntryPrice::GetViewPort( int nPixels, EDecimate eDecimate, DoubleArray& daTime, DoubleArray& daPrice ) {
+
+  if ( !ChartEntryTime::Decimate( nPixels ) ) {
+    daTime = ChartEntryTime::GetDateTimes();
+    daPrice = GetPrices();
+    return;
+  }
+
+  m_vDecimatedTime.clear();
+  m_vDecimatedPrice.clear();
+
+  auto append = [this]( size_type ix ){
+    m_vDecimatedTime.push_back( ChartEntryTime::ChartTime( ix ) );
+    m_vDecimatedPrice.push_back( m_vDouble[ ix ] );
+  };
+
+  switch ( eDecimate ) {
+    case EDecimate::Envelope:
+      {
+        size_type ixPrevious( 0 );
+        bool bPrevious( false );
+        for ( const Span& span: ChartEntryTime::Spans() ) {
+          const size_type rix[ 4 ] = { // in time order
+            span.ixFirst,
+            std::min( span.ixLow, span.ixHigh ),
+            std::max( span.ixLow, span.ixHigh ),
+            span.ixLast
+          };
+          for ( const size_type ix: rix ) {
+            if ( !bPrevious || ( ix != ixPrevious ) ) {
+              append( ix );
+              ixPrevious = ix;
+              bPrevious = true;
+            }
+          }
+        }
+      }
+      break;
+    case EDecimate::Peak:
+      for ( const Span& span: ChartEntryTime::Spans() ) {
+        append( span.ixHigh );
+      }
+      break;
+  }
+
+  daTime = DoubleArray( m_vDecimatedTime.data(), (int)m_vDecimatedTime.size() );
+  daPrice = DoubleArray( m_vDecimatedPrice.data(), (int)m_vDecimatedPrice.size() );
+}
+
 bool ChartEntryPrice::AddEntryToChart( XYChart *pXY, structChartAttributes *pAttributes )  {
   bool bAdded( false );
   ClearQueue();
   if ( 0 != this->ChartEntryTime::Size() ) {
-    DoubleArray daXData = ChartEntryTime::GetDateTimes();
+    DoubleArray daXData;
+    DoubleArray daPrices;
+    GetViewPort( pAttributes->nPixels, EDecimate::Envelope, daXData, daPrices );
     if ( 0 != daXData.len ) {
-      LineLayer *ll = pXY->addLineLayer( this->GetPrices() );
+      LineLayer *ll = pXY->addLineLayer( daPrices );
       ll->setXData( daXData );
       pAttributes->dblXMin = daXData[0];
       pAttributes->dblXMax = daXData[ daXData.len - 1 ];
@@ -56,10 +56,21 @@ protected:
     return DoubleArray( &m_vDouble[ IxStart() ], CntElements() );
   }
 
+  enum class EDecimate {
+    Envelope // first, low, high, last of each span:  a line drawn through them matches the full line at each pixel
+  , Peak     // high of each span:  suits bars, such as volume
+  };
+
+  // times and prices visible in the viewport, decimated when the viewport is much wider than nPixels
+  void GetViewPort( int nPixels, EDecimate, DoubleArray& daTime, DoubleArray& daPrice );
+
 private:
 
   vDouble_t m_vDouble;
 
+  vDouble_t m_vDecimatedTime; // hold the decimated viewport while ChartDirector references it
+  vDouble_t m_vDecimatedPrice;
+
   ou::tf::Queue<ou::tf::Price> m_queue;
 
 };
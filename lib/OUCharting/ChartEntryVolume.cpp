@@ -50,9 +50,11 @@ bool ChartEntryVolume::AddEntryToChart( XYChart *pXY, structChartAttributes *pAt
   bool bAdded( false );
   ChartEntryPrice::ClearQueue();
   if ( 0 != ChartEntryPrice::Size() ) {
-    DoubleArray daXData = ChartEntryTime::GetDateTimes();
+    DoubleArray daXData;
+    DoubleArray daVolumes;
+    GetViewPort( pAttributes->nPixels, EDecimate::Peak, daXData, daVolumes );
     if ( 0 != daXData.len ) {
-      BarLayer *bl = pXY->addBarLayer( this->GetPrices() );
+      BarLayer *bl = pXY->addBarLayer( daVolumes );
     
       bl->setXData( daXData );
       pAttributes->dblXMin = daXData[0];
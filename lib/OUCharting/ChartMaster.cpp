@@ -21,7 +21,7 @@ ChartMaster::ChartMaster( unsigned int width, unsigned int height )
 : m_pCdv( nullptr), m_pDA( nullptr )
 , m_nChartWidth( width ), m_nChartHeight( height )
 , m_intCrossHairX {}, m_intCrossHairY {}, m_bCrossHair( false )
-, m_bHasData( false )
+, m_bHasData( false ), m_bDecimate( true )
 , m_dblX {}, m_dblY {}
 , m_xLeft {}, m_xX {}, m_xRight {}
 , m_formatter( "%.2f"  )
@@ -170,6 +170,9 @@ void ChartMaster::ChartData( XYChart* pXY0 ) {
     [this,&dblXBegin,&dblXEnd]( ou::ChartEntryCarrier& carrier ){
       size_t ixChart = carrier.GetActualChartId();
       ChartEntryBase::structChartAttributes Attributes;
+      if ( m_bDecimate ) {
+        Attributes.nPixels = m_vSubCharts[ ixChart ]->getPlotArea()->getWidth(); // entries decimate to this
+      }
       if ( carrier.GetChartEntry()->AddEntryToChart( m_vSubCharts[ ixChart ].get(), &Attributes ) ) {
         // following assumes values are always > 0
         dblXBegin = ( 0 == dblXBegin )
@@ -46,6 +46,7 @@ public:
   void SetBarWidth( boost::posix_time::time_duration tdBarWidth );
 
   void SetChartDimensions( unsigned int width, unsigned int height);
+  void SetDecimate( bool bDecimate ) { m_bDecimate = bDecimate; } // default true, false hands every viewport point to ChartDirector
   void DrawChart();
 
   using fOnDrawChart_t = std::function<void( bool bCursor, const MemBlock& )>;
@@ -88,6 +89,7 @@ private:
   DrawArea* m_pDA;
 
   bool m_bHasData;
+  bool m_bDecimate;
 
   int m_intCrossHairX, m_intCrossHairY;
   bool m_bCrossHair;
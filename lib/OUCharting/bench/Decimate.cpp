@@ -0,0 +1,94 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// headless render of a tick series into a MemBlock, at several zoom levels, with and without decimation
+//   usage: OUChartingDecimate [points [width]]
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <iostream>
+
+#include <chartdir/chartdir.h>
+
+#include <OUCharting/ChartMaster.h>
+#include <OUCharting/ChartDataView.h>
+#include <OUCharting/ChartEntryPrice.h>
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nPoints = ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 3'000'000;
+  const unsigned int nWidth = ( 2 < argc ) ? std::stoul( argv[ 2 ] ) : 1600;
+  static const size_t nRepeat = 5;
+
+  namespace pt = boost::posix_time;
+
+  ou::ChartEntryPrice cePrice;
+  cePrice.Reserve( nPoints );
+
+  // random walk at irregular sub-second intervals, a tick chart of a busy session
+  std::mt19937 rng( 42 );
+  std::exponential_distribution<double> interval( 1.0 / 5000.0 ); // mean 5ms
+  std::normal_distribution<double> step( 0.0, 0.25 );
+
+  const pt::ptime dtBegin( boost::gregorian::date( 2026, 10, 16 ), pt::time_duration( 13, 30, 0 ) );
+  pt::ptime dt( dtBegin );
+  double price( 5000.0 );
+  for ( size_t ix = 0; ix < nPoints; ++ix ) {
+    dt += pt::microseconds( 1 + (long) interval( rng ) );
+    price += step( rng );
+    cePrice.Append( dt, price );
+  }
+  const pt::ptime dtEnd( dt );
+  cePrice.ClearQueue();
+
+  ou::ChartDataView cdv;
+  cdv.Add( 0, &cePrice );
+
+  ou::ChartMaster cm( nWidth, 800 );
+  cm.SetChartDataView( &cdv );
+
+  size_t nBytes {};
+  cm.SetOnDrawChart(
+    [&nBytes]( bool, const MemBlock& m ){
+      nBytes = m.len;
+    } );
+
+  std::cout << nPoints << " points, " << nWidth << " pixels wide, " << dtEnd - dtBegin << std::endl;
+
+  const pt::time_duration tdSession( dtEnd - dtBegin );
+  for ( const long nZoom: { 1L, 10L, 100L, 1000L } ) {
+
+    const pt::ptime dtViewBegin( dtEnd - pt::microseconds( tdSession.total_microseconds() / nZoom ) );
+    cdv.SetViewPort( dtViewBegin, dtEnd );
+
+    for ( const bool bDecimate: { false, true } ) {
+      cm.SetDecimate( bDecimate );
+      auto start = std::chrono::steady_clock::now();
+      for ( size_t ix = 0; ix < nRepeat; ++ix ) {
+        cm.DrawChart();
+      }
+      const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start ).count() / nRepeat;
+      std::cout
+        << "zoom 1/" << nZoom
+        << ( bDecimate ? " decimated: " : " full:      " )
+        << ms << " ms/draw, "
+        << nBytes << " bytes"
+        << std::endl;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
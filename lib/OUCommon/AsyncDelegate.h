@@ -0,0 +1,241 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    AsyncDelegate.h
+ * Author:  raymond@burkholder.net
+ * Project: OUCommon
+ * Created: October 17, 2026 14:00
+ */
+
+#pragma once
+
+// asynchronous subscription to a Delegate:
+//   the dispatching thread copies the value into the subscriber's bounded queue and returns,
+//   the handler runs later on the subscriber's executor (io_context, strand, ...),
+//   so a slow subscriber no longer holds up the dispatching thread, nor the other subscribers
+//
+// Example:
+//   auto pAsync = ou::AsyncDelegate<const Quote&>::Factory(
+//     strand, MakeDelegate( this, &Chart::HandleQuote ), 1024, ou::EOverflow::Conflate );
+//   watch.OnQuote.Add( pAsync->Handler() );
+//   ...
+//   watch.OnQuote.Remove( pAsync->Handler() ); // before pAsync is released
+
+#include <mutex>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cassert>
+#include <type_traits>
+#include <condition_variable>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/any_io_executor.hpp>
+
+#include "FastDelegate.h"
+#include "BoundedQueue.h"
+
+namespace ou { // One Unified
+
+// ==== AsyncDelegate
+
+enum class EOverflow {
+  Block       // dispatching thread waits for room, see Dispatch for a dispatch from the executor itself
+, DropOldest  // oldest queued value is discarded
+, Conflate    // each dispatch empties the queue before pushing, so at most one value waits,
+              //   suits quotes/trades for a single symbol; capacity is 2, the BoundedQueue minimum
+};
+
+template<typename T>  // T: as in Delegate<T>, normally const&
+class AsyncDelegate: public std::enable_shared_from_this<AsyncDelegate<T> > {
+public:
+
+  using value_t = std::decay_t<T>;
+  using OnDispatchHandler = fastdelegate::FastDelegate1<T>;          // registered with the Delegate
+  using OnValueHandler = fastdelegate::FastDelegate1<const value_t&>; // called on the executor
+  using pAsyncDelegate_t = std::shared_ptr<AsyncDelegate<T> >;
+
+  struct Stats {
+    size_t nDepth;     // currently queued
+    size_t nQueued;    // accepted from the dispatching thread
+    size_t nDelivered; // handed to the handler
+    size_t nDropped;   // discarded by DropOldest or Conflate
+    size_t nBlocked;   // dispatches which had to wait for room
+  };
+
+  AsyncDelegate( boost::asio::any_io_executor executor, OnValueHandler handler, size_t nCapacity = 1024, EOverflow eOverflow = EOverflow::Block )
+  : m_executor( std::move( executor ) ), m_handler( handler )
+  , m_queue( ( EOverflow::Conflate == eOverflow ) ? 2 : nCapacity ), m_eOverflow( eOverflow )
+  , m_bScheduled( false ), m_bClosed( false ), m_idDrain( std::thread::id() ), m_nWaiting {}
+  , m_nQueued {}, m_nDelivered {}, m_nDropped {}, m_nBlocked {}
+  {}
+
+  static pAsyncDelegate_t Factory( boost::asio::any_io_executor executor, OnValueHandler handler, size_t nCapacity = 1024, EOverflow eOverflow = EOverflow::Block ) {
+    return std::make_shared<AsyncDelegate<T> >( std::move( executor ), handler, nCapacity, eOverflow );
+  }
+
+  OnDispatchHandler Handler() { return fastdelegate::MakeDelegate( this, &AsyncDelegate<T>::Dispatch ); }
+
+  void Close() { // queued values are discarded rather than delivered, a blocked dispatch returns
+    m_bClosed.store( true );
+    if ( 0 < m_nWaiting.load() ) {
+      std::scoped_lock<std::mutex> lock( m_mutexRoom );
+      m_cvRoom.notify_all();
+    }
+  }
+
+  Stats GetStats() const {
+    Stats stats;
+    stats.nDepth = m_queue.Size();
+    stats.nQueued = m_nQueued.load( std::memory_order_relaxed );
+    stats.nDelivered = m_nDelivered.load( std::memory_order_relaxed );
+    stats.nDropped = m_nDropped.load( std::memory_order_relaxed );
+    stats.nBlocked = m_nBlocked.load( std::memory_order_relaxed );
+    return stats;
+  }
+
+  // called from the dispatching thread
+  //   Block: waiting for room from within the executor (the handler dispatching to itself,
+  //   or the dispatching thread being the one running the io_context or strand) would stop
+  //   the very drain being waited on, so in that case the oldest value is dropped instead
+  void Dispatch( T t ) {
+
+    if ( m_bClosed.load( std::memory_order_acquire ) ) return;
+
+    switch ( m_eOverflow ) {
+      case EOverflow::Conflate:
+        {
+          value_t discard;
+          while ( m_queue.Pop( discard ) ) m_nDropped.fetch_add( 1, std::memory_order_relaxed );
+        }
+        while ( !m_queue.Push( t ) ) { // a drain may have just freed, then refilled, the cell
+          value_t discard;
+          if ( m_queue.Pop( discard ) ) m_nDropped.fetch_add( 1, std::memory_order_relaxed );
+        }
+        break;
+      case EOverflow::DropOldest:
+        PushDropOldest( t );
+        break;
+      case EOverflow::Block:
+        if ( !m_queue.Push( t ) ) {
+          if ( RunningInExecutor() ) {
+            PushDropOldest( t );
+            break;
+          }
+          m_nBlocked.fetch_add( 1, std::memory_order_relaxed );
+          m_nWaiting.fetch_add( 1 ); // seq_cst, pairs with the fence in Drain
+          Schedule(); // ensure a drain is on its way
+          {
+            std::unique_lock<std::mutex> lock( m_mutexRoom );
+            while ( !m_queue.Push( t ) ) {
+              if ( m_bClosed.load() ) {
+                m_nWaiting.fetch_sub( 1 );
+                return;
+              }
+              m_cvRoom.wait( lock );
+            }
+          }
+          m_nWaiting.fetch_sub( 1 );
+        }
+        break;
+    }
+
+    m_nQueued.fetch_add( 1, std::memory_order_relaxed );
+    Schedule();
+  }
+
+protected:
+private:
+
+  static const size_t nBatch = 64; // values delivered per executor turn
+
+  boost::asio::any_io_executor m_executor;
+  OnValueHandler m_handler;
+
+  BoundedQueue<value_t> m_queue;
+  const EOverflow m_eOverflow;
+
+  std::atomic<bool> m_bScheduled; // a Drain has been posted and not yet finished
+  std::atomic<bool> m_bClosed;
+
+  std::atomic<std::thread::id> m_idDrain; // thread currently in Drain
+  std::atomic<size_t> m_nWaiting; // Block dispatches waiting for room
+  std::mutex m_mutexRoom;
+  std::condition_variable m_cvRoom;
+
+  std::atomic<size_t> m_nQueued;
+  std::atomic<size_t> m_nDelivered;
+  std::atomic<size_t> m_nDropped;
+  std::atomic<size_t> m_nBlocked;
+
+  void PushDropOldest( const value_t& t ) {
+    while ( !m_queue.Push( t ) ) {
+      value_t discard;
+      if ( m_queue.Pop( discard ) ) m_nDropped.fetch_add( 1, std::memory_order_relaxed );
+    }
+  }
+
+  bool RunningInExecutor() const {
+    if ( std::this_thread::get_id() == m_idDrain.load() ) return true; // dispatched from the handler
+    using context_executor_t = boost::asio::io_context::executor_type;
+    if ( const auto* p = m_executor.template target<context_executor_t>() ) {
+      return p->running_in_this_thread();
+    }
+    if ( const auto* p = m_executor.template target<boost::asio::strand<context_executor_t> >() ) {
+      return p->running_in_this_thread();
+    }
+    return false;
+  }
+
+  void Schedule() {
+    if ( !m_bScheduled.exchange( true ) ) { // seq_cst, pairs with the store in Drain
+      boost::asio::post( m_executor, [self = this->shared_from_this()](){ self->Drain(); } );
+    }
+  }
+
+  // called on the executor
+  void Drain() {
+    m_idDrain.store( std::this_thread::get_id() );
+    value_t value;
+    size_t n {};
+    while ( ( nBatch > n ) && m_queue.Pop( value ) ) {
+      if ( !m_bClosed.load( std::memory_order_acquire ) ) {
+        m_handler( value );
+        m_nDelivered.fetch_add( 1, std::memory_order_relaxed );
+      }
+      n++;
+    }
+    m_idDrain.store( std::thread::id() );
+    std::atomic_thread_fence( std::memory_order_seq_cst ); // pops visible before m_nWaiting is read
+    if ( ( 0 < n ) && ( 0 < m_nWaiting.load() ) ) { // room has been made
+      std::scoped_lock<std::mutex> lock( m_mutexRoom );
+      m_cvRoom.notify_all();
+    }
+    if ( nBatch == n ) { // yield the executor, keep the schedule
+      boost::asio::post( m_executor, [self = this->shared_from_this()](){ self->Drain(); } );
+    }
+    else {
+      m_bScheduled.store( false );
+      std::atomic_thread_fence( std::memory_order_seq_cst );
+      if ( !m_queue.Empty() ) Schedule(); // arrived after the final Pop
+    }
+  }
+
+};
+
+} // namespace ou
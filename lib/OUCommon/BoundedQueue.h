@@ -0,0 +1,119 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    BoundedQueue.h
+ * Author:  raymond@burkholder.net
+ * Project: OUCommon
+ * Created: October 17, 2026 13:50
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace ou { // One Unified
+
+// ==== BoundedQueue: lock free, multiple producer, multiple consumer, fixed capacity
+//   each cell carries a sequence number which hands ownership between producers and consumers
+//   (Dmitry Vyukov's bounded queue), capacity is rounded up to a power of two
+
+template<typename T>
+class BoundedQueue {
+public:
+
+  BoundedQueue( std::size_t nCapacity )
+  : m_ixEnqueue {}, m_ixDequeue {}
+  {
+    std::size_t n( 2 );
+    while ( n < nCapacity ) n <<= 1;
+    m_nMask = n - 1;
+    m_vCell = std::vector<Cell>( n );
+    for ( std::size_t ix = 0; ix < n; ix++ ) {
+      m_vCell[ ix ].nSequence.store( ix, std::memory_order_relaxed );
+    }
+  }
+
+  std::size_t Capacity() const { return m_nMask + 1; }
+
+  std::size_t Size() const { // approximate while in use
+    const std::size_t nEnqueue( m_ixEnqueue.load( std::memory_order_relaxed ) );
+    const std::size_t nDequeue( m_ixDequeue.load( std::memory_order_relaxed ) );
+    return ( nEnqueue > nDequeue ) ? ( nEnqueue - nDequeue ) : 0;
+  }
+
+  bool Empty() const { return 0 == Size(); }
+
+  bool Push( const T& value ) { // false when full
+    std::size_t ix( m_ixEnqueue.load( std::memory_order_relaxed ) );
+    for ( ;; ) {
+      Cell& cell( m_vCell[ ix & m_nMask ] );
+      const std::size_t nSequence( cell.nSequence.load( std::memory_order_acquire ) );
+      const std::intptr_t diff( (std::intptr_t)nSequence - (std::intptr_t)ix );
+      if ( 0 == diff ) {
+        if ( m_ixEnqueue.compare_exchange_weak( ix, ix + 1, std::memory_order_relaxed ) ) {
+          cell.value = value;
+          cell.nSequence.store( ix + 1, std::memory_order_release );
+          return true;
+        }
+      }
+      else {
+        if ( 0 > diff ) return false;
+        ix = m_ixEnqueue.load( std::memory_order_relaxed );
+      }
+    }
+  }
+
+  bool Pop( T& value ) { // false when empty
+    std::size_t ix( m_ixDequeue.load( std::memory_order_relaxed ) );
+    for ( ;; ) {
+      Cell& cell( m_vCell[ ix & m_nMask ] );
+      const std::size_t nSequence( cell.nSequence.load( std::memory_order_acquire ) );
+      const std::intptr_t diff( (std::intptr_t)nSequence - (std::intptr_t)( ix + 1 ) );
+      if ( 0 == diff ) {
+        if ( m_ixDequeue.compare_exchange_weak( ix, ix + 1, std::memory_order_relaxed ) ) {
+          value = std::move( cell.value );
+          cell.nSequence.store( ix + m_nMask + 1, std::memory_order_release );
+          return true;
+        }
+      }
+      else {
+        if ( 0 > diff ) return false;
+        ix = m_ixDequeue.load( std::memory_order_relaxed );
+      }
+    }
+  }
+
+protected:
+private:
+
+  struct Cell {
+    std::atomic<std::size_t> nSequence;
+    T value;
+    Cell(): nSequence {}, value {} {}
+    Cell( const Cell& rhs ): nSequence( rhs.nSequence.load() ), value( rhs.value ) {} // construction only
+  };
+
+  using vCell_t = std::vector<Cell>;
+  vCell_t m_vCell;
+  std::size_t m_nMask;
+
+  alignas( 64 ) std::atomic<std::size_t> m_ixEnqueue;
+  alignas( 64 ) std::atomic<std::size_t> m_ixDequeue;
+};
+
+} // namespace ou
@@ -0,0 +1,259 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    JsonScanner.h
+ * Author:  raymond@burkholder.net
+ * Project: OUCommon
+ * Created: October 17, 2026 20:50
+ */
+
+#pragma once
+
+// pull scanner for json messages with a known schema, nothing is allocated:
+//   the caller walks the message in document order, taking the members it needs, skipping the rest
+//   strings are returned as views into the message, escapes are left in place, see Escaped()
+//   numbers may also be quoted, as some feeds send prices and quantities as strings
+//   members and elements must be comma separated: a missing, leading or trailing comma fails
+//   on malformed input, Failed() becomes true and every further call returns false
+//
+//   ou::JsonScanner scan( sMessage );
+//   std::string_view key;
+//   if ( scan.Object() ) {
+//     while ( scan.Key( key ) ) {
+//       if ( "price" == key ) scan.Number( price );
+//       else scan.Skip();
+//     }
+//   }
+//   if ( scan.Failed() ) ...
+
+#include <cstdint>
+#include <charconv>
+#include <string_view>
+
+namespace ou { // One Unified
+
+class JsonScanner {
+public:
+
+  enum class EType { Null, Boolean, Number, String, Array, Object, End, Error };
+
+  explicit JsonScanner( std::string_view sv )
+  : m_p( sv.data() ), m_end( sv.data() + sv.size() ), m_bFailed( false ), m_bEscaped( false ), m_bFirst( false ) {}
+
+  bool Failed() const { return m_bFailed; }
+  bool Escaped() const { return m_bEscaped; } // last string contained an escape
+
+  EType Peek() {
+    Space();
+    if ( m_end == m_p ) return m_bFailed ? EType::Error : EType::End;
+    switch ( *m_p ) {
+      case '{': return EType::Object;
+      case '[': return EType::Array;
+      case '"': return EType::String;
+      case 'n': return EType::Null;
+      case 't':
+      case 'f': return EType::Boolean;
+      default:  return ( ( '-' == *m_p ) || ( ( '0' <= *m_p ) && ( '9' >= *m_p ) ) ) ? EType::Number : EType::Error;
+    }
+  }
+
+  bool Object() { return Opened( '{' ); }
+
+  // true with the next key of the object, false at the closing brace, which is consumed
+  bool Key( std::string_view& key ) {
+    if ( !Delimit( '}' ) ) return false;
+    return String( key ) && Expect( ':' );
+  }
+
+  bool Array() { return Opened( '[' ); }
+
+  // true ahead of the next element of the array, false at the closing bracket, which is consumed
+  bool Element() { return Delimit( ']' ); }
+
+  bool String( std::string_view& sv ) {
+    const char* begin;
+    const char* end;
+    if ( !Quoted( begin, end ) ) return false;
+    sv = std::string_view( begin, end - begin );
+    return true;
+  }
+
+  // number, or a quoted number
+  bool Number( uint64_t& n ) { return Convert( n ); }
+  bool Number( int64_t& n ) { return Convert( n ); }
+  bool Number( double& n ) { return Convert( n ); }
+
+  bool Boolean( bool& b ) {
+    Space();
+    if ( Literal( "true" ) ) { b = true; return true; }
+    if ( Literal( "false" ) ) { b = false; return true; }
+    return Fail();
+  }
+
+  bool Null() { // consumes the value only when it is null
+    Space();
+    return Literal( "null" );
+  }
+
+  bool Skip() {
+    std::string_view sv;
+    return Value( sv );
+  }
+
+  bool Value( std::string_view& sv ) { // any value, as its text
+    Space();
+    const char* begin( m_p );
+    std::string_view key;
+    switch ( Peek() ) {
+      case EType::Object:
+        Object();
+        while ( Key( key ) ) Skip();
+        break;
+      case EType::Array:
+        Array();
+        while ( Element() ) Skip();
+        break;
+      case EType::String:
+        String( key );
+        break;
+      case EType::Null:
+        if ( !Literal( "null" ) ) Fail();
+        break;
+      case EType::Boolean:
+        {
+          bool b;
+          Boolean( b );
+        }
+        break;
+      case EType::Number:
+        while ( ( m_end != m_p ) && Numeric( *m_p ) ) ++m_p;
+        break;
+      default:
+        Fail();
+        break;
+    }
+    if ( m_bFailed ) return false;
+    sv = std::string_view( begin, m_p - begin );
+    return true;
+  }
+
+protected:
+private:
+
+  const char* m_p;
+  const char* m_end;
+  bool m_bFailed;
+  bool m_bEscaped;
+  bool m_bFirst; // no member or element yet in the innermost object or array
+
+  bool Fail() {
+    m_bFailed = true;
+    m_p = m_end;
+    return false;
+  }
+
+  void Space() {
+    while ( ( m_end != m_p ) && ( ( ' ' == *m_p ) || ( '\n' == *m_p ) || ( '\r' == *m_p ) || ( '\t' == *m_p ) ) ) ++m_p;
+  }
+
+  bool Expect( char ch ) {
+    Space();
+    if ( ( m_end != m_p ) && ( ch == *m_p ) ) {
+      ++m_p;
+      return true;
+    }
+    return Fail();
+  }
+
+  bool Opened( char ch ) {
+    if ( !Expect( ch ) ) return false;
+    m_bFirst = true;
+    return true;
+  }
+
+  bool Delimit( char chClose ) { // the comma ahead of each but the first is consumed
+    Space();
+    if ( m_end == m_p ) return Fail();
+    if ( chClose == *m_p ) {
+      ++m_p;
+      m_bFirst = false; // the enclosing object or array now has a member
+      return false;
+    }
+    if ( m_bFirst ) {
+      m_bFirst = false;
+      return true; // a leading comma then fails as the member or element
+    }
+    if ( ',' != *m_p ) return Fail();
+    ++m_p;
+    Space();
+    return ( m_end != m_p ) || Fail();
+  }
+
+  bool Literal( std::string_view sv ) {
+    if ( ( (size_t)( m_end - m_p ) >= sv.size() ) && ( 0 == sv.compare( 0, sv.size(), m_p, sv.size() ) ) ) {
+      m_p += sv.size();
+      return true;
+    }
+    return false;
+  }
+
+  static bool Numeric( char ch ) {
+    return ( ( '0' <= ch ) && ( '9' >= ch ) ) || ( '-' == ch ) || ( '+' == ch ) || ( '.' == ch ) || ( 'e' == ch ) || ( 'E' == ch );
+  }
+
+  bool Quoted( const char*& begin, const char*& end ) {
+    if ( !Expect( '"' ) ) return false;
+    m_bEscaped = false;
+    begin = m_p;
+    while ( m_end != m_p ) {
+      switch ( *m_p ) {
+        case '"':
+          end = m_p;
+          ++m_p;
+          return true;
+        case '\\':
+          m_bEscaped = true;
+          if ( m_end == ++m_p ) return Fail();
+          break;
+      }
+      ++m_p;
+    }
+    return Fail();
+  }
+
+  template<typename T>
+  bool Convert( T& n ) {
+    Space();
+    const char* begin( m_p );
+    const char* end( m_end );
+    bool bQuoted( false );
+    if ( ( m_end != m_p ) && ( '"' == *m_p ) ) {
+      if ( !Quoted( begin, end ) ) return false;
+      bQuoted = true;
+    }
+    const std::from_chars_result result = std::from_chars( begin, end, n );
+    if ( std::errc() != result.ec ) return Fail();
+    if ( bQuoted ) {
+      if ( end != result.ptr ) return Fail();
+    }
+    else {
+      m_p = result.ptr;
+    }
+    return true;
+  }
+
+};
+
+} // namespace ou
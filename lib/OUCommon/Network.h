@@ -16,6 +16,8 @@
 #include <string>
 #include <vector>
 #include <cassert>
+#include <cstring>
+#include <string_view>
 
 #include <boost/asio.hpp>  // class outbound processing
 #include <boost/array.hpp>
@@ -62,6 +64,13 @@ using boost::asio::ip::tcp;
 // ownerT:  CRTP class
 // charT:  type of character processed
 
+// two receive modes, selected by which callback ownerT supplies:
+//   OnNetworkLineBuffer: each line is copied into a linebuffer_t from the repository, owner gives it back later
+//   OnNetworkLineView:   lines are views directly into a contiguous receive buffer,
+//                        valid only for the duration of the callback, nothing is copied or allocated
+//                        (a partial line at the end of a read is shifted to the front before the next read)
+//                        in both modes every cr is dropped and the lf terminates the line
+
 namespace ou {
 
 template <typename ownerT, typename charT = unsigned char>
@@ -76,6 +85,7 @@ public:
   };
 
 #define NETWORK_INPUT_BUF_SIZE 2048
+#define NETWORK_RECEIVE_BUF_SIZE 65536
 
   using port_t = unsigned short;
   using ipaddress_t =  std::string;
@@ -94,6 +104,7 @@ public:
   using inputrepository_t = BufferRepository<inputbuffer_t>;
   using linebuffer_t = std::vector<bufferelement_t>;  // used for composing lines of data for processing
   using linerepository_t = BufferRepository<linebuffer_t>;
+  using lineview_t = std::string_view; // OnNetworkLineView, excludes the lf, cr removed
 
   Network();
   Network( const structConnection& connection );
@@ -115,6 +126,7 @@ protected:
   void OnNetworkDisconnected() {};
   void OnNetworkError( size_t ) {;};
   void OnNetworkLineBuffer( linebuffer_t* ) {};  // new line available for processing
+  void OnNetworkLineView( lineview_t ) {};  // new line available, in place, for the duration of the call
   void OnNetworkSendDone() {};
 
 private:
@@ -148,6 +160,10 @@ private:
 
   linebuffer_t* m_pline;  // current parsing results
 
+  linebuffer_t m_vReceive; // OnNetworkLineView mode, contiguous receive buffer
+  size_t m_ixReceiveBegin {}; // start of the unprocessed line
+  size_t m_ixReceiveEnd {};   // end of received data
+
   size_t m_cntAsyncReads;
   size_t m_cntBytesTransferred_input;
   size_t m_cntLinesProcessed;
@@ -161,7 +177,13 @@ private:
   void OnSendDone( const boost::system::error_code& error, std::size_t bytes_transferred, linebuffer_t* );
   void OnSendDoneNoNotify( const boost::system::error_code& error, std::size_t bytes_transferred, linebuffer_t* );
   void OnReadDone( const boost::system::error_code& error, const std::size_t bytes_transferred, inputbuffer_t* );
+  void OnReadViewDone( const boost::system::error_code& error, const std::size_t bytes_transferred );
   void AsyncRead( void );
+  void AsyncReadView( void );
+
+  static bool LineViewMode() {
+    return &Network<ownerT, charT>::OnNetworkLineView != &ownerT::OnNetworkLineView;
+  }
 
   void AsioThread( void );
 
@@ -235,6 +257,9 @@ template <typename ownerT, typename charT>
 void Network<ownerT,charT>::CommonConstruction() {
   m_pline = m_reposLineBuffers.CheckOutL();  // have a receiving line ready
   m_pline->clear();
+  if ( LineViewMode() ) {
+    m_vReceive.resize( NETWORK_RECEIVE_BUF_SIZE );
+  }
   m_pwork = new boost::asio::io_service::work(m_io);  // keep the asio service running
   m_asioThread = boost::thread( boost::bind( &Network::AsioThread, this ) );
   m_stateNetwork = NS_DISCONNECTED;
@@ -375,7 +400,13 @@ void Network<ownerT,charT>::OnConnectDone( const boost::system::error_code& erro
       static_cast<ownerT*>( this )->OnNetworkConnected();
     }
 
-    AsyncRead();
+    if ( LineViewMode() ) {
+      m_ixReceiveBegin = m_ixReceiveEnd = 0;
+      AsyncReadView();
+    }
+    else {
+      AsyncRead();
+    }
   }
 }
 
@@ -529,6 +560,114 @@ void Network<ownerT,charT>::OnReadDone( const boost::system::error_code& error,
   boost::interprocess::ipcdetail::atomic_dec32( &m_lReadProgress );
 }
 
+//
+// AsyncReadView
+//
+
+template <typename ownerT, typename charT>
+void Network<ownerT,charT>::AsyncReadView() {
+
+  if ( NS_DISCONNECTING == m_stateNetwork ) {
+  }
+  else {
+    assert( NS_CONNECTED == m_stateNetwork );
+  }
+
+  boost::interprocess::ipcdetail::atomic_inc32( &m_lReadProgress );
+
+  // make room: shift the partial line to the front, or grow when a single line fills the buffer
+  if ( ( m_vReceive.size() - m_ixReceiveEnd ) < NETWORK_INPUT_BUF_SIZE ) {
+    if ( 0 < m_ixReceiveBegin ) {
+      const size_t nPartial = m_ixReceiveEnd - m_ixReceiveBegin;
+      std::memmove( m_vReceive.data(), m_vReceive.data() + m_ixReceiveBegin, nPartial );
+      m_ixReceiveBegin = 0;
+      m_ixReceiveEnd = nPartial;
+    }
+    if ( ( m_vReceive.size() - m_ixReceiveEnd ) < NETWORK_INPUT_BUF_SIZE ) {
+      m_vReceive.resize( 2 * m_vReceive.size() );
+    }
+  }
+
+  // the next read is issued after the current data is processed, so the view remains valid during the callback
+  m_psocket->async_read_some(
+    boost::asio::buffer( m_vReceive.data() + m_ixReceiveEnd, m_vReceive.size() - m_ixReceiveEnd ),
+    boost::bind(
+      &Network::OnReadViewDone, this,
+      boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred ) );
+}
+
+//
+// OnReadViewDone
+//
+
+template <typename ownerT, typename charT>
+void Network<ownerT,charT>::OnReadViewDone( const boost::system::error_code& error, const std::size_t bytes_transferred ) {
+
+  static_assert( 1 == sizeof( bufferelement_t ), "OnNetworkLineView requires single byte characters" );
+
+  if ( error || ( 0 == bytes_transferred ) ) {
+    // eof: connection has been closed, operation_aborted: socket closed locally during disconnect
+    // no further read is issued, any partial line is discarded
+    m_ixReceiveBegin = m_ixReceiveEnd = 0;
+    if ( error
+      && ( boost::asio::error::eof != error )
+      && ( boost::asio::error::operation_aborted != error )
+      && ( NS_DISCONNECTING != m_stateNetwork )
+    ) {
+      if ( &Network<ownerT, charT>::OnNetworkError != &ownerT::OnNetworkError ) {
+        static_cast<ownerT*>( this )->OnNetworkError( ERROR_SOCKET );
+      }
+    }
+  }
+  else {
+    assert( ( NS_CONNECTED == m_stateNetwork ) || ( NS_DISCONNECTING == m_stateNetwork) );
+
+    ++m_cntAsyncReads;
+    m_cntBytesTransferred_input += bytes_transferred;
+
+    char* const data = reinterpret_cast<char*>( m_vReceive.data() );
+
+    // drop every cr in the new data, as OnReadDone does, compacting in place
+    const size_t ixReceived = m_ixReceiveEnd + bytes_transferred;
+    size_t ixKept = ixReceived;
+    const char* pCr = static_cast<const char*>( std::memchr( data + m_ixReceiveEnd, 0x0d, bytes_transferred ) );
+    if ( nullptr != pCr ) {
+      ixKept = pCr - data;
+      for ( size_t ix = ixKept + 1; ix < ixReceived; ++ix ) {
+        if ( 0x0d != data[ ix ] ) data[ ixKept++ ] = data[ ix ];
+      }
+    }
+
+    size_t ixScan = m_ixReceiveEnd; // earlier bytes have already been scanned for a line feed
+    m_ixReceiveEnd = ixKept;
+
+    while ( ixScan < m_ixReceiveEnd ) {
+      const char* pLf = static_cast<const char*>( std::memchr( data + ixScan, 0x0a, m_ixReceiveEnd - ixScan ) );
+      if ( nullptr == pLf ) break;
+      const size_t ixLf = pLf - data;
+      try {
+        static_cast<ownerT*>( this )->OnNetworkLineView( lineview_t( data + m_ixReceiveBegin, ixLf - m_ixReceiveBegin ) );
+      }
+      catch( const std::logic_error& e ) {
+        std::cerr << "Network<>::OnReadViewDone caught: " << e.what() << std::endl;
+      }
+      catch(...) {
+        std::cerr << "Network<>::OnReadViewDone default exception handler" << std::endl;
+      }
+      ++m_cntLinesProcessed;
+      m_ixReceiveBegin = ixScan = ixLf + 1;
+    }
+
+    if ( m_ixReceiveBegin == m_ixReceiveEnd ) { // nothing partial, start at the front again
+      m_ixReceiveBegin = m_ixReceiveEnd = 0;
+    }
+
+    AsyncReadView();
+  }
+
+  boost::interprocess::ipcdetail::atomic_dec32( &m_lReadProgress );
+}
+
 //
 // Send
 //
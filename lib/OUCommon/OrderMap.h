@@ -0,0 +1,156 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    OrderMap.h
+ * Author:  raymond@burkholder.net
+ * Project: OUCommon
+ * Created  October 17, 2026 10:05
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+
+namespace ou { // One Unified
+
+// ==== OrderMap: open addressing hash keyed by order id
+//   (TFIQFeed/Level2 book, simulated matching engine):
+//   linear probing in one contiguous table, power of two capacity, kept at most half full,
+//   erase shifts the following entries back rather than leaving tombstones
+//   pointers returned by Find/Emplace are invalidated by a subsequent Emplace or Erase
+
+template<typename Value>
+class OrderMap {
+public:
+
+  using key_t = uint64_t;
+
+  OrderMap( std::size_t nCapacity = 4096 )
+  : m_nSize {}
+  {
+    std::size_t n( 16 );
+    while ( n < nCapacity ) n <<= 1;
+    m_vSlot.resize( n );
+    m_nMask = n - 1;
+  }
+
+  std::size_t Size() const { return m_nSize; }
+
+  void Clear() {
+    for ( Slot& slot: m_vSlot ) slot.bUsed = false;
+    m_nSize = 0;
+  }
+
+  Value* Find( key_t key ) {
+    std::size_t ix( Hash( key ) & m_nMask );
+    while ( m_vSlot[ ix ].bUsed ) {
+      if ( key == m_vSlot[ ix ].key ) return &m_vSlot[ ix ].value;
+      ix = ( ix + 1 ) & m_nMask;
+    }
+    return nullptr;
+  }
+
+  // returns existing entry, and false, if key is already present
+  std::pair<Value*,bool> Emplace( key_t key, const Value& value ) {
+    if ( ( 2 * ( m_nSize + 1 ) ) > m_vSlot.size() ) Grow();
+    std::size_t ix( Hash( key ) & m_nMask );
+    while ( m_vSlot[ ix ].bUsed ) {
+      if ( key == m_vSlot[ ix ].key ) return std::pair( &m_vSlot[ ix ].value, false );
+      ix = ( ix + 1 ) & m_nMask;
+    }
+    Slot& slot( m_vSlot[ ix ] );
+    slot.key = key;
+    slot.value = value;
+    slot.bUsed = true;
+    m_nSize++;
+    return std::pair( &slot.value, true );
+  }
+
+  bool Erase( key_t key ) {
+    std::size_t ix( Hash( key ) & m_nMask );
+    while ( m_vSlot[ ix ].bUsed ) {
+      if ( key == m_vSlot[ ix ].key ) {
+        // backward shift: pull up any later entry whose home slot does not lie in ( ix, ixNext ]
+        std::size_t ixHole( ix );
+        std::size_t ixNext( ( ix + 1 ) & m_nMask );
+        while ( m_vSlot[ ixNext ].bUsed ) {
+          const std::size_t ixHome( Hash( m_vSlot[ ixNext ].key ) & m_nMask );
+          if ( ( ( ixNext - ixHome ) & m_nMask ) >= ( ( ixNext - ixHole ) & m_nMask ) ) {
+            m_vSlot[ ixHole ] = std::move( m_vSlot[ ixNext ] );
+            ixHole = ixNext;
+          }
+          ixNext = ( ixNext + 1 ) & m_nMask;
+        }
+        m_vSlot[ ixHole ].bUsed = false;
+        m_nSize--;
+        return true;
+      }
+      ix = ( ix + 1 ) & m_nMask;
+    }
+    return false;
+  }
+
+  template<typename Function> // void( key_t, Value& )
+  void ForEach( Function&& f ) {
+    for ( Slot& slot: m_vSlot ) {
+      if ( slot.bUsed ) f( slot.key, slot.value );
+    }
+  }
+
+protected:
+private:
+
+  struct Slot {
+    key_t key;
+    bool bUsed;
+    Value value;
+    Slot(): key {}, bUsed( false ), value {} {}
+  };
+
+  using vSlot_t = std::vector<Slot>;
+  vSlot_t m_vSlot;
+
+  std::size_t m_nMask;
+  std::size_t m_nSize;
+
+  static std::size_t Hash( key_t key ) { // splitmix64 finalizer, order ids are sequential
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+  }
+
+  void Grow() { // keys are unique, so re-insertion only needs the first free slot
+    vSlot_t vSlot( 2 * m_vSlot.size() );
+    std::swap( vSlot, m_vSlot );
+    m_nMask = m_vSlot.size() - 1;
+    for ( Slot& slot: vSlot ) {
+      if ( slot.bUsed ) {
+        std::size_t ix( Hash( slot.key ) & m_nMask );
+        while ( m_vSlot[ ix ].bUsed ) ix = ( ix + 1 ) & m_nMask;
+        m_vSlot[ ix ] = std::move( slot );
+      }
+    }
+  }
+
+};
+
+} // namespace ou
@@ -0,0 +1,104 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    SeqLock.h
+ * Author:  raymond@burkholder.net
+ * Project: OUCommon
+ * Created: October 17, 2026 14:40
+ */
+
+#pragma once
+
+// last value cache:  one writer, any number of readers, neither side takes a lock
+//   the writer never waits, a reader retries when it overlaps a write
+//   the value is held as atomic words, so T needs to be trivially copyable
+//   Load returns a version, which advances with each Store, so a reader can skip work when nothing has changed
+
+#include <atomic>
+#include <thread>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+
+namespace ou { // One Unified
+
+template<typename T>
+class SeqLock {
+  static_assert( std::is_trivially_copyable<T>::value, "SeqLock: T needs to be trivially copyable" );
+public:
+
+  using version_t = uint64_t;
+
+  SeqLock(): m_nSequence( 0 ) {
+    for ( std::atomic<uint64_t>& word: m_rWord ) word.store( 0, std::memory_order_relaxed );
+  }
+
+  SeqLock( const T& value ): SeqLock() { Store( value ); }
+
+  SeqLock( const SeqLock& ) = delete;
+  SeqLock& operator=( const SeqLock& ) = delete;
+
+  // single writer
+  void Store( const T& value ) {
+    uint64_t rWord[ nWords ] {};
+    std::memcpy( rWord, &value, sizeof( T ) );
+    const uint64_t nSequence( m_nSequence.load( std::memory_order_relaxed ) );
+    m_nSequence.store( nSequence + 1, std::memory_order_relaxed ); // odd: write in progress
+    std::atomic_thread_fence( std::memory_order_release );
+    for ( size_t ix = 0; ix < nWords; ix++ ) {
+      m_rWord[ ix ].store( rWord[ ix ], std::memory_order_relaxed );
+    }
+    m_nSequence.store( nSequence + 2, std::memory_order_release );
+  }
+
+  // consistent copy of the most recent Store, returns its version
+  version_t Load( T& value ) const {
+    uint64_t rWord[ nWords ];
+    uint64_t nSequence1, nSequence2;
+    for ( ;; ) {
+      nSequence1 = m_nSequence.load( std::memory_order_acquire );
+      if ( 0 == ( nSequence1 & 1 ) ) {
+        for ( size_t ix = 0; ix < nWords; ix++ ) {
+          rWord[ ix ] = m_rWord[ ix ].load( std::memory_order_relaxed );
+        }
+        std::atomic_thread_fence( std::memory_order_acquire );
+        nSequence2 = m_nSequence.load( std::memory_order_relaxed );
+        if ( nSequence1 == nSequence2 ) break;
+      }
+      std::this_thread::yield();
+    }
+    std::memcpy( &value, rWord, sizeof( T ) );
+    return nSequence1 >> 1;
+  }
+
+  T Load() const {
+    T value;
+    Load( value );
+    return value;
+  }
+
+  version_t Version() const { return m_nSequence.load( std::memory_order_acquire ) >> 1; } // 0 until the first Store
+
+protected:
+private:
+
+  static const size_t nWords = ( sizeof( T ) + sizeof( uint64_t ) - 1 ) / sizeof( uint64_t );
+
+  alignas( 64 ) std::atomic<uint64_t> m_nSequence;
+  std::atomic<uint64_t> m_rWord[ nWords ];
+
+};
+
+} // namespace ou
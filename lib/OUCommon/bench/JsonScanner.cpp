@@ -0,0 +1,298 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// ou::JsonScanner replay:  websocket frames, one per line, from a capture (or synthesized Phemex
+//   trade and Alpaca trade_updates frames) are decoded as the providers decode them, reporting ns/frame;
+//   a set of well formed and malformed documents is checked first
+//   usage: OUCommonJsonScanner [capture file [passes]]
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+#include <OUCommon/JsonScanner.h>
+
+namespace {
+
+struct Tally {
+  size_t cntFrames {};
+  size_t cntBytes {};
+  size_t cntFailed {};
+  size_t cntTrades {};
+  uint64_t hash { 14695981039346656037ull };  // fnv-1a over decoded values
+  void Add( uint64_t n ) { hash ^= n; hash *= 1099511628211ull; }
+  void Add( std::string_view sv ) { for ( const char ch: sv ) { hash ^= (unsigned char)ch; hash *= 1099511628211ull; } }
+};
+
+// as phemex::Provider and phemex::gateway::trades::Decode:
+//   {"sequence":n,"symbol":"...","trades":[[time_stamp,"Buy",priceEp,quantity],...],"type":"..."}
+bool Phemex( std::string_view sMessage, Tally& tally ) {
+
+  ou::JsonScanner scan( sMessage );
+  std::string_view key;
+  std::string_view svSymbol;
+  std::string_view svType;
+  uint64_t id {};
+  uint64_t sequence {};
+
+  if ( scan.Object() ) {
+    while ( scan.Key( key ) ) {
+      if ( "error" == key ) {
+        if ( !scan.Null() ) scan.Skip();
+      }
+      else if ( "id" == key ) {
+        if ( !scan.Null() ) scan.Number( id );
+      }
+      else if ( "trades" == key ) {
+        if ( scan.Array() ) {
+          while ( scan.Element() ) {
+            uint64_t time_stamp {}, price {}, quantity {};
+            std::string_view side;
+            bool bOk
+              =  scan.Array()
+              && scan.Element() && scan.Number( time_stamp )
+              && scan.Element() && scan.String( side )
+              && scan.Element() && scan.Number( price )
+              && scan.Element() && scan.Number( quantity )
+              ;
+            if ( bOk ) {
+              while ( scan.Element() ) scan.Skip();
+            }
+            tally.Add( time_stamp ); tally.Add( side ); tally.Add( price ); tally.Add( quantity );
+            ++tally.cntTrades;
+          }
+        }
+      }
+      else if ( "sequence" == key ) scan.Number( sequence );
+      else if ( "symbol" == key ) scan.String( svSymbol );
+      else if ( "type" == key ) scan.String( svType );
+      else scan.Skip();
+    }
+  }
+
+  tally.Add( id ); tally.Add( sequence ); tally.Add( svSymbol ); tally.Add( svType );
+  return !scan.Failed();
+}
+
+// as alpaca::Provider and Provider::TradeUpdate:  {"stream":"...","data":{...}}
+bool Alpaca( std::string_view sMessage, Tally& tally ) {
+
+  ou::JsonScanner scan( sMessage );
+  std::string_view key;
+  std::string_view svStream;
+  std::string_view svData;
+
+  if ( scan.Object() ) {
+    while ( scan.Key( key ) ) {
+      if ( "stream" == key ) scan.String( svStream );
+      else if ( "data" == key ) scan.Value( svData );
+      else scan.Skip();
+    }
+  }
+  if ( scan.Failed() ) return false;
+  tally.Add( svStream );
+  if ( "trade_updates" != svStream ) return true;
+
+  std::string_view event, timestamp, execution_id, order_id, order_side;
+  double price {}, qty {}, position_qty {};
+
+  ou::JsonScanner data( svData );
+  if ( data.Object() ) {
+    while ( data.Key( key ) ) {
+      if ( "event" == key ) data.String( event );
+      else if ( "timestamp" == key ) data.String( timestamp );
+      else if ( "execution_id" == key ) data.String( execution_id );
+      else if ( "price" == key ) data.Number( price );
+      else if ( "qty" == key ) data.Number( qty );
+      else if ( "position_qty" == key ) data.Number( position_qty );
+      else if ( "order" == key ) {
+        if ( data.Object() ) {
+          while ( data.Key( key ) ) {
+            if ( "id" == key ) data.String( order_id );
+            else if ( "side" == key ) data.String( order_side );
+            else data.Skip();
+          }
+        }
+      }
+      else data.Skip();
+    }
+  }
+
+  tally.Add( event ); tally.Add( timestamp ); tally.Add( execution_id ); tally.Add( order_id ); tally.Add( order_side );
+  tally.Add( uint64_t( price * 100.0 + 0.5 ) ); tally.Add( uint64_t( qty ) ); tally.Add( uint64_t( position_qty ) );
+  ++tally.cntTrades;
+  return !data.Failed();
+}
+
+bool IsAlpaca( std::string_view sv ) {
+  return std::string_view::npos != sv.substr( 0, 16 ).find( "\"stream\"" );
+}
+
+std::vector<std::string> Synthesize( size_t nFrames ) {
+  std::mt19937_64 rng( 42 );
+  static const char* rszSymbol[] = { "sBTCUSDT", "sETHUSDT", "BTCUSD", "ETHUSD" };
+  static const char* rszEvent[] = { "new", "fill", "partial_fill", "canceled" };
+  std::vector<std::string> vFrame;
+  vFrame.reserve( nFrames );
+  uint64_t ts = 1792224000000000000ull;
+  uint64_t priceEp = 650000000;
+  char sz[ 640 ];
+  for ( size_t ix = 0; ix < nFrames; ++ix ) {
+    ts += 1 + rng() % 5000000;
+    if ( 0 != ( ix % 8 ) ) { // phemex trades, one to five per frame
+      std::string s( "{\"sequence\":" + std::to_string( 1000000 + ix ) + ",\"symbol\":\"" + rszSymbol[ rng() % 4 ] + "\",\"trades\":[" );
+      const size_t nTrades = 1 + rng() % 5;
+      for ( size_t ixTrade = 0; ixTrade < nTrades; ++ixTrade ) {
+        priceEp += 500 * ( int( rng() % 5 ) - 2 );
+        snprintf( sz, sizeof( sz ), "%s[%llu,\"%s\",%llu,%llu]",
+          0 == ixTrade ? "" : ",",
+          (unsigned long long)( ts + ixTrade ), 0 == ( rng() % 2 ) ? "Buy" : "Sell",
+          (unsigned long long)priceEp, (unsigned long long)( 1 + rng() % 20000 ) );
+        s += sz;
+      }
+      s += "],\"type\":\"incremental\"}";
+      vFrame.emplace_back( std::move( s ) );
+    }
+    else { // alpaca trade update, order object in full as sent
+      const double price = priceEp / 1e4 / 100.0;
+      snprintf( sz, sizeof( sz ),
+        "{\"stream\":\"trade_updates\",\"data\":{\"event\":\"%s\",\"execution_id\":\"%016llx\","
+        "\"order\":{\"id\":\"%016llx\",\"client_order_id\":\"c%zu\",\"created_at\":\"2026-10-17T14:30:00.123456Z\","
+        "\"symbol\":\"SPY\",\"asset_class\":\"us_equity\",\"qty\":\"%u\",\"filled_qty\":\"%u\",\"filled_avg_price\":\"%.2f\","
+        "\"order_type\":\"limit\",\"type\":\"limit\",\"side\":\"%s\",\"time_in_force\":\"day\",\"limit_price\":\"%.2f\","
+        "\"stop_price\":null,\"status\":\"filled\",\"extended_hours\":false,\"legs\":null,\"trail_percent\":null},"
+        "\"position_qty\":\"%d\",\"price\":\"%.2f\",\"qty\":\"%u\",\"timestamp\":\"2026-10-17T14:30:01.%06zuZ\"}}",
+        rszEvent[ rng() % 4 ], (unsigned long long)rng(), (unsigned long long)rng(), ix,
+        unsigned( 1 + rng() % 100 ), unsigned( rng() % 100 ), price, 0 == ( rng() % 2 ) ? "buy" : "sell", price,
+        int( rng() % 200 ) - 100, price, unsigned( 1 + rng() % 100 ), ix % 1000000 );
+      vFrame.emplace_back( sz );
+    }
+  }
+  return vFrame;
+}
+
+// every document is walked fully with Value, as a provider skipping unknown members would
+bool Conformance() {
+  static const char* rszGood[] = {
+    "[]", "{}", " [ 1 , 2 ] ", "[[],[1],{}]", "{\"a\":[1,{\"b\":2}],\"c\":\"3\"}", "[true,false,null,-1.5e3]"
+  };
+  static const char* rszBad[] = {
+    "[1 2]", "{\"a\":1 \"b\":2}", "[,1]", "{,\"a\":1}", "[1,]", "{\"a\":1,}", "[1,,2]", "[[1] [2]]", "{\"a\":{} \"b\":1}", "[1"
+  };
+  bool bOk( true );
+  std::string_view sv;
+  for ( const char* sz: rszGood ) {
+    ou::JsonScanner scan( sz );
+    if ( !scan.Value( sv ) || ( ou::JsonScanner::EType::End != scan.Peek() ) ) {
+      std::cout << "rejected well formed: " << sz << std::endl;
+      bOk = false;
+    }
+  }
+  for ( const char* sz: rszBad ) {
+    ou::JsonScanner scan( sz );
+    if ( scan.Value( sv ) ) {
+      std::cout << "accepted malformed: " << sz << std::endl;
+      bOk = false;
+    }
+  }
+  return bOk;
+}
+
+struct Result {
+  Tally tally;
+  double dblBest {};
+};
+
+Result Replay( const std::vector<std::string>& vFrame, size_t nPasses ) {
+  using clock = std::chrono::steady_clock;
+  Result result;
+  for ( size_t pass = 0; pass < nPasses; ++pass ) {
+    Tally tally;
+    const auto start = clock::now();
+    for ( const std::string& s: vFrame ) {
+      const bool bOk = IsAlpaca( s ) ? Alpaca( s, tally ) : Phemex( s, tally );
+      if ( !bOk ) ++tally.cntFailed;
+      ++tally.cntFrames;
+      tally.cntBytes += s.size();
+    }
+    const double dblSeconds = std::chrono::duration<double>( clock::now() - start ).count();
+    if ( ( 0 == pass ) || ( dblSeconds < result.dblBest ) ) result.dblBest = dblSeconds;
+    if ( ( 0 != pass ) && ( tally.hash != result.tally.hash ) ) {
+      std::cout << "decode differs between passes" << std::endl;
+      result.tally.cntFailed = tally.cntFrames;
+      return result;
+    }
+    result.tally = tally;
+  }
+  return result;
+}
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  if ( !Conformance() ) return EXIT_FAILURE;
+  std::cout << "separators checked" << std::endl;
+
+  std::vector<std::string> vFrame;
+  if ( 1 < argc ) {
+    std::ifstream ifs( argv[ 1 ], std::ios::binary );
+    if ( !ifs ) {
+      std::cerr << "can not open " << argv[ 1 ] << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::string s;
+    while ( std::getline( ifs, s ) ) {
+      if ( !s.empty() && ( '\r' == s.back() ) ) s.pop_back();
+      if ( !s.empty() ) vFrame.emplace_back( std::move( s ) );
+    }
+  }
+  else {
+    vFrame = Synthesize( 1000000 );
+  }
+  const size_t nPasses = ( 2 < argc ) ? std::stoul( argv[ 2 ] ) : 5;
+
+  if ( vFrame.empty() ) {
+    std::cerr << "no frames to replay" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::string> vPhemex;
+  std::vector<std::string> vAlpaca;
+  for ( const std::string& s: vFrame ) ( IsAlpaca( s ) ? vAlpaca : vPhemex ).push_back( s );
+  std::cout << vFrame.size() << " frames, " << vPhemex.size() << " phemex, " << vAlpaca.size() << " alpaca, best of " << nPasses << std::endl;
+
+  bool bOk( true );
+  auto report = [&bOk, nPasses]( const char* szName, const std::vector<std::string>& v ){
+    if ( v.empty() ) return;
+    const Result result = Replay( v, nPasses );
+    std::cout
+      << szName << ": " << result.tally.cntFrames << " frames, "
+      << result.tally.cntTrades << " trades, "
+      << 1e9 * result.dblBest / result.tally.cntFrames << " ns/frame, "
+      << result.tally.cntBytes / result.dblBest / 1e6 << " MB/s, "
+      << result.tally.cntFailed << " failed"
+      << std::endl;
+    if ( 0 != result.tally.cntFailed ) bOk = false;
+  };
+  report( "phemex", vPhemex );
+  report( "alpaca", vAlpaca );
+  report( "mixed ", vFrame );
+
+  return bOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
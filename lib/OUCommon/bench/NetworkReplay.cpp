@@ -0,0 +1,363 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// ou::Network replay:  a recorded feed (or a synthetic IQFeed style Q stream, cr/lf terminated)
+//   is served from a loopback socket in uneven writes, then received by a line buffer owner
+//   and by a line view owner; lines and content checksums must agree.
+//   IQFeed remains on line buffers (its messages hold the buffer past the callback), so its Q decode,
+//   IQFBaseMessage tokenizing plus the Provider's symbol lookup, is measured on the buffer path and
+//   in memory, with Field (a string key) against FieldView (a heterogeneous lookup)
+//   usage: OUCommonNetworkReplay [capture file [passes]]
+
+#include <mutex>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+#include <condition_variable>
+
+#include <OUCommon/Network.h>
+
+#include <TFIQFeed/Messages.h>
+
+namespace {
+
+using port_t = unsigned short;
+
+struct Tally {
+  size_t cntLines {};
+  size_t cntBytes {};
+  uint64_t hash { 14695981039346656037ull };  // fnv-1a over line content and terminators
+  void Line( const unsigned char* p, size_t n ) {
+    for ( size_t ix = 0; ix < n; ++ix ) { hash ^= p[ ix ]; hash *= 1099511628211ull; }
+    hash ^= 0x0a; hash *= 1099511628211ull;
+    ++cntLines;
+    cntBytes += n;
+  }
+};
+
+template<typename T>
+class Owner: public ou::Network<T> {
+  friend ou::Network<T>;
+public:
+  Owner( port_t port, size_t nExpected )
+  : ou::Network<T>( "127.0.0.1", port ), m_nExpected( nExpected ), m_bDone( false ), m_bError( false ) {}
+  bool Wait() {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    return m_cv.wait_for( lock, std::chrono::seconds( 60 ), [this]{ return m_bDone || m_bError; } )
+      && !m_bError;
+  }
+  const Tally& Result() const { return m_tally; }
+protected:
+  Tally m_tally;
+  void Counted() {
+    if ( m_nExpected == m_tally.cntLines ) {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      m_bDone = true;
+      m_cv.notify_one();
+    }
+  }
+  void OnNetworkError( size_t ) {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_bError = true;
+    m_cv.notify_one();
+  }
+private:
+  const size_t m_nExpected;
+  bool m_bDone;
+  bool m_bError;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+};
+
+class BufferOwner: public Owner<BufferOwner> {
+  friend ou::Network<BufferOwner>;
+public:
+  using Owner<BufferOwner>::Owner;
+protected:
+  void OnNetworkLineBuffer( linebuffer_t* p ) {
+    m_tally.Line( p->data(), p->size() );
+    GiveBackBuffer( p );
+    Counted();
+  }
+};
+
+class ViewOwner: public Owner<ViewOwner> {
+  friend ou::Network<ViewOwner>;
+public:
+  using Owner<ViewOwner>::Owner;
+protected:
+  void OnNetworkLineView( lineview_t view ) {
+    m_tally.Line( reinterpret_cast<const unsigned char*>( view.data() ), view.size() );
+    Counted();
+  }
+};
+
+// IQFeed's decode of a Q line, field numbering as in IQFUpdateMessage
+class QMessage: public ou::tf::iqfeed::IQFBaseMessage<QMessage> {
+public:
+  enum EField { QSymbol = 2, QLast = 3, QBid = 8, QAsk = 9 }; // layout of the synthetic stream
+  size_t Fields() const { return m_vFieldDelimiters.size() - 1; }
+};
+
+static_assert( std::is_same<QMessage::linebuffer_t, ou::Network<BufferOwner>::linebuffer_t>::value, "line buffers differ" );
+
+struct Watch {
+  size_t cntUpdate {};
+  double dblSum {};
+};
+
+// symbol map as in ProviderInterface: transparent, so FieldView finds without building a key
+template<bool bView>
+class Decoder {
+public:
+  using linebuffer_t = QMessage::linebuffer_t;
+  using iterator_t = QMessage::iterator_t;
+  using mapSymbols_t = std::map<std::string, Watch, std::less<> >;
+  void Decode( iterator_t begin, iterator_t end ) {
+    if ( ( begin == end ) || ( 'Q' != *begin ) ) return;
+    m_msg.Assign( begin, end );
+    if ( QMessage::QSymbol > m_msg.Fields() ) return;
+    mapSymbols_t::iterator iter;
+    if constexpr ( bView ) {
+      const std::string_view svSymbol( m_msg.FieldView( QMessage::QSymbol ) );
+      iter = m_mapSymbols.find( svSymbol );
+      if ( m_mapSymbols.end() == iter ) iter = m_mapSymbols.emplace( std::string( svSymbol ), Watch() ).first;
+    }
+    else {
+      const std::string sSymbol( m_msg.Field( QMessage::QSymbol ) );
+      iter = m_mapSymbols.find( sSymbol );
+      if ( m_mapSymbols.end() == iter ) iter = m_mapSymbols.emplace( sSymbol, Watch() ).first;
+    }
+    Watch& watch( iter->second );
+    watch.cntUpdate++;
+    if ( QMessage::QAsk <= m_msg.Fields() ) {
+      watch.dblSum += m_msg.Double( QMessage::QLast ) + m_msg.Double( QMessage::QBid ) + m_msg.Double( QMessage::QAsk );
+    }
+    ++m_cntMessages;
+  }
+  size_t Messages() const { return m_cntMessages; }
+  const mapSymbols_t& Symbols() const { return m_mapSymbols; }
+private:
+  QMessage m_msg;
+  mapSymbols_t m_mapSymbols;
+  size_t m_cntMessages {};
+};
+
+template<bool bViewA, bool bViewB>
+bool Same( const Decoder<bViewA>& a, const Decoder<bViewB>& b ) {
+  if ( ( a.Messages() != b.Messages() ) || ( a.Symbols().size() != b.Symbols().size() ) ) return false;
+  auto iterB = b.Symbols().begin();
+  for ( const auto& vt: a.Symbols() ) {
+    if ( ( vt.first != iterB->first ) || ( vt.second.cntUpdate != iterB->second.cntUpdate ) || ( vt.second.dblSum != iterB->second.dblSum ) ) return false;
+    ++iterB;
+  }
+  return true;
+}
+
+// the buffer owner, decoding as IQFeed does
+class DecodeOwner: public Owner<DecodeOwner> {
+  friend ou::Network<DecodeOwner>;
+public:
+  using Owner<DecodeOwner>::Owner;
+  const Decoder<true>& Decoded() const { return m_decoder; }
+protected:
+  void OnNetworkLineBuffer( linebuffer_t* p ) {
+    m_decoder.Decode( p->begin(), p->end() );
+    m_tally.Line( p->data(), p->size() );
+    GiveBackBuffer( p );
+    Counted();
+  }
+private:
+  Decoder<true> m_decoder;
+};
+
+std::string Synthesize( size_t nLines ) {
+  std::mt19937_64 rng( 42 );
+  static const char* rszSymbol[] = { "SPY", "QQQ", "@ESZ26", "AAPL", "MSFT", "IWM" };
+  std::string s;
+  s.reserve( nLines * 96 );
+  double dblBid = 500.0;
+  for ( size_t ix = 0; ix < nLines; ++ix ) {
+    dblBid += 0.01 * ( int( rng() % 5 ) - 2 );
+    const int nBidSize = 1 + rng() % 50;
+    const int nAskSize = 1 + rng() % 50;
+    const bool bTrade = 0 == ( rng() % 4 );
+    char sz[ 160 ];
+    snprintf( sz, sizeof( sz ), "Q,%s,%.2f,%d,%02u:%02u:%02u.%06u%c,11,%u,%.2f,%.2f,%d,%d,%s,\r\n",
+      rszSymbol[ rng() % 6 ], dblBid + 0.01, 1 + int( rng() % 200 ),
+      unsigned( 9 + ix / 3600000 % 7 ), unsigned( ix / 60000 % 60 ), unsigned( ix / 1000 % 60 ), unsigned( ix % 1000 * 1000 ),
+      bTrade ? 't' : 'b', unsigned( 1000000 + ix ), dblBid, dblBid + 0.02, nBidSize, nAskSize,
+      bTrade ? "Cba" : "ba" );
+    if ( 0 == ( ix % 997 ) ) s += '\r';  // a stray cr now and then, both modes drop it
+    s += sz;
+  }
+  return s;
+}
+
+size_t CountLines( const std::string& s ) {
+  size_t n {};
+  for ( const char ch: s ) if ( 0x0a == ch ) ++n;
+  return n;
+}
+
+// accept one connection, write the capture in uneven pieces so lines straddle reads, then close
+void Serve( boost::asio::ip::tcp::acceptor& acceptor, const std::string& sCapture ) {
+  boost::asio::ip::tcp::socket socket( acceptor.get_executor() );
+  acceptor.accept( socket );
+  std::mt19937 rng( 7 );
+  size_t ix {};
+  while ( ix < sCapture.size() ) {
+    const size_t n = std::min<size_t>( 512 + rng() % 16384, sCapture.size() - ix );
+    boost::asio::write( socket, boost::asio::buffer( sCapture.data() + ix, n ) );
+    ix += n;
+  }
+  boost::system::error_code ec;
+  socket.shutdown( boost::asio::ip::tcp::socket::shutdown_send, ec );
+}
+
+template<typename owner_t>
+bool Replay( const char* szName, const std::string& sCapture, size_t nLines, size_t nPasses, Tally& tally, std::function<void(const owner_t&)> fInspect = nullptr ) {
+  using clock = std::chrono::steady_clock;
+  double dblBest {};
+  for ( size_t pass = 0; pass < nPasses; ++pass ) {
+    boost::asio::io_context io;
+    boost::asio::ip::tcp::acceptor acceptor( io, boost::asio::ip::tcp::endpoint( boost::asio::ip::address_v4::loopback(), 0 ) );
+    const port_t port = acceptor.local_endpoint().port();
+    owner_t owner( port, nLines );
+    const auto start = clock::now();
+    owner.Connect();
+    std::thread server( [&acceptor, &sCapture](){ Serve( acceptor, sCapture ); } );
+    const bool bOk = owner.Wait();
+    const double dblSeconds = std::chrono::duration<double>( clock::now() - start ).count();
+    server.join();
+    owner.Disconnect();
+    if ( !bOk ) {
+      std::cout << szName << ": received " << owner.Result().cntLines << " of " << nLines << " lines" << std::endl;
+      return false;
+    }
+    tally = owner.Result();
+    if ( fInspect ) fInspect( owner );
+    if ( ( 0 == pass ) || ( dblSeconds < dblBest ) ) dblBest = dblSeconds;
+  }
+  std::cout
+    << szName << ": " << tally.cntLines << " lines, "
+    << 1e9 * dblBest / tally.cntLines << " ns/line, "
+    << tally.cntLines / dblBest / 1e6 << " M lines/s, "
+    << sCapture.size() / dblBest / 1e6 << " MB/s"
+    << std::endl;
+  return true;
+}
+
+// the capture as the line buffers Network hands over: terminators and cr removed
+std::vector<QMessage::linebuffer_t> Split( const std::string& sCapture ) {
+  std::vector<QMessage::linebuffer_t> vLines;
+  QMessage::linebuffer_t line;
+  for ( const char ch: sCapture ) {
+    switch ( ch ) {
+      case 0x0a:
+        vLines.push_back( line );
+        line.clear();
+        break;
+      case 0x0d:
+        break;
+      default:
+        line.push_back( ch );
+    }
+  }
+  return vLines;
+}
+
+// decode without the socket: IQFBaseMessage tokenizing, Double, and the symbol lookup
+template<bool bView>
+void DecodeInMemory( const char* szName, std::vector<QMessage::linebuffer_t>& vLines, size_t nPasses, Decoder<bView>& decoder ) {
+  using clock = std::chrono::steady_clock;
+  double dblBest {};
+  for ( size_t pass = 0; pass < nPasses; ++pass ) {
+    Decoder<bView> pass_decoder;
+    const auto start = clock::now();
+    for ( QMessage::linebuffer_t& line: vLines ) pass_decoder.Decode( line.begin(), line.end() );
+    const double dblSeconds = std::chrono::duration<double>( clock::now() - start ).count();
+    if ( ( 0 == pass ) || ( dblSeconds < dblBest ) ) dblBest = dblSeconds;
+    decoder = std::move( pass_decoder );
+  }
+  std::cout
+    << szName << ": " << decoder.Messages() << " Q messages, " << decoder.Symbols().size() << " symbols, "
+    << 1e9 * dblBest / decoder.Messages() << " ns/msg, "
+    << decoder.Messages() / dblBest / 1e6 << " M msgs/s"
+    << std::endl;
+}
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  std::string sCapture;
+  if ( 1 < argc ) {
+    std::ifstream ifs( argv[ 1 ], std::ios::binary );
+    if ( !ifs ) {
+      std::cerr << "can not open " << argv[ 1 ] << std::endl;
+      return EXIT_FAILURE;
+    }
+    sCapture.assign( std::istreambuf_iterator<char>( ifs ), std::istreambuf_iterator<char>() );
+  }
+  else {
+    sCapture = Synthesize( 1000000 );
+  }
+  const size_t nPasses = ( 2 < argc ) ? std::stoul( argv[ 2 ] ) : 5;
+
+  const size_t nLines = CountLines( sCapture );
+  if ( 0 == nLines ) {
+    std::cerr << "no lines to replay" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << sCapture.size() << " bytes, " << nLines << " lines, best of " << nPasses << std::endl;
+
+  Tally tallyBuffer;
+  Tally tallyView;
+  if ( !Replay<BufferOwner>( "line buffer", sCapture, nLines, nPasses, tallyBuffer ) ) return EXIT_FAILURE;
+  if ( !Replay<ViewOwner>( "line view  ", sCapture, nLines, nPasses, tallyView ) ) return EXIT_FAILURE;
+
+  Tally tallyDecode;
+  Decoder<true> decoderNetwork;
+  if ( !Replay<DecodeOwner>( "iqf decode ", sCapture, nLines, nPasses, tallyDecode,
+    [&decoderNetwork]( const DecodeOwner& owner ){ decoderNetwork = owner.Decoded(); } ) ) return EXIT_FAILURE;
+
+  if ( ( tallyBuffer.cntBytes != tallyView.cntBytes ) || ( tallyBuffer.hash != tallyView.hash ) ) {
+    std::cout << "content mismatch: " << tallyBuffer.cntBytes << " vs " << tallyView.cntBytes << " bytes" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "content matches" << std::endl;
+
+  std::vector<QMessage::linebuffer_t> vLines( Split( sCapture ) );
+  Decoder<false> decoderField;
+  Decoder<true> decoderView;
+  DecodeInMemory( "Field    ", vLines, nPasses, decoderField );
+  DecodeInMemory( "FieldView", vLines, nPasses, decoderView );
+
+  if ( !Same( decoderField, decoderView ) || !Same( decoderView, decoderNetwork ) ) {
+    std::cout << "decode mismatch" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "decode matches" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -60,5 +60,11 @@ void Individual::TreeToString( std::stringstream& ss ) const {
 //  ss << "\n";
 }
 
+void Individual::TreeToKey( Node::key_t& key ) const {
+  key.clear();
+  m_Signals.rnLong->TreeToKey( key );  // each tree's key is self delimiting
+  m_Signals.rnShort->TreeToKey( key );
+}
+
 } // namespace gp
 } // namespace ou
@@ -68,6 +68,7 @@ public:
   const Individual& operator=( const Individual& rhs );
 
   void TreeToString( std::stringstream& ss ) const;
+  void TreeToKey( Node::key_t& key ) const; // both signals, see Node::TreeToKey
 
   bool IsComputed( void ) const { return m_bComputed; };
   void SetComputed( bool bComputed = true ) { m_bComputed = bComputed; };
@@ -12,6 +12,8 @@
  * See the file LICENSE.txt for redistribution information.             *
  ************************************************************************/
 
+#include <typeinfo>
+
 #include "Node.h"
 
 namespace ou { // One Unified
@@ -132,6 +134,27 @@ void Node::TreeToString( std::stringstream& ss ) const {
   }
 }
 
+void Node::AppendKey( key_t& key ) const {
+  const size_t id( typeid( *this ).hash_code() );
+  key.append( reinterpret_cast<const char*>( &id ), sizeof( id ) );
+}
+
+// prefix order, a node's type determines its child count, so the key is unambiguous
+void Node::TreeToKey( key_t& key ) const {
+  AppendKey( key );
+  switch ( m_cntNodes ) {
+  case 0:
+    break;
+  case 1:
+    m_pChildCenter->TreeToKey( key );
+    break;
+  case 2:
+    m_pChildLeft->TreeToKey( key );
+    m_pChildRight->TreeToKey( key );
+    break;
+  }
+}
+
 Node* Node::Replicate( void ) {
   Node* node = CloneBasics();
   if ( 0 != m_pChildLeft ) {
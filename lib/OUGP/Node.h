@@ -17,6 +17,7 @@
 #include <cassert>
 #include <sstream>
 #include <vector>
+#include <string>
 #include <stdexcept>
 
 #include <boost/shared_ptr.hpp>
@@ -36,6 +37,9 @@ namespace FactoryType {
   enum E { All = 0, Terminals, Nodes, Count };
 }
 
+class Program;
+class Columns;
+
 class Node {
 public:
 
@@ -59,9 +63,17 @@ public:
   void TreeToString( std::stringstream& ) const;
   virtual void ToString( std::stringstream& ) const {};
 
+  // binary equivalent of TreeToString, identifies a tree's structure for fitness caching
+  using key_t = std::string;
+  void TreeToKey( key_t& ) const;
+  virtual void AppendKey( key_t& ) const; // node type, plus any value held by the node
+
   virtual bool EvaluateBoolean( void ) { throw std::logic_error( "EvaluateBoolean no override" ); };
   virtual double EvaluateDouble( void ) { throw std::logic_error( "EvaluateDouble no override" ); };
 
+  // append this node's instruction, children have already been emitted (see Program::Compile)
+  virtual void Emit( Program&, Columns& ) const { throw std::logic_error( "Emit no override" ); };
+
   Node& Parent( void ) { assert( 0 != m_pParent ); return *m_pParent; };
 
   // maybe use union here or change names to suit
@@ -73,6 +85,10 @@ public:
   Node& ChildCenter( void ) { assert( 0 != m_pChildCenter ); return *m_pChildCenter; };
   Node& ChildRight( void ) { assert( 0 != m_pChildRight ); return *m_pChildRight; };
 
+  const Node& ChildLeft( void ) const { assert( 0 != m_pChildLeft ); return *m_pChildLeft; };
+  const Node& ChildCenter( void ) const { assert( 0 != m_pChildCenter ); return *m_pChildCenter; };
+  const Node& ChildRight( void ) const { assert( 0 != m_pChildRight ); return *m_pChildRight; };
+
   Node* Replicate( void );  // makes a copy of this node, plus recursed copies of children
 
   virtual void PreProcess( void ) {}; // used with Genetic Programming Module for initializating time series
@@ -17,6 +17,7 @@
 #include <boost/fusion/container/vector.hpp>
 
 #include "Node.h"
+#include "Program.h"
 
 namespace ou { // One Unified
 namespace gp { // genetic programming
@@ -26,6 +27,7 @@ public:
   NodeBooleanFalse( void );
   ~NodeBooleanFalse( void );
   void ToString( std::stringstream& ss ) const { ss << "false"; };
+  void Emit( Program& program, Columns& ) const { program.Emit( Program::Op::False ); };
   bool EvaluateBoolean( void ) { return false; };
 protected:
 private:
@@ -36,6 +38,7 @@ public:
   NodeBooleanTrue( void );
   ~NodeBooleanTrue( void );
   void ToString( std::stringstream& ss ) const { ss << "true"; };
+  void Emit( Program& program, Columns& ) const { program.Emit( Program::Op::True ); };
   bool EvaluateBoolean( void ) { return true; };
 protected:
 private:
@@ -46,6 +49,7 @@ public:
   NodeBooleanNot( void );
   ~NodeBooleanNot( void );
   void ToString( std::stringstream& ss ) const { ss << "!"; };
+  void Emit( Program& program, Columns& ) const { program.Emit( Program::Op::Not ); };
   bool EvaluateBoolean( void );
 protected:
 private:
@@ -56,6 +60,7 @@ public:
   NodeBooleanAnd( void );
   ~NodeBooleanAnd( void );
   void ToString( std::stringstream& ss ) const { ss << "&&"; };
+  void Emit( Program& program, Columns& ) const { program.Emit( Program::Op::And ); };
   bool EvaluateBoolean( void );
 protected:
 private:
@@ -66,6 +71,7 @@ public:
   NodeBooleanOr( void );
   ~NodeBooleanOr( void );
   void ToString( std::stringstream& ss ) const { ss << "||"; };
+  void Emit( Program& program, Columns& ) const { program.Emit( Program::Op::Or ); };
   bool EvaluateBoolean( void );
 protected:
 private:
@@ -35,6 +35,7 @@ public:
   NodeCompareGT( void );
   ~NodeCompareGT( void );
   void ToString( std::stringstream& ss ) const { ss << ">"; };
+  void Emit( Program& program, Columns& ) const { program.Emit( Program::Op::GT ); };
   bool EvaluateBoolean( void );
 protected:
 private:
@@ -45,6 +46,7 @@ public:
   NodeCompareGE( void );
   ~NodeCompareGE( void );
   void ToString( std::stringstream& ss ) const { ss << ">="; };
+  void Emit( Program& program, Columns& ) const { program.Emit( Program::Op::GE ); };
   bool EvaluateBoolean( void );
 protected:
 private:
@@ -55,6 +57,7 @@ public:
   NodeCompareLT( void );
   ~NodeCompareLT( void );
   void ToString( std::stringstream& ss ) const { ss << "<"; };
+  void Emit( Program& program, Columns& ) const { program.Emit( Program::Op::LT ); };
   bool EvaluateBoolean( void );
 protected:
 private:
@@ -65,6 +68,7 @@ public:
   NodeCompareLE( void );
   ~NodeCompareLE( void );
   void ToString( std::stringstream& ss ) const { ss << "<="; };
+  void Emit( Program& program, Columns& ) const { program.Emit( Program::Op::LE ); };
   bool EvaluateBoolean( void );
 protected:
 private:
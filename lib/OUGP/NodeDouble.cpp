@@ -69,6 +69,11 @@ double NodeDoubleRandom::EvaluateDouble( void ) {
   return m_val;
 }
 
+void NodeDoubleRandom::AppendKey( key_t& key ) const {
+  Node::AppendKey( key );
+  key.append( reinterpret_cast<const char*>( &m_val ), sizeof( m_val ) );
+}
+
 // ********* NodeDoubleAbs *********
 
 NodeDoubleAbs::NodeDoubleAbs( void ) : NodeDouble<NodeDoubleAbs>() {
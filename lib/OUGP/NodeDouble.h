@@ -17,6 +17,7 @@
 #include <boost/fusion/container/vector.hpp>
 
 #include "Node.h"
+#include "Program.h"
 
 namespace ou { // One Unified
 namespace gp { // genetic programming
@@ -29,6 +30,7 @@ public:
   NodeDoubleZero( void );
   ~NodeDoubleZero( void );
   void ToString( std::stringstream& ss ) const { ss << "0.0"; };
+  void Emit( Program& program, Columns& ) const { program.EmitConstant( 0.0 ); };
   double EvaluateDouble( void );
 protected:
 private:
@@ -41,6 +43,8 @@ public:
   NodeDoubleRandom& operator=( const NodeDoubleRandom& rhs );
   ~NodeDoubleRandom( void );
   void ToString( std::stringstream& ss ) const { ss << m_val; };
+  void AppendKey( key_t& key ) const;
+  void Emit( Program& program, Columns& ) const { program.EmitConstant( m_val ); };
   double EvaluateDouble( void );
 protected:
 private:
@@ -54,6 +58,7 @@ public:
   NodeDoubleAbs& operator=( const NodeDoubleAbs& rhs );
   ~NodeDoubleAbs( void );
   void ToString( std::stringstream& ss ) const { ss << "abs"; };
+  void Emit( Program& program, Columns& ) const { program.Emit( Program::Op::Abs ); };
   double EvaluateDouble( void );
 protected:
 private:
@@ -64,6 +69,7 @@ public:
   NodeDoubleAdd( void );
   ~NodeDoubleAdd( void );
   void ToString( std::stringstream& ss ) const { ss << "+"; };
+  void Emit( Program& program, Columns& ) const { program.Emit( Program::Op::Add ); };
   double EvaluateDouble( void );
 protected:
 private:
@@ -74,6 +80,7 @@ public:
   NodeDoubleSub( void );
   ~NodeDoubleSub( void );
   void ToString( std::stringstream& ss ) const { ss << "-"; };
+  void Emit( Program& program, Columns& ) const { program.Emit( Program::Op::Sub ); };
   double EvaluateDouble( void );
 protected:
 private:
@@ -84,6 +91,7 @@ public:
   NodeDoubleMlt( void );
   ~NodeDoubleMlt( void );
   void ToString( std::stringstream& ss ) const { ss << "*"; };
+  void Emit( Program& program, Columns& ) const { program.Emit( Program::Op::Mlt ); };
   double EvaluateDouble( void );
 protected:
 private:
@@ -94,6 +102,7 @@ public:
   NodeDoubleDvd( void );
   ~NodeDoubleDvd( void );
   void ToString( std::stringstream& ss ) const { ss << "/"; };
+  void Emit( Program& program, Columns& ) const { program.Emit( Program::Op::Dvd ); };
   double EvaluateDouble( void );
 protected:
 private:
@@ -15,6 +15,10 @@
 #include <vector>
 #include <algorithm>
 #include <ctime>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <exception>
 
 #include <boost/phoenix/core.hpp>
 #include <boost/phoenix/operator.hpp>
@@ -41,7 +45,8 @@ Population::Population( unsigned int nPopulationSize )
   m_nElites( 0 ), m_nReproductions( 0 ), m_nCrossOvers( 0 ), m_nNew( 0 ),
   m_rng( std::time( 0 ) ),  // possible issue after jan 18, 2038?
   m_urd( 0.0, 1.0 ),  // probability in [0.0, 1.0)
-  m_cntAboveAverage( 0 )
+  m_cntAboveAverage( 0 ),
+  m_nEvaluated( 0 ), m_nCacheHits( 0 )
 {
 //  assert( 0 == ( nPopulationSize % 2 ) ); // ensure even number of population elements
 }
@@ -159,6 +164,7 @@ bool Population::MakeNewGeneration( void ) {
   if (  2 > cntMaxElites ) cntMaxElites = 2;
 
   if ( 0 == m_vGenerations.size() ) {
+    m_tpStart = std::chrono::steady_clock::now();
     bMore = true;
     m_pvCurGeneration = new vGeneration_t;
     m_pvCurGeneration->resize( m_nPopulationSize );
@@ -301,6 +307,106 @@ bool Population::MakeNewGeneration( void ) {
   return bMore;
 }
 
+void Population::EvaluateFitness( fFitness_t&& fFitness, unsigned int nThreads, fPrepare_t&& fPrepare ) {
+
+  assert( 0 != m_pvCurGeneration );
+  vGeneration_t& gen( *m_pvCurGeneration );
+
+  // distinct trees not yet cached, identical individuals share one evaluation
+  using vIndividual_t = std::vector<Individual*>;
+  struct Pending {
+    Node::key_t key;
+    vIndividual_t vIndividual;
+  };
+  std::vector<Pending> vPending;
+  std::unordered_map<Node::key_t, size_t> mapPending;
+
+  Node::key_t key;
+  for ( Individual& individual: gen ) {
+    individual.TreeToKey( key );
+    mapFitness_t::const_iterator iterCache = m_mapFitness.find( key );
+    if ( m_mapFitness.end() != iterCache ) {
+      individual.m_dblRawFitness = iterCache->second;
+      individual.SetComputed();
+      m_nCacheHits++;
+    }
+    else {
+      std::unordered_map<Node::key_t, size_t>::iterator iterPending = mapPending.find( key );
+      if ( mapPending.end() == iterPending ) {
+        mapPending.emplace( key, vPending.size() );
+        vPending.emplace_back( Pending{ key, vIndividual_t( 1, &individual ) } );
+      }
+      else {
+        vPending[ iterPending->second ].vIndividual.push_back( &individual );
+        m_nCacheHits++;
+      }
+    }
+  }
+
+  if ( vPending.empty() ) return;
+
+  if ( fPrepare ) {
+    for ( Pending& pending: vPending ) fPrepare( *pending.vIndividual.front() );
+  }
+
+  if ( 0 == nThreads ) nThreads = std::max<unsigned int>( 1, std::thread::hardware_concurrency() );
+  nThreads = std::min<unsigned int>( nThreads, vPending.size() );
+
+  // workers take the next tree as they finish one, so long and short backtests balance out
+  std::vector<double> vFitness( vPending.size() );
+  std::atomic<size_t> ixNext( 0 );
+  std::mutex mutexException;
+  std::exception_ptr pException;
+
+  auto worker =
+    [&]( uint32_t seed ){
+      boost::random::mt19937 rng( seed );
+      for ( size_t ix = ixNext++; ix < vPending.size(); ix = ixNext++ ) {
+        try {
+          vFitness[ ix ] = fFitness( *vPending[ ix ].vIndividual.front(), rng );
+        }
+        catch (...) {
+          std::scoped_lock<std::mutex> lock( mutexException );
+          if ( !pException ) pException = std::current_exception();
+          ixNext = vPending.size(); // abandon remaining work
+        }
+      }
+    };
+
+  std::vector<std::thread> vThread;
+  vThread.reserve( nThreads );
+  for ( unsigned int ix = 0; ix < nThreads; ix++ ) {
+    vThread.emplace_back( worker, m_rng() ); // seeds drawn serially from the population's generator
+  }
+  for ( std::thread& thread: vThread ) thread.join();
+
+  if ( pException ) std::rethrow_exception( pException );
+
+  for ( size_t ix = 0; ix < vPending.size(); ix++ ) {
+    Pending& pending( vPending[ ix ] );
+    for ( Individual* pIndividual: pending.vIndividual ) {
+      pIndividual->m_dblRawFitness = vFitness[ ix ];
+      pIndividual->SetComputed();
+    }
+    m_mapFitness.emplace( std::move( pending.key ), vFitness[ ix ] );
+  }
+  m_nEvaluated += vPending.size();
+}
+
+Population::FitnessStats Population::GetFitnessStats( void ) const {
+  FitnessStats stats;
+  stats.nGenerations = m_vGenerations.size();
+  stats.nEvaluated = m_nEvaluated;
+  stats.nCacheHits = m_nCacheHits;
+  const double dblSeconds( ( 0 == stats.nGenerations )
+    ? 0.0
+    : std::chrono::duration<double>( std::chrono::steady_clock::now() - m_tpStart ).count() );
+  stats.dblGenerationsPerSecond = ( 0.0 < dblSeconds ) ? ( (double)stats.nGenerations / dblSeconds ) : 0.0;
+  const size_t nTotal( m_nEvaluated + m_nCacheHits );
+  stats.dblCacheHitRatio = ( 0 == nTotal ) ? 0.0 : ( (double)m_nCacheHits / (double)nTotal );
+  return stats;
+}
+
 bool Population::CrossOver( pRootNode_t& rn1, pRootNode_t& rn2 ) {
 
   bool bSuccessful = true;
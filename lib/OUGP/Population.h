@@ -16,6 +16,10 @@
 
 #include <vector>
 #include <array>
+#include <chrono>
+#include <string>
+#include <functional>
+#include <unordered_map>
 
 #include <boost/random.hpp>
 #include <boost/random/uniform_real_distribution.hpp>
@@ -50,6 +54,25 @@ public:
   bool MakeNewGeneration( void );
   void CalcFitness( void );
 
+  // raw fitness of the current generation, computed in parallel, cached by tree structure across generations
+  //   fFitness: called concurrently, once per distinct uncached tree, returns the raw fitness,
+  //     the generator is private to the calling thread
+  //   fPrepare: optional, called serially for each of those trees beforehand (eg Program::Compile into shared Columns)
+  //   nThreads: 0 for std::thread::hardware_concurrency
+  // follow with CalcFitness
+  using fFitness_t = std::function<double(Individual&, boost::random::mt19937&)>;
+  using fPrepare_t = std::function<void(Individual&)>;
+  void EvaluateFitness( fFitness_t&& fFitness, unsigned int nThreads = 0, fPrepare_t&& fPrepare = nullptr );
+
+  struct FitnessStats {
+    size_t nGenerations;
+    size_t nEvaluated;  // fFitness calls
+    size_t nCacheHits;  // individuals whose fitness came from the cache, or from an identical individual
+    double dblGenerationsPerSecond; // since the first generation
+    double dblCacheHitRatio; // hits / ( hits + evaluated )
+  };
+  FitnessStats GetFitnessStats( void ) const;
+
 protected:
 private:
 
@@ -89,6 +112,13 @@ private:
   boost::random::mt19937 m_rng;
   boost::random::uniform_real_distribution<double> m_urd;
 
+  using mapFitness_t = std::unordered_map<Node::key_t, double>; // Individual::TreeToKey -> raw fitness
+  mapFitness_t m_mapFitness;
+
+  size_t m_nEvaluated;
+  size_t m_nCacheHits;
+  std::chrono::steady_clock::time_point m_tpStart;
+
   TreeBuilder m_tb;
 
   void BuildIndividuals( vGeneration_t& vGeneration );
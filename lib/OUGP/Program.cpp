@@ -0,0 +1,274 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Program.cpp
+ * Author:  raymond@burkholder.net
+ * Project: OUGP
+ * Created: October 17, 2026 15:10
+ */
+
+#include <math.h>
+#include <cmath>
+#include <limits>
+#include <cassert>
+#include <stdexcept>
+#include <algorithm>
+
+#include "Node.h"
+#include "RootNode.h"
+
+#include "Program.h"
+
+namespace ou { // One Unified
+namespace gp { // genetic programming
+
+// ********* Columns *********
+
+Columns::Columns( size_t nBars ): m_nBars( nBars ) {
+}
+
+Columns::~Columns( void ) {
+}
+
+size_t Columns::Column( const key_t& key, fBuild_t&& fBuild ) {
+  mapKey_t::iterator iter = m_mapKey.find( key );
+  if ( m_mapKey.end() == iter ) {
+    const size_t ixColumn( m_vColumn.size() );
+    m_vColumn.emplace_back( column_t( m_nBars, std::numeric_limits<double>::quiet_NaN() ) );
+    fBuild( m_vColumn.back() );
+    assert( m_nBars == m_vColumn.back().size() );
+    iter = m_mapKey.emplace( key, ixColumn ).first;
+  }
+  return iter->second;
+}
+
+void Columns::Clear( void ) {
+  m_mapKey.clear();
+  m_vColumn.clear();
+}
+
+// ********* Program *********
+
+namespace {
+  const char* rszOp[] = {
+    "false", "true", "const", "col",
+    "!", "&&", "||",
+    "abs", "+", "-", "*", "/",
+    ">", ">=", "<", "<="
+  };
+}
+
+Program::Program( void ): m_nDepth( 0 ), m_nMaxDepth( 0 ) {
+}
+
+Program::~Program( void ) {
+}
+
+void Program::Clear( void ) {
+  m_vInstruction.clear();
+  m_nDepth = m_nMaxDepth = 0;
+}
+
+void Program::Compile( const RootNode& root, Columns& columns ) {
+  Clear();
+  Compile( static_cast<const Node&>( root ), columns );
+  assert( 1 == m_nDepth );
+}
+
+// postfix: children, then the node itself
+void Program::Compile( const Node& node, Columns& columns ) {
+  switch ( node.NodeCount() ) {
+  case 0:
+    break;
+  case 1:
+    Compile( node.ChildCenter(), columns );
+    break;
+  case 2:
+    Compile( node.ChildLeft(), columns );
+    Compile( node.ChildRight(), columns );
+    break;
+  }
+  node.Emit( *this, columns );
+}
+
+void Program::Push( Instruction& instruction, size_t nArgs ) {
+  if ( nArgs > m_nDepth ) {
+    throw std::logic_error( "Program::Push stack underflow" );
+  }
+  m_nDepth -= nArgs;
+  instruction.dst = m_nDepth;
+  instruction.a = ( 0 < nArgs ) ? m_nDepth : 0;
+  instruction.b = ( 1 < nArgs ) ? m_nDepth + 1 : 0;
+  m_nDepth++;
+  m_nMaxDepth = std::max( m_nMaxDepth, m_nDepth );
+  m_vInstruction.push_back( instruction );
+}
+
+void Program::Emit( Op op ) {
+  Instruction instruction {};
+  instruction.op = op;
+  switch ( op ) {
+  case Op::False:
+  case Op::True:
+    Push( instruction, 0 );
+    break;
+  case Op::Not:
+  case Op::Abs:
+    Push( instruction, 1 );
+    break;
+  case Op::Constant:
+  case Op::Column:
+    throw std::logic_error( "Program::Emit use EmitConstant or EmitColumn" );
+  default:
+    Push( instruction, 2 );
+    break;
+  }
+}
+
+void Program::EmitConstant( double value ) {
+  Instruction instruction {};
+  instruction.op = Op::Constant;
+  instruction.value = value;
+  Push( instruction, 0 );
+}
+
+void Program::EmitColumn( size_t ixColumn ) {
+  Instruction instruction {};
+  instruction.op = Op::Column;
+  instruction.ixColumn = ixColumn;
+  Push( instruction, 0 );
+}
+
+// f( ixFirst, n, pResult ) receives each block's result
+template<typename F>
+void Program::Evaluate( const Columns& columns, F f ) const {
+
+  if ( m_vInstruction.empty() ) {
+    throw std::logic_error( "Program::Evaluate not compiled" );
+  }
+
+  std::vector<double> vRegister( m_nMaxDepth * nBlock );
+  std::vector<const double*> vpRegister( m_nMaxDepth ); // a register may alias a column
+
+  const size_t nBars( columns.Size() );
+  for ( size_t ixFirst = 0; ixFirst < nBars; ixFirst += nBlock ) {
+    const size_t n( std::min( nBlock, nBars - ixFirst ) );
+    for ( const Instruction& instruction: m_vInstruction ) {
+      double* dst( &vRegister[ instruction.dst * nBlock ] );
+      const double* a( vpRegister[ instruction.a ] );
+      const double* b( vpRegister[ instruction.b ] );
+      switch ( instruction.op ) {
+      case Op::False:
+        std::fill( dst, dst + n, 0.0 );
+        break;
+      case Op::True:
+        std::fill( dst, dst + n, 1.0 );
+        break;
+      case Op::Constant:
+        std::fill( dst, dst + n, instruction.value );
+        break;
+      case Op::Column:
+        vpRegister[ instruction.dst ] = columns.Data( instruction.ixColumn ) + ixFirst;
+        continue; // no copy
+      case Op::Not:
+        for ( size_t ix = 0; ix < n; ix++ ) dst[ ix ] = ( 0.0 == a[ ix ] ) ? 1.0 : 0.0;
+        break;
+      case Op::And:
+        for ( size_t ix = 0; ix < n; ix++ ) dst[ ix ] = ( ( 0.0 != a[ ix ] ) & ( 0.0 != b[ ix ] ) ) ? 1.0 : 0.0;
+        break;
+      case Op::Or:
+        for ( size_t ix = 0; ix < n; ix++ ) dst[ ix ] = ( ( 0.0 != a[ ix ] ) | ( 0.0 != b[ ix ] ) ) ? 1.0 : 0.0;
+        break;
+      case Op::Abs:
+        for ( size_t ix = 0; ix < n; ix++ ) dst[ ix ] = std::abs( a[ ix ] );
+        break;
+      case Op::Add:
+        for ( size_t ix = 0; ix < n; ix++ ) dst[ ix ] = a[ ix ] + b[ ix ];
+        break;
+      case Op::Sub:
+        for ( size_t ix = 0; ix < n; ix++ ) dst[ ix ] = a[ ix ] - b[ ix ];
+        break;
+      case Op::Mlt:
+        for ( size_t ix = 0; ix < n; ix++ ) dst[ ix ] = a[ ix ] * b[ ix ];
+        break;
+      case Op::Dvd: // as NodeDoubleDvd
+        for ( size_t ix = 0; ix < n; ix++ ) dst[ ix ] = ( 0.0 == b[ ix ] ) ? HUGE_VAL : a[ ix ] / b[ ix ];
+        break;
+      case Op::GT:
+        for ( size_t ix = 0; ix < n; ix++ ) dst[ ix ] = ( a[ ix ] > b[ ix ] ) ? 1.0 : 0.0;
+        break;
+      case Op::GE:
+        for ( size_t ix = 0; ix < n; ix++ ) dst[ ix ] = ( a[ ix ] >= b[ ix ] ) ? 1.0 : 0.0;
+        break;
+      case Op::LT:
+        for ( size_t ix = 0; ix < n; ix++ ) dst[ ix ] = ( a[ ix ] < b[ ix ] ) ? 1.0 : 0.0;
+        break;
+      case Op::LE:
+        for ( size_t ix = 0; ix < n; ix++ ) dst[ ix ] = ( a[ ix ] <= b[ ix ] ) ? 1.0 : 0.0;
+        break;
+      }
+      vpRegister[ instruction.dst ] = dst;
+    }
+    f( ixFirst, n, vpRegister[ 0 ] );
+  }
+}
+
+void Program::Evaluate( const Columns& columns, std::vector<double>& vResult ) const {
+  vResult.resize( columns.Size() );
+  Evaluate(
+    columns,
+    [&vResult]( size_t ixFirst, size_t n, const double* pResult ){
+      std::copy( pResult, pResult + n, vResult.begin() + ixFirst );
+    } );
+}
+
+void Program::Evaluate( const Columns& columns, std::vector<uint8_t>& vSignal ) const {
+  vSignal.resize( columns.Size() );
+  Evaluate(
+    columns,
+    [&vSignal]( size_t ixFirst, size_t n, const double* pResult ){
+      uint8_t* pSignal( &vSignal[ ixFirst ] );
+      for ( size_t ix = 0; ix < n; ix++ ) pSignal[ ix ] = ( 0.0 != pResult[ ix ] ) ? 1 : 0;
+    } );
+}
+
+void Program::ToString( std::stringstream& ss ) const {
+  for ( const Instruction& instruction: m_vInstruction ) {
+    ss << "r" << instruction.dst << " = ";
+    switch ( instruction.op ) {
+    case Op::False:
+    case Op::True:
+      ss << rszOp[ (size_t)instruction.op ];
+      break;
+    case Op::Constant:
+      ss << instruction.value;
+      break;
+    case Op::Column:
+      ss << "col[" << instruction.ixColumn << "]";
+      break;
+    case Op::Not:
+    case Op::Abs:
+      ss << rszOp[ (size_t)instruction.op ] << " r" << instruction.a;
+      break;
+    default:
+      ss << "r" << instruction.a << " " << rszOp[ (size_t)instruction.op ] << " r" << instruction.b;
+      break;
+    }
+    ss << std::endl;
+  }
+}
+
+} // namespace gp
+} // namespace ou
@@ -0,0 +1,142 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Program.h
+ * Author:  raymond@burkholder.net
+ * Project: OUGP
+ * Created: October 17, 2026 15:10
+ */
+
+#pragma once
+
+// compiled form of a Node tree:  a postfix program over a register file
+//   evaluation runs the window in blocks of bars, each instruction is applied across the block
+//   before the next one runs, so an individual costs a few tight loops per node rather than
+//   a virtual call per node per bar
+// terminals are Columns:  computed once, then shared by every program which references them
+
+#include <map>
+#include <vector>
+#include <cstdint>
+#include <sstream>
+#include <functional>
+
+namespace ou { // One Unified
+namespace gp { // genetic programming
+
+class Node;
+class RootNode;
+
+// ==== Columns: terminal values, one double per bar of the window
+
+class Columns {
+public:
+
+  using column_t = std::vector<double>;
+  using fBuild_t = std::function<void(column_t&)>; // fill the column, already sized to Size()
+  using key_t = std::pair<const void*, int>; // source, field
+
+  Columns( size_t nBars );
+  virtual ~Columns( void );
+
+  size_t Size( void ) const { return m_nBars; };
+  size_t Count( void ) const { return m_vColumn.size(); }; // columns built so far
+
+  // index of the column for key, built on first reference (not thread safe, compile on one thread)
+  size_t Column( const key_t& key, fBuild_t&& fBuild );
+
+  const double* Data( size_t ixColumn ) const { return m_vColumn[ ixColumn ].data(); };
+
+  void Clear( void );
+
+protected:
+private:
+
+  const size_t m_nBars;
+
+  using mapKey_t = std::map<key_t, size_t>;
+  mapKey_t m_mapKey;
+
+  using vColumn_t = std::vector<column_t>;
+  vColumn_t m_vColumn;
+
+};
+
+// ==== Program
+
+class Program {
+public:
+
+  enum class Op: uint8_t {
+    False, True, Constant, Column, // terminals
+    Not, And, Or,                  // boolean
+    Abs, Add, Sub, Mlt, Dvd,       // double
+    GT, GE, LT, LE                 // compare
+  };
+
+  using reg_t = uint16_t;
+
+  struct Instruction {
+    Op op;
+    reg_t dst;
+    reg_t a;
+    reg_t b;
+    uint32_t ixColumn;
+    double value;
+  };
+
+  Program( void );
+  ~Program( void );
+
+  size_t Size( void ) const { return m_vInstruction.size(); };
+  size_t Registers( void ) const { return m_nMaxDepth; };
+
+  void Clear( void );
+
+  // lower a tree, columns referenced by terminals are built in columns as required
+  void Compile( const RootNode&, Columns& );
+
+  // used by Node::Emit
+  void Emit( Op );
+  void EmitConstant( double );
+  void EmitColumn( size_t ixColumn );
+
+  // one value per bar, booleans as 0.0/1.0 (and Not/And/Or/compare results are always one or the other)
+  void Evaluate( const Columns&, std::vector<double>& vResult ) const;
+  void Evaluate( const Columns&, std::vector<uint8_t>& vSignal ) const;
+
+  void ToString( std::stringstream& ) const; // disassembly
+
+protected:
+private:
+
+  static constexpr size_t nBlock = 512; // bars per pass, keeps the register file in cache
+
+  using vInstruction_t = std::vector<Instruction>;
+  vInstruction_t m_vInstruction;
+
+  size_t m_nDepth;    // stack depth while emitting, the stack slot is the register
+  size_t m_nMaxDepth;
+
+  void Compile( const Node&, Columns& );
+  void Push( Instruction&, size_t nArgs );
+
+  template<typename F>
+  void Evaluate( const Columns&, F f ) const;
+
+};
+
+} // namespace gp
+} // namespace ou
@@ -20,6 +20,7 @@
 #include <boost/random.hpp>
 
 #include "Node.h"
+#include "Program.h"
 
 namespace ou { // One Unified
 namespace gp { // genetic programming
@@ -36,6 +37,7 @@ public:
   const RootNode& operator=( const RootNode& rhs );
 
   void ToString( std::stringstream& ss ) const { ss << "root="; };
+  void Emit( Program&, Columns& ) const {}; // the child's result is the result
   bool EvaluateBoolean( void );
 
   bool HasBooleanCandidates( void ) { return ( 0 != m_vBooleanCandidates.size() ); };  // should always be true
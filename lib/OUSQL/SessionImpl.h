@@ -45,6 +45,7 @@
 #include <string>
 #include <vector>
 #include <typeinfo>
+#include <typeindex>
 #include <stdexcept>
 
 #include <boost/noncopyable.hpp>
@@ -52,6 +53,7 @@
 
 #include "Constants.h"
 #include "Actions.h"
+#include "WriteBehind.h"
 
 namespace ou {
 namespace db {
@@ -258,6 +260,9 @@ private:
 //
 // SessionImpl
 
+template<class F>
+struct KeyInsert {}; // statement cache key for the composed insert of F
+
 template<class IDatabase> // IDatabase is a the specific handler type:  sqlite3 or pg or ...
 class SessionImpl: boost::noncopyable {
 public:
@@ -265,6 +270,7 @@ public:
   using session_t = SessionImpl<IDatabase>;
   using pSession_t = std::shared_ptr<session_t>;
   using pQueryBase_t = QueryBase::pQueryBase_t;
+  using WriteBehindStats_t = typename WriteBehind<IDatabase>::Stats;
 
   SessionImpl();
   virtual ~SessionImpl();
@@ -401,6 +407,45 @@ public:
     m_db.CloseStatement( statement );
   }
 
+  // cached statements:  prepared on first use for key type K (typically F itself), then reset and
+  //   re-bound on each use.  sSqlQuery is only consulted on first use, so is to be the same each time.
+  //   With write-behind enabled, a copy of f is queued rather than executed, F needs to be copyable
+  template<class K, class F>
+  void Write( const std::string& sSqlQuery, F& f ) {
+    const std::type_index key( typeid( K ) );
+    mapStatementText_t::iterator iter = m_mapStatementText.find( key );
+    if ( m_mapStatementText.end() == iter ) {
+      iter = m_mapStatementText.emplace( key, sSqlQuery ).first;
+    }
+    WriteCached( key, iter->second, f );
+  }
+
+  template<class F>
+  void WriteInsert( F& f ) {
+    const std::type_index key( typeid( KeyInsert<F> ) );
+    mapStatementText_t::iterator iter = m_mapStatementText.find( key );
+    if ( m_mapStatementText.end() == iter ) {
+      typename IDatabase::Action_Compose_Insert action( GetTableName<F>() );
+      f.Fields( action );
+      std::string sSqlQuery;
+      action.ComposeStatement( sSqlQuery );
+      iter = m_mapStatementText.emplace( key, sSqlQuery ).first;
+    }
+    WriteCached( key, iter->second, f );
+  }
+
+  // write-behind:  Write and WriteInsert are queued, then committed in groups by a background thread
+  //   on a second connection, with the database switched to WAL.  Other statements remain synchronous.
+  //   Writes become visible to this connection as they are committed, Flush() to wait for them.
+  //   A failed background write is logged, then thrown as std::runtime_error from the next Flush() or Sync().
+  void EnableWriteBehind( size_t nCapacity = 4096, size_t nGroup = 256 );
+  bool IsWriteBehind() const { return nullptr != m_pWriteBehind.get(); }
+  void Flush() { if ( m_pWriteBehind ) m_pWriteBehind->Flush(); } // queued writes are committed
+  void Sync() { if ( m_pWriteBehind ) m_pWriteBehind->Sync(); }  // ... and durable
+  WriteBehindStats_t GetWriteBehindStats() const {
+    return m_pWriteBehind ? m_pWriteBehind->GetStats() : WriteBehindStats_t {};
+  }
+
   template<class F>
   void MapRowDefToTableName( const std::string& sTableName ) {
     std::string sF( typeid( F ).name() );
@@ -447,8 +492,29 @@ protected:
 private:
 
   bool m_bOpened;
+  std::string m_sFileName;
 
   IDatabase m_db;
+  StatementCache<IDatabase> m_cache; // for m_db
+
+  std::unique_ptr<WriteBehind<IDatabase> > m_pWriteBehind;
+
+  using mapStatementText_t = std::map<std::type_index, std::string>; // node based, queued writes refer to the text
+  mapStatementText_t m_mapStatementText;
+
+  template<class F>
+  void WriteCached( const std::type_index& key, const std::string& sSqlQuery, F& f ) {
+    if ( m_pWriteBehind ) {
+      const std::string* pSqlQuery( &sSqlQuery );
+      m_pWriteBehind->Write(
+        [key,pSqlQuery,f]( StatementCache<IDatabase>& cache ) mutable {
+          cache.Execute( key, *pSqlQuery, f );
+        } );
+    }
+    else {
+      m_cache.Execute( key, sSqlQuery, f );
+    }
+  }
 
   typedef std::map<std::string, pQueryBase_t> mapTableDefs_t;  // map table name to table definition
   typedef typename mapTableDefs_t::iterator mapTableDefs_iter_t;
@@ -464,7 +530,7 @@ private:
 
 // Constructor
 template<class IDatabase>
-SessionImpl<IDatabase>::SessionImpl(): m_bOpened( false ) {
+SessionImpl<IDatabase>::SessionImpl(): m_bOpened( false ), m_cache( m_db ) {
 }
 
 // Destructor
@@ -482,6 +548,7 @@ void SessionImpl<IDatabase>::ImplOpen( const std::string& sDbFileName, enumOpenF
   }
   else {
     m_db.SessionOpen( sDbFileName, flags );
+    m_sFileName = sDbFileName;
     m_bOpened = true;
   }
 }
@@ -491,12 +558,27 @@ template<class IDatabase>
 void SessionImpl<IDatabase>::ImplClose() {
   if ( m_bOpened ) {
     m_bOpened = false;
+    m_pWriteBehind.reset(); // flushes and syncs
+    m_cache.Clear();
     m_db.SessionClose();
     // 2013/08/26 process memory doesn't appear to be relaimed after this
     //   trying again with addition of reset();
   }
 }
 
+// EnableWriteBehind
+template<class IDatabase>
+void SessionImpl<IDatabase>::EnableWriteBehind( size_t nCapacity, size_t nGroup ) {
+  if ( !m_bOpened ) {
+    throw std::runtime_error( "EnableWriteBehind: session not opened" );
+  }
+  if ( !m_pWriteBehind ) {
+    m_db.WriteAheadLog();
+    m_db.SetBusyTimeout( WriteBehind<IDatabase>::nBusyTimeout ); // the background thread may hold the write lock
+    m_pWriteBehind = std::make_unique<WriteBehind<IDatabase> >( m_sFileName, nCapacity, nGroup );
+  }
+}
+
 // CreateTables
 template<class IDatabase>
 void SessionImpl<IDatabase>::CreateTables() {
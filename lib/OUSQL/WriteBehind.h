@@ -0,0 +1,361 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    WriteBehind.h
+ * Author:  raymond@burkholder.net
+ * Project: OUSQL
+ * Created: October 17, 2026 16:20
+ */
+
+#pragma once
+
+// StatementCache:  statements prepared once, then reset and re-bound on each use
+// WriteBehind:  writes are queued by the caller, and committed in grouped transactions
+//   by a background thread on its own connection, so the caller does not wait on the disk.
+//   Flush() waits for what has been queued to be committed, Sync() additionally makes it durable.
+//   Failures are logged as they happen, and thrown from the next Flush() or Sync()
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <stdexcept>
+#include <typeindex>
+#include <functional>
+#include <condition_variable>
+
+#include <boost/noncopyable.hpp>
+#include <boost/log/trivial.hpp>
+
+#include <OUCommon/BoundedQueue.h>
+
+#include "Constants.h"
+
+namespace ou {
+namespace db {
+
+// ==== StatementCache
+
+template<class IDatabase>
+class StatementCache: boost::noncopyable {
+public:
+
+  using structStatementState = typename IDatabase::structStatementState;
+
+  StatementCache( IDatabase& db ): m_db( db ) {}
+  ~StatementCache() { Clear(); }
+
+  // sSqlQuery is only consulted when key is first seen, true when a row is available
+  template<class F>
+  bool Execute( const std::type_index& key, const std::string& sSqlQuery, F& f ) {
+    typename mapStatement_t::iterator iter = m_mapStatement.find( key );
+    if ( m_mapStatement.end() == iter ) {
+      pStatement_t pStatement( new structStatementState );
+      std::string sStatement( sSqlQuery );
+      m_db.PrepareStatement( *pStatement, sStatement );
+      iter = m_mapStatement.emplace( key, std::move( pStatement ) ).first;
+    }
+    else {
+      m_db.ResetStatement( *iter->second );
+    }
+    typename IDatabase::Action_Bind_Values action( *iter->second );
+    f.Fields( action );
+    try {
+      return m_db.ExecuteStatement( *iter->second );
+    }
+    catch ( const std::runtime_error& ) {
+      // reset reports the failed step once, which leaves the statement reusable, and closable
+      try {
+        m_db.ResetStatement( *iter->second );
+      }
+      catch ( const std::runtime_error& ) {}
+      throw;
+    }
+  }
+
+  size_t Size() const { return m_mapStatement.size(); }
+
+  void Clear() { // statements need to be closed before the connection
+    for ( typename mapStatement_t::value_type& vt: m_mapStatement ) {
+      m_db.CloseStatement( *vt.second );
+    }
+    m_mapStatement.clear();
+  }
+
+protected:
+private:
+
+  IDatabase& m_db;
+
+  using pStatement_t = std::unique_ptr<structStatementState>;
+  using mapStatement_t = std::map<std::type_index, pStatement_t>;
+  mapStatement_t m_mapStatement;
+
+};
+
+// ==== WriteBehind
+
+template<class IDatabase>
+class WriteBehind: boost::noncopyable {
+public:
+
+  using cache_t = StatementCache<IDatabase>;
+  using fWrite_t = std::function<void( cache_t& )>; // runs on the background thread, inside a transaction
+
+  struct Stats {
+    size_t nDepth;        // currently queued
+    size_t nQueued;       // accepted from callers
+    size_t nCommitted;    // written and committed, including those which failed
+    size_t nErrors;       // writes or commits which failed, logged with detail
+    size_t nBlocked;      // writes which had to wait for room in the queue
+    size_t nTransactions; // groups committed
+    double dblCommitLatencyLast; // ms, begin through commit of a group
+    double dblCommitLatencyMax;
+    double dblCommitLatencyMean;
+  };
+
+  WriteBehind( const std::string& sDbFileName, size_t nCapacity = 4096, size_t nGroup = 256 )
+  : m_queue( nCapacity ), m_nGroup( nGroup ), m_cache( m_db )
+  , m_bStop( false ), m_nWaiting {}, m_nErrorsPending {}
+  , m_nQueued {}, m_nCommitted {}, m_nErrors {}, m_nBlocked {}, m_nTransactions {}
+  , m_dblLatencyLast {}, m_dblLatencyMax {}, m_dblLatencyTotal {}
+  {
+    m_db.SessionOpen( sDbFileName );
+    m_db.WriteAheadLog();
+    m_db.SetBusyTimeout( nBusyTimeout );
+    m_thread = std::thread( [this](){ Run(); } );
+  }
+
+  ~WriteBehind() {
+    try {
+      Sync();
+    }
+    catch ( const std::runtime_error& ) {} // failures were logged as they happened
+    {
+      std::scoped_lock<std::mutex> lock( m_mutex );
+      m_bStop = true;
+    }
+    m_cvWake.notify_one();
+    m_thread.join();
+    m_cache.Clear();
+    m_db.SessionClose();
+  }
+
+  static const int nBusyTimeout = 5000; // ms, applied to both connections
+
+  // from the caller, blocks only while the queue is full
+  void Write( fWrite_t&& fWrite ) {
+    if ( !m_queue.Push( fWrite ) ) {
+      m_nBlocked.fetch_add( 1, std::memory_order_relaxed );
+      m_nWaiting.fetch_add( 1 ); // seq_cst, pairs with the fence in Room
+      Wake();
+      {
+        std::unique_lock<std::mutex> lock( m_mutexRoom );
+        while ( !m_queue.Push( fWrite ) ) {
+          m_cvRoom.wait( lock );
+        }
+      }
+      m_nWaiting.fetch_sub( 1 );
+    }
+    m_nQueued.fetch_add( 1, std::memory_order_release );
+    Wake();
+  }
+
+  // waits for all writes queued so far to be committed
+  // throws std::runtime_error when a write or commit failed since the previous Flush or Sync
+  void Flush() {
+    WaitCommitted();
+    ThrowPending();
+  }
+
+  // durability barrier:  flush, then checkpoint the log into the database, for use at shutdown
+  // throws as Flush does, the checkpoint is attempted regardless
+  void Sync() {
+    WaitCommitted();
+    {
+      std::scoped_lock<std::mutex> lock( m_mutexDb );
+      try {
+        m_db.Checkpoint();
+      }
+      catch ( const std::runtime_error& e ) {
+        Failed( "Sync", e );
+      }
+    }
+    ThrowPending();
+  }
+
+  Stats GetStats() const {
+    Stats stats;
+    stats.nDepth = m_queue.Size();
+    stats.nQueued = m_nQueued.load( std::memory_order_relaxed );
+    stats.nCommitted = m_nCommitted.load( std::memory_order_relaxed );
+    stats.nErrors = m_nErrors.load( std::memory_order_relaxed );
+    stats.nBlocked = m_nBlocked.load( std::memory_order_relaxed );
+    stats.nTransactions = m_nTransactions.load( std::memory_order_relaxed );
+    stats.dblCommitLatencyLast = m_dblLatencyLast.load( std::memory_order_relaxed );
+    stats.dblCommitLatencyMax = m_dblLatencyMax.load( std::memory_order_relaxed );
+    stats.dblCommitLatencyMean
+      = ( 0 == stats.nTransactions ) ? 0.0 : ( m_dblLatencyTotal.load( std::memory_order_relaxed ) / stats.nTransactions );
+    return stats;
+  }
+
+protected:
+private:
+
+  IDatabase m_db; // second connection, owned by the background thread
+  ou::BoundedQueue<fWrite_t> m_queue;
+  const size_t m_nGroup; // writes per transaction, at most
+  cache_t m_cache;
+
+  std::thread m_thread;
+
+  std::mutex m_mutex; // with m_cvWake, m_cvCommitted
+  std::mutex m_mutexDb; // the background thread's transaction, or a checkpoint
+  std::condition_variable m_cvWake;
+  std::condition_variable m_cvCommitted;
+  bool m_bStop;
+
+  std::atomic<size_t> m_nWaiting; // writes waiting for room in the queue
+  std::mutex m_mutexRoom;
+  std::condition_variable m_cvRoom;
+
+  size_t m_nErrorsPending; // since the last Flush or Sync, with m_mutex
+  std::string m_sErrorFirst;
+
+  std::atomic<size_t> m_nQueued;
+  std::atomic<size_t> m_nCommitted;
+  std::atomic<size_t> m_nErrors;
+  std::atomic<size_t> m_nBlocked;
+  std::atomic<size_t> m_nTransactions;
+
+  std::atomic<double> m_dblLatencyLast;
+  std::atomic<double> m_dblLatencyMax;
+  std::atomic<double> m_dblLatencyTotal; // only written by the background thread
+
+  void WaitCommitted() {
+    const size_t nTarget( m_nQueued.load( std::memory_order_acquire ) );
+    Wake();
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_cvCommitted.wait( lock, [this,nTarget](){ return nTarget <= m_nCommitted.load( std::memory_order_acquire ); } );
+  }
+
+  void ThrowPending() {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    if ( 0 < m_nErrorsPending ) {
+      const std::string sError(
+        "WriteBehind: " + std::to_string( m_nErrorsPending ) + " failed, first: " + m_sErrorFirst );
+      m_nErrorsPending = 0;
+      m_sErrorFirst.clear();
+      lock.unlock();
+      throw std::runtime_error( sError );
+    }
+  }
+
+  void Failed( const char* szWhere, const std::runtime_error& e ) {
+    m_nErrors.fetch_add( 1, std::memory_order_relaxed );
+    BOOST_LOG_TRIVIAL(error) << "WriteBehind::" << szWhere << ": " << e.what();
+    std::scoped_lock<std::mutex> lock( m_mutex );
+    if ( 0 == m_nErrorsPending ) {
+      m_sErrorFirst = std::string( szWhere ) + ": " + e.what();
+    }
+    m_nErrorsPending++;
+  }
+
+  void Wake() {
+    { std::scoped_lock<std::mutex> lock( m_mutex ); } // pairs with the predicate check in Run
+    m_cvWake.notify_one();
+  }
+
+  void Room() { // after a Pop, releases writes waiting on a full queue
+    std::atomic_thread_fence( std::memory_order_seq_cst ); // pop visible before m_nWaiting is read
+    if ( 0 < m_nWaiting.load() ) {
+      std::scoped_lock<std::mutex> lock( m_mutexRoom );
+      m_cvRoom.notify_all();
+    }
+  }
+
+  void Run() {
+
+    fWrite_t fWrite;
+
+    for ( ;; ) {
+
+      {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        m_cvWake.wait( lock, [this](){ return m_bStop || !m_queue.Empty(); } );
+        if ( m_bStop && m_queue.Empty() ) break;
+      }
+
+      size_t nWrites {};
+      {
+        std::scoped_lock<std::mutex> lock( m_mutexDb );
+        const std::chrono::steady_clock::time_point tpBegin( std::chrono::steady_clock::now() );
+
+        bool bTransaction( false );
+        try {
+          m_db.BeginTransaction();
+          bTransaction = true;
+        }
+        catch ( const std::runtime_error& e ) { // writes still go through, one transaction each
+          Failed( "Run begin", e );
+        }
+
+        while ( ( m_nGroup > nWrites ) && m_queue.Pop( fWrite ) ) {
+          Room();
+          try {
+            fWrite( m_cache );
+          }
+          catch ( const std::runtime_error& e ) {
+            Failed( "Run write", e );
+          }
+          fWrite = nullptr; // release captures
+          nWrites++;
+        }
+
+        if ( bTransaction ) {
+          try {
+            m_db.CommitTransaction();
+          }
+          catch ( const std::runtime_error& e ) {
+            Failed( "Run commit", e );
+            try {
+              m_db.RollbackTransaction();
+            }
+            catch (...) {}
+          }
+        }
+
+        const double dblLatency( std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - tpBegin ).count() );
+        m_dblLatencyLast.store( dblLatency, std::memory_order_relaxed );
+        if ( dblLatency > m_dblLatencyMax.load( std::memory_order_relaxed ) ) m_dblLatencyMax.store( dblLatency, std::memory_order_relaxed );
+        m_dblLatencyTotal.store( m_dblLatencyTotal.load( std::memory_order_relaxed ) + dblLatency, std::memory_order_relaxed );
+        m_nTransactions.fetch_add( 1, std::memory_order_relaxed );
+      }
+
+      {
+        std::scoped_lock<std::mutex> lock( m_mutex );
+        m_nCommitted.fetch_add( nWrites, std::memory_order_release );
+      }
+      m_cvCommitted.notify_all();
+    }
+  }
+
+};
+
+} // namespace db
+} // namespace ou
@@ -151,5 +151,43 @@ void ISqlite3::CloseStatement( structStatementState& statement ) {
   }
 }
 
+void ISqlite3::ExecuteDirect( const std::string& sStatement ) {
+  char* szError( nullptr );
+  int rtn = sqlite3_exec( m_db, sStatement.c_str(), nullptr, nullptr, &szError );
+  if ( SQLITE_OK != rtn ) {
+    std::string sErr( "ISqlite3::ExecuteDirect: " );
+    sErr += sStatement;
+    sErr += " error(";
+    sErr += boost::lexical_cast<std::string>( rtn );
+    sErr += ")";
+    if ( nullptr != szError ) {
+      sErr += " ";
+      sErr += szError;
+      sqlite3_free( szError );
+    }
+    throw std::runtime_error( sErr );
+  }
+}
+
+void ISqlite3::WriteAheadLog() {
+  ExecuteDirect( "PRAGMA journal_mode=WAL" ); // persistent in the database file
+  ExecuteDirect( "PRAGMA synchronous=NORMAL" ); // per connection
+}
+
+void ISqlite3::Checkpoint() {
+  ExecuteDirect( "PRAGMA wal_checkpoint(FULL)" );
+}
+
+void ISqlite3::SetBusyTimeout( int ms ) {
+  int rtn = sqlite3_busy_timeout( m_db, ms );
+  if ( SQLITE_OK != rtn ) {
+    std::string sErr( "ISqlite3::SetBusyTimeout: " );
+    sErr += " error(";
+    sErr += boost::lexical_cast<std::string>( rtn );
+    sErr += ")";
+    throw std::runtime_error( sErr );
+  }
+}
+
 } // db
 } // ou
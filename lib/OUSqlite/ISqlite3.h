@@ -55,6 +55,15 @@ public:
   void ResetStatement(   structStatementState& statement );
   void CloseStatement(   structStatementState& statement );
 
+  // used by write-behind
+  void ExecuteDirect( const std::string& sStatement ); // no parameters, no rows:  pragma, begin, commit
+  void BeginTransaction() { ExecuteDirect( "BEGIN" ); }
+  void CommitTransaction() { ExecuteDirect( "COMMIT" ); }
+  void RollbackTransaction() { ExecuteDirect( "ROLLBACK" ); }
+  void WriteAheadLog();  // WAL journal, syncs at checkpoints rather than each commit
+  void Checkpoint();     // WAL content is written back and synced
+  void SetBusyTimeout( int ms ); // wait on a lock held by another connection, rather than fail
+
   boost::int64_t GetLastRowId( void ) {
     return sqlite3_last_insert_rowid( m_db );
   }
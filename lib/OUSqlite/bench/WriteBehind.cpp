@@ -0,0 +1,165 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// caller side cost of Session::WriteInsert, synchronous versus write-behind, on a scratch database
+//   then confirms a failed background write is thrown from Sync, and that writes carry on after it
+//   usage: OUSqliteWriteBehind [rows [file]]
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <iostream>
+#include <algorithm>
+
+#include <OUSqlite/Session.h>
+
+namespace {
+
+struct Row {
+  template<class A>
+  void Fields( A& a ) {
+    ou::db::Field( a, "id", id );
+    ou::db::Field( a, "price", dblPrice );
+    ou::db::Field( a, "quantity", nQuantity );
+    ou::db::Field( a, "exchange", sExchange );
+  }
+  int64_t id;
+  double dblPrice;
+  int64_t nQuantity;
+  std::string sExchange;
+  Row(): id {}, dblPrice {}, nQuantity {} {}
+};
+
+struct RowCreate: Row {
+  template<class A>
+  void Fields( A& a ) {
+    Row::Fields( a );
+    ou::db::Key( a, "id" );
+  }
+};
+
+const std::string sTableName( "bench" );
+
+struct Tables {
+  void HandleRegisterTables( ou::db::Session& session ) {
+    session.RegisterTable<RowCreate>( sTableName );
+  }
+  void HandleRegisterRows( ou::db::Session& session ) {
+    session.MapRowDefToTableName<Row>( sTableName );
+  }
+};
+
+using ns_t = std::chrono::nanoseconds;
+
+// per write latencies as seen by the caller
+void Report( const std::string& sLabel, std::vector<ns_t>& vLatency, ns_t nsTotal ) {
+  std::sort( vLatency.begin(), vLatency.end() );
+  const size_t n( vLatency.size() );
+  std::cout
+    << sLabel
+    << ": " << nsTotal.count() / n << " ns/write"
+    << ", p50 " << vLatency[ n / 2 ].count()
+    << ", p99 " << vLatency[ ( n * 99 ) / 100 ].count()
+    << ", max " << vLatency.back().count()
+    << std::endl;
+}
+
+void Insert( ou::db::Session& session, int64_t idBegin, size_t nRows, std::vector<ns_t>& vLatency ) {
+  Row row;
+  row.sExchange = "SMART";
+  vLatency.clear();
+  vLatency.reserve( nRows );
+  for ( size_t ix = 0; ix < nRows; ++ix ) {
+    row.id = idBegin + ix;
+    row.dblPrice = 100.0 + 0.01 * ix;
+    row.nQuantity = 1 + ix % 10;
+    const auto start = std::chrono::steady_clock::now();
+    session.WriteInsert( row );
+    vLatency.push_back( std::chrono::steady_clock::now() - start );
+  }
+}
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nRows = ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 2000;
+  const std::string sFileName = ( 2 < argc ) ? argv[ 2 ] : "OUSqliteWriteBehind.db";
+
+  std::remove( sFileName.c_str() );
+
+  Tables tables;
+  ou::db::Session session;
+  session.OnRegisterTables.Add( MakeDelegate( &tables, &Tables::HandleRegisterTables ) );
+  session.OnRegisterRows.Add( MakeDelegate( &tables, &Tables::HandleRegisterRows ) );
+  session.Open( sFileName );
+
+  std::vector<ns_t> vLatency;
+
+  auto start = std::chrono::steady_clock::now();
+  Insert( session, 0, nRows, vLatency );
+  Report( "synchronous", vLatency, std::chrono::steady_clock::now() - start );
+
+  session.EnableWriteBehind();
+
+  start = std::chrono::steady_clock::now();
+  Insert( session, nRows, nRows, vLatency );
+  const auto nsQueued( std::chrono::steady_clock::now() - start );
+  Report( "write-behind", vLatency, nsQueued );
+
+  start = std::chrono::steady_clock::now();
+  session.Flush();
+  const auto nsFlush( std::chrono::steady_clock::now() - start );
+
+  const ou::db::Session::WriteBehindStats_t stats( session.GetWriteBehindStats() );
+  std::cout
+    << "flush " << std::chrono::duration_cast<std::chrono::microseconds>( nsFlush ).count() << " us"
+    << ", committed " << stats.nCommitted
+    << ", transactions " << stats.nTransactions
+    << ", blocked " << stats.nBlocked
+    << ", commit ms mean " << stats.dblCommitLatencyMean
+    << " max " << stats.dblCommitLatencyMax
+    << std::endl;
+
+  // a duplicate key fails on the background thread, the next Flush has to report it
+  bool bSurfaced( false );
+  Insert( session, 0, 1, vLatency );
+  try {
+    session.Sync();
+  }
+  catch ( const std::runtime_error& e ) {
+    bSurfaced = true;
+    std::cout << "failed write surfaced: " << e.what() << std::endl;
+  }
+  if ( !bSurfaced ) {
+    std::cout << "failed write not surfaced" << std::endl;
+  }
+
+  // the cached statement has to remain usable after the failure
+  bool bRecovered( true );
+  Insert( session, 2 * nRows, 1, vLatency );
+  try {
+    session.Flush();
+  }
+  catch ( const std::runtime_error& e ) {
+    bRecovered = false;
+    std::cout << "write after the failure: " << e.what() << std::endl;
+  }
+
+  session.Close();
+  std::remove( sFileName.c_str() );
+
+  return ( bSurfaced && bRecovered && ( 0 == stats.nErrors ) ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -28,6 +28,8 @@
 
 #include <boost/asio/strand.hpp>
 
+#include <OUCommon/JsonScanner.h>
+
 #include <TFTrading/OrderManager.h>
 
 #include "one_shot.hpp"
@@ -290,63 +292,66 @@ void Provider::TradeUpdates() {
     },
     [this]( std::string&& sMessage){ // fMessage_t
       //std::cout << "order update message: " << sMessage << std::endl;
-      json::error_code jec;
-      json::value jv = json::parse( sMessage, jec );
-      if ( jec.failed() ) {
+
+      // {"stream":"<type>","data":{...}}, data is held as a view until the stream type is known
+      ou::JsonScanner scan( sMessage );
+      std::string_view key;
+      std::string_view svStream;
+      std::string_view svData;
+
+      if ( scan.Object() ) {
+        while ( scan.Key( key ) ) {
+          if ( "stream" == key ) scan.String( svStream );
+          else if ( "data" == key ) scan.Value( svData );
+          else scan.Skip();
+        }
+      }
+
+      if ( scan.Failed() ) {
         BOOST_LOG_TRIVIAL(error) << "provider/alpaca failed to parse web_socket stream: " << sMessage;
       }
       else {
 
-        // TODO: encase in try/catch
-
-        struct Stream {
-          std::string sType;
-          json::object object;
-        } stream;
-
-        json::object const& obj = jv.as_object();
-        extract( obj, stream.sType, "stream" );
-        extract( obj, stream.object, "data" );
-
-        // todo use kvm or spirit to parse
         bool bFound( false );
 
-        if ( "authorization" == stream.sType ) {
+        if ( "authorization" == svStream ) {
           bFound = true;
-          BOOST_LOG_TRIVIAL(info) << "authorization: " << stream.object;
+          BOOST_LOG_TRIVIAL(info) << "authorization: " << svData;
           // {"stream":"authorization","data":{"action":"authenticate","status":"authorized"}}
 
           struct Auth {
-            std::string sAction;
-            std::string sStatus;
+            std::string_view sAction;
+            std::string_view sStatus;
           } auth;
 
-          extract( stream.object, auth.sAction, "action" );
+          ou::JsonScanner data( svData );
+          if ( data.Object() ) {
+            while ( data.Key( key ) ) {
+              if ( "action" == key ) data.String( auth.sAction );
+              else if ( "status" == key ) data.String( auth.sStatus );
+              else data.Skip();
+            }
+          }
           assert( "authenticate" == auth.sAction );
-          extract( stream.object, auth.sStatus, "status" );
           assert( "authorized" == auth.sStatus );
 
           m_state = EState::authorized;
         }
 
-        if ( "listening" == stream.sType ) {
+        if ( "listening" == svStream ) {
           bFound = true;
-          BOOST_LOG_TRIVIAL(error) << "listening status: " << stream.object << std::endl;
+          BOOST_LOG_TRIVIAL(error) << "listening status: " << svData << std::endl;
           // {"stream":"listening","data":{"streams":["trade_updates"]}}
 
-          json::array objStreams;
-          extract( stream.object, objStreams, "streams" );
-          //assert( "[\"trade_updates\"]" == json::to( objStreams ) );
-
           m_state = EState::listening;
         }
 
-        if ( "trade_updates" == stream.sType ) {
+        if ( "trade_updates" == svStream ) {
           bFound = true;
-          std::cout << "trade update: " << stream.object << std::endl;
+          BOOST_LOG_TRIVIAL(debug) << "provider/alpaca trade update: " << svData;
           // {"stream":"trade_updates","data":{"event":"new",
           // {"stream":"trade_updates","data":{"event":"fill",
-          TradeUpdate( stream.object );
+          TradeUpdate( svData );
         }
         if ( !bFound ) {
           BOOST_LOG_TRIVIAL(warning) << "provider/alpaca unknown order update message: " << sMessage << std::endl;
@@ -356,121 +361,91 @@ void Provider::TradeUpdates() {
   );
 }
 
-void Provider::TradeUpdate( const json::object& obj ) {
+void Provider::TradeUpdate( std::string_view svData ) {
 
+  // decoded in place, only the fields used below, the order object is scanned for its id and side
   struct Update {
-    std::string id;
-    std::string event;
-    std::string execution_id;
-    std::string timestamp;
-
-    std::string position_qty;
-    std::string price;
-    std::string qty;
+    std::string_view event;
+    std::string_view execution_id;
+    std::string_view timestamp;
+
+    double position_qty;
+    double price;
+    double qty;
+
+    std::string_view order_id;
+    std::string_view order_side;
+
+    Update(): position_qty {}, price {}, qty {} {}
   } update;
 
-  //json::value order;
-  order::Status status;
+  ou::JsonScanner scan( svData );
+  std::string_view key;
+
+  if ( scan.Object() ) {
+    while ( scan.Key( key ) ) {
+      if ( "event" == key ) scan.String( update.event );
+      else if ( "timestamp" == key ) scan.String( update.timestamp );
+      else if ( "execution_id" == key ) scan.String( update.execution_id );
+      else if ( "price" == key ) scan.Number( update.price );
+      else if ( "qty" == key ) scan.Number( update.qty );
+      else if ( "position_qty" == key ) scan.Number( update.position_qty );
+      else if ( "order" == key ) {
+        if ( scan.Object() ) {
+          while ( scan.Key( key ) ) {
+            if ( "id" == key ) scan.String( update.order_id );
+            else if ( "side" == key ) scan.String( update.order_side );
+            else scan.Skip();
+          }
+        }
+      }
+      else scan.Skip();
+    }
+  }
 
-  extract( obj, update.event, "event" );
-  extract( obj, update.timestamp, "timestamp" );
+  if ( scan.Failed() ) {
+    BOOST_LOG_TRIVIAL(error) << "provider/alpaca failed to decode trade update: " << svData;
+    return;
+  }
 
   EEvent event = m_kwmEvent.FindMatch( update.event );
   switch ( event ) {
     case EEvent::new_:
       {
-        //extract( obj, update.id, "id" );
-        json::object order;
-        extract( obj, order, "order" );
-        //order::Decode( order, status ); // is the full decode necessary, just extract other desired fields?
-        std::string id;
-        extract( order, id, "id" );
-        //std::string sIdOrder;
-        //extract( order, sIdOrder, "client_order_id" );
-        //try {
-          ou::tf::Order::idOrder_t idOrder;
-          //idOrder = boost::lexical_cast<ou::tf::Order::idOrder_t>( status.client_order_id );
-
-          //umapOrderLookup_t::iterator iter = m_umapOrderLookup.find( id );
-          //assert( m_umapOrderLookup.end() != iter );
-          //OrderManager::GlobalInstance().UpdateReference( iter->second, id );
-        //}
-        //catch ( boost::bad_lexical_cast& e ) {
-        //  std::cout << "alpaca provider: can not decode order " << status.client_order_id << std::endl;
-        //}
-      }
-      break;
-    case EEvent::partial_fill:
-      {
-        json::value order;
-
-        extract( obj, update.qty, "qty" );
-        extract( obj, update.price, "price" );
-        extract( obj, update.execution_id, "execution_id" );
-
-        extract( obj, order, "order" );
-        order::Decode( order, status );
-        OrderSide::EOrderSide side( OrderSide::Unknown );
-        if ( "sell" == status.side ) side = OrderSide::Sell;
-        if ( "buy"  == status.side ) side = OrderSide::Buy;
-        auto price = boost::lexical_cast<double>( update.price );
-        auto volume = boost::lexical_cast<ou::tf::Price::volume_t>( update.qty );
-        ou::tf::Execution exec(
-          price,
-          volume,
-          side,
-          std::string( "alpaca" ),
-          update.execution_id
-        );
         //ou::tf::Order::idOrder_t idOrder;
         //idOrder = boost::lexical_cast<ou::tf::Order::idOrder_t>( status.client_order_id );
-        umapOrderLookup_t::iterator iter = m_umapOrderLookup.find( status.id );
-        if ( m_umapOrderLookup.end() != iter ) { // there may be unknown manual orders
-          OrderManager::GlobalInstance().ReportExecution( iter->second->GetOrderId(), exec );
-        }
+
+        //umapOrderLookup_t::iterator iter = m_umapOrderLookup.find( id );
+        //assert( m_umapOrderLookup.end() != iter );
+        //OrderManager::GlobalInstance().UpdateReference( iter->second, id );
       }
       break;
+    case EEvent::partial_fill:
     case EEvent::fill:
-      try {
-        json::value order; // TODO: use object instead like with new_?
-
-        extract( obj, update.qty, "qty" );
-        extract( obj, update.price, "price" );
-        extract( obj, update.execution_id, "execution_id" );
-
-        extract( obj, order, "order" );
-        order::Decode( order, status );
+      {
         OrderSide::EOrderSide side( OrderSide::Unknown );
-        if ( "sell" == status.side ) side = OrderSide::Sell;
-        if ( "buy"  == status.side ) side = OrderSide::Buy;
-        auto price = boost::lexical_cast<double>( update.price );
-        auto volume = boost::lexical_cast<ou::tf::Price::volume_t>( update.qty );
+        if ( "sell" == update.order_side ) side = OrderSide::Sell;
+        if ( "buy"  == update.order_side ) side = OrderSide::Buy;
         ou::tf::Execution exec(
-          price,
-          volume,
+          update.price,
+          (ou::tf::Price::volume_t)update.qty,
           side,
           std::string( "alpaca" ),
-          update.execution_id
+          std::string( update.execution_id )
         );
         //ou::tf::Order::idOrder_t idOrder;
         //idOrder = boost::lexical_cast<ou::tf::Order::idOrder_t>( status.client_order_id );
-        umapOrderLookup_t::iterator iter = m_umapOrderLookup.find( status.id );
+        umapOrderLookup_t::iterator iter = m_umapOrderLookup.find( std::string( update.order_id ) );
         if ( m_umapOrderLookup.end() != iter ) { // there may be unknown manual orders
           OrderManager::GlobalInstance().ReportExecution( iter->second->GetOrderId(), exec );
         }
       }
-      catch(...) {
-        BOOST_LOG_TRIVIAL(error) << "provider/alpaca EEVent::fill broke";
-      }
       break;
     case EEvent::canceled:
       {
-        json::value order; // TODO: use object instead?
-        extract( obj, order, "order" );
-        order::Decode( order, status );
         //ou::tf::Order::idOrder_t idOrder;
         //idOrder = boost::lexical_cast<ou::tf::Order::idOrder_t>( status.client_order_id );
-        umapOrderLookup_t::iterator iter = m_umapOrderLookup.find( status.id );
+        umapOrderLookup_t::iterator iter = m_umapOrderLookup.find( std::string( update.order_id ) );
         if ( m_umapOrderLookup.end() != iter ) { // there may be unknown manual orders
           OrderManager::GlobalInstance().ReportCancellation( iter->second->GetOrderId() );
         }
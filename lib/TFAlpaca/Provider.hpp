@@ -24,6 +24,7 @@
 #include <map>
 #include <set>
 #include <memory>
+#include <string_view>
 #include <unordered_map>
 
 #include <boost/asio/ssl.hpp>
@@ -37,12 +38,6 @@
 namespace asio = boost::asio; // from <boost/asio.hpp>
 namespace ssl  = asio::ssl;   // from <boost/asio/ssl.hpp>
 
-namespace boost {
-namespace json {
-  class object;
-}
-}
-
 namespace ou {
 namespace tf {
 namespace alpaca {
@@ -139,7 +134,7 @@ private:
   void Positions();
   void TradeUpdates();
 
-  void TradeUpdate( const boost::json::object& obj );
+  void TradeUpdate( std::string_view ); // the data member of a trade_updates message
 
 };
 
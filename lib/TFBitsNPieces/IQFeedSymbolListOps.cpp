@@ -14,6 +14,8 @@
 
 #include "stdafx.h"
 
+#include <TFIQFeed/MktSymbolSnapshot.h>
+
 #include "IQFeedSymbolListOps.h"
 
 namespace ou { // One Unified
@@ -53,6 +55,8 @@ void IQFeedSymbolListOps::WorkerObtainNewIQFeedSymbolListRemote( void ) {
   ou::tf::iqfeed::LoadMktSymbols( m_listIQFeedSymbols, ou::tf::iqfeed::MktSymbolLoadType::Download, true, iqfeed::detail::sFileNameMarketSymbolsText ); 
 	Status( "Saving Binary File ... " );
   m_listIQFeedSymbols.SaveToFile( iqfeed::detail::sFileNameMarketSymbolsBinary );
+	Status( "Saving Snapshot File ... " );
+  ou::tf::iqfeed::MktSymbolSnapshot::Write( m_listIQFeedSymbols, iqfeed::detail::sFileNameMarketSymbolsSnapshot );
 	StatusDone();
 	Done( ccDone );
   m_fenceWorker.fetch_sub( 1, boost::memory_order_release );
@@ -73,6 +77,8 @@ void IQFeedSymbolListOps::WorkerObtainNewIQFeedSymbolListLocal( void ) {
   ou::tf::iqfeed::LoadMktSymbols( m_listIQFeedSymbols, ou::tf::iqfeed::MktSymbolLoadType::LoadTextFromDisk, false, iqfeed::detail::sFileNameMarketSymbolsText ); 
 	Status( "Saving Binary File ... " );
   m_listIQFeedSymbols.SaveToFile( iqfeed::detail::sFileNameMarketSymbolsBinary );
+	Status( "Saving Snapshot File ... " );
+  ou::tf::iqfeed::MktSymbolSnapshot::Write( m_listIQFeedSymbols, iqfeed::detail::sFileNameMarketSymbolsSnapshot );
 	StatusDone();
 	Done( ccDone );
   m_fenceWorker.fetch_sub( 1, boost::memory_order_release );
@@ -0,0 +1,301 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    InstrumentScanner.h
+ * Author:  raymond@burkholder.net
+ * Project: TFBitsNPieces
+ * Created: October 17, 2026 19:10
+ */
+
+#pragma once
+
+// parallel version of InstrumentFilter:
+//   1. dataset paths are enumerated on the calling thread
+//   2. one reader thread, with its own HDF5DataManager, reads each dataset in turn,
+//      libhdf5 is not thread safe, so all hdf5 access is serialized in this stage.
+//      only the tail window before dtEnd is read: one binary search for dtEnd,
+//      then a hyperslab read of at most nWindow datums
+//   3. a pool of workers runs the filter, each symbol is given its own copy of S
+//   4. results are passed to cbResult on the calling thread, in enumeration order,
+//      so output is the same for any number of workers
+// symbols in flight are bounded, so memory does not grow with the size of the universe
+
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <condition_variable>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <TFHDF5TimeSeries/HDF5DataManager.h>
+#include <TFHDF5TimeSeries/HDF5IterateGroups.h>
+#include <TFHDF5TimeSeries/HDF5TimeSeriesContainer.h>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+template<typename S, typename TS> // S=per symbol data structure, copied from a prototype, TS=time series type to be used
+class InstrumentScanner {
+public:
+
+  using size_type = typename TS::size_type;
+  using datum_t = typename TS::datum_t;
+
+  using cbUseGroup_t = std::function<bool (const std::string&, const std::string&)>;  // calling thread: path, group
+  using cbFilter_t   = std::function<bool (S&, const std::string&, const TS&)>; // worker threads: structure, name, timeseries
+  using cbResult_t   = std::function<void (S&, const std::string&, const std::string&, const TS&)>;  // calling thread, in order: structure, path, name, timeseries
+
+  struct Stats {
+    size_t nSymbols;  // enumerated
+    size_t nRead;     // with at least nRequired datums in the range
+    size_t nPassed;   // by the filter
+    unsigned int nWorkers;
+    double dblSeconds;
+    Stats(): nSymbols {}, nRead {}, nPassed {}, nWorkers {}, dblSeconds {} {}
+    double SymbolsPerSecond() const { return ( 0.0 < dblSeconds ) ? ( nSymbols / dblSeconds ) : 0.0; }
+  };
+
+  InstrumentScanner(
+    const std::string& sPath,
+    boost::posix_time::ptime dtBegin, boost::posix_time::ptime dtEnd,
+    size_type nRequired,
+    size_type nWindow, // read at most the last nWindow datums before dtEnd, 0 reads the whole range
+    const S& prototype,
+    cbUseGroup_t, cbFilter_t, cbResult_t,
+    unsigned int nWorkers = 0 // 0 uses the hardware concurrency, less one for the reader
+    );
+  ~InstrumentScanner() {};
+
+  const Stats& GetStats() const { return m_stats; }
+
+protected:
+private:
+
+  struct Dataset {
+    std::string sPath;
+    std::string sObject;
+    Dataset( const std::string& sPath_, const std::string& sObject_ )
+    : sPath( sPath_ ), sObject( sObject_ ) {}
+  };
+
+  struct Item {
+    S s;
+    TS ts;
+    bool bDone;   // read, and filtered when required
+    bool bPassed;
+    Item( const S& s_ ): s( s_ ), bDone( false ), bPassed( false ) {}
+  };
+
+  using pItem_t = std::unique_ptr<Item>;
+
+  const boost::posix_time::ptime m_dtBegin;
+  const boost::posix_time::ptime m_dtEnd;
+  const size_type m_nRequired;
+  const size_type m_nWindow;
+
+  cbFilter_t m_cbFilter;
+
+  std::vector<Dataset> m_vDataset;
+  std::vector<pItem_t> m_vItem; // by dataset, released once merged
+
+  std::mutex m_mutex;
+  std::condition_variable m_cvWork;     // workers
+  std::condition_variable m_cvProgress; // reader and merge
+  std::deque<size_t> m_dequeWork;       // items read, waiting for the filter
+  size_t m_ixMerged;
+  bool m_bReadComplete;
+
+  Stats m_stats;
+
+  bool Read( HDF5DataManager&, const std::string& sPath, TS& );
+  void Reader( const S& prototype, size_t nInFlight );
+  void Worker();
+};
+
+template<typename S, typename TS>
+InstrumentScanner<S,TS>::InstrumentScanner(
+  const std::string& sPath,
+  boost::posix_time::ptime dtBegin, boost::posix_time::ptime dtEnd,
+  size_type nRequired, size_type nWindow,
+  const S& prototype,
+  cbUseGroup_t cbUseGroup, cbFilter_t cbFilter, cbResult_t cbResult,
+  unsigned int nWorkers )
+: m_dtBegin( dtBegin ), m_dtEnd( dtEnd ), m_nRequired( nRequired ), m_nWindow( nWindow )
+, m_cbFilter( cbFilter )
+, m_ixMerged {}, m_bReadComplete( false )
+{
+  if ( dtBegin >= dtEnd ) {
+    throw std::runtime_error( "dtBegin >= dtEnd" );
+  }
+
+  const std::chrono::steady_clock::time_point tStart( std::chrono::steady_clock::now() );
+
+  { // enumerate, the handle is closed before the reader opens its own
+    bool bUseGroup( false );
+    ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO );
+    ou::tf::hdf5::IterateGroups ig(
+      dm, sPath,
+      [&bUseGroup,&cbUseGroup]( const std::string& sPath, const std::string& sGroup ){
+        bUseGroup = cbUseGroup( sPath, sGroup );
+      },
+      [&bUseGroup,this]( const std::string& sPath, const std::string& sObject ){
+        if ( bUseGroup ) m_vDataset.emplace_back( sPath, sObject );
+      }
+      );
+  }
+
+  m_stats.nSymbols = m_vDataset.size();
+  m_vItem.resize( m_vDataset.size() );
+
+  if ( 0 == nWorkers ) {
+    const unsigned int nHardware( std::thread::hardware_concurrency() );
+    nWorkers = ( 2 < nHardware ) ? ( nHardware - 1 ) : 1;
+  }
+  m_stats.nWorkers = nWorkers;
+
+  std::thread threadReader( &InstrumentScanner<S,TS>::Reader, this, std::cref( prototype ), 4 * nWorkers + 4 );
+  std::vector<std::thread> vWorker;
+  for ( unsigned int ix = 0; ix < nWorkers; ix++ ) {
+    vWorker.emplace_back( &InstrumentScanner<S,TS>::Worker, this );
+  }
+
+  // merge, in enumeration order
+  for ( size_t ix = 0; ix < m_vItem.size(); ix++ ) {
+    pItem_t pItem;
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_cvProgress.wait( lock, [this,ix](){ return m_vItem[ ix ] && m_vItem[ ix ]->bDone; } );
+      pItem = std::move( m_vItem[ ix ] );
+      m_ixMerged = ix + 1;
+    }
+    m_cvProgress.notify_all(); // reader may be waiting for room
+    if ( pItem->bPassed ) {
+      m_stats.nPassed++;
+      const Dataset& dataset( m_vDataset[ ix ] );
+      cbResult( pItem->s, dataset.sPath, dataset.sObject, pItem->ts );
+    }
+  }
+
+  threadReader.join();
+  for ( std::thread& thread: vWorker ) thread.join();
+
+  m_stats.dblSeconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - tStart ).count();
+
+  std::cout
+    << "InstrumentScanner " << sPath << ": "
+    << m_stats.nSymbols << " symbols, "
+    << m_stats.nRead << " read, "
+    << m_stats.nPassed << " passed, "
+    << m_stats.nWorkers << " workers, "
+    << m_stats.SymbolsPerSecond() << " symbols/sec"
+    << std::endl;
+}
+
+template<typename S, typename TS>
+bool InstrumentScanner<S,TS>::Read( HDF5DataManager& dm, const std::string& sPath, TS& ts ) {
+  using container_t = ou::tf::HDF5TimeSeriesContainer<datum_t>;
+  container_t tsRepository( dm, sPath );
+  typename container_t::iterator begin( tsRepository.begin() );
+  typename container_t::iterator end( std::lower_bound( begin, tsRepository.end(), m_dtEnd ) );
+  if ( ( 0 < m_nWindow ) && ( m_nWindow < ( end - begin ) ) ) {
+    begin = end - m_nWindow;
+  }
+  begin = std::lower_bound( begin, end, m_dtBegin );
+  const hsize_t cnt = end - begin;
+  if ( m_nRequired > cnt ) return false;
+  ts.Resize( cnt );
+  tsRepository.Read( begin, end, &ts );
+  return true;
+}
+
+template<typename S, typename TS>
+void InstrumentScanner<S,TS>::Reader( const S& prototype, size_t nInFlight ) {
+  ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO );
+  for ( size_t ix = 0; ix < m_vDataset.size(); ix++ ) {
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_cvProgress.wait( lock, [this,ix,nInFlight](){ return ( ix - m_ixMerged ) < nInFlight; } );
+    }
+    pItem_t pItem = std::make_unique<Item>( prototype );
+    bool bRead( false );
+    try {
+      bRead = Read( dm, m_vDataset[ ix ].sPath, pItem->ts );
+    }
+    catch ( H5::Exception& e ) {
+      std::cout << "InstrumentScanner::Reader " << m_vDataset[ ix ].sPath << " H5::Exception " << e.getDetailMsg() << std::endl;
+    }
+    catch ( std::exception& e ) {
+      std::cout << "InstrumentScanner::Reader " << m_vDataset[ ix ].sPath << " problem: " << e.what() << std::endl;
+    }
+    {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      if ( bRead ) {
+        m_stats.nRead++;
+        m_dequeWork.push_back( ix );
+      }
+      else {
+        pItem->bDone = true; // nothing to filter
+      }
+      m_vItem[ ix ] = std::move( pItem );
+    }
+    if ( bRead ) m_cvWork.notify_one();
+    else m_cvProgress.notify_all();
+  }
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_bReadComplete = true;
+  }
+  m_cvWork.notify_all();
+}
+
+template<typename S, typename TS>
+void InstrumentScanner<S,TS>::Worker() {
+  while ( true ) {
+    Item* pItem( nullptr );
+    size_t ix {};
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_cvWork.wait( lock, [this](){ return m_bReadComplete || !m_dequeWork.empty(); } );
+      if ( m_dequeWork.empty() ) break; // read complete, nothing left
+      ix = m_dequeWork.front();
+      m_dequeWork.pop_front();
+      pItem = m_vItem[ ix ].get(); // not released until done
+    }
+    bool bPassed( false );
+    try {
+      bPassed = m_cbFilter( pItem->s, m_vDataset[ ix ].sObject, pItem->ts );
+    }
+    catch ( std::exception& e ) {
+      std::cout << "InstrumentScanner::Worker " << m_vDataset[ ix ].sObject << " problem: " << e.what() << std::endl;
+    }
+    {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      pItem->bPassed = bPassed;
+      pItem->bDone = true;
+    }
+    m_cvProgress.notify_all();
+  }
+}
+
+} // namespace tf
+} // namespace ou
@@ -17,6 +17,10 @@
 namespace ou { // One Unified
 namespace gp { // genetic programming
 
+namespace {
+  enum EField { FTradePrice = 0, FQuoteBid, FQuoteAsk, FQuoteMid, FPriceValue }; // column keys, per series
+}
+
 NodeTSTrade::NodeTSTrade(void): NodeTimeSeries<NodeTSTrade, ou::tf::Trades>() {
   m_cntNodes = 0;
 }
@@ -28,6 +32,10 @@ double NodeTSTrade::EvaluateDouble( void ) {
   return TimeSeries()->Last()->Price();
 }
 
+void NodeTSTrade::Emit( Program& program, Columns& columns ) const {
+  program.EmitColumn( TimeSeriesColumns::Cast( columns ).Column( m_pTimeSeries, FTradePrice, []( const ou::tf::Trade& trade ){ return trade.Price(); } ) );
+}
+
 // =======================
 
 NodeTSQuoteBid::NodeTSQuoteBid(void): NodeTimeSeries<NodeTSQuoteBid, ou::tf::Quotes>() {
@@ -41,6 +49,10 @@ double NodeTSQuoteBid::EvaluateDouble( void ) {
   return TimeSeries()->Last()->Bid();
 }
 
+void NodeTSQuoteBid::Emit( Program& program, Columns& columns ) const {
+  program.EmitColumn( TimeSeriesColumns::Cast( columns ).Column( m_pTimeSeries, FQuoteBid, []( const ou::tf::Quote& quote ){ return quote.Bid(); } ) );
+}
+
 // =======================
 
 NodeTSQuoteAsk::NodeTSQuoteAsk(void): NodeTimeSeries<NodeTSQuoteAsk, ou::tf::Quotes>() {
@@ -54,6 +66,10 @@ double NodeTSQuoteAsk::EvaluateDouble( void ) {
   return TimeSeries()->Last()->Ask();
 }
 
+void NodeTSQuoteAsk::Emit( Program& program, Columns& columns ) const {
+  program.EmitColumn( TimeSeriesColumns::Cast( columns ).Column( m_pTimeSeries, FQuoteAsk, []( const ou::tf::Quote& quote ){ return quote.Ask(); } ) );
+}
+
 // =======================
 
 NodeTSQuoteMid::NodeTSQuoteMid(void): NodeTimeSeries<NodeTSQuoteMid, ou::tf::Quotes>() {
@@ -67,6 +83,10 @@ double NodeTSQuoteMid::EvaluateDouble( void ) {
   return TimeSeries()->Last()->Midpoint();
 }
 
+void NodeTSQuoteMid::Emit( Program& program, Columns& columns ) const {
+  program.EmitColumn( TimeSeriesColumns::Cast( columns ).Column( m_pTimeSeries, FQuoteMid, []( const ou::tf::Quote& quote ){ return quote.Midpoint(); } ) );
+}
+
 // =======================
 
 NodeTSPrice::NodeTSPrice(void): NodeTimeSeries<NodeTSPrice, ou::tf::Prices>() {
@@ -80,6 +100,10 @@ double NodeTSPrice::EvaluateDouble( void ) {
   return TimeSeries()->Last()->Value();
 }
 
+void NodeTSPrice::Emit( Program& program, Columns& columns ) const {
+  program.EmitColumn( TimeSeriesColumns::Cast( columns ).Column( m_pTimeSeries, FPriceValue, []( const ou::tf::Price& price ){ return price.Value(); } ) );
+}
+
 // =======================
 
 } // namespace gp
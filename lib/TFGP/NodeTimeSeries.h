@@ -19,6 +19,7 @@
 #include <OUGP/Node.h>
 
 #include "TimeSeriesForNode.h"
+#include "TimeSeriesColumns.h"
 #include "TimeSeriesRegistration.h"
 
 namespace ou { // One Unified
@@ -59,6 +60,7 @@ public:
   ~NodeTSTrade(void);
   void ToString( std::stringstream& ss ) const { ss << m_pTimeSeries->GetName() << ".price()"; };
   double EvaluateDouble( void );
+  void Emit( Program&, Columns& ) const;
 protected:
 private:
 };
@@ -71,6 +73,7 @@ public:
   ~NodeTSQuoteBid(void);
   void ToString( std::stringstream& ss ) const { ss << m_pTimeSeries->GetName() << ".bid()"; };
   double EvaluateDouble( void );
+  void Emit( Program&, Columns& ) const;
 protected:
 private:
 };
@@ -81,6 +84,7 @@ public:
   ~NodeTSQuoteAsk(void);
   void ToString( std::stringstream& ss ) const { ss << m_pTimeSeries->GetName() << ".ask()"; };
   double EvaluateDouble( void );
+  void Emit( Program&, Columns& ) const;
 protected:
 private:
 };
@@ -91,6 +95,7 @@ public:
   ~NodeTSQuoteMid(void);
   void ToString( std::stringstream& ss ) const { ss << m_pTimeSeries->GetName() << ".mid()"; };
   double EvaluateDouble( void );
+  void Emit( Program&, Columns& ) const;
 protected:
 private:
 };
@@ -103,6 +108,7 @@ public:
   ~NodeTSPrice(void);
   void ToString( std::stringstream& ss ) const { ss << m_pTimeSeries->GetName() << ".value()"; };
   double EvaluateDouble( void );
+  void Emit( Program&, Columns& ) const;
 protected:
 private:
 };
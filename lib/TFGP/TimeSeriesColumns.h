@@ -0,0 +1,96 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    TimeSeriesColumns.h
+ * Author:  raymond@burkholder.net
+ * Project: TFGP
+ * Created: October 17, 2026 15:40
+ */
+
+#pragma once
+
+// terminal columns for compiled programs, sampled from time series on a common timeline:
+//   the value at each instant is that of the latest datum at or before the instant (NaN before the first),
+//   matching TimeSeries()->Last() when the tree is evaluated during a replay.
+// construct one per generation over the backtest window, every individual's program shares its columns
+
+#include <limits>
+#include <vector>
+#include <stdexcept>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <OUGP/Program.h>
+
+namespace ou { // One Unified
+namespace gp { // genetic programming
+
+class TimeSeriesColumns: public Columns {
+public:
+
+  using dt_t = boost::posix_time::ptime;
+  using vTimeline_t = std::vector<dt_t>;
+
+  TimeSeriesColumns( vTimeline_t&& vTimeline ) // instants of evaluation, ascending
+  : Columns( vTimeline.size() ), m_vTimeline( std::move( vTimeline ) ) {}
+  virtual ~TimeSeriesColumns( void ) {}
+
+  // evaluate at each datum of a series, typically the quotes or trades driving the strategy
+  template<typename TS>
+  static vTimeline_t Timeline( const TS& series ) {
+    vTimeline_t vTimeline;
+    vTimeline.reserve( series.Size() );
+    for ( typename TS::const_iterator iter = series.begin(); series.end() != iter; ++iter ) {
+      vTimeline.push_back( iter->DateTime() );
+    }
+    return vTimeline;
+  }
+
+  static TimeSeriesColumns& Cast( Columns& columns ) {
+    TimeSeriesColumns* p = dynamic_cast<TimeSeriesColumns*>( &columns );
+    if ( 0 == p ) throw std::runtime_error( "TimeSeriesColumns::Cast: time series nodes require TimeSeriesColumns" );
+    return *p;
+  }
+
+  const vTimeline_t& Timeline( void ) const { return m_vTimeline; };
+
+  // F: double( const TS::datum_t& ), field distinguishes columns taken from the same series
+  template<typename TS, typename F>
+  size_t Column( const TS* pSeries, int field, F f ) {
+    assert( 0 != pSeries );
+    return Columns::Column(
+      key_t( pSeries, field ),
+      [this,pSeries,f]( column_t& column ){
+        typename TS::const_iterator iter( pSeries->begin() );
+        const typename TS::const_iterator end( pSeries->end() );
+        double value( std::numeric_limits<double>::quiet_NaN() );
+        for ( size_t ix = 0; ix < m_vTimeline.size(); ix++ ) {
+          const dt_t dt( m_vTimeline[ ix ] );
+          while ( ( end != iter ) && ( iter->DateTime() <= dt ) ) {
+            value = f( *iter );
+            ++iter;
+          }
+          column[ ix ] = value;
+        }
+      } );
+  }
+
+protected:
+private:
+  const vTimeline_t m_vTimeline;
+};
+
+} // namespace gp
+} // namespace ou
@@ -0,0 +1,70 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    HDF5ChunkedSeries.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFHDF5TimeSeries
+ * Created: October 17, 2026 13:10
+ */
+
+#include <future>
+
+#include "HDF5ChunkedSeries.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+HDF5ReadAhead::HDF5ReadAhead( const std::string& sFileName )
+: m_work( boost::asio::make_work_guard( m_context ) )
+{
+  m_thread = std::thread( [this](){ m_context.run(); } );
+  try {
+    Call( [this,&sFileName](){ m_pdm = std::make_unique<HDF5DataManager>( HDF5DataManager::RO, sFileName ); } );
+  }
+  catch (...) {
+    m_work.reset();
+    m_thread.join();
+    throw;
+  }
+}
+
+HDF5ReadAhead::~HDF5ReadAhead() {
+  Post( [this](){ m_pdm.reset(); } );
+  m_work.reset();
+  m_thread.join();
+}
+
+void HDF5ReadAhead::Post( fJob_t&& f ) {
+  boost::asio::post( m_context, std::move( f ) );
+}
+
+void HDF5ReadAhead::Call( fJob_t&& f ) {
+  std::promise<void> promise;
+  std::future<void> future = promise.get_future();
+  Post(
+    [&f,&promise](){
+      try {
+        f();
+        promise.set_value();
+      }
+      catch (...) {
+        promise.set_exception( std::current_exception() );
+      }
+    } );
+  future.get();
+}
+
+} // namespace tf
+} // namespace ou
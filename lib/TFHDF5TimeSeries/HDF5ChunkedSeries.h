@@ -0,0 +1,267 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    HDF5ChunkedSeries.h
+ * Author:  raymond@burkholder.net
+ * Project: TFHDF5TimeSeries
+ * Created: October 17, 2026 13:10
+ */
+
+#pragma once
+
+// streamed access to a dataset:  fixed size chunks are read by hyperslab, the next chunk is read
+//   ahead on a background thread while the current one is consumed, memory is two chunks per series.
+// all hdf5 calls for the file, including open and close, are made on the HDF5ReadAhead thread,
+//   as the library is not built thread safe, no other thread may make hdf5 calls, on any file,
+//   while an HDF5ReadAhead exists.
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <exception>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+
+#include "HDF5DataManager.h"
+#include "HDF5TimeSeriesAccessor.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+// ==== HDF5ReadAhead: owns the file and the thread which reads it
+
+class HDF5ReadAhead {
+public:
+
+  using fJob_t = std::function<void()>;
+
+  HDF5ReadAhead( const std::string& sFileName ); // throws std::runtime_error
+  ~HDF5ReadAhead();
+
+  HDF5DataManager& DataManager() { return *m_pdm; } // use only from within a job
+
+  void Post( fJob_t&& );
+  void Call( fJob_t&& ); // post and wait for completion, exceptions are rethrown to the caller
+
+protected:
+private:
+
+  boost::asio::io_context m_context;
+  boost::asio::executor_work_guard<boost::asio::io_context::executor_type> m_work;
+  std::thread m_thread;
+
+  std::unique_ptr<HDF5DataManager> m_pdm;
+};
+
+// ==== HDF5ChunkedSeriesBase: counters, independent of datum type
+
+class HDF5ChunkedSeriesBase {
+public:
+
+  HDF5ChunkedSeriesBase(): m_nsStalled {}, m_nChunks {} {}
+  virtual ~HDF5ChunkedSeriesBase() {}
+
+  // time spent in First/Next waiting on a chunk
+  std::chrono::nanoseconds Stalled() const { return std::chrono::nanoseconds( m_nsStalled.load() ); }
+  size_t ChunksRead() const { return m_nChunks.load(); }
+
+protected:
+  std::atomic<int64_t> m_nsStalled;
+  std::atomic<size_t> m_nChunks;
+private:
+};
+
+// ==== HDF5ChunkedSeries: First/Next cursor as in TimeSeries, suitable for MergeCarrier
+
+template<class DD>
+class HDF5ChunkedSeries: public HDF5ChunkedSeriesBase {
+public:
+
+  using datum_t = DD;
+  using size_type = size_t;
+
+  HDF5ChunkedSeries( HDF5ReadAhead&, const std::string& sPath, size_type nChunk = 4096 ); // throws std::runtime_error
+  virtual ~HDF5ChunkedSeries();
+
+  size_type Size() const { return m_nSize; }
+
+  // pointer is valid until the chunk is exhausted by Next
+  const DD* First();
+  const DD* Next(); // a failed read ahead is rethrown here
+
+protected:
+private:
+
+  struct Chunk {
+    std::vector<DD> vDatum;
+    size_type nDatum;
+    Chunk(): nDatum {} {}
+  };
+
+  HDF5ReadAhead& m_ra;
+  std::unique_ptr<HDF5TimeSeriesAccessor<DD> > m_pAccessor; // created and destroyed on the read ahead thread
+
+  const size_type m_nChunk;
+  size_type m_nSize;
+
+  Chunk m_rChunk[ 2 ];
+  Chunk* m_pFront; // being consumed
+  Chunk* m_pBack;  // being filled
+  size_type m_ixCursor; // into front
+  size_type m_ixDisk;   // next element to be read
+
+  std::mutex m_mutexBack;
+  std::condition_variable m_cvBack;
+  bool m_bBackPending; // fill requested, not yet consumed
+  bool m_bBackReady;
+  std::exception_ptr m_pBackException; // from Fill on the read ahead thread
+
+  void Fill( Chunk&, size_type ixDisk ); // on read ahead thread
+  void RequestBack();
+  void WaitBack( bool bConsume ); // when consuming, counts the stall and rethrows a failed fill
+
+};
+
+template<class DD>
+HDF5ChunkedSeries<DD>::HDF5ChunkedSeries( HDF5ReadAhead& ra, const std::string& sPath, size_type nChunk )
+: HDF5ChunkedSeriesBase()
+, m_ra( ra ), m_nChunk( nChunk ), m_nSize {}
+, m_pFront( &m_rChunk[ 0 ] ), m_pBack( &m_rChunk[ 1 ] )
+, m_ixCursor {}, m_ixDisk {}
+, m_bBackPending( false ), m_bBackReady( false )
+{
+  assert( 0 < nChunk );
+  m_ra.Call(
+    [this,&sPath](){
+      m_pAccessor = std::make_unique<HDF5TimeSeriesAccessor<DD> >( m_ra.DataManager(), sPath );
+      m_nSize = m_pAccessor->size();
+    } );
+  for ( Chunk& chunk: m_rChunk ) {
+    chunk.vDatum.resize( std::min( m_nChunk, m_nSize ) );
+  }
+}
+
+template<class DD>
+HDF5ChunkedSeries<DD>::~HDF5ChunkedSeries() {
+  WaitBack( false );
+  m_ra.Call( [this](){ m_pAccessor.reset(); } );
+}
+
+template<class DD>
+void HDF5ChunkedSeries<DD>::Fill( Chunk& chunk, size_type ixDisk ) {
+  const hsize_t n = std::min( m_nChunk, m_nSize - ixDisk );
+  if ( 0 < n ) {
+    H5::DataSpace dsMemory( 1, &n );
+    dsMemory.selectAll();
+    m_pAccessor->Read( ixDisk, n, &dsMemory, chunk.vDatum.data() );
+    dsMemory.close();
+    m_nChunks++;
+  }
+  chunk.nDatum = n;
+}
+
+template<class DD>
+void HDF5ChunkedSeries<DD>::RequestBack() {
+  if ( m_nSize <= m_ixDisk ) return; // nothing further to read
+  const size_type ixDisk( m_ixDisk );
+  m_ixDisk = std::min( m_nSize, m_ixDisk + m_nChunk );
+  {
+    std::scoped_lock<std::mutex> lock( m_mutexBack );
+    m_bBackPending = true;
+    m_bBackReady = false;
+    m_pBackException = nullptr;
+  }
+  Chunk* pChunk( m_pBack );
+  m_ra.Post(
+    [this,pChunk,ixDisk](){
+      std::exception_ptr pException;
+      try {
+        Fill( *pChunk, ixDisk );
+      }
+      catch ( ... ) { // an exception escaping here would end the read ahead thread
+        pChunk->nDatum = 0;
+        pException = std::current_exception();
+      }
+      std::scoped_lock<std::mutex> lock( m_mutexBack );
+      m_pBackException = pException;
+      m_bBackReady = true;
+      m_cvBack.notify_one();
+    } );
+}
+
+template<class DD>
+void HDF5ChunkedSeries<DD>::WaitBack( bool bConsume ) {
+  std::unique_lock<std::mutex> lock( m_mutexBack );
+  if ( m_bBackPending && !m_bBackReady ) {
+    const auto start = std::chrono::steady_clock::now();
+    m_cvBack.wait( lock, [this]{ return m_bBackReady; } );
+    if ( bConsume ) {
+      m_nsStalled += std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start ).count();
+    }
+  }
+  if ( m_pBackException ) {
+    std::exception_ptr pException( m_pBackException );
+    m_pBackException = nullptr;
+    if ( bConsume ) {
+      m_bBackPending = false; // series ends, a following First starts over
+      std::rethrow_exception( pException );
+    }
+  }
+}
+
+template<class DD>
+const DD* HDF5ChunkedSeries<DD>::First() {
+
+  WaitBack( false ); // discard any read ahead from a previous pass
+  m_bBackPending = false;
+
+  const auto start = std::chrono::steady_clock::now();
+  m_ra.Call( [this](){ Fill( *m_pFront, 0 ); } );
+  m_nsStalled += std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start ).count();
+
+  m_ixCursor = 0;
+  m_ixDisk = m_pFront->nDatum;
+  RequestBack();
+
+  return ( 0 == m_pFront->nDatum ) ? nullptr : &m_pFront->vDatum[ 0 ];
+}
+
+template<class DD>
+const DD* HDF5ChunkedSeries<DD>::Next() {
+  ++m_ixCursor;
+  if ( m_ixCursor < m_pFront->nDatum ) {
+    return &m_pFront->vDatum[ m_ixCursor ];
+  }
+  if ( !m_bBackPending ) return nullptr; // series complete
+
+  WaitBack( true ); // throws on a failed read ahead
+  m_bBackPending = false;
+  std::swap( m_pFront, m_pBack );
+  m_ixCursor = 0;
+  RequestBack();
+
+  return ( 0 == m_pFront->nDatum ) ? nullptr : &m_pFront->vDatum[ 0 ];
+}
+
+} // namespace tf
+} // namespace ou
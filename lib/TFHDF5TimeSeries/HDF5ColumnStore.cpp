@@ -0,0 +1,109 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    HDF5ColumnStore.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFHDF5TimeSeries
+ * Created: October 17, 2026 12:05
+ */
+
+#include <iostream>
+
+#include <boost/filesystem.hpp>
+
+#include <TFTimeSeries/ColumnStore.h>
+
+#include "HDF5IterateGroups.h"
+#include "HDF5TimeSeriesContainer.h"
+
+#include "HDF5ColumnStore.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace hdf5 {
+
+ColumnStoreExport::ColumnStoreExport( HDF5DataManager& dm, const std::string& sDirectory, const std::string& sBaseGroup )
+: m_dm( dm ), m_sDirectory( sDirectory ), m_sBaseGroup( sBaseGroup )
+{}
+
+ColumnStoreExport::Stats ColumnStoreExport::Run() {
+  m_stats = Stats();
+  ExportGroup<Quotes>();
+  ExportGroup<Trades>();
+  ExportGroup<Bars>();
+  return m_stats;
+}
+
+template<typename Series>
+void ColumnStoreExport::ExportGroup() {
+  const std::string sGroup( m_sBaseGroup + Series::Directory() );
+  if ( !m_dm.GroupExists( sGroup ) ) return;
+  IterateGroups ig(
+    m_dm, sGroup,
+    []( const std::string&, const std::string& ){}, // sub directories are created as files are written
+    [this]( const std::string& sObjectPath, const std::string& ){ ExportSeries<Series>( sObjectPath ); }
+    );
+}
+
+template<typename Series>
+void ColumnStoreExport::ExportSeries( const std::string& sObjectPath ) {
+
+  using datum_t = typename Series::datum_t;
+
+  Series series;
+  try {
+    HDF5TimeSeriesContainer<datum_t> repository( m_dm, sObjectPath );
+    typename HDF5TimeSeriesContainer<datum_t>::iterator begin, end;
+    begin = repository.begin();
+    end = repository.end();
+    series.Resize( end - begin );
+    repository.Read( begin, end, &series );
+  }
+  catch ( std::runtime_error& e ) {
+    std::cerr << "ColumnStoreExport " << sObjectPath << " skipped: " << e.what() << std::endl;
+    m_stats.nSkipped++;
+    return;
+  }
+  m_stats.nSeries++;
+
+  // sObjectPath is relative to the file root, so is kept below m_sDirectory
+  const boost::filesystem::path pathBase( m_sDirectory + sObjectPath.substr( m_sBaseGroup.size() ) );
+  boost::filesystem::create_directories( pathBase.parent_path() );
+
+  // one file per day
+  typename Series::const_iterator iterBegin = series.begin();
+  while ( series.end() != iterBegin ) {
+    const boost::gregorian::date date( iterBegin->DateTime().date() );
+    typename Series::const_iterator iterEnd = iterBegin;
+    while ( ( series.end() != iterEnd ) && ( date == iterEnd->DateTime().date() ) ) iterEnd++;
+
+    const std::string sPath( pathBase.string() + '.' + boost::gregorian::to_iso_string( date ) + ".cs" );
+    try {
+      WriteColumnStore<datum_t>( sPath, iterBegin, iterEnd );
+      m_stats.nFiles++;
+      m_stats.nDatums += iterEnd - iterBegin;
+    }
+    catch ( std::runtime_error& e ) { // prices beyond the column store scale, or the file could not be written
+      std::cerr << "ColumnStoreExport " << sObjectPath << " skipped: " << e.what() << std::endl;
+      m_stats.nSkipped++;
+    }
+
+    iterBegin = iterEnd;
+  }
+}
+
+} // namespace hdf5
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,69 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    HDF5ColumnStore.h
+ * Author:  raymond@burkholder.net
+ * Project: TFHDF5TimeSeries
+ * Created: October 17, 2026 12:05
+ */
+
+#pragma once
+
+#include <string>
+
+#include "HDF5DataManager.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace hdf5 {
+
+// converts the /quotes/, /trades/ and /bars/ series below sBaseGroup into column store files,
+//   one file per symbol per day:  sDirectory/quotes/SPY.20240304.cs
+//   sub groups are carried over as sub directories
+
+class ColumnStoreExport {
+public:
+
+  struct Stats {
+    size_t nSeries;  // datasets read
+    size_t nFiles;   // symbol-day files written
+    size_t nDatums;
+    size_t nSkipped; // datasets which could not be read, days which could not be written
+    Stats(): nSeries {}, nFiles {}, nDatums {}, nSkipped {} {}
+  };
+
+  ColumnStoreExport( HDF5DataManager&, const std::string& sDirectory, const std::string& sBaseGroup = "" );
+
+  Stats Run();
+
+protected:
+private:
+
+  HDF5DataManager& m_dm;
+  const std::string m_sDirectory;
+  const std::string m_sBaseGroup;
+
+  Stats m_stats;
+
+  template<typename Series>
+  void ExportGroup();
+
+  template<typename Series>
+  void ExportSeries( const std::string& sObjectPath );
+};
+
+} // namespace hdf5
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,245 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// column store round trip:  synthetic quotes and trades over two days are written to a scratch hdf5 file,
+//   ColumnStoreExport converts them to symbol-day files, which are read back through ColumnStoreView and
+//   compared datum by datum with the hdf5 series; hdf5 and column store read rates are reported.
+//   Writer checks:  times keep the resolution of ptime, a price beyond 8 digits fails Save
+//   usage: TFHDF5TimeSeriesColumnStore [datums per series per day]
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <boost/filesystem.hpp>
+
+#include <TFTimeSeries/TimeSeries.h>
+#include <TFTimeSeries/ColumnStore.h>
+
+#include <TFHDF5TimeSeries/HDF5DataManager.h>
+#include <TFHDF5TimeSeries/HDF5ColumnStore.h>
+#include <TFHDF5TimeSeries/HDF5WriteTimeSeries.h>
+#include <TFHDF5TimeSeries/HDF5TimeSeriesContainer.h>
+
+namespace {
+
+using clock_t_ = std::chrono::steady_clock;
+
+const std::string sBaseGroup( "/bench" );
+const char* rszSymbol[] = { "SPY", "QQQ" };
+const boost::gregorian::date rDate[] = { boost::gregorian::date( 2026, 10, 15 ), boost::gregorian::date( 2026, 10, 16 ) };
+
+double Seconds( clock_t_::time_point start ) {
+  return std::chrono::duration<double>( clock_t_::now() - start ).count();
+}
+
+// microsecond times through the session, prices on a penny grid, some sub-penny
+void Synthesize( size_t nPerDay, ou::tf::Quotes& quotes, ou::tf::Trades& trades, std::mt19937_64& rng ) {
+  for ( const boost::gregorian::date& date: rDate ) {
+    const boost::posix_time::ptime dtOpen( date, boost::posix_time::time_duration( 13, 30, 0 ) );
+    int64_t nCents = 50000;
+    int64_t us {};
+    for ( size_t ix = 0; ix < nPerDay; ++ix ) {
+      us += 1 + rng() % 20000;
+      nCents += int( rng() % 5 ) - 2;
+      const boost::posix_time::ptime dt( dtOpen + boost::posix_time::microseconds( us ) );
+      const double dblBid( nCents / 100.0 );
+      quotes.Append( ou::tf::Quote( dt, dblBid, 1 + rng() % 500, ( nCents + 1 + rng() % 3 ) / 100.0, 1 + rng() % 500 ) );
+      if ( 0 == ( ix % 3 ) ) {
+        const double dblPrice( ( 0 == ( rng() % 16 ) ) ? ( nCents * 100 + 50 ) / 10000.0 : dblBid ); // sub-penny prints
+        trades.Append( ou::tf::Trade( dt, dblPrice, 1 + rng() % 1000 ) );
+      }
+    }
+  }
+}
+
+template<typename Series>
+double ReadHdf5( ou::tf::HDF5DataManager& dm, const std::string& sPath, Series& series ) {
+  using datum_t = typename Series::datum_t;
+  const auto start = clock_t_::now();
+  ou::tf::HDF5TimeSeriesContainer<datum_t> repository( dm, sPath );
+  typename ou::tf::HDF5TimeSeriesContainer<datum_t>::iterator begin, end;
+  begin = repository.begin();
+  end = repository.end();
+  series.Resize( end - begin );
+  repository.Read( begin, end, &series );
+  return Seconds( start );
+}
+
+bool Same( const ou::tf::Quote& a, const ou::tf::Quote& b ) {
+  return ( a.DateTime() == b.DateTime() ) && ( a.Bid() == b.Bid() ) && ( a.Ask() == b.Ask() )
+    && ( a.BidSize() == b.BidSize() ) && ( a.AskSize() == b.AskSize() );
+}
+
+bool Same( const ou::tf::Trade& a, const ou::tf::Trade& b ) {
+  return ( a.DateTime() == b.DateTime() ) && ( a.Price() == b.Price() ) && ( a.Volume() == b.Volume() );
+}
+
+struct Rate {
+  size_t nDatums {};
+  double dblHdf5 {};
+  double dblColumn {};
+  size_t nMismatch {};
+};
+
+// every symbol-day file against the hdf5 series it came from
+template<typename Series>
+void Compare( ou::tf::HDF5DataManager& dm, const std::string& sDirectory, Rate& rate ) {
+  using datum_t = typename Series::datum_t;
+  for ( const char* szSymbol: rszSymbol ) {
+    Series series;
+    rate.dblHdf5 += ReadHdf5( dm, sBaseGroup + Series::Directory() + szSymbol, series );
+    size_t ix {};
+    for ( const boost::gregorian::date& date: rDate ) {
+      const std::string sPath( sDirectory + Series::Directory() + szSymbol + '.' + boost::gregorian::to_iso_string( date ) + ".cs" );
+      const auto start = clock_t_::now();
+      ou::tf::ColumnStoreView<datum_t> view( sPath );
+      for ( const datum_t* p = view.First(); nullptr != p; p = view.Next() ) {
+        if ( ( series.Size() <= ix ) || !Same( *p, series[ ix ] ) ) rate.nMismatch++;
+        ++ix;
+      }
+      rate.dblColumn += Seconds( start );
+    }
+    if ( series.Size() != ix ) rate.nMismatch += ( series.Size() > ix ) ? series.Size() - ix : ix - series.Size();
+    rate.nDatums += ix;
+  }
+}
+
+void Report( const char* szName, const Rate& rate ) {
+  std::cout
+    << szName << ": " << rate.nDatums << " datums, "
+    << "hdf5 " << 1e9 * rate.dblHdf5 / rate.nDatums << " ns/datum, "
+    << "column store " << 1e9 * rate.dblColumn / rate.nDatums << " ns/datum, "
+    << rate.nMismatch << " mismatched"
+    << std::endl;
+}
+
+bool WriterChecks( const boost::filesystem::path& pathDirectory ) {
+
+  bool bOk( true );
+  const std::string sPath( ( pathDirectory / "writer.cs" ).string() );
+
+  // time at the resolution of ptime
+  const int64_t ns( 1792158600123456789ll );
+  {
+    ou::tf::cs::Writer writer( ou::tf::cs::EDatum::Trade, 1, 1 );
+    const double dblPrice( 500.25 );
+    const uint64_t nVolume( 100 );
+    writer.Append( ns, &dblPrice, &nVolume );
+    writer.Save( sPath );
+  }
+  const ou::tf::ColumnStoreView<ou::tf::Trade> view( sPath );
+  const int64_t nsResolution( std::max<int64_t>( 1, 1000000000 / boost::posix_time::time_duration::ticks_per_second() ) );
+  auto tick = [nsResolution]( int64_t n )->int64_t { // the earlier tick
+    int64_t q( n / nsResolution );
+    if ( 0 > ( n % nsResolution ) ) q--;
+    return q * nsResolution;
+  };
+  const int64_t nsRead( ou::tf::cs::ToNanoseconds( view.At( 0 ).DateTime() ) );
+  if ( tick( ns ) != nsRead ) {
+    std::cout << "time " << ns << " read as " << nsRead << std::endl;
+    bOk = false;
+  }
+  const int64_t nsBefore( -1500 );
+  if ( tick( nsBefore ) != ou::tf::cs::ToNanoseconds( ou::tf::cs::FromNanoseconds( nsBefore ) ) ) {
+    std::cout << "time " << nsBefore << " not truncated toward the earlier tick" << std::endl;
+    bOk = false;
+  }
+
+  // a price which no scale up to 8 digits holds
+  bool bThrown( false );
+  {
+    ou::tf::cs::Writer writer( ou::tf::cs::EDatum::Trade, 1, 1 );
+    const double dblPrice( 1.0 / 3.0 );
+    const uint64_t nVolume( 1 );
+    writer.Append( ns, &dblPrice, &nVolume );
+    try {
+      writer.Save( ( pathDirectory / "inexact.cs" ).string() );
+    }
+    catch ( const std::runtime_error& e ) {
+      bThrown = true;
+      std::cout << "inexact price: " << e.what() << std::endl;
+    }
+  }
+  if ( !bThrown ) {
+    std::cout << "inexact price was saved" << std::endl;
+    bOk = false;
+  }
+
+  return bOk;
+}
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nPerDay = ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 500000;
+
+  const boost::filesystem::path pathDirectory( boost::filesystem::temp_directory_path() / boost::filesystem::unique_path( "column-store-%%%%%%%%" ) );
+  boost::filesystem::create_directories( pathDirectory );
+  const std::string sHdf5( ( pathDirectory / "bench.hdf5" ).string() );
+  const std::string sColumns( ( pathDirectory / "cs" ).string() );
+
+  bool bOk( true );
+
+  try {
+
+    ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RDWR, sHdf5 );
+
+    std::mt19937_64 rng( 42 );
+    for ( const char* szSymbol: rszSymbol ) {
+      ou::tf::Quotes quotes;
+      ou::tf::Trades trades;
+      Synthesize( nPerDay, quotes, trades, rng );
+      ou::tf::HDF5WriteTimeSeries<ou::tf::Quotes> wtsQuotes( dm, true, true, 5, 1024 );
+      wtsQuotes.Write( sBaseGroup + ou::tf::Quotes::Directory() + szSymbol, &quotes );
+      ou::tf::HDF5WriteTimeSeries<ou::tf::Trades> wtsTrades( dm, true, true, 5, 1024 );
+      wtsTrades.Write( sBaseGroup + ou::tf::Trades::Directory() + szSymbol, &trades );
+    }
+    dm.Flush();
+
+    const auto start = clock_t_::now();
+    ou::tf::hdf5::ColumnStoreExport exporter( dm, sColumns, sBaseGroup );
+    const ou::tf::hdf5::ColumnStoreExport::Stats stats( exporter.Run() );
+    const double dblExport( Seconds( start ) );
+    std::cout
+      << "export: " << stats.nSeries << " series, " << stats.nFiles << " files, " << stats.nDatums << " datums, "
+      << stats.nSkipped << " skipped, " << 1e9 * dblExport / stats.nDatums << " ns/datum"
+      << std::endl;
+    if ( ( 4 != stats.nSeries ) || ( 8 != stats.nFiles ) || ( 0 != stats.nSkipped ) ) bOk = false;
+
+    Rate rateQuotes;
+    Compare<ou::tf::Quotes>( dm, sColumns, rateQuotes );
+    Report( "quotes", rateQuotes );
+    Rate rateTrades;
+    Compare<ou::tf::Trades>( dm, sColumns, rateTrades );
+    Report( "trades", rateTrades );
+    if ( ( 0 != rateQuotes.nMismatch ) || ( 0 != rateTrades.nMismatch ) ) bOk = false;
+
+    if ( !WriterChecks( pathDirectory ) ) bOk = false;
+  }
+  catch ( const std::exception& e ) {
+    std::cout << "failed: " << e.what() << std::endl;
+    bOk = false;
+  }
+
+  boost::system::error_code ec;
+  boost::filesystem::remove_all( pathDirectory, ec );
+
+  std::cout << ( bOk ? "round trip matches" : "round trip failed" ) << std::endl;
+  return bOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
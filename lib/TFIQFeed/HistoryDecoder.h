@@ -0,0 +1,277 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    HistoryDecoder.h
+ * Author:  raymond@burkholder.net
+ * Project: TFIQFeed
+ * Created: October 17, 2026 21:25
+ */
+
+#pragma once
+
+// fixed format decoding of the historical data records, in place of the spirit grammars:
+//   the record is the line following the request id and comma, ie 'LH,2023-06-28 09:30:00.123456,...'
+//   dates and times are read at fixed widths, integers are accumulated directly,
+//   a decimal is its integer mantissa divided by a power of ten, a single rounding, so the same double as strtod
+//   records of a response generally share a date, the last one is kept to skip the calendar arithmetic
+//   false is returned on anything outside the format, HistoryQuery then falls back to its grammar
+
+#include <limits>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <string_view>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include "HistoryStructs.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+
+class HistoryDecoder {
+public:
+
+  using TickDataPoint = HistoryStructs::TickDataPoint;
+  using Interval      = HistoryStructs::Interval;
+  using EndOfDay      = HistoryStructs::EndOfDay;
+
+  HistoryDecoder()
+  : m_nYear {}, m_nMonth {}, m_nDay {}
+  {
+    std::memset( m_rDate, 0, sizeof( m_rDate ) );
+  }
+
+  bool Decode( std::string_view, TickDataPoint& );
+  bool Decode( std::string_view, Interval& );
+  bool Decode( std::string_view, EndOfDay& );
+
+protected:
+private:
+
+  class Cursor {
+  public:
+
+    explicit Cursor( std::string_view sv ): m_p( sv.data() ), m_end( sv.data() + sv.size() ) {}
+
+    bool Done() const { return m_end == m_p; }
+
+    const char* Position() const { return m_p; }
+    bool Remaining( size_t n ) const { return n <= size_t( m_end - m_p ); }
+    void Skip( size_t n ) { assert( Remaining( n ) ); m_p += n; }
+
+    bool Literal( char ch ) {
+      if ( ( m_end != m_p ) && ( ch == *m_p ) ) {
+        ++m_p;
+        return true;
+      }
+      return false;
+    }
+
+    // a run of digits, appended to value, returns the count
+    unsigned int Run( uint64_t& value ) {
+      const char* begin( m_p );
+      while ( m_end != m_p ) {
+        const unsigned int d = *m_p - '0';
+        if ( 9 < d ) break;
+        value = 10 * value + d;
+        ++m_p;
+      }
+      return m_p - begin;
+    }
+
+    template<typename U>
+    bool Digits( unsigned int n, U& value ) { // exactly n digits
+      uint64_t v {};
+      if ( n != Run( v ) ) return false;
+      value = v;
+      return true;
+    }
+
+    bool Time( unsigned short& hour, unsigned short& minute, unsigned short& second ) { // hh:mm:ss
+      return
+           Digits( 2, hour ) && Literal( ':' )
+        && Digits( 2, minute ) && Literal( ':' )
+        && Digits( 2, second )
+        && ( 24 > hour ) && ( 60 > minute ) && ( 60 > second );
+    }
+
+    // the field formats, each consumes the trailing comma
+
+    template<typename U>
+    bool Unsigned( U& value ) {
+      uint64_t v {};
+      const unsigned int nDigits( Run( v ) );
+      if ( ( 0 == nDigits ) || ( 19 < nDigits ) ) return false;
+      if ( std::numeric_limits<U>::max() < v ) return false;
+      value = v;
+      return Literal( ',' );
+    }
+
+    bool Decimal( double& value ) { // [-]digits[.digits]
+      const char* begin( m_p );
+      const bool bNegative( Literal( '-' ) );
+      uint64_t mantissa {};
+      unsigned int nDigits( Run( mantissa ) );
+      unsigned int nScale {};
+      if ( Literal( '.' ) ) {
+        nScale = Run( mantissa );
+        nDigits += nScale;
+      }
+      if ( 0 == nDigits ) return false;
+      if ( c_nExactDigits < nDigits ) { // mantissa no longer exact
+        const std::from_chars_result result = std::from_chars( begin, m_end, value );
+        if ( ( std::errc() != result.ec ) || ( m_p != result.ptr ) ) return false;
+      }
+      else {
+        value = (double)mantissa / c_rPow10[ nScale ];
+        if ( bNegative ) value = -value;
+      }
+      return Literal( ',' );
+    }
+
+    bool Character( char& ch ) {
+      if ( !Remaining( 2 ) || ( ',' != m_p[ 1 ] ) ) return false;
+      ch = *m_p;
+      m_p += 2;
+      return true;
+    }
+
+    bool Hex( std::string_view& sv ) { // one or more of 0-9A-F
+      const char* begin( m_p );
+      while ( ( m_end != m_p ) && ( ( ( '0' <= *m_p ) && ( '9' >= *m_p ) ) || ( ( 'A' <= *m_p ) && ( 'F' >= *m_p ) ) ) ) ++m_p;
+      if ( begin == m_p ) return false;
+      sv = std::string_view( begin, m_p - begin );
+      return Literal( ',' );
+    }
+
+  private:
+    static constexpr unsigned int c_nExactDigits = 15; // 10^15 < 2^53
+    static constexpr double c_rPow10[ c_nExactDigits + 1 ] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15
+    };
+    const char* m_p;
+    const char* const m_end;
+  };
+
+  char m_rDate[ 10 ]; // yyyy-mm-dd of the last record
+  unsigned short m_nYear;
+  unsigned short m_nMonth;
+  unsigned short m_nDay;
+  boost::gregorian::date m_date;
+
+  static bool Prefix( Cursor& cursor ) {
+    return cursor.Literal( 'L' ) && cursor.Literal( 'H' ) && cursor.Literal( ',' );
+  }
+
+  bool Date( Cursor&, unsigned short& year, unsigned short& month, unsigned short& day );
+};
+
+inline bool HistoryDecoder::Date( Cursor& cursor, unsigned short& year, unsigned short& month, unsigned short& day ) {
+  if ( !cursor.Remaining( sizeof( m_rDate ) ) ) return false;
+  const char* pDate( cursor.Position() );
+  if ( 0 != std::memcmp( m_rDate, pDate, sizeof( m_rDate ) ) ) {
+    unsigned short nYear, nMonth, nDay;
+    if ( !(
+         cursor.Digits( 4, nYear ) && cursor.Literal( '-' )
+      && cursor.Digits( 2, nMonth ) && cursor.Literal( '-' )
+      && cursor.Digits( 2, nDay )
+    ) ) return false;
+    if ( ( 1400 > nYear ) || ( 1 > nMonth ) || ( 12 < nMonth ) || ( 1 > nDay ) ) return false;
+    if ( boost::gregorian::gregorian_calendar::end_of_month_day( nYear, nMonth ) < nDay ) return false;
+    m_date = boost::gregorian::date( nYear, nMonth, nDay );
+    m_nYear = nYear;
+    m_nMonth = nMonth;
+    m_nDay = nDay;
+    std::memcpy( m_rDate, pDate, sizeof( m_rDate ) );
+  }
+  else {
+    cursor.Skip( sizeof( m_rDate ) );
+  }
+  year = m_nYear;
+  month = m_nMonth;
+  day = m_nDay;
+  return true;
+}
+
+inline bool HistoryDecoder::Decode( std::string_view sv, TickDataPoint& dp ) {
+  Cursor cursor( sv );
+  std::string_view svConditions;
+  if ( !(
+       Prefix( cursor )
+    && Date( cursor, dp.Year, dp.Month, dp.Day )
+    && cursor.Literal( ' ' )
+    && cursor.Time( dp.Hour, dp.Minute, dp.Second )
+    && cursor.Literal( '.' ) && cursor.Digits( 6, dp.Micro ) && cursor.Literal( ',' )
+    && cursor.Decimal( dp.Last )
+    && cursor.Unsigned( dp.LastSize )
+    && cursor.Unsigned( dp.TotalVolume )
+    && cursor.Decimal( dp.Bid )
+    && cursor.Decimal( dp.Ask )
+    && cursor.Unsigned( dp.TickID )
+    && cursor.Character( dp.BasisForLast )
+    && cursor.Unsigned( dp.MarketCenter )
+    && cursor.Hex( svConditions )
+    && cursor.Unsigned( dp.TradeAggressor )
+    && cursor.Unsigned( dp.DayCode )
+    && cursor.Done()
+  ) ) return false;
+  dp.sTradeConditions.assign( svConditions.data(), svConditions.size() );
+  dp.DateTime = boost::posix_time::ptime( m_date, boost::posix_time::time_duration( dp.Hour, dp.Minute, dp.Second, dp.Micro ) );
+  return true;
+}
+
+inline bool HistoryDecoder::Decode( std::string_view sv, Interval& dp ) {
+  Cursor cursor( sv );
+  if ( !(
+       Prefix( cursor )
+    && Date( cursor, dp.Year, dp.Month, dp.Day )
+    && cursor.Literal( ' ' )
+    && cursor.Time( dp.Hour, dp.Minute, dp.Second ) && cursor.Literal( ',' )
+    && cursor.Decimal( dp.High )
+    && cursor.Decimal( dp.Low )
+    && cursor.Decimal( dp.Open )
+    && cursor.Decimal( dp.Close )
+    && cursor.Unsigned( dp.TotalVolume )
+    && cursor.Unsigned( dp.PeriodVolume )
+    && cursor.Unsigned( dp.NumberOfTrades )
+    && cursor.Done()
+  ) ) return false;
+  dp.DateTime = boost::posix_time::ptime( m_date, boost::posix_time::time_duration( dp.Hour, dp.Minute, dp.Second ) );
+  return true;
+}
+
+inline bool HistoryDecoder::Decode( std::string_view sv, EndOfDay& dp ) {
+  Cursor cursor( sv );
+  if ( !(
+       Prefix( cursor )
+    && Date( cursor, dp.Year, dp.Month, dp.Day ) && cursor.Literal( ',' )
+    && cursor.Decimal( dp.High )
+    && cursor.Decimal( dp.Low )
+    && cursor.Decimal( dp.Open )
+    && cursor.Decimal( dp.Close )
+    && cursor.Unsigned( dp.PeriodVolume )
+    && cursor.Unsigned( dp.OpenInterest )
+    && cursor.Done()
+  ) ) return false;
+  dp.DateTime = boost::posix_time::ptime( m_date, boost::posix_time::time_duration( 23, 59, 59 ) );
+  return true;
+}
+
+} // namespace iqfeed
+} // namespace tf
+} // namespace ou
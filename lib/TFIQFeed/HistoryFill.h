@@ -0,0 +1,330 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    HistoryFill.h
+ * Author:  raymond@burkholder.net
+ * Project: TFIQFeed
+ * Created: October 17, 2026 21:25
+ */
+
+#pragma once
+
+// bulk form of HistoryQuery, for loading history into time series:
+//   the connection runs in line view mode, records are decoded in place in the receive buffer,
+//   and appended straight into the caller's series, there are no per record callbacks
+//   ticks become a Quote (bid, ask) and a Trade (last, last size), as in HistoryBulkQuery
+//   intervals and end of days become a Bar, with the period volume
+//   the series are reserved for n more when a request is for n datums,
+//   they must remain in place until OnHistoryRequestDone
+//   there is no grammar fallback, as in HistoryQuery: a record outside the fixed format fails the request,
+//   as does an error record ( 'E,!NO_DATA!', 'E,Invalid symbol' ), reported once the '!ENDMSG!' following it arrives
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+#include <boost/log/trivial.hpp>
+
+#include <boost/thread/thread.hpp>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <OUCommon/Network.h>
+
+#include <TFTimeSeries/TimeSeries.h>
+
+#include "HistoryDecoder.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+
+template <typename T> // T: CRTP inheriting class
+class HistoryFill: public ou::Network<HistoryFill<T> > {
+  friend ou::Network<HistoryFill<T> >;
+public:
+
+  HistoryFill(); // local IQFeed history port
+  HistoryFill( const std::string& sAddress, unsigned short nPort );
+  virtual ~HistoryFill();
+
+  void RetrieveNDataPoints( const std::string& sSymbol, unsigned int n, ou::tf::Quotes&, ou::tf::Trades& );  // HTX ticks
+  void RetrieveNDaysOfDataPoints( const std::string& sSymbol, unsigned int n, ou::tf::Quotes&, ou::tf::Trades& ); // HTD ticks
+
+  void RetrieveNIntervals( const std::string& sSymbol, unsigned int i, unsigned int n, ou::tf::Bars& );  // HIX i=interval in seconds
+  void RetrieveNDaysOfIntervals( const std::string& sSymbol, unsigned int i, unsigned int n, ou::tf::Bars& ); // HID i=interval in seconds
+
+  void RetrieveNEndOfDays( const std::string& sSymbol, unsigned int n, ou::tf::Bars& );  // HDX
+
+  size_t Datums() const { return m_nDatums; }     // appended by the current or last request
+  size_t Rejected() const { return m_nRejected; } // records of the current or last request which did not decode, fails the request
+
+protected:
+
+  using inherited_t = typename ou::Network<HistoryFill<T> >;
+  using lineview_t = typename inherited_t::lineview_t;
+
+  enum class ERetrieval {  // activity in progress on this port
+    Idle,
+    DataPoints,  // ticks are arriving
+    Intervals,   // intervals are arriving
+    EndOfDays    // end of days are arriving
+  } m_stateRetrieval;
+
+  // called by Network via CRTP
+  void OnNetworkConnected() {
+    this->Send( "S,SET PROTOCOL,6.2\n" );
+    if ( &HistoryFill<T>::OnHistoryConnected != &T::OnHistoryConnected ) {
+      static_cast<T*>( this )->OnHistoryConnected();
+    }
+  };
+  void OnNetworkDisconnected() {
+    if ( &HistoryFill<T>::OnHistoryDisconnected != &T::OnHistoryDisconnected ) {
+      static_cast<T*>( this )->OnHistoryDisconnected();
+    }
+  };
+  void OnNetworkError( size_t e ) {
+    if ( &HistoryFill<T>::OnHistoryError != &T::OnHistoryError ) {
+      static_cast<T*>( this )->OnHistoryError( e );
+    }
+  };
+  void OnNetworkLineView( lineview_t );
+
+  // CRTP based dummy callbacks
+  void OnHistoryConnected() {};
+  void OnHistoryDisconnected() {};
+  void OnHistoryError( size_t ) {};
+  void OnHistoryRequestDone( bool /* bOk */ ) {}; // the series are released to the caller
+
+private:
+
+  static const char c_chCmdSystem;
+
+  static const char c_chRidTick;
+  static const char c_chRidInterval;
+  static const char c_chRidEndOfDay;
+
+  static const size_t c_nMillisecondsToSleep;
+
+  HistoryDecoder m_decoder;
+
+  // reused for each record, the trade conditions string keeps its capacity
+  HistoryDecoder::TickDataPoint m_tick;
+  HistoryDecoder::Interval m_interval;
+  HistoryDecoder::EndOfDay m_eod;
+
+  ou::tf::Quotes* m_pQuotes;
+  ou::tf::Trades* m_pTrades;
+  ou::tf::Bars* m_pBars;
+
+  size_t m_nDatums;
+  size_t m_nRejected;
+  bool m_bError; // an error record arrived, the request completes with '!ENDMSG!'
+
+  void CheckIdle( const char* szName ) const;
+  void Start( ERetrieval, const std::string& sCommand );
+  void Record( std::string_view );
+  void Done( bool bOk );
+
+};
+
+template <typename T>
+HistoryFill<T>::HistoryFill()
+: ou::Network<HistoryFill<T> >( "127.0.0.1", 9100 )
+, m_stateRetrieval( ERetrieval::Idle )
+, m_pQuotes( nullptr ), m_pTrades( nullptr ), m_pBars( nullptr )
+, m_nDatums {}, m_nRejected {}, m_bError( false )
+{
+}
+
+template <typename T>
+HistoryFill<T>::HistoryFill( const std::string& sAddress, unsigned short nPort )
+: ou::Network<HistoryFill<T> >( sAddress, nPort )
+, m_stateRetrieval( ERetrieval::Idle )
+, m_pQuotes( nullptr ), m_pTrades( nullptr ), m_pBars( nullptr )
+, m_nDatums {}, m_nRejected {}, m_bError( false )
+{
+}
+
+template <typename T>
+HistoryFill<T>::~HistoryFill() {
+}
+
+template <typename T>
+void HistoryFill<T>::CheckIdle( const char* szName ) const {
+  if ( ERetrieval::Idle != m_stateRetrieval ) {
+    throw std::logic_error( std::string( "HistoryFill<T>::" ) + szName + ": not in IDLE" );
+  }
+}
+
+template <typename T>
+void HistoryFill<T>::Start( ERetrieval state, const std::string& sCommand ) {
+  m_stateRetrieval = state;
+  m_nDatums = 0;
+  m_nRejected = 0;
+  m_bError = false;
+  boost::this_thread::sleep( boost::posix_time::milliseconds( c_nMillisecondsToSleep ) );
+  this->Send( sCommand );
+}
+
+template <typename T>
+void HistoryFill<T>::RetrieveNDataPoints( const std::string& sSymbol, unsigned int n, ou::tf::Quotes& quotes, ou::tf::Trades& trades ) {
+  CheckIdle( "RetrieveNDataPoints" );
+  quotes.Reserve( quotes.Size() + n );
+  trades.Reserve( trades.Size() + n );
+  m_pQuotes = &quotes;
+  m_pTrades = &trades;
+  std::stringstream ss;
+  ss << "HTX," << sSymbol << "," << n << ",1," << c_chRidTick << "\n";
+  Start( ERetrieval::DataPoints, ss.str() );
+}
+
+template <typename T>
+void HistoryFill<T>::RetrieveNDaysOfDataPoints( const std::string& sSymbol, unsigned int n, ou::tf::Quotes& quotes, ou::tf::Trades& trades ) {
+  CheckIdle( "RetrieveNDaysOfDataPoints" );
+  m_pQuotes = &quotes;
+  m_pTrades = &trades;
+  std::stringstream ss;
+  ss << "HTD," << sSymbol << "," << n << ",,,,1," << c_chRidTick << "\n";
+  Start( ERetrieval::DataPoints, ss.str() );
+}
+
+template <typename T>
+void HistoryFill<T>::RetrieveNIntervals( const std::string& sSymbol, unsigned int i, unsigned int n, ou::tf::Bars& bars ) {
+  CheckIdle( "RetrieveNIntervals" );
+  bars.Reserve( bars.Size() + n );
+  m_pBars = &bars;
+  std::stringstream ss;
+  ss << "HIX," << sSymbol << "," << i << "," << n << ",1," << c_chRidInterval << "\n";
+  Start( ERetrieval::Intervals, ss.str() );
+}
+
+template <typename T>
+void HistoryFill<T>::RetrieveNDaysOfIntervals( const std::string& sSymbol, unsigned int i, unsigned int n, ou::tf::Bars& bars ) {
+  CheckIdle( "RetrieveNDaysOfIntervals" );
+  m_pBars = &bars;
+  std::stringstream ss;
+  ss << "HID," << sSymbol << "," << i << "," << n << ",,,,1," << c_chRidInterval << "\n";
+  Start( ERetrieval::Intervals, ss.str() );
+}
+
+template <typename T>
+void HistoryFill<T>::RetrieveNEndOfDays( const std::string& sSymbol, unsigned int n, ou::tf::Bars& bars ) {
+  CheckIdle( "RetrieveNEndOfDays" );
+  bars.Reserve( bars.Size() + n );
+  m_pBars = &bars;
+  std::stringstream ss;
+  ss << "HDX," << sSymbol << "," << n << ",1," << c_chRidEndOfDay << "\n";
+  Start( ERetrieval::EndOfDays, ss.str() );
+}
+
+template <typename T>
+void HistoryFill<T>::OnNetworkLineView( lineview_t line ) {
+
+  if ( 2 > line.size() ) return;
+
+  if ( ERetrieval::Idle == m_stateRetrieval ) {
+    if ( c_chCmdSystem != line[ 0 ] ) { // 'S,CURRENT PROTOCOL,6.2' is expected
+      BOOST_LOG_TRIVIAL(error) << "HistoryFill<T>::OnNetworkLineView Idle: " << line;
+    }
+    return;
+  }
+
+  if ( c_chCmdSystem == line[ 0 ] ) {
+    BOOST_LOG_TRIVIAL(info) << line;
+    return;
+  }
+
+  // end message is like: 'T,!ENDMSG!'
+  Record( line.substr( 2 ) );
+}
+
+template <typename T>
+void HistoryFill<T>::Record( std::string_view record ) {
+
+  bool bDecoded( false );
+  switch ( m_stateRetrieval ) {
+    case ERetrieval::DataPoints:
+      bDecoded = m_decoder.Decode( record, m_tick );
+      if ( bDecoded ) {
+        m_pQuotes->Append( ou::tf::Quote( m_tick.DateTime, m_tick.Bid, 0, m_tick.Ask, 0 ) );
+        m_pTrades->Append( ou::tf::Trade( m_tick.DateTime, m_tick.Last, m_tick.LastSize ) );
+      }
+      break;
+    case ERetrieval::Intervals:
+      bDecoded = m_decoder.Decode( record, m_interval );
+      if ( bDecoded ) {
+        m_pBars->Append( ou::tf::Bar( m_interval.DateTime, m_interval.Open, m_interval.High, m_interval.Low, m_interval.Close, m_interval.PeriodVolume ) );
+      }
+      break;
+    case ERetrieval::EndOfDays:
+      bDecoded = m_decoder.Decode( record, m_eod );
+      if ( bDecoded ) {
+        m_pBars->Append( ou::tf::Bar( m_eod.DateTime, m_eod.Open, m_eod.High, m_eod.Low, m_eod.Close, m_eod.PeriodVolume ) );
+      }
+      break;
+    case ERetrieval::Idle:
+      assert( false );
+      break;
+  }
+
+  if ( bDecoded ) {
+    ++m_nDatums;
+  }
+  else {
+    if ( "!ENDMSG!" == record.substr( 0, 8 ) ) {
+      Done( !m_bError && ( 0 == m_nRejected ) );
+    }
+    else {
+      if ( !record.empty() && ( 'E' == record[ 0 ] ) ) { // 'E,Invalid symbol', 'E,!NO_DATA!', then '!ENDMSG!'
+        BOOST_LOG_TRIVIAL(warning) << "HistoryFill<T>::Record " << record;
+        m_bError = true;
+      }
+      else {
+        if ( 0 == m_nRejected ) {
+          BOOST_LOG_TRIVIAL(error) << "HistoryFill<T>::Record not in the fixed format: " << record;
+        }
+        ++m_nRejected;
+      }
+    }
+  }
+}
+
+template <typename T>
+void HistoryFill<T>::Done( bool bOk ) {
+  if ( 0 < m_nRejected ) {
+    BOOST_LOG_TRIVIAL(warning) << "HistoryFill<T>::Done " << m_nRejected << " records rejected, " << m_nDatums << " appended";
+  }
+  m_stateRetrieval = ERetrieval::Idle;
+  m_pQuotes = nullptr;
+  m_pTrades = nullptr;
+  m_pBars = nullptr;
+  if ( &HistoryFill<T>::OnHistoryRequestDone != &T::OnHistoryRequestDone ) {
+    static_cast<T*>( this )->OnHistoryRequestDone( bOk );
+  }
+}
+
+template <typename T> const char   HistoryFill<T>::c_chCmdSystem( 'S' );
+
+template <typename T> const char   HistoryFill<T>::c_chRidTick( 'T' );
+template <typename T> const char   HistoryFill<T>::c_chRidInterval( 'I' );
+template <typename T> const char   HistoryFill<T>::c_chRidEndOfDay( 'O' );
+
+template <typename T> const size_t HistoryFill<T>::c_nMillisecondsToSleep( 75 );
+
+} // namespace iqfeed
+} // namespace tf
+} // namespace ou
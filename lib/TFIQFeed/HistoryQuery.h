@@ -19,8 +19,12 @@
 // todo:  put parsers in separate compilation units to cut down on compile time
 //    may not be possible based upon templating of the character type from the network buffer
 
+// records are decoded with HistoryDecoder, the spirit grammars remain for records outside its fixed format
+// HistoryFill is the bulk form, records go straight into time series without the per record callbacks
+
 #include <string>
 #include <sstream>
+#include <string_view>
 
 #include <boost/log/trivial.hpp>
 
@@ -38,73 +42,10 @@ namespace posix_time = boost::posix_time;
 #include <OUCommon/ReusableBuffers.h>
 #include <OUCommon/Network.h>
 
-namespace qi = boost::spirit::qi;
-
-namespace ou { // One Unified
-namespace tf { // TradeFrame
-namespace iqfeed { // IQFeed
-
-namespace HistoryStructs {
-
-  struct TickDataPoint {
-    unsigned short Year;
-    unsigned short Month;
-    unsigned short Day;
-    unsigned short Hour;
-    unsigned short Minute;
-    unsigned short Second;
-    unsigned long Micro;
-    posix_time::ptime DateTime;
-    double Last;
-    uint32_t LastSize;
-    uint32_t TotalVolume;
-    double Bid;
-    double Ask;
-    uint64_t TickID;
-    char BasisForLast;  // 'C' normal, 'E' extended
-    uint16_t MarketCenter;
-    std::string sTradeConditions;
-    uint16_t TradeAggressor;
-    uint16_t DayCode;
-  };
-
-  // "I,LH,2023-06-28 00:00:00,4411.50,4411.25,4411.25,4411.50,42885,55,0,"
-  struct Interval {
-    unsigned short Year;
-    unsigned short Month;
-    unsigned short Day;
-    unsigned short Hour;
-    unsigned short Minute;
-    unsigned short Second;
-    posix_time::ptime DateTime;
-    double High;
-    double Low;
-    double Open;
-    double Close;
-    uint32_t TotalVolume;
-    uint32_t PeriodVolume;
-    uint32_t NumberOfTrades;
-  };
-
-  // "O,LH,2022-08-02,4167.25,4160.00,4167.25,4160.00,3,1103,"
-  struct EndOfDay {
-    unsigned short Year;
-    unsigned short Month;
-    unsigned short Day;
-    posix_time::ptime DateTime;
-    double High;
-    double Low;
-    double Open;
-    double Close;
-    uint32_t PeriodVolume;
-    uint32_t OpenInterest;
-  };
-
-} // namespace HistoryStructs
-} // namespace iqfeed
-} // namespace tf
-} // namespace ou
+#include "HistoryStructs.h"
+#include "HistoryDecoder.h"
 
+namespace qi = boost::spirit::qi;
 
 BOOST_FUSION_ADAPT_STRUCT(
   ou::tf::iqfeed::HistoryStructs::TickDataPoint,
@@ -248,7 +189,8 @@ public:
   using Interval      = ou::tf::iqfeed::HistoryStructs::Interval;
   using EndOfDay      = ou::tf::iqfeed::HistoryStructs::EndOfDay;
 
-  HistoryQuery();
+  HistoryQuery(); // local IQFeed history port
+  HistoryQuery( const std::string& sAddress, unsigned short nPort );
   virtual ~HistoryQuery();
 
   // http://www.iqfeed.net/dev/api/docs/docsBeta/HistoricalviaTCPIP.cfm
@@ -346,6 +288,13 @@ private:
   qi::rule<const_iterator_t> m_ruleEndMsg;
   qi::rule<const_iterator_t> m_ruleErrorInvalidSymbol;
 
+  HistoryDecoder m_decoder;
+
+  static std::string_view Record( const_iterator_t bgn, const_iterator_t end ) {
+    if ( bgn == end ) return std::string_view();
+    return std::string_view( reinterpret_cast<const char*>( &*bgn ), end - bgn );
+  }
+
   // Process the line
   void ProcessHistoryRetrieval( linebuffer_t* buf );
 
@@ -360,6 +309,15 @@ HistoryQuery<T>::HistoryQuery()
   m_ruleErrorInvalidSymbol = qi::lit( "E,Invalid symbol" );
 }
 
+template <typename T>
+HistoryQuery<T>::HistoryQuery( const std::string& sAddress, unsigned short nPort )
+: Network<HistoryQuery<T> >( sAddress, nPort )
+, m_stateRetrieval( RetrievalState::Idle )
+{
+  m_ruleEndMsg = qi::lit( "!ENDMSG!" );
+  m_ruleErrorInvalidSymbol = qi::lit( "E,Invalid symbol" );
+}
+
 template <typename T>
 HistoryQuery<T>::~HistoryQuery() {
 }
@@ -532,6 +490,11 @@ void HistoryQuery<T>::ProcessHistoryRetrieval( linebuffer_t* buf ) {
     case c_chRidTick: {
         assert ( RetrievalState::RetrieveDataPoints == m_stateRetrieval );
         TickDataPoint* pDP = m_reposTickDataPoint.CheckOutL();
+        if ( m_decoder.Decode( Record( bgn, end ), *pDP ) ) {
+          bParsed = true;
+          static_cast<T*>( this )->OnHistoryTickDataPoint( pDP );
+          break;
+        }
         bParsed = parse( bgn, end, m_grammarDataPoint, *pDP );
         if ( bParsed && ( bgn == end ) ) {
           //pDP->DateTime = boost::posix_time::time_from_string( pDP->sDateTime );  // very very slow
@@ -550,6 +513,11 @@ void HistoryQuery<T>::ProcessHistoryRetrieval( linebuffer_t* buf ) {
     case c_chRidInterval: {
         assert ( RetrievalState::RetrieveIntervals == m_stateRetrieval );
         Interval* pDP = m_reposInterval.CheckOutL();
+        if ( m_decoder.Decode( Record( bgn, end ), *pDP ) ) {
+          bParsed = true;
+          static_cast<T*>( this )->OnHistoryIntervalData( pDP );
+          break;
+        }
         bParsed = parse( bgn, end, m_grammarInterval, *pDP );
         if ( bParsed && ( bgn == end ) ) {
           //pDP->DateTime = boost::posix_time::time_from_string( pDP->sDateTime );  // very very slow
@@ -568,6 +536,11 @@ void HistoryQuery<T>::ProcessHistoryRetrieval( linebuffer_t* buf ) {
     case c_chRidEndOfDay: {
         assert ( RetrievalState::RetrieveEndOfDays == m_stateRetrieval );
         EndOfDay* pDP = m_reposEndOfDay.CheckOutL();
+        if ( m_decoder.Decode( Record( bgn, end ), *pDP ) ) {
+          bParsed = true;
+          static_cast<T*>( this )->OnHistoryEndOfDayData( pDP );
+          break;
+        }
         bParsed = parse( bgn, end, m_grammarEndOfDay, *pDP );
         if ( bParsed && ( bgn == end ) ) {
           //pDP->DateTime = boost::posix_time::time_from_string( pDP->sDateTime );  // very very slow
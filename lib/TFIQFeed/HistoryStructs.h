@@ -0,0 +1,95 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    HistoryStructs.h
+ * Author:  raymond@burkholder.net
+ * Project: TFIQFeed
+ * Created: October 17, 2026 21:25
+ */
+
+#pragma once
+
+// records of the historical data responses, as parsed by HistoryQuery and HistoryDecoder
+
+#include <string>
+#include <cstdint>
+
+#include <boost/date_time/posix_time/ptime.hpp>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+
+namespace HistoryStructs {
+
+  // "T,LH,2023-06-28 09:30:00.123456,4411.50,2,42885,4411.25,4411.50,12345678,C,11,01,1,28,"
+  struct TickDataPoint {
+    unsigned short Year;
+    unsigned short Month;
+    unsigned short Day;
+    unsigned short Hour;
+    unsigned short Minute;
+    unsigned short Second;
+    unsigned long Micro;
+    boost::posix_time::ptime DateTime;
+    double Last;
+    uint32_t LastSize;
+    uint32_t TotalVolume;
+    double Bid;
+    double Ask;
+    uint64_t TickID;
+    char BasisForLast;  // 'C' normal, 'E' extended
+    uint16_t MarketCenter;
+    std::string sTradeConditions;
+    uint16_t TradeAggressor;
+    uint16_t DayCode;
+  };
+
+  // "I,LH,2023-06-28 00:00:00,4411.50,4411.25,4411.25,4411.50,42885,55,0,"
+  struct Interval {
+    unsigned short Year;
+    unsigned short Month;
+    unsigned short Day;
+    unsigned short Hour;
+    unsigned short Minute;
+    unsigned short Second;
+    boost::posix_time::ptime DateTime;
+    double High;
+    double Low;
+    double Open;
+    double Close;
+    uint32_t TotalVolume;
+    uint32_t PeriodVolume;
+    uint32_t NumberOfTrades;
+  };
+
+  // "O,LH,2022-08-02,4167.25,4160.00,4167.25,4160.00,3,1103,"
+  struct EndOfDay {
+    unsigned short Year;
+    unsigned short Month;
+    unsigned short Day;
+    boost::posix_time::ptime DateTime;
+    double High;
+    double Low;
+    double Open;
+    double Close;
+    uint32_t PeriodVolume;
+    uint32_t OpenInterest;
+  };
+
+} // namespace HistoryStructs
+} // namespace iqfeed
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,525 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    FeatureEngine.cpp
+ * Author:  raymond@burkholder.net
+ * Project: lib/TFIQFeed/Level2
+ * Created: October 17, 2026 17:05
+ */
+
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "FeatureEngine.hpp"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+namespace l2 { // level 2 data
+
+namespace {
+
+  // same order as the FeatureSet_Level columns, 22 per side, then cross
+  const FeatureEngine::vName_t vNames = {
+    "ask.v1.volume", "ask.v1.price", "ask.v1.aggregateVolume", "ask.v1.aggregatePrice",
+    "ask.v3.diffToTop", "ask.v3.diffToAdjacent",
+    "ask.v4.meanPrice", "ask.v4.meanVolume",
+    "ask.v6.dPrice_dt", "ask.v6.dVolume_dt",
+    "ask.v7.intensityLimit", "ask.v7.intensityMarket", "ask.v7.intensityCancel",
+    "ask.v8.intensityLimit", "ask.v8.intensityMarket", "ask.v8.intensityCancel",
+    "ask.v8.relativeLimit", "ask.v8.relativeMarket", "ask.v8.relativeCancel",
+    "ask.v9.accelLimit", "ask.v9.accelMarket", "ask.v9.accelCancel",
+
+    "bid.v1.volume", "bid.v1.price", "bid.v1.aggregateVolume", "bid.v1.aggregatePrice",
+    "bid.v3.diffToTop", "bid.v3.diffToAdjacent",
+    "bid.v4.meanPrice", "bid.v4.meanVolume",
+    "bid.v6.dPrice_dt", "bid.v6.dVolume_dt",
+    "bid.v7.intensityLimit", "bid.v7.intensityMarket", "bid.v7.intensityCancel",
+    "bid.v8.intensityLimit", "bid.v8.intensityMarket", "bid.v8.intensityCancel",
+    "bid.v8.relativeLimit", "bid.v8.relativeMarket", "bid.v8.relativeCancel",
+    "bid.v9.accelLimit", "bid.v9.accelMarket", "bid.v9.accelCancel",
+
+    "cross.v2.spread", "cross.v2.mid",
+    "cross.v2.imbalanceLvl", "cross.v2.imbalanceAgg",
+    "cross.v5.sumPriceSpreads", "cross.v5.sumVolumeSpreads"
+  };
+
+  const uint16_t nPerSide = 22;
+  const uint16_t ixCross = 2 * nPerSide;
+
+  // as FeatureSet_Level
+  const double dblWeightShort = 20.0;
+  const double dblWeightHeadShort =                    1.0   / dblWeightShort;
+  const double dblWeightTailShort = ( dblWeightShort - 1.0 ) / dblWeightShort;
+
+  const double dblWeightLong = 200.0;
+  const double dblWeightHeadLong =                   1.0   / dblWeightLong;
+  const double dblWeightTailLong = ( dblWeightLong - 1.0 ) / dblWeightLong;
+
+  const double dblNone = -1.0; // dtLast not yet set
+
+  using volume_t = ou::tf::Trade::volume_t; // as FeatureSet_Level
+
+  const boost::posix_time::ptime dtEpoch( boost::gregorian::date( 1970, 1, 1 ) );
+
+  inline double Microseconds( const ou::tf::Depth& depth ) {
+    return (double)( depth.DateTime() - dtEpoch ).total_microseconds();
+  }
+
+
+  inline double Ratio( double numerator, double denominator ) {
+    return ( 0.0 == denominator ) ? 0.0 : numerator / denominator;
+  }
+}
+
+// side features 2 - 7 ( aggregates, diffs, means ), cross 3 - 5 ( imbalanceAgg, sums ) are positional
+//   side features 10 - 21 cycle through limit, market, cancel
+FeatureEngine::EClass FeatureEngine::Classify( uint16_t feature ) {
+  if ( ixCross > feature ) {
+    const uint16_t f( feature % nPerSide );
+    if ( ( 2 <= f ) && ( 7 >= f ) ) return Positional;
+    if ( 10 <= f ) return (EClass)( Limit + ( f - 10 ) % 3 );
+    return Quote_;
+  }
+  else {
+    return ( ( ixCross + 3 ) <= feature ) ? Positional : Quote_;
+  }
+}
+
+const FeatureEngine::vName_t& FeatureEngine::Names() {
+  return vNames;
+}
+
+FeatureEngine::FeatureEngine( size_t nLevels, const vName_t& vColumn )
+: m_nLevels( nLevels )
+, m_nStride( nLevels + 1 )
+, m_vColumn( vColumn )
+, m_bSentinelSet( false )
+, m_bChanged( false )
+{
+  assert( 0 < m_nLevels );
+
+  for ( std::vector<double>& vState: m_rState ) {
+    vState.assign( m_nStride * FieldCount, 0.0 );
+  }
+  for ( ESide side: { ESide::Ask, ESide::Bid } ) {
+    for ( unsigned int ix = 1; ix <= m_nLevels; ix++ ) Reset( side, ix );
+  }
+
+  uint32_t ixOutput {};
+  for ( const std::string& sColumn: m_vColumn ) {
+    Add( sColumn, ixOutput++, false );
+  }
+  Index();
+
+  m_vOutput.assign( m_vColumn.size(), 0.0f );
+  for ( ESide side: { ESide::Ask, ESide::Bid } ) {
+    for ( size_t class_ = 0; class_ < ClassCount; class_++ ) {
+      Evaluate( side, (EClass)class_, 1, m_nLevels );
+    }
+  }
+  m_bChanged = true;
+}
+
+FeatureEngine::~FeatureEngine() {}
+
+// compile: "<name>.l<level>" to an instruction
+void FeatureEngine::Add( const std::string& sColumn, uint32_t ixOutput, bool bSentinel ) {
+
+  const std::string::size_type pos( sColumn.rfind( ".l" ) );
+  if ( std::string::npos == pos ) {
+    throw std::runtime_error( "FeatureEngine: column " + sColumn + " has no level" );
+  }
+  const std::string sName( sColumn.substr( 0, pos ) );
+  vName_t::const_iterator iter = std::find( vNames.begin(), vNames.end(), sName );
+  if ( vNames.end() == iter ) {
+    throw std::runtime_error( "FeatureEngine: column " + sColumn + " not found" );
+  }
+  const unsigned long level( std::stoul( sColumn.substr( pos + 2 ) ) );
+  if ( ( 0 == level ) || ( m_nLevels < level ) ) {
+    throw std::runtime_error( "FeatureEngine: column " + sColumn + " level out of range" );
+  }
+
+  const uint16_t feature( iter - vNames.begin() );
+  Instruction instruction( Compile( feature, level, ixOutput ) );
+  instruction.bSentinel = bSentinel;
+  const EClass class_( Classify( feature ) );
+  if ( ixCross <= feature ) {
+    m_rInstruction[ (size_t)ESide::Ask ][ class_ ].push_back( instruction );
+    m_rInstruction[ (size_t)ESide::Bid ][ class_ ].push_back( instruction );
+  }
+  else {
+    m_rInstruction[ feature / nPerSide ][ class_ ].push_back( instruction );
+  }
+}
+
+// order each class by level, and note where each level starts
+void FeatureEngine::Index() {
+  for ( size_t side = 0; side < 2; side++ ) {
+    for ( size_t class_ = 0; class_ < ClassCount; class_++ ) {
+      vInstruction_t& vInstruction( m_rInstruction[ side ][ class_ ] );
+      std::stable_sort(
+        vInstruction.begin(), vInstruction.end(),
+        []( const Instruction& lhs, const Instruction& rhs ){ return lhs.level < rhs.level; } );
+      std::vector<size_t>& vFirst( m_rFirst[ side ][ class_ ] );
+      vFirst.resize( m_nStride + 1 );
+      size_t ix {};
+      for ( size_t level = 0; level <= m_nStride; level++ ) {
+        while ( ( ix < vInstruction.size() ) && ( vInstruction[ ix ].level < level ) ) ix++;
+        vFirst[ level ] = ix;
+      }
+    }
+  }
+}
+
+// comes after construction, once; a sentinel already a column is flagged, otherwise is computed after the columns
+void FeatureEngine::Set( const vSentinel_t& vSentinel ) {
+
+  assert( !m_bSentinelSet );
+  m_bSentinelSet = true;
+
+  for ( const vSentinel_t::value_type& sName: vSentinel ) {
+    for ( size_t level = 1; level <= m_nLevels; level++ ) {
+      const std::string sColumn( sName + ".l" + std::to_string( level ) );
+      vName_t::const_iterator iter = std::find( m_vColumn.begin(), m_vColumn.end(), sColumn );
+      if ( m_vColumn.end() == iter ) {
+        Add( sColumn, m_vOutput.size(), true );
+        m_vOutput.push_back( 0.0f );
+      }
+      else {
+        const uint32_t ixOutput( iter - m_vColumn.begin() );
+        for ( vInstruction_t& vInstruction: m_rInstruction[ (size_t)ESide::Ask ] ) {
+          for ( Instruction& instruction: vInstruction ) if ( ixOutput == instruction.ixOutput ) instruction.bSentinel = true;
+        }
+        for ( vInstruction_t& vInstruction: m_rInstruction[ (size_t)ESide::Bid ] ) {
+          for ( Instruction& instruction: vInstruction ) if ( ixOutput == instruction.ixOutput ) instruction.bSentinel = true;
+        }
+      }
+    }
+  }
+  Index();
+
+  for ( ESide side: { ESide::Ask, ESide::Bid } ) {
+    for ( size_t class_ = 0; class_ < ClassCount; class_++ ) {
+      Evaluate( side, (EClass)class_, 1, m_nLevels );
+    }
+  }
+  m_bChanged = true;
+}
+
+void FeatureEngine::Reset( ESide side, unsigned int ix ) {
+  std::fill_n( &State( side, Price, ix ), FieldCount, 0.0 );
+  State( side, dtLast, ix ) = dblNone;
+  State( side, dtLastLimit, ix ) = dblNone;
+  State( side, dtLastMarket, ix ) = dblNone;
+  State( side, dtLastCancel, ix ) = dblNone;
+}
+
+// move n levels from ixFrom to ixTo, every field
+void FeatureEngine::Shift( ESide side, unsigned int ixFrom, unsigned int ixTo, unsigned int n ) {
+  std::memmove( &State( side, Price, ixTo ), &State( side, Price, ixFrom ), n * FieldCount * sizeof( double ) ); // overlapping
+}
+
+void FeatureEngine::HandleBookChangesAsk( ou::tf::iqfeed::l2::EOp op, unsigned int ix, const ou::tf::Depth& depth ) {
+  BookChange( ESide::Ask, op, ix, depth );
+}
+
+void FeatureEngine::HandleBookChangesBid( ou::tf::iqfeed::l2::EOp op, unsigned int ix, const ou::tf::Depth& depth ) {
+  BookChange( ESide::Bid, op, ix, depth );
+}
+
+// levels move as they do in FeatureSet, the state of a level (derivatives, intensities) moves with it,
+//   so the values match those of FeatureSet, other than the aggregates, which are also brought up to date
+//   when levels shift
+void FeatureEngine::BookChange( ESide side, ou::tf::iqfeed::l2::EOp op, unsigned int ix, const ou::tf::Depth& depth ) {
+  if ( ( 0 == ix ) || ( m_nLevels < ix ) ) return;
+  switch ( op ) {
+    case ou::tf::iqfeed::l2::EOp::Insert:
+      if ( m_nLevels > ix ) {
+        Shift( side, ix, ix + 1, m_nLevels - ix );
+      }
+      Quote( side, ix, depth );
+      for ( size_t class_ = 0; class_ < Positional; class_++ ) {
+        Evaluate( side, (EClass)class_, ix, m_nLevels );
+      }
+      break;
+    case ou::tf::iqfeed::l2::EOp::Increase:
+    case ou::tf::iqfeed::l2::EOp::Decrease:
+      Quote( side, ix, depth );
+      Evaluate( side, Quote_, ix, ix );
+      break;
+    case ou::tf::iqfeed::l2::EOp::Delete:
+      if ( m_nLevels > ix ) {
+        Shift( side, ix + 1, ix, m_nLevels - ix );
+      }
+      // as FeatureSet, the deepest level is left as it was, its replacement is not reported
+      for ( size_t class_ = 0; class_ < Positional; class_++ ) {
+        Evaluate( side, (EClass)class_, ix, m_nLevels );
+      }
+      break;
+  }
+  Aggregate( side, ix );
+  Evaluate( side, Positional, ( 1 == ix ) ? 1 : ix - 1, m_nLevels ); // ix - 1 for diffToAdjacent
+}
+
+// as FeatureSet_Level::Ask_Quote/Ask_Derivatives
+void FeatureEngine::Quote( ESide side, unsigned int ix, const ou::tf::Depth& depth ) {
+  const double dt( Microseconds( depth ) );
+  double& last( State( side, dtLast, ix ) );
+  if ( dblNone != last ) {
+    const double diff( dt - last ); // might be delete -> update
+    if ( 0.0 < diff ) {
+      const double deltaArrival( diff / 1000000.0 ); // rate per second
+      double& dPrice( State( side, dPrice_dt, ix ) );
+      double& dVolume( State( side, dVolume_dt, ix ) );
+      dPrice  = dblWeightTailShort * dPrice  + dblWeightHeadShort * ( depth.Price()  / deltaArrival );
+      dVolume = (volume_t)( dblWeightTailShort * dVolume + dblWeightHeadShort * ( depth.Volume() / deltaArrival ) ); // as FeatureSet_Level
+    }
+  }
+  last = dt;
+  State( side, Price, ix ) = depth.Price();
+  State( side, Volume, ix ) = depth.Volume();
+}
+
+// sums of the levels above, for ixFrom and deeper
+void FeatureEngine::Aggregate( ESide side, unsigned int ixFrom ) {
+  State( side, AggregatePrice, 1 ) = 0.0;
+  State( side, AggregateVolume, 1 ) = 0.0;
+  for ( unsigned int ix = std::max( 2u, ixFrom ); ix <= m_nLevels; ix++ ) {
+    State( side, AggregatePrice, ix ) = State( side, AggregatePrice, ix - 1 ) + State( side, Price, ix - 1 );
+    State( side, AggregateVolume, ix ) = State( side, AggregateVolume, ix - 1 ) + State( side, Volume, ix - 1 );
+  }
+}
+
+// as FeatureSet_Level::Intensity: v7 short term, v8 long term, v9 accelleration
+void FeatureEngine::Intensity( ESide side, unsigned int ix, EField field, EClass class_, const ou::tf::Depth& depth ) {
+  if ( ( 0 == ix ) || ( m_nLevels < ix ) ) return;
+  const double dt( Microseconds( depth ) );
+  double& last( State( side, field, ix ) );
+  if ( dblNone != last ) {
+    const double diff( dt - last );
+    if ( 0.0 < diff ) {
+      double& intensityShort( State( side, (EField)( field + 1 ), ix ) );
+      double& intensityLong(  State( side, (EField)( field + 2 ), ix ) );
+      double& accelShort(     State( side, (EField)( field + 3 ), ix ) );
+      const double intensityShortPrevious( intensityShort );
+      const double deltaArrival( diff / 1000000.0 ); // rate per second
+      intensityShort = dblWeightTailShort * intensityShort + dblWeightHeadShort / deltaArrival;
+      intensityLong  = dblWeightTailLong  * intensityLong  + dblWeightHeadLong  / deltaArrival;
+      const double diffIntensity( intensityShort - intensityShortPrevious );
+      accelShort     = dblWeightTailShort * accelShort     + dblWeightHeadShort * diffIntensity / deltaArrival;
+    }
+  }
+  last = dt;
+  Evaluate( side, class_, ix, ix );
+}
+
+void FeatureEngine::Ask_IncLimit(  unsigned int ix, const ou::tf::Depth& depth ) { Intensity( ESide::Ask, ix, dtLastLimit,  Limit,  depth ); }
+void FeatureEngine::Ask_IncMarket( unsigned int ix, const ou::tf::Depth& depth ) { Intensity( ESide::Ask, ix, dtLastMarket, Market, depth ); }
+void FeatureEngine::Ask_IncCancel( unsigned int ix, const ou::tf::Depth& depth ) { Intensity( ESide::Ask, ix, dtLastCancel, Cancel, depth ); }
+
+void FeatureEngine::Bid_IncLimit(  unsigned int ix, const ou::tf::Depth& depth ) { Intensity( ESide::Bid, ix, dtLastLimit,  Limit,  depth ); }
+void FeatureEngine::Bid_IncMarket( unsigned int ix, const ou::tf::Depth& depth ) { Intensity( ESide::Bid, ix, dtLastMarket, Market, depth ); }
+void FeatureEngine::Bid_IncCancel( unsigned int ix, const ou::tf::Depth& depth ) { Intensity( ESide::Bid, ix, dtLastCancel, Cancel, depth ); }
+
+FeatureEngine::Instruction FeatureEngine::Compile( uint16_t feature, uint16_t level, uint32_t ixOutput ) const {
+
+  Instruction instruction {};
+  instruction.op = EOpCode::Copy;
+  instruction.level = level;
+  instruction.ixOutput = ixOutput;
+
+  if ( ixCross > feature ) {
+
+    const ESide side( (ESide)( feature / nPerSide ) );
+    const bool bAsk( ESide::Ask == side ); // price distances are positive away from the top
+
+    switch ( feature % nPerSide ) {
+      case 0: instruction.a = &State( side, Volume, level ); break;
+      case 1: instruction.a = &State( side, Price, level ); break;
+      case 2: instruction.a = &State( side, AggregateVolume, level ); break;
+      case 3: instruction.a = &State( side, AggregatePrice, level ); break;
+      case 4: // diffToTop
+        if ( 1 == level ) instruction.op = EOpCode::Zero;
+        else {
+          instruction.op = EOpCode::Sub;
+          instruction.a = &State( side, Price, ( bAsk ? level : 1 ) );
+          instruction.b = &State( side, Price, ( bAsk ? 1 : level ) );
+        }
+        break;
+      case 5: // diffToAdjacent
+        if ( m_nLevels == level ) instruction.op = EOpCode::Zero;
+        else {
+          instruction.op = EOpCode::Sub;
+          instruction.a = &State( side, Price, ( bAsk ? level + 1 : level ) );
+          instruction.b = &State( side, Price, ( bAsk ? level : level + 1 ) );
+        }
+        break;
+      case 6: // meanPrice
+        instruction.op = EOpCode::AddScale;
+        instruction.a = &State( side, Price, level );
+        instruction.b = &State( side, AggregatePrice, level );
+        instruction.k = 1.0 / level;
+        break;
+      case 7: // meanVolume
+        instruction.op = EOpCode::AddScaleVolume;
+        instruction.a = &State( side, Volume, level );
+        instruction.b = &State( side, AggregateVolume, level );
+        instruction.k = 1.0 / level;
+        break;
+      case 8: instruction.a = &State( side, dPrice_dt, level ); break;
+      case 9: instruction.a = &State( side, dVolume_dt, level ); break;
+      case 10: instruction.a = &State( side, IntensityLimitShort, level ); break;
+      case 11: instruction.a = &State( side, IntensityMarketShort, level ); break;
+      case 12: instruction.a = &State( side, IntensityCancelShort, level ); break;
+      case 13: instruction.a = &State( side, IntensityLimitLong, level ); break;
+      case 14: instruction.a = &State( side, IntensityMarketLong, level ); break;
+      case 15: instruction.a = &State( side, IntensityCancelLong, level ); break;
+      case 16:
+        instruction.op = EOpCode::Ratio;
+        instruction.a = &State( side, IntensityLimitShort, level );
+        instruction.b = &State( side, IntensityLimitLong, level );
+        break;
+      case 17:
+        instruction.op = EOpCode::Ratio;
+        instruction.a = &State( side, IntensityMarketShort, level );
+        instruction.b = &State( side, IntensityMarketLong, level );
+        break;
+      case 18:
+        instruction.op = EOpCode::Ratio;
+        instruction.a = &State( side, IntensityCancelShort, level );
+        instruction.b = &State( side, IntensityCancelLong, level );
+        break;
+      case 19: instruction.a = &State( side, AccelLimit, level ); break;
+      case 20: instruction.a = &State( side, AccelMarket, level ); break;
+      case 21: instruction.a = &State( side, AccelCancel, level ); break;
+    }
+  }
+  else {
+
+    const double* pAskPrice( &State( ESide::Ask, Price, level ) );
+    const double* pBidPrice( &State( ESide::Bid, Price, level ) );
+    const double* pAskVolume( &State( ESide::Ask, Volume, level ) );
+    const double* pBidVolume( &State( ESide::Bid, Volume, level ) );
+
+    switch ( feature - ixCross ) {
+      case 0: // spread
+        instruction.op = EOpCode::Sub;
+        instruction.a = pAskPrice;
+        instruction.b = pBidPrice;
+        break;
+      case 1: // mid
+        instruction.op = EOpCode::AddScale;
+        instruction.a = pAskPrice;
+        instruction.b = pBidPrice;
+        instruction.k = 0.5;
+        break;
+      case 2: // imbalanceLvl
+        instruction.op = EOpCode::Imbalance;
+        instruction.a = pAskVolume;
+        instruction.b = pBidVolume;
+        break;
+      case 3: // imbalanceAgg
+        instruction.op = EOpCode::SumImbalance;
+        instruction.a = pAskVolume;
+        instruction.b = &State( ESide::Ask, AggregateVolume, level );
+        instruction.c = pBidVolume;
+        instruction.d = &State( ESide::Bid, AggregateVolume, level );
+        break;
+      case 4: // sumPriceSpreads
+        instruction.op = EOpCode::SumSub;
+        instruction.a = pAskPrice;
+        instruction.b = &State( ESide::Ask, AggregatePrice, level );
+        instruction.c = pBidPrice;
+        instruction.d = &State( ESide::Bid, AggregatePrice, level );
+        break;
+      case 5: // sumVolumeSpreads
+        instruction.op = EOpCode::SumSub;
+        instruction.a = pAskVolume;
+        instruction.b = &State( ESide::Ask, AggregateVolume, level );
+        instruction.c = pBidVolume;
+        instruction.d = &State( ESide::Bid, AggregateVolume, level );
+        break;
+    }
+  }
+
+  return instruction;
+}
+
+// one pass over the instructions for the levels touched
+void FeatureEngine::Evaluate( ESide side, EClass class_, unsigned int ixFrom, unsigned int ixTo ) {
+  const vInstruction_t& vInstruction( m_rInstruction[ (size_t)side ][ class_ ] );
+  const std::vector<size_t>& vFirst( m_rFirst[ (size_t)side ][ class_ ] );
+  float* pOutput( m_vOutput.data() );
+  bool bChanged( false );
+  for ( size_t ix = vFirst[ ixFrom ], end = vFirst[ ixTo + 1 ]; ix < end; ix++ ) {
+    const Instruction& instruction( vInstruction[ ix ] );
+    double value {};
+    switch ( instruction.op ) {
+      case EOpCode::Zero:
+        break;
+      case EOpCode::Copy:
+        value = *instruction.a;
+        break;
+      case EOpCode::Sub:
+        value = *instruction.a - *instruction.b;
+        break;
+      case EOpCode::AddScale:
+        value = ( *instruction.a + *instruction.b ) * instruction.k;
+        break;
+      case EOpCode::AddScaleVolume:
+        value = (volume_t)( ( *instruction.a + *instruction.b ) * instruction.k );
+        break;
+      case EOpCode::Ratio:
+        value = Ratio( *instruction.a, *instruction.b );
+        break;
+      case EOpCode::Imbalance:
+        value = Ratio( *instruction.b - *instruction.a, *instruction.b + *instruction.a );
+        break;
+      case EOpCode::SumSub:
+        value = ( *instruction.a + *instruction.b ) - ( *instruction.c + *instruction.d );
+        break;
+      case EOpCode::SumImbalance: {
+        const double sumA( *instruction.a + *instruction.b );
+        const double sumC( *instruction.c + *instruction.d );
+        value = Ratio( sumC - sumA, sumC + sumA );
+        }
+        break;
+    }
+    float& output( pOutput[ instruction.ixOutput ] );
+    bChanged |= instruction.bSentinel & ( output != (float)value );
+    output = value;
+  }
+  m_bChanged |= bChanged;
+}
+
+void FeatureEngine::Changed( bool& bChanged ) {
+  if ( m_bSentinelSet ) {
+    if ( m_bChanged ) {
+      bChanged = true;
+      m_bChanged = false;
+    }
+  }
+  else {
+    bChanged = true;
+  }
+}
+
+} // namespace l2
+} // namesapce iqfeed
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,165 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    FeatureEngine.hpp
+ * Author:  raymond@burkholder.net
+ * Project: lib/TFIQFeed/Level2
+ * Created: October 17, 2026 17:05
+ */
+
+ // the FeatureSet_Level features, computed incrementally for a declared list of columns:
+ //   * the list uses the FeatureSet header names, ie "ask.v1.price.l1", "cross.v2.imbalanceAgg.l3",
+ //     and is compiled into an instruction per column: an op over pointers into the book state,
+ //     ordered by level, so an update is one pass over a contiguous run of instructions
+ //   * book state is a row of fields per level, so an insert or delete shifts the book with one move
+ //   * instructions are classed by what changes them: the quote at the level (price, volume, v6, spread, ...),
+ //     an order arrival at the level (v7, v8, v9 of its type), or the levels above (aggregates, means,
+ //     diffs, imbalanceAgg, ...) - positional
+ //   * a quote at level ix re-evaluates the quote instructions at ix, and the positional ones
+ //     at ix - 1 (diffToAdjacent) and deeper; an insert or delete shifts levels, so re-evaluates
+ //     every class from ix; an order arrival only the instructions of its type at ix
+ //   * results are floats, contiguous, in the order declared, so can be handed directly to a model
+ //   * as FeatureSet, with sentinels set, Changed follows those columns only, otherwise every update is a change
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "Symbols.hpp"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+namespace l2 { // level 2 data
+
+class FeatureEngine {
+public:
+
+  using vName_t = std::vector<std::string>;
+  using vSentinel_t = std::vector<std::string>; // names without the level suffix
+
+  FeatureEngine( size_t nLevels, const vName_t& vColumn ); // levels tracked in the book, columns to produce
+  FeatureEngine( const FeatureEngine& ) = delete; // instructions point into the state
+  FeatureEngine& operator=( const FeatureEngine& ) = delete;
+  ~FeatureEngine();
+
+  void Set( const vSentinel_t& ); // as FeatureSet, the named columns at every level trigger Changed
+
+  // Assignment / Update, as FeatureSet
+
+  void HandleBookChangesAsk( ou::tf::iqfeed::l2::EOp, unsigned int, const ou::tf::Depth& );
+  void HandleBookChangesBid( ou::tf::iqfeed::l2::EOp, unsigned int, const ou::tf::Depth& );
+
+  void Ask_IncLimit(  unsigned int, const ou::tf::Depth& ); // v7 ask
+  void Ask_IncMarket( unsigned int, const ou::tf::Depth& );
+  void Ask_IncCancel( unsigned int, const ou::tf::Depth& );
+
+  void Bid_IncLimit(  unsigned int, const ou::tf::Depth& ); // v7 bid
+  void Bid_IncMarket( unsigned int, const ou::tf::Depth& );
+  void Bid_IncCancel( unsigned int, const ou::tf::Depth& );
+
+  // Queries
+
+  size_t Size() const { return m_vColumn.size(); }
+  const float* Data() const { return m_vOutput.data(); } // Size() values, in column order
+  const vName_t& Columns() const { return m_vColumn; }
+
+  void Changed( bool& ); // set true if a sentinel changed since the previous call, always without sentinels
+
+  static const vName_t& Names(); // column names available, without the level suffix
+
+protected:
+private:
+
+  enum class ESide: uint8_t { Ask, Bid };
+
+  // per side state, level major: m_rState[ side ][ level * FieldCount + field ]
+  enum EField {
+    Price, Volume,
+    dtLast, dPrice_dt, dVolume_dt,                                        // v6
+    dtLastLimit, IntensityLimitShort, IntensityLimitLong, AccelLimit,     // v7, v8, v9
+    dtLastMarket, IntensityMarketShort, IntensityMarketLong, AccelMarket,
+    dtLastCancel, IntensityCancelShort, IntensityCancelLong, AccelCancel,
+    AggregatePrice, AggregateVolume, // sums of the levels above
+    FieldCount
+  };
+
+  enum EClass { Quote_, Limit, Market, Cancel, Positional, ClassCount };
+
+  enum class EOpCode: uint8_t {
+    Zero,
+    Copy,           // a
+    Sub,            // a - b
+    AddScale,       // ( a + b ) * k
+    AddScaleVolume, // ( a + b ) * k, truncated as a volume
+    Ratio,          // a / b
+    Imbalance,      // ( b - a ) / ( b + a )
+    SumSub,         // ( a + b ) - ( c + d )
+    SumImbalance    // ( ( c + d ) - ( a + b ) ) / ( ( c + d ) + ( a + b ) )
+  };
+
+  struct Instruction {
+    EOpCode op;
+    bool bSentinel;
+    uint16_t level;
+    uint32_t ixOutput;
+    double k;
+    const double* a;
+    const double* b;
+    const double* c;
+    const double* d;
+  };
+
+  using vInstruction_t = std::vector<Instruction>;
+
+  const size_t m_nLevels;
+  const size_t m_nStride; // levels + 1, level 0 not used, as FeatureSet
+
+  vName_t m_vColumn;
+
+  std::vector<double> m_rState[ 2 ];
+
+  // [ side ][ class ], ascending level; cross features are under both sides
+  vInstruction_t m_rInstruction[ 2 ][ ClassCount ];
+  std::vector<size_t> m_rFirst[ 2 ][ ClassCount ]; // first instruction at or deeper than level
+
+  std::vector<float> m_vOutput; // columns, then sentinels not among the columns
+  bool m_bSentinelSet;
+  bool m_bChanged;
+
+  double& State( ESide side, EField field, size_t level ) { return m_rState[ (size_t)side ][ level * FieldCount + field ]; }
+  const double& State( ESide side, EField field, size_t level ) const { return m_rState[ (size_t)side ][ level * FieldCount + field ]; }
+
+  void BookChange( ESide, ou::tf::iqfeed::l2::EOp, unsigned int, const ou::tf::Depth& );
+  void Quote( ESide, unsigned int, const ou::tf::Depth& );
+  void Intensity( ESide, unsigned int, EField dtLast, EClass, const ou::tf::Depth& );
+  void Aggregate( ESide, unsigned int ixFrom );
+  void Shift( ESide, unsigned int ixFrom, unsigned int ixTo, unsigned int n );
+  void Reset( ESide, unsigned int ix );
+
+  static EClass Classify( uint16_t feature );
+  void Add( const std::string& sColumn, uint32_t ixOutput, bool bSentinel );
+  Instruction Compile( uint16_t feature, uint16_t level, uint32_t ixOutput ) const;
+  void Index();
+  void Evaluate( ESide, EClass, unsigned int ixFrom, unsigned int ixTo ); // levels inclusive
+
+};
+
+} // namespace l2
+} // namesapce iqfeed
+} // namespace tf
+} // namespace ou
@@ -32,51 +32,31 @@ namespace l2 { // level 2 data
 
 // ==== L2Base
 
-L2Base::L2Base()
+L2Base::L2Base( EBook eBook )
 : m_fMarketDepthByMM( nullptr )
 , m_fMarketDepthByOrder( nullptr )
-{}
-
-void L2Base::Clear( const ou::tf::Depth& depth ) {
-  switch ( depth.Side() ) {
-    case 'A':
-      m_LevelAggregateAsk.Clear( depth );
-      break;
-    case 'B':
-      m_LevelAggregateBid.Clear( depth );
+{
+  switch ( eBook ) {
+    case EBook::Flat:
+      m_pLevelBook = std::make_unique<LevelBookSides<FlatLevelAggregate> >();
       break;
+    case EBook::Map:
     default:
-      assert( false );
+      m_pLevelBook = std::make_unique<LevelBookSides<MapLevelAggregate> >();
       break;
   }
 }
 
+void L2Base::Clear( const ou::tf::Depth& depth ) {
+  m_pLevelBook->Clear( depth );
+}
+
 void L2Base::Add( const ou::tf::Depth& depth ) {
-  switch ( depth.Side() ) {
-    case 'A':
-      m_LevelAggregateAsk.Add( depth );
-      break;
-    case 'B':
-      m_LevelAggregateBid.Add( depth );
-      break;
-    default:
-      assert( false );
-      break;
-  }
+  m_pLevelBook->Add( depth );
 }
 
 void L2Base::Delete( const ou::tf::Depth& depth ) {
-  switch ( depth.Side() ) {
-    case 'A':
-      m_LevelAggregateAsk.Delete( depth );
-      break;
-    case 'B':
-      m_LevelAggregateBid.Delete( depth );
-      break;
-    default:
-      assert( false );
-      break;
-  }
+  m_pLevelBook->Delete( depth );
 }
 
 // ==== MarketMaker === for nasdaq equities LII
@@ -274,8 +254,8 @@ void MarketMaker::EmitMarketMakerMaps() {
 
 // ==== OrderBased
 
-OrderBased::OrderBased()
-: L2Base()
+OrderBased::OrderBased( EBook eBook )
+: L2Base( eBook )
 , m_state( EState::Ready )
 {}
 
@@ -371,14 +351,12 @@ void OrderBased::LimitOrderAdd( const ou::tf::DepthByOrder& depth ) {
 
   Order order( depth );
 
-  mapOrder_t::iterator iter = m_mapOrder.find( depth.OrderID() );
-  if ( m_mapOrder.end() != iter ) {
+  auto result = m_mapOrder.Emplace( depth.OrderID(), order );
+  if ( !result.second ) {
     // TODO: reset the order book, this happens upon a disconnect/reconnect, can this state be found?
     BOOST_LOG_TRIVIAL(warning) << "LimitOrderAdd re-add order skipped: " << depth.OrderID();
   }
   else {
-    auto result = m_mapOrder.emplace( std::pair( depth.OrderID(), order ) );
-    assert( result.second );
     m_idOrder = depth.OrderID();
     Add( depth );
   }
@@ -388,8 +366,8 @@ void OrderBased::LimitOrderAdd( const ou::tf::DepthByOrder& depth ) {
 void OrderBased::LimitOrderUpdate( const ou::tf::DepthByOrder& depth ) {
   m_state = EState::Update;
 
-  mapOrder_t::iterator iter = m_mapOrder.find( depth.OrderID() );
-  if ( m_mapOrder.end() == iter ) {
+  Order* pOrder = m_mapOrder.Find( depth.OrderID() );
+  if ( nullptr == pOrder ) {
     BOOST_LOG_TRIVIAL(error) << "LimitOrderUpdate order does not exist: " << depth.OrderID();
   }
   else {
@@ -398,7 +376,7 @@ void OrderBased::LimitOrderUpdate( const ou::tf::DepthByOrder& depth ) {
       BOOST_LOG_TRIVIAL(warning) << "LimitOrderUpdate order " << depth.OrderID() << " warning - zero new quantity";
     }
 
-    Order& order( iter->second );
+    Order& order( *pOrder );
     if ( order.chOrderSide != depth.Side() ) {
       BOOST_LOG_TRIVIAL(error) << "LimitOrderUpdate error - side change " << order.chOrderSide << " to " << depth.Side();
     }
@@ -417,17 +395,17 @@ void OrderBased::LimitOrderUpdate( const ou::tf::DepthByOrder& depth ) {
 void OrderBased::LimitOrderDelete( const ou::tf::DepthByOrder& depth ) {
   m_state = EState::Delete;
 
-  mapOrder_t::iterator iter = m_mapOrder.find( depth.OrderID() );
-  if ( m_mapOrder.end() == iter ) {
+  const Order* pOrder = m_mapOrder.Find( depth.OrderID() );
+  if ( nullptr == pOrder ) {
     BOOST_LOG_TRIVIAL(error) << "LimitOrderDelete order " << depth.OrderID() << " does not exist";
   }
   else {
     m_idOrder = depth.OrderID();
-    const Order& order( iter->second );
+    const Order& order( *pOrder );
     ou::tf::Depth depth_( depth.DateTime(), depth.Side(), order.dblPrice, order.nQuantity );
     Delete( depth_ );
 
-    m_mapOrder.erase( iter );
+    m_mapOrder.Erase( depth.OrderID() );
   }
   m_state = EState::Ready;
 }
@@ -437,21 +415,21 @@ void OrderBased::LimitOrderClear( const ou::tf::DepthByOrder& depth ) {
 
   std::vector<uint64_t> vOrderId; // delete order ids at end of use
 
-  for ( mapOrder_t::value_type& vt: m_mapOrder ) {
-    // clear only those entries for the side provided
-    if ( depth.Side() == vt.second.chOrderSide ) {
-      m_state = EState::Delete;
-      m_idOrder = vt.first;
-      const Order& order( vt.second );
-      ou::tf::Depth depth_( depth.DateTime(), depth.Side(), order.dblPrice, order.nQuantity );
-      Delete( depth_ );
-      vOrderId.push_back( vt.first );
-      m_state = EState::Clear;
-    }
-  }
+  m_mapOrder.ForEach(
+    [this,&depth,&vOrderId]( uint64_t idOrder, const Order& order ){
+      // clear only those entries for the side provided
+      if ( depth.Side() == order.chOrderSide ) {
+        m_state = EState::Delete;
+        m_idOrder = idOrder;
+        ou::tf::Depth depth_( depth.DateTime(), depth.Side(), order.dblPrice, order.nQuantity );
+        Delete( depth_ );
+        vOrderId.push_back( idOrder );
+        m_state = EState::Clear;
+      }
+    } );
 
   for ( uint64_t id: vOrderId ) {
-    size_t num = m_mapOrder.erase( id );
+    m_mapOrder.Erase( id );
   }
 
   m_state = EState::Ready;
@@ -464,6 +442,7 @@ using inherited_t = Dispatcher<Symbols>;
 Symbols::Symbols( fConnected_t&& fConnected )
 : inherited_t()
 , m_bSingle( false )
+, m_eBook( L2Base::EBook::Map )
 , m_fConnected( std::move( fConnected ) )
 , m_luSymbol( Carrier(), 20 )
 {}
@@ -481,6 +460,10 @@ void Symbols::Single( bool bSingle ) {
   m_bSingle = bSingle;
 }
 
+void Symbols::Book( L2Base::EBook eBook ) {
+  m_eBook = eBook;
+}
+
 void Symbols::Connect() {
   inherited_t::Connect();
 }
@@ -22,10 +22,13 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+#include <algorithm>
 
 #include <boost/log/trivial.hpp>
 
 #include <OUCommon/KeyWordMatch.h>
+#include <OUCommon/OrderMap.h>
 
 #include <TFTimeSeries/DatedDatum.h>
 #include <TFTimeSeries/TimeSeries.h>
@@ -221,8 +224,12 @@ public:
     }
   }
 
-  void Clear( const ou::tf::Depth& depth ) {
-    // clear a single entry
+  void Clear( const ou::tf::Depth& depth ) { // remove the level at the price, regardless of remaining orders
+    typename mapLevelAggregate_t::iterator iterLevelAggregate = m_mapLevelAggregate.find( depth.Price() );
+    if ( m_mapLevelAggregate.end() != iterLevelAggregate ) {
+      iterLevelAggregate->second.nOrders = 1;
+      Delete( ou::tf::Depth( depth.DateTime(), depth.Price(), iterLevelAggregate->second.nQuantity ) );
+    }
   }
 
 protected:
@@ -234,6 +241,185 @@ private:
   fVolumeAtPrice_t m_fVolumeAtPrice;
 }; // class MapLevelAggregate
 
+// ==== FlatLevelAggregate
+// same interface and callbacks as MapLevelAggregate, levels held in one sorted vector:
+//   sorted from worst to best, so top of book is at the back, and activity near the top
+//   only moves the few entries above it.  ixLevel is the distance from the back, no renumbering.
+
+template<typename Compare>  // ask is std::less<key>, bid is std::greater<key>
+class FlatLevelAggregate {
+  friend class Symbols;
+private:
+
+  struct LevelAggregate {
+    double price;
+    volume_t nQuantity;
+    int nOrders;
+    LevelAggregate( double price_, volume_t nQuantity_ )
+    : price( price_ ), nQuantity( nQuantity_ ), nOrders( 1 ) {}
+  };
+
+  using vLevelAggregate_t = std::vector<LevelAggregate>;
+
+public:
+
+  static const unsigned int max_ix = 10;
+
+  FlatLevelAggregate()
+  : m_fVolumeAtPrice( nullptr )
+  {
+    m_vLevelAggregate.reserve( 256 );
+  }
+
+  void Set( fVolumeAtPrice_t&& fVolumeAtPrice ) { // simple callback
+    m_fVolumeAtPrice = std::move( fVolumeAtPrice );
+  }
+
+  void Set( fBookChanges_t&& fBookChanges ) {
+    m_fBookChanges = std::move( fBookChanges );
+  }
+
+  void Add( const ou::tf::Depth& depth ) {
+
+    price_t price( depth.Price() );
+    volume_t volume( depth.Volume() );
+
+    typename vLevelAggregate_t::iterator iterLevelAggregate = Find( price );
+    if ( ( m_vLevelAggregate.end() == iterLevelAggregate ) || ( price != iterLevelAggregate->price ) ) {
+      iterLevelAggregate = m_vLevelAggregate.emplace( iterLevelAggregate, price, volume );
+      if ( m_fBookChanges ) {
+        m_fBookChanges( EOp::Insert, Level( iterLevelAggregate ), depth );
+      }
+    }
+    else { // exising level
+      iterLevelAggregate->nQuantity += volume;
+      iterLevelAggregate->nOrders++;
+      if ( m_fBookChanges ) {
+        ou::tf::Depth depth_( depth.DateTime(), price, iterLevelAggregate->nQuantity );
+        m_fBookChanges( EOp::Increase, Level( iterLevelAggregate ), depth_ );
+      }
+    }
+
+    if ( m_fVolumeAtPrice ) m_fVolumeAtPrice( price, iterLevelAggregate->nQuantity, true );
+  }
+
+  void Delete( const ou::tf::Depth& depth ) {
+
+    price_t price( depth.Price() );
+    volume_t volume( depth.Volume() );
+
+    typename vLevelAggregate_t::iterator iterLevelAggregate = Find( price );
+    if ( ( m_vLevelAggregate.end() == iterLevelAggregate ) || ( price != iterLevelAggregate->price ) ) {
+      BOOST_LOG_TRIVIAL(error) << "FlatLevelAggregate::Delete price not found: " << price;
+    }
+    else {
+      assert( volume <= iterLevelAggregate->nQuantity ); // ensure no wrap around
+      iterLevelAggregate->nQuantity -= volume;
+      iterLevelAggregate->nOrders--;
+
+      if ( m_fVolumeAtPrice ) m_fVolumeAtPrice( price, iterLevelAggregate->nQuantity, false );
+
+      if ( 0 == iterLevelAggregate->nQuantity ) { // level to be removed
+        assert( 0 == iterLevelAggregate->nOrders );
+        if ( m_fBookChanges ) {
+          ou::tf::Depth depth_( depth.DateTime(), price, 0 );
+          m_fBookChanges( EOp::Delete, Level( iterLevelAggregate ), depth_ );
+        }
+        m_vLevelAggregate.erase( iterLevelAggregate );
+      }
+      else { // level changes but is not removed
+        if ( m_fBookChanges ) {
+          ou::tf::Depth depth_( depth.DateTime(), price, iterLevelAggregate->nQuantity );
+          m_fBookChanges( EOp::Decrease, Level( iterLevelAggregate ), depth_ );
+        }
+      }
+    }
+  }
+
+  void Clear( const ou::tf::Depth& depth ) { // remove the level at the price, regardless of remaining orders
+    typename vLevelAggregate_t::iterator iterLevelAggregate = Find( depth.Price() );
+    if ( ( m_vLevelAggregate.end() != iterLevelAggregate ) && ( depth.Price() == iterLevelAggregate->price ) ) {
+      iterLevelAggregate->nOrders = 1;
+      Delete( ou::tf::Depth( depth.DateTime(), depth.Price(), iterLevelAggregate->nQuantity ) );
+    }
+  }
+
+protected:
+
+  vLevelAggregate_t m_vLevelAggregate;
+
+private:
+  fBookChanges_t m_fBookChanges;
+  fVolumeAtPrice_t m_fVolumeAtPrice;
+
+  // first entry at or better than price
+  typename vLevelAggregate_t::iterator Find( price_t price ) {
+    return std::lower_bound(
+      m_vLevelAggregate.begin(), m_vLevelAggregate.end(), price,
+      []( const LevelAggregate& level, price_t price ){ return Compare()( price, level.price ); } );
+  }
+
+  // 1 is top of book, zero is outside of max_ix
+  unsigned int Level( typename vLevelAggregate_t::const_iterator iter ) const {
+    const unsigned int ix = m_vLevelAggregate.end() - iter;
+    return ( max_ix < ix ) ? 0 : ix;
+  }
+
+}; // class FlatLevelAggregate
+
+// ==== LevelBook
+// ==== bid and ask price level aggregates, the implementation is chosen once per L2Base
+
+class LevelBook {
+public:
+  virtual ~LevelBook() {}
+  virtual void Set( fBookChanges_t&& fBid, fBookChanges_t&& fAsk ) = 0;
+  virtual void Set( fVolumeAtPrice_t&& fBid, fVolumeAtPrice_t&& fAsk ) = 0;
+  virtual void Clear( const ou::tf::Depth& ) = 0;
+  virtual void Add( const ou::tf::Depth& ) = 0;
+  virtual void Delete( const ou::tf::Depth& ) = 0;
+};
+
+template<template<typename> class Aggregate>  // MapLevelAggregate, FlatLevelAggregate
+class LevelBookSides: public LevelBook {
+public:
+
+  virtual void Set( fBookChanges_t&& fBid, fBookChanges_t&& fAsk ) {
+    m_ask.Set( std::move( fAsk ) );
+    m_bid.Set( std::move( fBid ) );
+  }
+  virtual void Set( fVolumeAtPrice_t&& fBid, fVolumeAtPrice_t&& fAsk ) {
+    m_ask.Set( std::move( fAsk ) );
+    m_bid.Set( std::move( fBid ) );
+  }
+
+  virtual void Clear( const ou::tf::Depth& depth ) {
+    switch ( depth.Side() ) {
+      case 'A': m_ask.Clear( depth ); break;
+      case 'B': m_bid.Clear( depth ); break;
+      default: assert( false ); break;
+    }
+  }
+  virtual void Add( const ou::tf::Depth& depth ) {
+    switch ( depth.Side() ) {
+      case 'A': m_ask.Add( depth ); break;
+      case 'B': m_bid.Add( depth ); break;
+      default: assert( false ); break;
+    }
+  }
+  virtual void Delete( const ou::tf::Depth& depth ) {
+    switch ( depth.Side() ) {
+      case 'A': m_ask.Delete( depth ); break;
+      case 'B': m_bid.Delete( depth ); break;
+      default: assert( false ); break;
+    }
+  }
+
+private:
+  Aggregate<std::less<double> > m_ask;    // top of book: lowest price
+  Aggregate<std::greater<double> > m_bid; // top of book: highest price
+};
+
 // ==== L2Base
 // ==== common code for MarketMaker, OrderBased
 
@@ -241,19 +427,19 @@ class L2Base {  // TODO: convert to CRTP? template based upon DepthByMM/DepthByO
   friend class Symbols;
 public:
 
-  L2Base();
+  enum class EBook { Map, Flat }; // price level implementation, see MapLevelAggregate, FlatLevelAggregate
+
+  L2Base( EBook = EBook::Map );
   virtual ~L2Base() {}
 
   using fMarketDepthByMM_t    = std::function<void(const DepthByMM&)>;
   using fMarketDepthByOrder_t = std::function<void(const DepthByOrder&)>;
 
   void Set( fBookChanges_t&& fBid, fBookChanges_t&& fAsk ) {
-    m_LevelAggregateAsk.Set( std::move( fAsk ) );
-    m_LevelAggregateBid.Set( std::move( fBid ) );
+    m_pLevelBook->Set( std::move( fBid ), std::move( fAsk ) );
   }
   void Set( fVolumeAtPrice_t&& fBid, fVolumeAtPrice_t&& fAsk ) {
-    m_LevelAggregateAsk.Set( std::move( fAsk ) );
-    m_LevelAggregateBid.Set( std::move( fBid ) );
+    m_pLevelBook->Set( std::move( fBid ), std::move( fAsk ) );
   }
   void Set( fMarketDepthByMM_t&& fMarketDepth ) {  // callback for mm structure
     m_fMarketDepthByMM = std::move( fMarketDepth );
@@ -264,11 +450,7 @@ public:
 
 protected:
 
-  using MapLevelAggregateAsk_t = MapLevelAggregate<std::less<double> >;    // top of book: lowest price
-  using MapLevelAggregateBid_t = MapLevelAggregate<std::greater<double> >; // top of book: highest price
-
-  MapLevelAggregateAsk_t m_LevelAggregateAsk;
-  MapLevelAggregateBid_t m_LevelAggregateBid;
+  std::unique_ptr<LevelBook> m_pLevelBook;
 
   fMarketDepthByMM_t m_fMarketDepthByMM;
   fMarketDepthByOrder_t m_fMarketDepthByOrder;
@@ -297,10 +479,10 @@ public:
 
   using pMarketMaker_t = std::shared_ptr<MarketMaker>;
 
-  MarketMaker(): L2Base() {}
+  MarketMaker( EBook eBook = EBook::Map ): L2Base( eBook ) {}
   virtual ~MarketMaker() {}
 
-  static pMarketMaker_t Factory() { return std::make_shared<MarketMaker>(); }
+  static pMarketMaker_t Factory( EBook eBook = EBook::Map ) { return std::make_shared<MarketMaker>( eBook ); }
 
   virtual void OnMBOClear( const msg::OrderClear::decoded& ) { assert( false ); } // not sure if there is a clear message for market maker
   virtual void OnMBOAdd( const msg::OrderArrival::decoded& ) { assert( false ); }; // Equity doesn't have this message
@@ -355,10 +537,10 @@ public:
   // used to signal internal state to external message processors
   enum class EState { Ready, Add, Update, Delete, Clear };
 
-  OrderBased();
+  OrderBased( EBook = EBook::Map );
   virtual ~OrderBased() {}
 
-  static pOrderBased_t Factory() { return std::make_shared<OrderBased>(); }
+  static pOrderBased_t Factory( EBook eBook = EBook::Map ) { return std::make_shared<OrderBased>( eBook ); }
 
   virtual void OnMBOClear( const msg::OrderClear::decoded& msg );
   virtual void OnMBOSummary( const msg::OrderArrival::decoded& msg );
@@ -382,6 +564,10 @@ private:
     uint8_t nPrecision;
     // ptime, if needed
 
+    Order()
+    : dblPrice {}, nPriority {}, nQuantity {}, chOrderSide {}, nPrecision {}
+    {}
+
     Order( const msg::OrderArrival::decoded& msg )
     : dblPrice( msg.dblPrice )
     , nQuantity( msg.nQuantity )
@@ -401,7 +587,7 @@ private:
     {}
   };
 
-  using mapOrder_t = std::map<uint64_t,Order>; // key is order id
+  using mapOrder_t = ou::OrderMap<Order>; // key is order id
   mapOrder_t m_mapOrder;
 
   EState m_state;
@@ -464,6 +650,7 @@ public:
   void WatchDel( const std::string& );
 
   void Single( bool ); // optimize for a single symbol stream
+  void Book( L2Base::EBook ); // price level implementation for symbols not yet encountered
 
 protected:
 
@@ -482,6 +669,7 @@ protected:
 private:
 
   bool m_bSingle;  // don't use m_luSymbol, dedicated to single symbol
+  L2Base::EBook m_eBook;
   Carrier m_single; // carrier for single symbol
 
   fConnected_t m_fConnected;
@@ -540,11 +728,11 @@ private:
     pL2Base_t pL2Base;
     if ( ( 0 != msg.nOrderId ) || ( 'C' == msg.chMsgType ) ) {
       assert( 0 == msg.mmid.rch[0] );
-      pL2Base = OrderBased::Factory();
+      pL2Base = OrderBased::Factory( m_eBook );
     }
     else {
       //assert( 4 == msg.sMarketMaker.size() ); // TODO: check each character is non-zero
-      pL2Base = MarketMaker::Factory();
+      pL2Base = MarketMaker::Factory( m_eBook );
     }
     m_mapL2Base.emplace( msg.sSymbolName, pL2Base );
     carrier = pL2Base.get();
@@ -0,0 +1,345 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// FeatureSet vs FeatureEngine:  depth by order messages recorded by Collector (or a synthetic stream)
+//   are run once through an OrderBased book, the book changes are captured, then replayed into
+//   each feature implementation as rdaf/l2 StrategyFutures does, with a torch style accumulation
+//   of the model columns (32 per level, levels 1 - 3) on each change, then on each sentinel change; the accumulated sums must agree
+//   usage: TFIQFeedLevel2Features [levels [passes [hdf5 file depth series path]]]
+//     ie TFIQFeedLevel2Features 10 3 collector.hdf5 /app/collector/20261016-120000/depths_by_order/@ESZ26
+
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <TFHDF5TimeSeries/HDF5DataManager.h>
+#include <TFHDF5TimeSeries/HDF5TimeSeriesContainer.h>
+
+#include <TFIQFeed/Level2/Symbols.hpp>
+#include <TFIQFeed/Level2/FeatureSet.hpp>
+#include <TFIQFeed/Level2/FeatureEngine.hpp>
+
+namespace {
+
+using namespace ou::tf::iqfeed::l2;
+
+using clock_t_ = std::chrono::steady_clock;
+
+// the rdaf/l2 Torch_impl selection
+const std::vector<std::string> vModelNames = {
+  "ask.v1.volume", "ask.v1.price", "ask.v6.dPrice_dt", "ask.v6.dVolume_dt",
+  "ask.v7.intensityLimit", "ask.v7.intensityMarket", "ask.v7.intensityCancel",
+  "ask.v8.intensityLimit", "ask.v8.intensityMarket", "ask.v8.intensityCancel",
+  "ask.v8.relativeLimit", "ask.v8.relativeMarket", "ask.v8.relativeCancel",
+  "ask.v9.accelLimit", "ask.v9.accelMarket", "ask.v9.accelCancel",
+  "bid.v1.volume", "bid.v1.price", "bid.v6.dPrice_dt", "bid.v6.dVolume_dt",
+  "bid.v7.intensityLimit", "bid.v7.intensityMarket", "bid.v7.intensityCancel",
+  "bid.v8.intensityLimit", "bid.v8.intensityMarket", "bid.v8.intensityCancel",
+  "bid.v8.relativeLimit", "bid.v8.relativeMarket", "bid.v8.relativeCancel",
+  "bid.v9.accelLimit", "bid.v9.accelMarket", "bid.v9.accelCancel"
+};
+const size_t c_nModelLevels = 3;
+
+// the rdaf/l2 README configuration, or none, where every change is accumulated
+const FeatureSet::vSentinel_t vSentinelConfig = { "ask.v1.price", "bid.v1.price" };
+
+using vDepth_t = std::vector<ou::tf::DepthByOrder>;
+
+void Synthesize( size_t nMessages, vDepth_t& vDepth ) { // as bench/Replay.cpp, with advancing time
+
+  std::mt19937_64 rng( 42 );
+  std::normal_distribution<double> distOffset( 0.0, 15.0 ); // ticks away from the inside
+
+  using live_t = std::pair<uint64_t,char>; // order id, side
+  std::vector<live_t> vLive;
+  uint64_t idOrder( 1000 );
+
+  boost::posix_time::ptime dt( boost::gregorian::date( 2026, 10, 16 ), boost::posix_time::hours( 14 ) );
+
+  auto price = [&rng,&distOffset]( char side )->double {
+    const int offset = std::abs( distOffset( rng ) );
+    return ( 'A' == side ) ? 4000.25 + 0.25 * offset : 4000.00 - 0.25 * offset;
+  };
+
+  vDepth.reserve( nMessages );
+  for ( size_t ix = 0; ix < nMessages; ++ix ) {
+    dt += boost::posix_time::microseconds( 1 + rng() % 2000 );
+    const int r = rng() % 10;
+    if ( ( 4 > r ) || ( 50 > vLive.size() ) ) { // add
+      const char side = ( rng() & 1 ) ? 'A' : 'B';
+      vDepth.emplace_back( dt, dt, idOrder, 0, '3', side, price( side ), 1 + rng() % 20 );
+      vLive.emplace_back( idOrder, side );
+      ++idOrder;
+    }
+    else {
+      const size_t k = rng() % vLive.size();
+      const live_t live( vLive[ k ] );
+      if ( 7 > r ) { // update
+        vDepth.emplace_back( dt, dt, live.first, 0, '4', live.second, price( live.second ), 1 + rng() % 20 );
+      }
+      else { // delete
+        vDepth.emplace_back( dt, dt, live.first, 0, '5', live.second );
+        vLive[ k ] = vLive.back();
+        vLive.pop_back();
+      }
+    }
+  }
+}
+
+bool Load( const std::string& sFile, const std::string& sPath, vDepth_t& vDepth ) {
+  try {
+    ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO, sFile );
+    ou::tf::HDF5TimeSeriesContainer<ou::tf::DepthByOrder> repository( dm, sPath );
+    ou::tf::HDF5TimeSeriesContainer<ou::tf::DepthByOrder>::iterator begin( repository.begin() ), end( repository.end() );
+    ou::tf::DepthsByOrder depths;
+    depths.Resize( end - begin );
+    repository.Read( begin, end, &depths );
+    vDepth.reserve( depths.Size() );
+    for ( size_t ix = 0; ix < depths.Size(); ++ix ) vDepth.push_back( depths[ ix ] );
+  }
+  catch ( std::runtime_error& e ) {
+    std::cerr << "can not read " << sPath << " from " << sFile << ": " << e.what() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// a book change, as delivered to StrategyFutures
+struct Change {
+  ou::tf::Depth depth;
+  unsigned int ix;
+  EOp op;
+  OrderBased::EState state;
+  bool bAsk;
+};
+using vChange_t = std::vector<Change>;
+
+void Capture( const vDepth_t& vDepth, size_t nLevels, vChange_t& vChange ) {
+  OrderBased book;
+  auto fCapture = [&book,&vChange,nLevels]( bool bAsk ) {
+    return [&book,&vChange,nLevels,bAsk]( EOp op, unsigned int ix, const ou::tf::Depth& depth ){
+      if ( nLevels < ix ) return;
+      vChange.push_back( Change{ depth, ix, op, book.State(), bAsk } );
+    };
+  };
+  book.Set( fCapture( false ), fCapture( true ) );
+  for ( const ou::tf::DepthByOrder& depth: vDepth ) book.MarketDepth( depth );
+}
+
+// StrategyFutures HandleBookChanges / Inc* sequence, without market order counting
+template<typename Features>
+inline void Apply( Features& features, const Change& change ) {
+  if ( 0 == change.ix ) return;
+  const unsigned int ix( change.ix );
+  const ou::tf::Depth& depth( change.depth );
+  if ( change.bAsk ) features.HandleBookChangesAsk( change.op, ix, depth );
+  else               features.HandleBookChangesBid( change.op, ix, depth );
+  switch ( change.state ) {
+    case OrderBased::EState::Add:
+    case OrderBased::EState::Delete:
+      switch ( change.op ) {
+        case EOp::Increase:
+        case EOp::Insert:
+          if ( change.bAsk ) features.Ask_IncLimit( ix, depth );
+          else               features.Bid_IncLimit( ix, depth );
+          break;
+        case EOp::Decrease:
+        case EOp::Delete:
+          if ( change.bAsk ) features.Ask_IncCancel( ix, depth );
+          else               features.Bid_IncCancel( ix, depth );
+          break;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+struct Result {
+  double dblNsPerChange {};
+  size_t cntAccumulated {};
+  std::vector<double> vSum; // per model column
+};
+
+// as Torch_impl: one accumulator per column, referencing the FeatureSet_Level member
+Result RunFeatureSet( const vChange_t& vChange, size_t nLevels, const FeatureSet::vSentinel_t& vSentinel, size_t nPasses ) {
+
+  using Level = FeatureSet_Level;
+  using price_t = Level::price_t;
+  using volume_t = Level::volume_t;
+
+  Result result;
+
+  for ( size_t pass = 0; pass < nPasses; ++pass ) {
+
+    FeatureSet fs;
+    fs.Set( nLevels );
+    if ( !vSentinel.empty() ) fs.Set( vSentinel );
+
+    struct Accumulator {
+      const double* pDouble;
+      const volume_t* pVolume;
+      double accumulate;
+    };
+    std::vector<Accumulator> vAccumulator;
+    for ( size_t level = 1; level <= c_nModelLevels; ++level ) {
+      const Level& l( fs.FVS()[ level ] );
+      for ( const Level::BookLevel* p: { &l.ask, &l.bid } ) {
+        const Level::BookLevel& b( *p );
+        vAccumulator.push_back( { nullptr, &b.v1.volume, 0.0 } );
+        vAccumulator.push_back( { &b.v1.price, nullptr, 0.0 } );
+        vAccumulator.push_back( { &b.v6.dPrice_dt, nullptr, 0.0 } );
+        vAccumulator.push_back( { nullptr, &b.v6.dVolume_dt, 0.0 } );
+        for ( const double* pd: {
+          &b.v7.intensityLimit, &b.v7.intensityMarket, &b.v7.intensityCancel,
+          &b.v8.intensityLimit, &b.v8.intensityMarket, &b.v8.intensityCancel,
+          &b.v8.relativeLimit, &b.v8.relativeMarket, &b.v8.relativeCancel,
+          &b.v9.accelLimit, &b.v9.accelMarket, &b.v9.accelCancel } ) {
+          vAccumulator.push_back( { pd, nullptr, 0.0 } );
+        }
+      }
+    }
+    static_assert( std::is_same<price_t, double>::value, "price_t is double" );
+
+    size_t cntAccumulated {};
+    const auto start = clock_t_::now();
+    for ( const Change& change: vChange ) {
+      Apply( fs, change );
+      bool bChanged( false );
+      fs.Changed( bChanged );
+      if ( bChanged ) {
+        for ( Accumulator& accumulator: vAccumulator ) {
+          accumulator.accumulate += ( nullptr != accumulator.pDouble ) ? *accumulator.pDouble : *accumulator.pVolume;
+        }
+        ++cntAccumulated;
+      }
+    }
+    const double dblNs = std::chrono::duration<double,std::nano>( clock_t_::now() - start ).count() / vChange.size();
+
+    if ( ( 0 == pass ) || ( dblNs < result.dblNsPerChange ) ) result.dblNsPerChange = dblNs;
+    result.cntAccumulated = cntAccumulated;
+    result.vSum.clear();
+    for ( const Accumulator& accumulator: vAccumulator ) result.vSum.push_back( accumulator.accumulate );
+  }
+
+  return result;
+}
+
+// the engine row is already in model column order
+Result RunFeatureEngine( const vChange_t& vChange, size_t nLevels, const FeatureEngine::vSentinel_t& vSentinel, size_t nPasses ) {
+
+  FeatureEngine::vName_t vColumn;
+  for ( size_t level = 1; level <= c_nModelLevels; ++level ) {
+    for ( const std::string& sName: vModelNames ) vColumn.push_back( sName + ".l" + std::to_string( level ) );
+  }
+
+  Result result;
+
+  for ( size_t pass = 0; pass < nPasses; ++pass ) {
+
+    FeatureEngine fe( nLevels, vColumn );
+    if ( !vSentinel.empty() ) fe.Set( vSentinel );
+    const float* pRow( fe.Data() );
+    const size_t nColumns( fe.Size() );
+    std::vector<double> vAccumulate( nColumns, 0.0 );
+
+    size_t cntAccumulated {};
+    const auto start = clock_t_::now();
+    for ( const Change& change: vChange ) {
+      Apply( fe, change );
+      bool bChanged( false );
+      fe.Changed( bChanged );
+      if ( bChanged ) {
+        double* pAccumulate( vAccumulate.data() );
+        for ( size_t ix = 0; ix < nColumns; ++ix ) pAccumulate[ ix ] += pRow[ ix ];
+        ++cntAccumulated;
+      }
+    }
+    const double dblNs = std::chrono::duration<double,std::nano>( clock_t_::now() - start ).count() / vChange.size();
+
+    if ( ( 0 == pass ) || ( dblNs < result.dblNsPerChange ) ) result.dblNsPerChange = dblNs;
+    result.cntAccumulated = cntAccumulated;
+    result.vSum = vAccumulate;
+  }
+
+  return result;
+}
+
+bool Compare( const char* szName, const vChange_t& vChange, size_t nLevels, const FeatureSet::vSentinel_t& vSentinel, size_t nPasses ) {
+
+  const Result set = RunFeatureSet( vChange, nLevels, vSentinel, nPasses );
+  const Result engine = RunFeatureEngine( vChange, nLevels, vSentinel, nPasses );
+  std::cout
+    << szName << ": "
+    << "FeatureSet " << set.dblNsPerChange << " ns/change, "
+    << "FeatureEngine " << engine.dblNsPerChange << " ns/change, "
+    << set.cntAccumulated << "/" << engine.cntAccumulated << " accumulated"
+    << std::endl;
+
+  // the engine row is float, so allow for its rounding over the accumulation
+  size_t nMismatch {};
+  for ( size_t ix = 0; ix < set.vSum.size(); ++ix ) {
+    const double a( set.vSum[ ix ] );
+    const double b( engine.vSum[ ix ] );
+    if ( std::abs( a - b ) > 1e-5 * std::max( 1.0, std::max( std::abs( a ), std::abs( b ) ) ) ) {
+      if ( 5 > nMismatch ) {
+        std::cout
+          << "  column " << vModelNames[ ix % vModelNames.size() ] << ".l" << ( 1 + ix / vModelNames.size() )
+          << ": " << a << " vs " << b << std::endl;
+      }
+      ++nMismatch;
+    }
+  }
+  if ( ( set.cntAccumulated != engine.cntAccumulated ) || ( 0 != nMismatch ) ) {
+    std::cout << "  " << nMismatch << " columns differ" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nLevels = ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 10;
+  const size_t nPasses = ( 2 < argc ) ? std::stoul( argv[ 2 ] ) : 3;
+  if ( c_nModelLevels > nLevels ) {
+    std::cerr << "levels must be at least " << c_nModelLevels << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vDepth_t vDepth;
+  if ( 4 < argc ) {
+    if ( !Load( argv[ 3 ], argv[ 4 ], vDepth ) ) return EXIT_FAILURE;
+  }
+  else {
+    Synthesize( 2000000, vDepth );
+  }
+
+  vChange_t vChange;
+  Capture( vDepth, nLevels, vChange );
+  std::cout
+    << vDepth.size() << " messages, " << vChange.size() << " book changes within " << nLevels << " levels, "
+    << "best of " << nPasses << std::endl;
+
+  if ( !Compare( "every change", vChange, nLevels, {}, nPasses ) ) return EXIT_FAILURE;
+  if ( !Compare( "sentinels   ", vChange, nLevels, vSentinelConfig, nPasses ) ) return EXIT_FAILURE;
+
+  std::cout << "accumulated columns match" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// l2::OrderBased replay:  one synthetic depth by order stream (adds, updates, deletes clustered
+//   around the inside), recorded once, then replayed through the Map and the Flat price level books;
+//   the book change callback streams must be identical
+//   usage: TFIQFeedLevel2Replay [messages [passes]]
+
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <iostream>
+
+#include <TFIQFeed/Level2/Symbols.hpp>
+
+namespace {
+
+using namespace ou::tf::iqfeed::l2;
+
+using vDepth_t = std::vector<ou::tf::DepthByOrder>;
+
+void Record( size_t nMessages, vDepth_t& vDepth ) {
+
+  std::mt19937_64 rng( 42 );
+  std::normal_distribution<double> distOffset( 0.0, 15.0 ); // ticks away from the inside
+
+  using live_t = std::pair<uint64_t,char>; // order id, side
+  std::vector<live_t> vLive;
+  uint64_t idOrder( 1000 );
+
+  const boost::posix_time::ptime dt( boost::gregorian::date( 2026, 10, 16 ), boost::posix_time::hours( 14 ) );
+
+  auto price = [&rng,&distOffset]( char side )->double {
+    const int offset = std::abs( distOffset( rng ) );
+    return ( 'A' == side ) ? 4000.25 + 0.25 * offset : 4000.00 - 0.25 * offset;
+  };
+
+  vDepth.reserve( nMessages );
+  for ( size_t ix = 0; ix < nMessages; ++ix ) {
+    const int r = rng() % 10;
+    if ( ( 4 > r ) || ( 50 > vLive.size() ) ) { // add
+      const char side = ( rng() & 1 ) ? 'A' : 'B';
+      vDepth.emplace_back( dt, dt, idOrder, 0, '3', side, price( side ), 1 + rng() % 20 );
+      vLive.emplace_back( idOrder, side );
+      ++idOrder;
+    }
+    else {
+      const size_t k = rng() % vLive.size();
+      const live_t live( vLive[ k ] );
+      if ( 7 > r ) { // update
+        vDepth.emplace_back( dt, dt, live.first, 0, '4', live.second, price( live.second ), 1 + rng() % 20 );
+      }
+      else { // delete
+        vDepth.emplace_back( dt, dt, live.first, 0, '5', live.second );
+        vLive[ k ] = vLive.back();
+        vLive.pop_back();
+      }
+    }
+  }
+}
+
+struct Result {
+  size_t cntCallbacks {};
+  uint64_t hash {};
+  double dblNsPerMessage {};
+};
+
+Result Replay( L2Base::EBook eBook, const vDepth_t& vDepth, size_t nPasses ) {
+
+  using clock = std::chrono::steady_clock;
+  Result result;
+
+  for ( size_t pass = 0; pass < nPasses; ++pass ) {
+
+    size_t cntCallbacks {};
+    uint64_t hash {};
+
+    auto fBookChanges = [&cntCallbacks,&hash]( char side ) {
+      return [&cntCallbacks,&hash,side]( EOp op, unsigned int ix, const ou::tf::Depth& depth ){
+        ++cntCallbacks;
+        hash = ( hash * 1000003 ) ^ (
+          31 * (uint64_t)op + 7 * ix + (uint64_t)std::llround( 100.0 * depth.Price() ) + 13 * depth.Volume() + side );
+      };
+    };
+
+    OrderBased book( eBook );
+    book.Set( fBookChanges( 'B' ), fBookChanges( 'A' ) );
+
+    const auto start = clock::now();
+    for ( const ou::tf::DepthByOrder& depth: vDepth ) {
+      book.MarketDepth( depth );
+    }
+    const double dblNs = std::chrono::duration<double,std::nano>( clock::now() - start ).count() / vDepth.size();
+
+    if ( ( 0 == pass ) || ( dblNs < result.dblNsPerMessage ) ) result.dblNsPerMessage = dblNs;
+    result.cntCallbacks = cntCallbacks;
+    result.hash = hash;
+  }
+
+  return result;
+}
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nMessages = ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 2000000;
+  const size_t nPasses = ( 2 < argc ) ? std::stoul( argv[ 2 ] ) : 3;
+
+  vDepth_t vDepth;
+  Record( nMessages, vDepth );
+  std::cout << vDepth.size() << " messages, best of " << nPasses << std::endl;
+
+  const Result map = Replay( L2Base::EBook::Map, vDepth, nPasses );
+  std::cout << "map:  " << map.dblNsPerMessage << " ns/message, " << map.cntCallbacks << " callbacks" << std::endl;
+
+  const Result flat = Replay( L2Base::EBook::Flat, vDepth, nPasses );
+  std::cout << "flat: " << flat.dblNsPerMessage << " ns/message, " << flat.cntCallbacks << " callbacks" << std::endl;
+
+  if ( ( map.cntCallbacks != flat.cntCallbacks ) || ( map.hash != flat.hash ) ) {
+    std::cout << "callback streams differ" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "callback streams match" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -33,6 +33,7 @@ namespace detail {
   // shared between debug and release
   const std::string sFileNameMarketSymbolsText( "../mktsymbols_v2.txt" );
   const std::string sFileNameMarketSymbolsBinary( "../symbols.ser" );
+  const std::string sFileNameMarketSymbolsSnapshot( "../symbols.snap" );
 }
 
 typedef MarketSymbol::TableRowDef trd_t;
@@ -26,6 +26,7 @@ namespace detail {
   // shared between debug and release
   extern const std::string sFileNameMarketSymbolsText;
   extern const std::string sFileNameMarketSymbolsBinary;
+  extern const std::string sFileNameMarketSymbolsSnapshot; // MktSymbolSnapshot
 }
 
 namespace MktSymbolLoadType {
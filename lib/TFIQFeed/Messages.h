@@ -16,6 +16,7 @@
 
 #include <string>
 #include <vector>
+#include <string_view>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 
@@ -93,6 +94,7 @@ public:
 
   // change to return a fielddelimiter_t
   const std::string Field( ixFields_t ) const;
+  std::string_view FieldView( ixFields_t ) const; // no allocation, valid while the line buffer is held
   double Double( ixFields_t ) const;  // use boost::spirit?
   int Integer( ixFields_t ) const;  // use boost::spirit?
   date Date( ixFields_t ) const;
@@ -585,6 +587,18 @@ const std::string IQFBaseMessage<T, charT>::Field( ixFields_t fld ) const {
   return sField;
 }
 
+template <class T, class charT>
+std::string_view IQFBaseMessage<T, charT>::FieldView( ixFields_t fld ) const {
+  static_assert( 1 == sizeof( charT ), "FieldView requires single byte characters" );
+  BOOST_ASSERT( 0 != fld );
+  BOOST_ASSERT( fld <= m_vFieldDelimiters.size() - 1 );
+  const fielddelimiter_t& fielddelimiter( m_vFieldDelimiters[ fld ] );
+  if ( fielddelimiter.first == fielddelimiter.second ) return std::string_view();
+  return std::string_view(
+    reinterpret_cast<const char*>( &*fielddelimiter.first ),
+    fielddelimiter.second - fielddelimiter.first );
+}
+
 template <class T, class charT>
 double IQFBaseMessage<T, charT>::Double( ixFields_t fld ) const {
   BOOST_ASSERT( 0 != fld );
@@ -0,0 +1,397 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    MktSymbolSnapshot.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFIQFeed
+ * Created: October 17, 2026 17:40
+ */
+
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include "ValidateMktSymbolLine.h"
+#include "InMemoryMktSymbolList.h"
+
+#include "MktSymbolSnapshot.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+
+namespace {
+
+  static const char rchMagic[ 4 ] = { 'O', 'U', 'M', 'S' };
+  static const uint16_t nVersion = 1;
+
+  static_assert( 48 == sizeof( MktSymbolSnapshot::Record ), "MktSymbolSnapshot::Record layout" );
+
+  using trd_t = MktSymbolSnapshot::trd_t;
+  using vTrd_t = std::vector<const trd_t*>;
+
+  inline uint64_t Align( uint64_t n ) { return ( n + 7 ) & ~uint64_t( 7 ); }
+
+  // records are sorted by symbol and unique, as InMemoryMktSymbolList's ixSymbol
+  void Save( const vTrd_t& vTrd, const std::string& sPath ) {
+
+    const size_t nRecords( vTrd.size() );
+
+    // intern the strings
+    std::vector<char> vString( 1, '\0' );
+    std::unordered_map<std::string_view, uint32_t> mapString;
+    auto intern = [&vString,&mapString,&sPath]( const std::string& s )->uint32_t {
+      if ( s.empty() ) return 0;
+      const std::string_view sv( s );
+      auto iter = mapString.find( sv );
+      if ( mapString.end() == iter ) {
+        if ( std::numeric_limits<uint32_t>::max() < ( vString.size() + s.size() + 1 ) ) {
+          throw std::runtime_error( "MktSymbolSnapshot::Write string section too large: " + sPath );
+        }
+        iter = mapString.emplace( sv, (uint32_t)vString.size() ).first;
+        vString.insert( vString.end(), s.begin(), s.end() );
+        vString.push_back( '\0' );
+      }
+      return iter->second;
+    };
+
+    std::vector<MktSymbolSnapshot::Record> vRecord( nRecords );
+    for ( size_t ix = 0; ix < nRecords; ix++ ) {
+      const trd_t& trd( *vTrd[ ix ] );
+      MktSymbolSnapshot::Record& record( vRecord[ ix ] );
+      std::memset( &record, 0, sizeof( record ) );
+      record.dblStrike = trd.dblStrike;
+      record.ixSymbol = intern( trd.sSymbol );
+      record.ixDescription = intern( trd.sDescription );
+      record.ixExchange = intern( trd.sExchange );
+      record.ixListedMarket = intern( trd.sListedMarket );
+      record.ixUnderlying = intern( trd.sUnderlying );
+      record.nSIC = trd.nSIC;
+      record.nNAICS = trd.nNAICS;
+      record.nMultiplier = trd.nMultiplier;
+      record.nYear = trd.nYear;
+      record.nMonth = trd.nMonth;
+      record.nDay = trd.nDay;
+      record.eSecurityType = (uint8_t)trd.sc;
+      record.eOptionSide = (uint8_t)trd.eOptionSide;
+      record.bFrontMonth = trd.bFrontMonth;
+      record.bHasOptions = trd.bHasOptions;
+    }
+
+    // secondary indexes, stable so symbol order is kept within a key
+    auto index = [&vTrd,nRecords]( auto less )->std::vector<uint32_t> {
+      std::vector<uint32_t> vIndex( nRecords );
+      std::iota( vIndex.begin(), vIndex.end(), 0 );
+      std::stable_sort(
+        vIndex.begin(), vIndex.end(),
+        [&vTrd,&less]( uint32_t lhs, uint32_t rhs ){ return less( *vTrd[ lhs ], *vTrd[ rhs ] ); } );
+      return vIndex;
+    };
+    const std::vector<uint32_t> vExchange( index( []( const trd_t& lhs, const trd_t& rhs ){ return lhs.sExchange < rhs.sExchange; } ) );
+    const std::vector<uint32_t> vType( index( []( const trd_t& lhs, const trd_t& rhs ){ return lhs.sc < rhs.sc; } ) );
+    const std::vector<uint32_t> vUnderlying( index( []( const trd_t& lhs, const trd_t& rhs ){ return lhs.sUnderlying < rhs.sUnderlying; } ) );
+
+    MktSymbolSnapshot::Header header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.rchMagic, rchMagic, sizeof( rchMagic ) );
+    header.nVersion = nVersion;
+    header.nRecordSize = sizeof( MktSymbolSnapshot::Record );
+    header.nRecords = nRecords;
+    header.ixRecords = Align( sizeof( header ) );
+    header.ixExchange = Align( header.ixRecords + nRecords * sizeof( MktSymbolSnapshot::Record ) );
+    header.ixType = Align( header.ixExchange + nRecords * sizeof( uint32_t ) );
+    header.ixUnderlying = Align( header.ixType + nRecords * sizeof( uint32_t ) );
+    header.ixStrings = Align( header.ixUnderlying + nRecords * sizeof( uint32_t ) );
+    header.nStrings = vString.size();
+
+    std::ofstream out( sPath, std::ios::binary | std::ios::trunc );
+    if ( !out ) {
+      throw std::runtime_error( "MktSymbolSnapshot::Write can not open: " + sPath );
+    }
+
+    auto pad = [&out](){
+      static const char rchZero[ 8 ] {};
+      const size_t n( Align( out.tellp() ) - out.tellp() );
+      out.write( rchZero, n );
+    };
+
+    out.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+    pad();
+    out.write( reinterpret_cast<const char*>( vRecord.data() ), nRecords * sizeof( MktSymbolSnapshot::Record ) );
+    pad();
+    out.write( reinterpret_cast<const char*>( vExchange.data() ), nRecords * sizeof( uint32_t ) );
+    pad();
+    out.write( reinterpret_cast<const char*>( vType.data() ), nRecords * sizeof( uint32_t ) );
+    pad();
+    out.write( reinterpret_cast<const char*>( vUnderlying.data() ), nRecords * sizeof( uint32_t ) );
+    pad();
+    out.write( vString.data(), vString.size() );
+
+    if ( !out ) {
+      throw std::runtime_error( "MktSymbolSnapshot::Write write failed: " + sPath );
+    }
+  }
+
+  // ==== Build support
+
+  struct Chunk {
+    const char* pBegin;
+    const char* pEnd;
+    std::vector<trd_t> vTrd;
+    std::unique_ptr<ValidateMktSymbolLine> pValidator;
+    void Append( const trd_t& trd ) { vTrd.push_back( trd ); }
+  };
+
+  // the merged, symbol ordered, list for ValidateMktSymbolLine::PostProcess
+  struct Merged {
+    vTrd_t vTrd;
+    trd_t* Find( const std::string& sSymbol ) {
+      vTrd_t::iterator iter = std::lower_bound(
+        vTrd.begin(), vTrd.end(), sSymbol,
+        []( const trd_t* p, const std::string& s ){ return p->sSymbol < s; } );
+      return ( ( vTrd.end() != iter ) && ( sSymbol == (*iter)->sSymbol ) ) ? const_cast<trd_t*>( *iter ) : nullptr;
+    }
+    bool HandleSymbolHasOption( const std::string& sSymbol ) {
+      trd_t* p( Find( sSymbol ) );
+      if ( nullptr != p ) p->bHasOptions = true;
+      return nullptr != p;
+    }
+    void HandleUpdateOptionUnderlying( const std::string& sSymbol, const std::string& sUnderlying ) {
+      trd_t* p( Find( sSymbol ) );
+      if ( nullptr != p ) p->sUnderlying = sUnderlying;
+    }
+  };
+
+} // namespace anonymous
+
+// ==== writers
+
+void MktSymbolSnapshot::Write( const InMemoryMktSymbolList& list, const std::string& sPath ) {
+  vTrd_t vTrd;
+  vTrd.reserve( list.Size() );
+  list.ScanSymbols( [&vTrd]( const trd_t& trd ){ vTrd.push_back( &trd ); } );
+  Save( vTrd, sPath );
+}
+
+size_t MktSymbolSnapshot::Build( const std::string& sPathText, const std::string& sPath, unsigned int nThreads ) {
+
+  boost::interprocess::file_mapping file;
+  boost::interprocess::mapped_region region;
+  try {
+    file = boost::interprocess::file_mapping( sPathText.c_str(), boost::interprocess::read_only );
+    region = boost::interprocess::mapped_region( file, boost::interprocess::read_only );
+  }
+  catch ( const boost::interprocess::interprocess_exception& e ) {
+    throw std::runtime_error( "MktSymbolSnapshot::Build can not map " + sPathText + ": " + e.what() );
+  }
+
+  const char* pBegin( static_cast<const char*>( region.get_address() ) );
+  const char* pEnd( pBegin + region.get_size() );
+
+  pBegin = std::find( pBegin, pEnd, '\n' ); // remove header line
+  if ( pEnd != pBegin ) pBegin++;
+
+  if ( 0 == nThreads ) nThreads = std::max( 1u, std::thread::hardware_concurrency() );
+
+  // chunks end on line boundaries
+  std::vector<Chunk> vChunk( nThreads );
+  const size_t nChunk( ( pEnd - pBegin ) / nThreads );
+  const char* p( pBegin );
+  for ( Chunk& chunk: vChunk ) {
+    chunk.pBegin = p;
+    p = ( ( pEnd - p ) > (ptrdiff_t)nChunk ) ? std::find( p + nChunk, pEnd, '\n' ) : pEnd;
+    if ( pEnd != p ) p++;
+    chunk.pEnd = p;
+  }
+  vChunk.back().pEnd = pEnd;
+
+  std::vector<std::thread> vThread;
+  for ( Chunk& chunk: vChunk ) {
+    chunk.pValidator = std::make_unique<ValidateMktSymbolLine>();
+    chunk.pValidator->SetOnProcessLine( MakeDelegate( &chunk, &Chunk::Append ) );
+    vThread.emplace_back(
+      [&chunk](){
+        const char* pBegin( chunk.pBegin );
+        const char* pEnd( chunk.pEnd );
+        while ( pBegin != pEnd ) {
+          chunk.pValidator->Parse( pBegin, pEnd );
+        }
+      } );
+  }
+  size_t nLines {};
+  for ( size_t ix = 0; ix < vThread.size(); ix++ ) {
+    vThread[ ix ].join();
+    nLines += vChunk[ ix ].pValidator->LinesProcessed();
+  }
+
+  // merge in file order, the first of a duplicated symbol is kept, as InMemoryMktSymbolList
+  Merged merged;
+  for ( Chunk& chunk: vChunk ) {
+    for ( const trd_t& trd: chunk.vTrd ) merged.vTrd.push_back( &trd );
+  }
+  std::stable_sort(
+    merged.vTrd.begin(), merged.vTrd.end(),
+    []( const trd_t* lhs, const trd_t* rhs ){ return lhs->sSymbol < rhs->sSymbol; } );
+  merged.vTrd.erase(
+    std::unique(
+      merged.vTrd.begin(), merged.vTrd.end(),
+      []( const trd_t* lhs, const trd_t* rhs ){ return lhs->sSymbol == rhs->sSymbol; } ),
+    merged.vTrd.end() );
+
+  // each validator knows the options of its own chunk, their underlyings are looked up in the merged list
+  for ( Chunk& chunk: vChunk ) {
+    chunk.pValidator->SetOnProcessHasOption( MakeDelegate( &merged, &Merged::HandleSymbolHasOption ) );
+    chunk.pValidator->SetOnUpdateOptionUnderlying( MakeDelegate( &merged, &Merged::HandleUpdateOptionUnderlying ) );
+    chunk.pValidator->PostProcess();
+  }
+
+  Save( merged.vTrd, sPath );
+
+  std::cout
+    << "MktSymbolSnapshot::Build " << nLines << " lines, "
+    << merged.vTrd.size() << " symbols, "
+    << nThreads << " threads"
+    << std::endl;
+
+  return merged.vTrd.size();
+}
+
+// ==== reader
+
+MktSymbolSnapshot::MktSymbolSnapshot( const std::string& sPath )
+: m_pBase( nullptr ), m_pHeader( nullptr ), m_pRecord( nullptr )
+, m_pExchange( nullptr ), m_pType( nullptr ), m_pUnderlying( nullptr )
+, m_pString( nullptr )
+{
+  try {
+    m_file = boost::interprocess::file_mapping( sPath.c_str(), boost::interprocess::read_only );
+    m_region = boost::interprocess::mapped_region( m_file, boost::interprocess::read_only );
+  }
+  catch ( const boost::interprocess::interprocess_exception& e ) {
+    throw std::runtime_error( "MktSymbolSnapshot can not map " + sPath + ": " + e.what() );
+  }
+
+  const size_t nFileSize( m_region.get_size() );
+  m_pBase = static_cast<const char*>( m_region.get_address() );
+  m_pHeader = reinterpret_cast<const Header*>( m_pBase );
+
+  if ( ( sizeof( Header ) > nFileSize ) || ( 0 != std::memcmp( m_pHeader->rchMagic, rchMagic, sizeof( rchMagic ) ) ) ) {
+    throw std::runtime_error( "MktSymbolSnapshot not a symbol snapshot: " + sPath );
+  }
+  if ( ( nVersion != m_pHeader->nVersion ) || ( sizeof( Record ) != m_pHeader->nRecordSize ) ) {
+    throw std::runtime_error( "MktSymbolSnapshot unknown version: " + sPath );
+  }
+
+  const uint64_t nRecords( m_pHeader->nRecords );
+  if (
+       ( nFileSize < ( m_pHeader->ixRecords + nRecords * sizeof( Record ) ) )
+    || ( nFileSize < ( m_pHeader->ixExchange + nRecords * sizeof( uint32_t ) ) )
+    || ( nFileSize < ( m_pHeader->ixType + nRecords * sizeof( uint32_t ) ) )
+    || ( nFileSize < ( m_pHeader->ixUnderlying + nRecords * sizeof( uint32_t ) ) )
+    || ( nFileSize < ( m_pHeader->ixStrings + m_pHeader->nStrings ) )
+    || ( 0 == m_pHeader->nStrings )
+    || ( '\0' != m_pBase[ m_pHeader->ixStrings + m_pHeader->nStrings - 1 ] )
+  ) {
+    throw std::runtime_error( "MktSymbolSnapshot truncated: " + sPath );
+  }
+
+  m_pRecord = reinterpret_cast<const Record*>( m_pBase + m_pHeader->ixRecords );
+  m_pExchange = reinterpret_cast<const uint32_t*>( m_pBase + m_pHeader->ixExchange );
+  m_pType = reinterpret_cast<const uint32_t*>( m_pBase + m_pHeader->ixType );
+  m_pUnderlying = reinterpret_cast<const uint32_t*>( m_pBase + m_pHeader->ixUnderlying );
+  m_pString = m_pBase + m_pHeader->ixStrings;
+}
+
+MktSymbolSnapshot::~MktSymbolSnapshot() {}
+
+const MktSymbolSnapshot::Record* MktSymbolSnapshot::Find( const std::string& sName ) const {
+  const Record* pEnd( m_pRecord + m_pHeader->nRecords );
+  const Record* p = std::lower_bound(
+    m_pRecord, pEnd, sName,
+    [this]( const Record& record, const std::string& s ){ return 0 > std::strcmp( String( record.ixSymbol ), s.c_str() ); } );
+  return ( ( pEnd != p ) && ( sName == String( p->ixSymbol ) ) ) ? p : nullptr;
+}
+
+MktSymbolSnapshot::trd_t MktSymbolSnapshot::GetTrd( const std::string& sName ) const {
+  const Record* p( Find( sName ) );
+  if ( nullptr == p ) {
+    throw std::runtime_error( "GetTrd can't find " + sName );
+  }
+  return Decode( *p );
+}
+
+MktSymbolSnapshot::trd_t MktSymbolSnapshot::Decode( const Record& record ) const {
+  trd_t trd;
+  trd.sSymbol = String( record.ixSymbol );
+  trd.sDescription = String( record.ixDescription );
+  trd.sExchange = String( record.ixExchange );
+  trd.sListedMarket = String( record.ixListedMarket );
+  trd.sc = (ESecurityType)record.eSecurityType;
+  trd.nMultiplier = record.nMultiplier;
+  trd.nSIC = record.nSIC;
+  trd.nNAICS = record.nNAICS;
+  trd.sUnderlying = String( record.ixUnderlying );
+  trd.eOptionSide = (ou::tf::OptionSide::EOptionSide)record.eOptionSide;
+  trd.dblStrike = record.dblStrike;
+  trd.nYear = record.nYear;
+  trd.nMonth = record.nMonth;
+  trd.nDay = record.nDay;
+  trd.bFrontMonth = record.bFrontMonth;
+  trd.bHasOptions = record.bHasOptions;
+  return trd;
+}
+
+// the index entries for a key are contiguous, found with a binary search on the record the entry names
+
+MktSymbolSnapshot::range_t MktSymbolSnapshot::EqualRangeExchange( const std::string& sExchange ) const {
+  struct Compare {
+    const MktSymbolSnapshot* pSnapshot;
+    const char* Key( uint32_t ix ) const { return pSnapshot->String( pSnapshot->At( ix ).ixExchange ); }
+    bool operator()( uint32_t ix, const char* sz ) const { return 0 > std::strcmp( Key( ix ), sz ); }
+    bool operator()( const char* sz, uint32_t ix ) const { return 0 > std::strcmp( sz, Key( ix ) ); }
+  };
+  return std::equal_range( m_pExchange, m_pExchange + m_pHeader->nRecords, sExchange.c_str(), Compare { this } );
+}
+
+MktSymbolSnapshot::range_t MktSymbolSnapshot::EqualRangeType( ESecurityType sc ) const {
+  struct Compare {
+    const Record* pRecord;
+    bool operator()( uint32_t ix, uint8_t sc ) const { return pRecord[ ix ].eSecurityType < sc; }
+    bool operator()( uint8_t sc, uint32_t ix ) const { return sc < pRecord[ ix ].eSecurityType; }
+  };
+  return std::equal_range( m_pType, m_pType + m_pHeader->nRecords, (uint8_t)sc, Compare { m_pRecord } );
+}
+
+MktSymbolSnapshot::range_t MktSymbolSnapshot::EqualRangeUnderlying( const std::string& sUnderlying ) const {
+  struct Compare {
+    const MktSymbolSnapshot* pSnapshot;
+    const char* Key( uint32_t ix ) const { return pSnapshot->String( pSnapshot->At( ix ).ixUnderlying ); }
+    bool operator()( uint32_t ix, const char* sz ) const { return 0 > std::strcmp( Key( ix ), sz ); }
+    bool operator()( const char* sz, uint32_t ix ) const { return 0 > std::strcmp( sz, Key( ix ) ); }
+  };
+  return std::equal_range( m_pUnderlying, m_pUnderlying + m_pHeader->nRecords, sUnderlying.c_str(), Compare { this } );
+}
+
+} // namespace iqfeed
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,161 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    MktSymbolSnapshot.h
+ * Author:  raymond@burkholder.net
+ * Project: TFIQFeed
+ * Created: October 17, 2026 17:40
+ */
+
+#pragma once
+
+// read only, memory mapped, alternative to InMemoryMktSymbolList::LoadFromFile:
+//   fixed width records sorted by symbol, strings interned into one section,
+//   record number indexes prebuilt for exchange, security type and underlying.
+//   nothing is deserialized on open, a lookup is a binary search over the mapping,
+//   and only the records visited are decoded into a TableRowDef.
+
+#include <string>
+#include <cstdint>
+#include <utility>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "SecurityType.h"
+#include "MarketSymbol.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+
+class InMemoryMktSymbolList;
+
+class MktSymbolSnapshot {
+public:
+
+  using trd_t = ou::tf::iqfeed::MarketSymbol::TableRowDef;
+
+  struct Header {        // all sections are 8 byte aligned
+    char rchMagic[4];    // OUMS
+    uint16_t nVersion;
+    uint16_t nRecordSize;
+    uint64_t nRecords;
+    uint64_t ixRecords;    // Record[ nRecords ], by symbol
+    uint64_t ixExchange;   // uint32_t[ nRecords ] record numbers, by exchange then symbol
+    uint64_t ixType;       // by security type then symbol
+    uint64_t ixUnderlying; // by underlying then symbol
+    uint64_t ixStrings;    // nul terminated, offset 0 is the empty string
+    uint64_t nStrings;     // bytes
+  };
+
+  struct Record {
+    double dblStrike;
+    uint32_t ixSymbol;      // offsets into the string section
+    uint32_t ixDescription;
+    uint32_t ixExchange;
+    uint32_t ixListedMarket;
+    uint32_t ixUnderlying;
+    uint32_t nSIC;
+    uint32_t nNAICS;
+    uint16_t nMultiplier;
+    uint16_t nYear;
+    uint8_t nMonth;
+    uint8_t nDay;
+    uint8_t eSecurityType;
+    uint8_t eOptionSide;
+    uint8_t bFrontMonth;
+    uint8_t bHasOptions;
+    uint8_t rchPad[2];
+  };
+
+  MktSymbolSnapshot( const std::string& sPath ); // throws std::runtime_error
+  ~MktSymbolSnapshot();
+
+  // write a snapshot of a loaded list
+  static void Write( const InMemoryMktSymbolList&, const std::string& sPath );
+
+  // daily refresh: parse the mktsymbols_v2.txt text in nThreads chunks, then write the snapshot
+  //   0 == nThreads uses the hardware concurrency, returns the number of symbols written
+  static size_t Build( const std::string& sPathText, const std::string& sPath, unsigned int nThreads = 0 );
+
+  size_t Size() const { return m_pHeader->nRecords; }
+
+  bool Exists( const std::string& sName ) const { return nullptr != Find( sName ); }
+  const Record* Find( const std::string& sName ) const; // nullptr when not found
+  trd_t GetTrd( const std::string& sName ) const; // throws std::runtime_error when not found
+
+  const Record& At( size_t ix ) const { return m_pRecord[ ix ]; } // in symbol order
+  const char* String( uint32_t ix ) const { return m_pString + ix; }
+  trd_t Decode( const Record& ) const;
+
+  template<typename Function>
+  void SelectOptionsByUnderlying( const std::string& sUnderlying, Function f ) const {
+    const range_t range( EqualRangeUnderlying( sUnderlying ) );
+    for ( const uint32_t* p = range.first; range.second != p; p++ ) {
+      f( Decode( m_pRecord[ *p ] ) );
+    }
+  }
+
+  template<typename ExchangeIterator, typename Function>
+  void SelectSymbolsByExchange( ExchangeIterator beginExchange, ExchangeIterator endExchange, Function f ) const {
+    while ( beginExchange != endExchange ) {
+      const range_t range( EqualRangeExchange( *beginExchange ) );
+      for ( const uint32_t* p = range.first; range.second != p; p++ ) {
+        f( Decode( m_pRecord[ *p ] ) );
+      }
+      beginExchange++;
+    }
+  }
+
+  template<typename Function>
+  void SelectSymbolsByType( ESecurityType sc, Function f ) const {
+    const range_t range( EqualRangeType( sc ) );
+    for ( const uint32_t* p = range.first; range.second != p; p++ ) {
+      f( Decode( m_pRecord[ *p ] ) );
+    }
+  }
+
+  template<typename Function>
+  void ScanSymbols( Function f ) const {
+    for ( size_t ix = 0; ix < m_pHeader->nRecords; ix++ ) {
+      f( Decode( m_pRecord[ ix ] ) );
+    }
+  }
+
+protected:
+private:
+
+  using range_t = std::pair<const uint32_t*, const uint32_t*>;
+
+  boost::interprocess::file_mapping m_file;
+  boost::interprocess::mapped_region m_region;
+
+  const char* m_pBase;
+  const Header* m_pHeader;
+  const Record* m_pRecord;
+  const uint32_t* m_pExchange;
+  const uint32_t* m_pType;
+  const uint32_t* m_pUnderlying;
+  const char* m_pString;
+
+  range_t EqualRangeExchange( const std::string& ) const;
+  range_t EqualRangeType( ESecurityType ) const;
+  range_t EqualRangeUnderlying( const std::string& ) const;
+};
+
+} // namespace iqfeed
+} // namespace tf
+} // namespace ou
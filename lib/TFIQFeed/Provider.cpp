@@ -190,7 +190,7 @@ void Provider::StopTradeWatch(pSymbol_t pSymbol) {
 
 void Provider::OnIQFeedDynamicFeedUpdateMessage( linebuffer_t* pBuffer, IQFDynamicFeedUpdateMessage *pMsg ) {
   inherited_t::mapSymbols_t::iterator mapSymbols_iter;
-  auto field = pMsg->Field( IQFDynamicFeedSummaryMessage::DFSymbol );
+  auto field = pMsg->FieldView( IQFDynamicFeedSummaryMessage::DFSymbol );
   mapSymbols_iter = m_mapSymbols.find( field );
   if ( m_mapSymbols.end() != mapSymbols_iter ) {
     pSymbol_t pSym = mapSymbols_iter -> second;
@@ -204,7 +204,7 @@ void Provider::OnIQFeedDynamicFeedUpdateMessage( linebuffer_t* pBuffer, IQFDynam
 
 void Provider::OnIQFeedDynamicFeedSummaryMessage( linebuffer_t* pBuffer, IQFDynamicFeedSummaryMessage *pMsg ) {
   inherited_t::mapSymbols_t::iterator mapSymbols_iter;
-  auto field = pMsg->Field( IQFDynamicFeedSummaryMessage::DFSymbol );
+  auto field = pMsg->FieldView( IQFDynamicFeedSummaryMessage::DFSymbol );
   mapSymbols_iter = m_mapSymbols.find( field );
   if ( m_mapSymbols.end() != mapSymbols_iter ) {
     pSymbol_t  pSym = mapSymbols_iter -> second;
@@ -218,7 +218,7 @@ void Provider::OnIQFeedDynamicFeedSummaryMessage( linebuffer_t* pBuffer, IQFDyna
 
 void Provider::OnIQFeedUpdateMessage( linebuffer_t* pBuffer, IQFUpdateMessage *pMsg ) {
   inherited_t::mapSymbols_t::iterator mapSymbols_iter;
-  mapSymbols_iter = m_mapSymbols.find( pMsg->Field( IQFUpdateMessage::QPSymbol ) );
+  mapSymbols_iter = m_mapSymbols.find( pMsg->FieldView( IQFUpdateMessage::QPSymbol ) );
   pSymbol_t pSym;
   if ( m_mapSymbols.end() != mapSymbols_iter ) {
     pSym = mapSymbols_iter -> second;
@@ -229,7 +229,7 @@ void Provider::OnIQFeedUpdateMessage( linebuffer_t* pBuffer, IQFUpdateMessage *p
 
 void Provider::OnIQFeedSummaryMessage( linebuffer_t* pBuffer, IQFSummaryMessage *pMsg ) {
   inherited_t::mapSymbols_t::iterator mapSymbols_iter;
-  mapSymbols_iter = m_mapSymbols.find( pMsg->Field( IQFSummaryMessage::QPSymbol ) );
+  mapSymbols_iter = m_mapSymbols.find( pMsg->FieldView( IQFSummaryMessage::QPSymbol ) );
   pSymbol_t pSym;
   if ( m_mapSymbols.end() != mapSymbols_iter ) {
     pSym = mapSymbols_iter -> second;
@@ -240,7 +240,7 @@ void Provider::OnIQFeedSummaryMessage( linebuffer_t* pBuffer, IQFSummaryMessage
 
 void Provider::OnIQFeedFundamentalMessage( linebuffer_t* pBuffer, IQFFundamentalMessage *pMsg ) {
   inherited_t::mapSymbols_t::iterator mapSymbols_iter;
-  mapSymbols_iter = m_mapSymbols.find( pMsg->Field( IQFFundamentalMessage::FSymbol ) );
+  mapSymbols_iter = m_mapSymbols.find( pMsg->FieldView( IQFFundamentalMessage::FSymbol ) );
   pSymbol_t pSym;
   if ( m_mapSymbols.end() != mapSymbols_iter ) {
     pSym = mapSymbols_iter -> second;
@@ -110,7 +110,7 @@ void IQFeedSymbol::DecodeDynamicFeedMessage( IQFDynamicFeedMessage<T>* pMsg )  {
 
   summary.bNewTrade = summary.bNewQuote = summary.bNewOpen = false;
 
-  std::string content = pMsg->Field( IQFDynamicFeedMessage<T>::DFMessageContents );
+  const std::string_view content = pMsg->FieldView( IQFDynamicFeedMessage<T>::DFMessageContents );
   for ( const char id: content ) {
     switch ( id ) {
       case 'C':
@@ -177,7 +177,7 @@ void IQFeedSymbol::DecodePricingMessage( IQFPricingMessage<T>* pMsg ) {
   double dblOpen, dblBid, dblAsk;
   int nBidSize, nAskSize;
 
-  std::string sLastTradeTime = pMsg->Field( IQFPricingMessage<T>::QPLastTradeTime );
+  const std::string_view sLastTradeTime = pMsg->FieldView( IQFPricingMessage<T>::QPLastTradeTime );
   if ( sLastTradeTime.length() > 0 ) {
     chType = sLastTradeTime[ sLastTradeTime.length() - 1 ];
   }
@@ -0,0 +1,389 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// history tick decoding:  a recorded HTX response (or a synthetic one) is decoded into Quotes/Trades
+//   by the spirit grammar (as HistoryQuery did per record) and by HistoryDecoder, the series must match,
+//   then the response is served from a loopback socket to a HistoryQuery, with a callback per record,
+//   and to a HistoryFill, which fills the series in bulk, after first answering an error response
+//   usage: TFIQFeedHistory [capture file [passes]]
+//     capture file: the raw response to an HTX request, ie 'T,LH,...' lines ending with 'T,!ENDMSG!,'
+
+#include <mutex>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <condition_variable>
+
+#include <TFIQFeed/HistoryQuery.h>
+#include <TFIQFeed/HistoryFill.h>
+
+namespace {
+
+using port_t = unsigned short;
+using vRecord_t = std::vector<std::string_view>; // records without the request id, ie 'LH,...'
+using clock_t_ = std::chrono::steady_clock;
+
+std::string Synthesize( size_t nRecords ) {
+  std::mt19937_64 rng( 42 );
+  std::string s;
+  s.reserve( nRecords * 110 );
+  double dblLast = 500.0;
+  uint32_t nTotalVolume {};
+  uint64_t idTick( 5000000 );
+  static const char* rszConditions[] = { "01", "3D", "0117", "87" };
+  for ( size_t ix = 0; ix < nRecords; ++ix ) {
+    dblLast += 0.01 * ( int( rng() % 5 ) - 2 );
+    const uint32_t nSize = 1 + rng() % 500;
+    nTotalVolume += nSize;
+    const unsigned int nSecond = 34200 + ix / 50; // 09:30 onwards, 50 ticks a second
+    char sz[ 192 ];
+    snprintf( sz, sizeof( sz ), "T,LH,2026-10-16 %02u:%02u:%02u.%06u,%.2f,%u,%u,%.2f,%.2f,%llu,%c,%u,%s,%u,%u,\r\n",
+      nSecond / 3600, nSecond / 60 % 60, nSecond % 60, unsigned( rng() % 1000000 ),
+      dblLast, nSize, nTotalVolume, dblLast - 0.01, dblLast + 0.01, (unsigned long long)idTick++,
+      ( rng() & 1 ) ? 'C' : 'O', unsigned( 1 + rng() % 30 ), rszConditions[ rng() % 4 ],
+      unsigned( rng() % 3 ), 16u );
+    s += sz;
+  }
+  s += "T,!ENDMSG!,\r\n";
+  return s;
+}
+
+// the data records, 'T,' removed, cr removed
+void Split( const std::string& sCapture, vRecord_t& vRecord ) {
+  size_t ix {};
+  while ( ix < sCapture.size() ) {
+    size_t ixLf = sCapture.find( '\n', ix );
+    if ( std::string::npos == ixLf ) ixLf = sCapture.size();
+    std::string_view line( sCapture.data() + ix, ixLf - ix );
+    if ( !line.empty() && ( '\r' == line.back() ) ) line.remove_suffix( 1 );
+    if ( ( 4 < line.size() ) && ( 'T' == line[ 0 ] ) && ( 'L' == line[ 2 ] ) ) {
+      vRecord.push_back( line.substr( 2 ) );
+    }
+    ix = ixLf + 1;
+  }
+}
+
+uint64_t Hash( ou::tf::Quotes& quotes, ou::tf::Trades& trades ) { // TimeSeries indexing is non-const
+  uint64_t hash( 14695981039346656037ull );
+  auto mix = [&hash]( uint64_t v ){ hash ^= v; hash *= 1099511628211ull; };
+  for ( size_t ix = 0; ix < trades.Size(); ++ix ) {
+    const ou::tf::Quote& quote( quotes[ ix ] );
+    const ou::tf::Trade& trade( trades[ ix ] );
+    mix( trade.DateTime().time_of_day().total_microseconds() );
+    mix( std::llround( trade.Price() * 10000.0 ) );
+    mix( trade.Volume() );
+    mix( std::llround( quote.Bid() * 10000.0 ) );
+    mix( std::llround( quote.Ask() * 10000.0 ) );
+  }
+  return hash;
+}
+
+struct Result {
+  double dblNsPerRecord {};
+  size_t cntRecords {};
+  uint64_t hash {};
+};
+
+Result Spirit( const vRecord_t& vRecord, size_t nPasses ) {
+  using TickDataPoint = ou::tf::iqfeed::HistoryStructs::TickDataPoint;
+  ou::tf::iqfeed::HistoryStructs::DataPointParser<const char*> grammar;
+  Result result;
+  for ( size_t pass = 0; pass < nPasses; ++pass ) {
+    ou::tf::Quotes quotes;
+    ou::tf::Trades trades;
+    quotes.Reserve( vRecord.size() );
+    trades.Reserve( vRecord.size() );
+    TickDataPoint dp;
+    const auto start = clock_t_::now();
+    for ( const std::string_view& record: vRecord ) {
+      const char* bgn( record.data() );
+      const char* end( record.data() + record.size() );
+      dp.sTradeConditions.clear();
+      if ( qi::parse( bgn, end, grammar, dp ) && ( bgn == end ) ) {
+        dp.DateTime = boost::posix_time::ptime(
+          boost::gregorian::date( dp.Year, dp.Month, dp.Day ),
+          boost::posix_time::time_duration( dp.Hour, dp.Minute, dp.Second, dp.Micro ) );
+        quotes.Append( ou::tf::Quote( dp.DateTime, dp.Bid, 0, dp.Ask, 0 ) );
+        trades.Append( ou::tf::Trade( dp.DateTime, dp.Last, dp.LastSize ) );
+      }
+    }
+    const double dblNs = std::chrono::duration<double,std::nano>( clock_t_::now() - start ).count() / vRecord.size();
+    if ( ( 0 == pass ) || ( dblNs < result.dblNsPerRecord ) ) result.dblNsPerRecord = dblNs;
+    result.cntRecords = trades.Size();
+    result.hash = Hash( quotes, trades );
+  }
+  return result;
+}
+
+Result Decoder( const vRecord_t& vRecord, size_t nPasses ) {
+  Result result;
+  for ( size_t pass = 0; pass < nPasses; ++pass ) {
+    ou::tf::iqfeed::HistoryDecoder decoder;
+    ou::tf::iqfeed::HistoryDecoder::TickDataPoint dp;
+    ou::tf::Quotes quotes;
+    ou::tf::Trades trades;
+    quotes.Reserve( vRecord.size() );
+    trades.Reserve( vRecord.size() );
+    const auto start = clock_t_::now();
+    for ( const std::string_view& record: vRecord ) {
+      if ( decoder.Decode( record, dp ) ) {
+        quotes.Append( ou::tf::Quote( dp.DateTime, dp.Bid, 0, dp.Ask, 0 ) );
+        trades.Append( ou::tf::Trade( dp.DateTime, dp.Last, dp.LastSize ) );
+      }
+    }
+    const double dblNs = std::chrono::duration<double,std::nano>( clock_t_::now() - start ).count() / vRecord.size();
+    if ( ( 0 == pass ) || ( dblNs < result.dblNsPerRecord ) ) result.dblNsPerRecord = dblNs;
+    result.cntRecords = trades.Size();
+    result.hash = Hash( quotes, trades );
+  }
+  return result;
+}
+
+// completion shared by the loopback clients
+class Signal {
+public:
+  Signal(): m_bConnected( false ), m_bDone( false ), m_bOk( false ) {}
+  bool WaitConnected() {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    return m_cv.wait_for( lock, std::chrono::seconds( 10 ), [this]{ return m_bConnected; } );
+  }
+  bool WaitDone() {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    return m_cv.wait_for( lock, std::chrono::seconds( 60 ), [this]{ return m_bDone; } ) && m_bOk;
+  }
+  clock_t_::time_point Finished() const { return m_tpDone; }
+protected:
+  void Connected() {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_bConnected = true;
+    m_cv.notify_one();
+  }
+  void Finish( bool bOk ) {
+    m_tpDone = clock_t_::now();
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_bOk = bOk;
+    m_bDone = true;
+    m_cv.notify_one();
+  }
+private:
+  bool m_bConnected;
+  bool m_bDone;
+  bool m_bOk;
+  clock_t_::time_point m_tpDone;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+};
+
+// first requests a symbol which answers 'E,!NO_DATA!' then '!ENDMSG!', and from within that completion,
+//   as IQFeedGetHistory does, requests the ticks; the error request must fail with nothing appended,
+//   and the '!ENDMSG!' following the error must not complete the tick request
+class Fill: public ou::tf::iqfeed::HistoryFill<Fill>, public Signal {
+  friend ou::tf::iqfeed::HistoryFill<Fill>;
+public:
+  Fill( port_t port, size_t nRecords, ou::tf::Quotes& quotes, ou::tf::Trades& trades )
+  : ou::tf::iqfeed::HistoryFill<Fill>( "127.0.0.1", port )
+  , m_nRecords( nRecords ), m_quotes( quotes ), m_trades( trades ), m_bFirst( true )
+  {}
+  void Request() { RetrieveNDataPoints( "NODATA", 1, m_quotes, m_trades ); }
+protected:
+  void OnHistoryConnected() { Connected(); }
+  void OnHistoryError( size_t ) { Finish( false ); }
+  void OnHistoryRequestDone( bool bOk ) {
+    if ( m_bFirst ) {
+      m_bFirst = false;
+      if ( bOk || ( 0 != Datums() ) ) {
+        std::cout << "bulk fill: error response not reported" << std::endl;
+        Finish( false );
+      }
+      else {
+        RetrieveNDataPoints( "SPY", m_nRecords, m_quotes, m_trades );
+      }
+    }
+    else {
+      Finish( bOk && ( m_nRecords == Datums() ) );
+    }
+  }
+private:
+  const size_t m_nRecords;
+  ou::tf::Quotes& m_quotes;
+  ou::tf::Trades& m_trades;
+  bool m_bFirst;
+};
+
+// the per record path: line buffer copies, a callback per record, appended by the caller, as HistoryBulkQuery
+class Query: public ou::tf::iqfeed::HistoryQuery<Query>, public Signal {
+  friend ou::tf::iqfeed::HistoryQuery<Query>;
+public:
+  Query( port_t port, ou::tf::Quotes& quotes, ou::tf::Trades& trades )
+  : ou::tf::iqfeed::HistoryQuery<Query>( "127.0.0.1", port )
+  , m_quotes( quotes ), m_trades( trades )
+  {}
+protected:
+  void OnHistoryConnected() { Connected(); }
+  void OnHistoryError( size_t ) { Finish( false ); }
+  void OnHistoryTickDataPoint( TickDataPoint* pDP ) {
+    m_quotes.Append( ou::tf::Quote( pDP->DateTime, pDP->Bid, 0, pDP->Ask, 0 ) );
+    m_trades.Append( ou::tf::Trade( pDP->DateTime, pDP->Last, pDP->LastSize ) );
+    ReQueueTickDataPoint( pDP );
+  }
+  void OnHistoryRequestDone( bool bOk ) { Finish( bOk ); }
+private:
+  ou::tf::Quotes& m_quotes;
+  ou::tf::Trades& m_trades;
+};
+
+// accept one connection, answer each HTX request in turn, writing in uneven pieces;
+//   the last response is timed from the arrival of its request
+void Serve( boost::asio::ip::tcp::acceptor& acceptor, const std::vector<const std::string*>& vResponse, clock_t_::time_point& tpStart ) {
+  boost::asio::ip::tcp::socket socket( acceptor.get_executor() );
+  acceptor.accept( socket );
+  boost::asio::streambuf buf;
+  std::mt19937 rng( 7 );
+  for ( const std::string* pResponse: vResponse ) {
+    std::string sLine;
+    do {
+      boost::asio::read_until( socket, buf, '\n' );
+      std::istream is( &buf );
+      std::getline( is, sLine );
+    } while ( 0 != sLine.compare( 0, 3, "HTX" ) );
+    tpStart = clock_t_::now();
+    const std::string& sResponse( *pResponse );
+    size_t ix {};
+    while ( ix < sResponse.size() ) {
+      const size_t n = std::min<size_t>( 512 + rng() % 16384, sResponse.size() - ix );
+      boost::asio::write( socket, boost::asio::buffer( sResponse.data() + ix, n ) );
+      ix += n;
+    }
+  }
+  boost::system::error_code ec;
+  socket.shutdown( boost::asio::ip::tcp::socket::shutdown_send, ec );
+}
+
+const std::string sNoData( "T,E,!NO_DATA!,\r\nT,!ENDMSG!,\r\n" );
+
+bool Bulk( const std::string& sCapture, size_t nRecords, size_t nPasses, Result& result ) {
+  for ( size_t pass = 0; pass < nPasses; ++pass ) {
+    boost::asio::io_context io;
+    boost::asio::ip::tcp::acceptor acceptor( io, boost::asio::ip::tcp::endpoint( boost::asio::ip::address_v4::loopback(), 0 ) );
+    ou::tf::Quotes quotes;
+    ou::tf::Trades trades;
+    clock_t_::time_point tpStart;
+    Fill fill( acceptor.local_endpoint().port(), nRecords, quotes, trades );
+    std::thread server( [&acceptor, &sCapture, &tpStart](){ Serve( acceptor, { &sNoData, &sCapture }, tpStart ); } );
+    fill.Connect();
+    bool bOk = fill.WaitConnected();
+    if ( bOk ) {
+      fill.Request();
+      bOk = fill.WaitDone();
+    }
+    server.join();
+    fill.Disconnect();
+    if ( !bOk ) {
+      std::cout << "bulk fill: incomplete, " << trades.Size() << " of " << nRecords << " records" << std::endl;
+      return false;
+    }
+    const double dblNs = std::chrono::duration<double,std::nano>( fill.Finished() - tpStart ).count() / nRecords;
+    if ( ( 0 == pass ) || ( dblNs < result.dblNsPerRecord ) ) result.dblNsPerRecord = dblNs;
+    result.cntRecords = trades.Size();
+    result.hash = Hash( quotes, trades );
+  }
+  return true;
+}
+
+bool PerRecord( const std::string& sCapture, size_t nRecords, size_t nPasses, Result& result ) {
+  for ( size_t pass = 0; pass < nPasses; ++pass ) {
+    boost::asio::io_context io;
+    boost::asio::ip::tcp::acceptor acceptor( io, boost::asio::ip::tcp::endpoint( boost::asio::ip::address_v4::loopback(), 0 ) );
+    ou::tf::Quotes quotes;
+    ou::tf::Trades trades;
+    quotes.Reserve( nRecords );
+    trades.Reserve( nRecords );
+    clock_t_::time_point tpStart;
+    Query query( acceptor.local_endpoint().port(), quotes, trades );
+    std::thread server( [&acceptor, &sCapture, &tpStart](){ Serve( acceptor, { &sCapture }, tpStart ); } );
+    query.Connect();
+    bool bOk = query.WaitConnected();
+    if ( bOk ) {
+      query.RetrieveNDataPoints( "SPY", nRecords );
+      bOk = query.WaitDone();
+    }
+    server.join();
+    query.Disconnect();
+    if ( !bOk ) {
+      std::cout << "per record: incomplete, " << trades.Size() << " of " << nRecords << " records" << std::endl;
+      return false;
+    }
+    const double dblNs = std::chrono::duration<double,std::nano>( query.Finished() - tpStart ).count() / nRecords;
+    if ( ( 0 == pass ) || ( dblNs < result.dblNsPerRecord ) ) result.dblNsPerRecord = dblNs;
+    result.cntRecords = trades.Size();
+    result.hash = Hash( quotes, trades );
+  }
+  return true;
+}
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  std::string sCapture;
+  if ( 1 < argc ) {
+    std::ifstream ifs( argv[ 1 ], std::ios::binary );
+    if ( !ifs ) {
+      std::cerr << "can not open " << argv[ 1 ] << std::endl;
+      return EXIT_FAILURE;
+    }
+    sCapture.assign( std::istreambuf_iterator<char>( ifs ), std::istreambuf_iterator<char>() );
+  }
+  else {
+    sCapture = Synthesize( 1000000 );
+  }
+  const size_t nPasses = ( 2 < argc ) ? std::stoul( argv[ 2 ] ) : 3;
+
+  vRecord_t vRecord;
+  Split( sCapture, vRecord );
+  if ( vRecord.empty() ) {
+    std::cerr << "no tick records" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << sCapture.size() << " bytes, " << vRecord.size() << " records, best of " << nPasses << std::endl;
+
+  const Result spirit = Spirit( vRecord, nPasses );
+  std::cout << "spirit grammar: " << spirit.dblNsPerRecord << " ns/record, " << spirit.cntRecords << " decoded" << std::endl;
+
+  const Result decoder = Decoder( vRecord, nPasses );
+  std::cout << "fixed decoder:  " << decoder.dblNsPerRecord << " ns/record, " << decoder.cntRecords << " decoded" << std::endl;
+
+  Result query;
+  if ( !PerRecord( sCapture, vRecord.size(), nPasses, query ) ) return EXIT_FAILURE;
+  std::cout << "per record:     " << query.dblNsPerRecord << " ns/record, " << query.cntRecords << " appended (loopback, HistoryQuery)" << std::endl;
+
+  Result bulk;
+  if ( !Bulk( sCapture, vRecord.size(), nPasses, bulk ) ) return EXIT_FAILURE;
+  std::cout << "bulk fill:      " << bulk.dblNsPerRecord << " ns/record, " << bulk.cntRecords << " appended (loopback, HistoryFill, after an error response)" << std::endl;
+
+  if ( ( spirit.cntRecords != decoder.cntRecords ) || ( spirit.hash != decoder.hash )
+    || ( spirit.cntRecords != query.cntRecords ) || ( spirit.hash != query.hash )
+    || ( spirit.cntRecords != bulk.cntRecords ) || ( spirit.hash != bulk.hash ) ) {
+    std::cout << "series differ" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "series match" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,410 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    IndicatorGraph.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFIndicators
+ * Created: October 17, 2026 22:10
+ */
+
+#include <cassert>
+#include <stdexcept>
+
+#include "IndicatorGraph.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+namespace {
+  const double c_nan( std::numeric_limits<double>::quiet_NaN() );
+  const size_t c_nInitialCapacity( 64 ); // time only windows, doubled as required
+}
+
+IndicatorGraph::IndicatorGraph()
+: m_bCompiled( false ), m_bFirst( true )
+{}
+
+IndicatorGraph::IndicatorGraph( const IndicatorGraph& rhs )
+: m_bCompiled( rhs.m_bCompiled ), m_bFirst( true )
+, m_vStep( rhs.m_vStep )
+, m_vValue( rhs.m_vValue.size(), c_nan )
+, m_vWindow( rhs.m_vWindow )
+, m_vInput( rhs.m_vInput )
+{
+  if ( m_bCompiled ) Layout();
+}
+
+IndicatorGraph& IndicatorGraph::operator=( const IndicatorGraph& rhs ) {
+  if ( this != &rhs ) {
+    m_bCompiled = rhs.m_bCompiled;
+    m_bFirst = true;
+    m_vStep = rhs.m_vStep;
+    m_vValue.assign( rhs.m_vValue.size(), c_nan );
+    m_vWindow = rhs.m_vWindow;
+    m_vArena.clear();
+    m_vInput = rhs.m_vInput;
+    m_vRecorder.clear();
+    if ( m_bCompiled ) Layout();
+  }
+  return *this;
+}
+
+IndicatorGraph::~IndicatorGraph() {}
+
+IndicatorGraph::node_t IndicatorGraph::Declare( const Step& step ) {
+  if ( m_bCompiled ) {
+    throw std::logic_error( "IndicatorGraph: declaration after Compile" );
+  }
+  const node_t node( m_vStep.size() );
+  if ( ( ( c_none != step.a ) && ( node <= step.a ) ) || ( ( c_none != step.b ) && ( node <= step.b ) ) ) {
+    throw std::runtime_error( "IndicatorGraph: unknown node" );
+  }
+  m_vStep.push_back( step );
+  m_vValue.push_back( c_nan );
+  return node;
+}
+
+IndicatorGraph::node_t IndicatorGraph::Input( const std::string& ) {
+  const node_t node( Declare( Step( EOp::Input, c_none ) ) );
+  m_vInput.push_back( node );
+  return node;
+}
+
+IndicatorGraph::node_t IndicatorGraph::Add( node_t a, node_t b ) { return Declare( Step( EOp::Add, a, b ) ); }
+IndicatorGraph::node_t IndicatorGraph::Subtract( node_t a, node_t b ) { return Declare( Step( EOp::Subtract, a, b ) ); }
+IndicatorGraph::node_t IndicatorGraph::Multiply( node_t a, node_t b ) { return Declare( Step( EOp::Multiply, a, b ) ); }
+IndicatorGraph::node_t IndicatorGraph::Divide( node_t a, node_t b ) { return Declare( Step( EOp::Divide, a, b ) ); }
+IndicatorGraph::node_t IndicatorGraph::Scale( node_t a, double k ) { return Declare( Step( EOp::Scale, a, c_none, c_none, k ) ); }
+
+IndicatorGraph::node_t IndicatorGraph::EMA( node_t a, time_duration td ) {
+  if ( 0 >= td.total_microseconds() ) {
+    throw std::runtime_error( "IndicatorGraph::EMA: time range required" );
+  }
+  return Declare( Step( EOp::EMA, a, c_none, c_none, (double) td.total_microseconds() ) );
+}
+
+IndicatorGraph::node_t IndicatorGraph::SMA( node_t a, const Window& w ) { return Windowed( EOp::SMA, a, w ); }
+IndicatorGraph::node_t IndicatorGraph::SD( node_t a, const Window& w ) { return Windowed( EOp::SD, a, w ); }
+IndicatorGraph::node_t IndicatorGraph::Slope( node_t a, const Window& w ) { return Windowed( EOp::Slope, a, w ); }
+IndicatorGraph::node_t IndicatorGraph::Min( node_t a, const Window& w ) { return Windowed( EOp::Min, a, w ); }
+IndicatorGraph::node_t IndicatorGraph::Max( node_t a, const Window& w ) { return Windowed( EOp::Max, a, w ); }
+IndicatorGraph::node_t IndicatorGraph::RateOfChange( node_t a, const Window& w ) { return Windowed( EOp::RateOfChange, a, w ); }
+
+IndicatorGraph::node_t IndicatorGraph::Windowed( EOp op, node_t a, const Window& w ) {
+
+  const int64_t tdWidth( w.td.total_microseconds() );
+  if ( ( 0 > tdWidth ) || ( ( 0 == tdWidth ) && ( 0 == w.nCount ) ) ) {
+    throw std::runtime_error( "IndicatorGraph: window requires a time width or a count" );
+  }
+
+  // share the window of an earlier indicator over the same node
+  uint32_t ixWindow( 0 );
+  for ( ; ixWindow < m_vWindow.size(); ixWindow++ ) {
+    const WindowState& ws( m_vWindow[ ixWindow ] );
+    if ( ( a == ws.source ) && ( tdWidth == ws.tdWidth ) && ( w.nCount == ws.nCount ) ) break;
+  }
+
+  const node_t node( Declare( Step( op, a, c_none, ixWindow ) ) ); // validates before the window is added
+
+  if ( m_vWindow.size() == ixWindow ) {
+    m_vWindow.emplace_back( a, tdWidth, w.nCount );
+  }
+  WindowState& ws( m_vWindow[ ixWindow ] );
+  switch ( op ) {
+    case EOp::Min:
+      ws.bMin = true;
+      break;
+    case EOp::Max:
+      ws.bMax = true;
+      break;
+    case EOp::RateOfChange:
+      break;
+    default:
+      ws.bSums = true;
+      break;
+  }
+
+  return node;
+}
+
+void IndicatorGraph::Compile() {
+  if ( m_bCompiled ) return;
+  m_bCompiled = true;
+  Layout();
+}
+
+void IndicatorGraph::Layout() {
+  size_t ixArena {};
+  for ( WindowState& ws: m_vWindow ) {
+    const size_t nCapacity( ( 0 < ws.nCount ) ? ( ws.nCount + 1 ) : c_nInitialCapacity ); // newest is added before expiry
+    for ( Ring* pRing: { &ws.history, &ws.dequeMin, &ws.dequeMax } ) {
+      *pRing = Ring();
+      pRing->ixBegin = ixArena;
+      pRing->nCapacity = nCapacity;
+      ixArena += nCapacity;
+    }
+  }
+  m_vArena.assign( ixArena, Sample() );
+  Reset();
+}
+
+void IndicatorGraph::Reset() {
+  m_bFirst = true;
+  std::fill( m_vValue.begin(), m_vValue.end(), c_nan );
+  for ( Step& step: m_vStep ) {
+    step.xPrev = 0.0;
+    step.tPrev = 0;
+  }
+  for ( WindowState& ws: m_vWindow ) {
+    ws.history.ixHead = ws.history.nSize = 0;
+    ws.dequeMin.ixHead = ws.dequeMin.nSize = 0;
+    ws.dequeMax.ixHead = ws.dequeMax.nSize = 0;
+    ws.nSequence = 0;
+    ws.xExpired = c_nan;
+    ws.ClearSums();
+  }
+}
+
+void IndicatorGraph::Record( node_t node, ou::tf::Prices& prices ) {
+  assert( node < m_vStep.size() );
+  Record( node, nullptr );
+  m_vRecorder.push_back( Recorder{ node, &prices } );
+}
+
+void IndicatorGraph::Record( node_t node, std::nullptr_t ) {
+  for ( std::vector<Recorder>::iterator iter = m_vRecorder.begin(); m_vRecorder.end() != iter; ) {
+    if ( node == iter->node ) iter = m_vRecorder.erase( iter );
+    else ++iter;
+  }
+}
+
+// a time only window is full: the arena is laid out again with its rings at twice the size,
+//   contents of every ring moved to the start of its region, oldest first, nothing left behind
+void IndicatorGraph::Grow( WindowState& wsFull ) {
+  std::vector<Sample> vArena;
+  vArena.reserve( m_vArena.size() + 3 * wsFull.history.nCapacity );
+  for ( WindowState& ws: m_vWindow ) {
+    const size_t nCapacity( ( &ws == &wsFull ) ? ( 2 * ws.history.nCapacity ) : ws.history.nCapacity );
+    for ( Ring* pRing: { &ws.history, &ws.dequeMin, &ws.dequeMax } ) {
+      Ring ring;
+      ring.ixBegin = vArena.size();
+      ring.nCapacity = nCapacity;
+      ring.nSize = pRing->nSize;
+      for ( size_t ix = 0; ix < pRing->nSize; ix++ ) {
+        vArena.push_back( m_vArena[ pRing->At( ix ) ] );
+      }
+      vArena.resize( ring.ixBegin + ring.nCapacity );
+      *pRing = ring;
+    }
+  }
+  m_vArena.swap( vArena );
+}
+
+void IndicatorGraph::Push( Ring& ring, const Sample& sample ) {
+  assert( ring.nSize < ring.nCapacity );
+  ring.nSize++;
+  m_vArena[ ring.At( ring.nSize - 1 ) ] = sample;
+}
+
+void IndicatorGraph::PopHead( Ring& ring ) {
+  assert( 0 < ring.nSize );
+  ring.ixHead = ( ring.ixHead + 1 ) % ring.nCapacity;
+  ring.nSize--;
+}
+
+void IndicatorGraph::PopTail( Ring& ring ) {
+  assert( 0 < ring.nSize );
+  ring.nSize--;
+}
+
+void IndicatorGraph::Added( WindowState& ws, const Sample& sample ) {
+  if ( ws.bSums ) {
+    const double t( 1e-6 * sample.t );
+    ws.n += 1.0;
+    ws.sx += sample.x;
+    ws.sxx += sample.x * sample.x;
+    ws.st += t;
+    ws.stt += t * t;
+    ws.stx += t * sample.x;
+  }
+  const Sample entry{ (int64_t) ws.nSequence, sample.x };
+  if ( ws.bMin ) {
+    while ( ( 0 < ws.dequeMin.nSize ) && ( Tail( ws.dequeMin ).x >= sample.x ) ) PopTail( ws.dequeMin );
+    Push( ws.dequeMin, entry );
+  }
+  if ( ws.bMax ) {
+    while ( ( 0 < ws.dequeMax.nSize ) && ( Tail( ws.dequeMax ).x <= sample.x ) ) PopTail( ws.dequeMax );
+    Push( ws.dequeMax, entry );
+  }
+  ws.nSequence++;
+}
+
+void IndicatorGraph::Expired( WindowState& ws, const Sample& sample ) { // prior to removal from the history
+  ws.xExpired = sample.x;
+  if ( ws.bSums ) {
+    const double t( 1e-6 * sample.t );
+    ws.n -= 1.0;
+    ws.sx -= sample.x;
+    ws.sxx -= sample.x * sample.x;
+    ws.st -= t;
+    ws.stt -= t * t;
+    ws.stx -= t * sample.x;
+  }
+  const int64_t nSequence( ws.nSequence - ws.history.nSize ); // of the oldest
+  if ( ws.bMin && ( 0 < ws.dequeMin.nSize ) && ( nSequence == Head( ws.dequeMin ).t ) ) PopHead( ws.dequeMin );
+  if ( ws.bMax && ( 0 < ws.dequeMax.nSize ) && ( nSequence == Head( ws.dequeMax ).t ) ) PopHead( ws.dequeMax );
+}
+
+void IndicatorGraph::Advance( WindowState& ws, int64_t t ) {
+
+  const double x( m_vValue[ ws.source ] );
+  if ( std::isnan( x ) ) return; // source not ready, nothing enters the window
+
+  if ( ws.history.nSize == ws.history.nCapacity ) Grow( ws );
+
+  const Sample sample{ t, x };
+  Push( ws.history, sample );
+  Added( ws, sample );
+
+  if ( 0 < ws.nCount ) {
+    while ( ws.history.nSize > ws.nCount ) {
+      Expired( ws, Head( ws.history ) );
+      PopHead( ws.history );
+    }
+  }
+  if ( 0 < ws.tdWidth ) {
+    while ( ( 1 < ws.history.nSize ) && ( ( t - Head( ws.history ).t ) > ws.tdWidth ) ) {
+      Expired( ws, Head( ws.history ) );
+      PopHead( ws.history );
+    }
+  }
+}
+
+void IndicatorGraph::Update( ptime dt, double x ) {
+  assert( 1 == m_vInput.size() );
+  m_vValue[ m_vInput.front() ] = x;
+  Update( dt );
+}
+
+void IndicatorGraph::Update( ptime dt ) {
+
+  if ( !m_bCompiled ) {
+    throw std::logic_error( "IndicatorGraph::Update: not compiled" );
+  }
+
+  if ( m_bFirst ) {
+    m_dtZero = dt;
+    m_bFirst = false;
+  }
+  const int64_t t( ( dt - m_dtZero ).total_microseconds() );
+
+  uint32_t ixAdvanced( 0 ); // windows are first used in declaration order
+  double* const value( m_vValue.data() );
+
+  for ( node_t node = 0; node < m_vStep.size(); node++ ) {
+    Step& step( m_vStep[ node ] );
+    switch ( step.op ) {
+      case EOp::Input:
+        break;
+      case EOp::Add:
+        value[ node ] = value[ step.a ] + value[ step.b ];
+        break;
+      case EOp::Subtract:
+        value[ node ] = value[ step.a ] - value[ step.b ];
+        break;
+      case EOp::Multiply:
+        value[ node ] = value[ step.a ] * value[ step.b ];
+        break;
+      case EOp::Divide:
+        value[ node ] = value[ step.a ] / value[ step.b ];
+        break;
+      case EOp::Scale:
+        value[ node ] = step.k * value[ step.a ];
+        break;
+      case EOp::EMA:
+        {
+          const double x( value[ step.a ] );
+          if ( std::isnan( x ) ) break;
+          if ( std::isnan( value[ node ] ) ) {
+            value[ node ] = x;
+          }
+          else {
+            const int64_t tdDif( ( t == step.tPrev ) ? 1 : ( t - step.tPrev ) );
+            const double alpha( (double) tdDif / step.k );
+            const double mu( std::exp( -alpha ) );
+            const double v( ( 1.0 - mu ) / alpha );  // linear interpolation
+            value[ node ] = mu * value[ node ] + ( v - mu ) * step.xPrev + ( 1.0 - v ) * x;
+          }
+          step.xPrev = x;
+          step.tPrev = t;
+        }
+        break;
+      default: // windowed
+        {
+          if ( step.ixWindow == ixAdvanced ) {
+            Advance( m_vWindow[ ixAdvanced ], t );
+            ixAdvanced++;
+          }
+          WindowState& ws( m_vWindow[ step.ixWindow ] );
+          double result( c_nan );
+          if ( 0 < ws.history.nSize ) {
+            switch ( step.op ) {
+              case EOp::SMA:
+                result = ws.sx / ws.n;
+                break;
+              case EOp::SD:
+                {
+                  const double syy( ws.sxx - ( ws.sx * ws.sx ) / ws.n );
+                  result = ( 0.0 < syy ) ? std::sqrt( syy / ws.n ) : 0.0;
+                }
+                break;
+              case EOp::Slope:
+                if ( 1.0 < ws.n ) {
+                  const double stt( ws.stt - ( ws.st * ws.st ) / ws.n );
+                  const double stx( ws.stx - ( ws.st * ws.sx ) / ws.n );
+                  result = ( 0.0 != stt ) ? ( stx / stt ) : 0.0;
+                }
+                else result = 0.0;
+                break;
+              case EOp::Min:
+                result = Head( ws.dequeMin ).x;
+                break;
+              case EOp::Max:
+                result = Head( ws.dequeMax ).x;
+                break;
+              case EOp::RateOfChange:
+                result = Tail( ws.history ).x - ws.xExpired;
+                break;
+              default:
+                assert( false );
+                break;
+            }
+          }
+          value[ node ] = result;
+        }
+        break;
+    }
+  }
+
+  for ( const Recorder& recorder: m_vRecorder ) {
+    const double x( value[ recorder.node ] );
+    if ( !std::isnan( x ) ) {
+      recorder.pPrices->Append( ou::tf::Price( dt, x ) );
+    }
+  }
+}
+
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,211 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    IndicatorGraph.h
+ * Author:  raymond@burkholder.net
+ * Project: TFIndicators
+ * Created: October 17, 2026 22:10
+ */
+
+#pragma once
+
+// a set of indicators evaluated as one unit, in place of TimeSeries chained by OnAppend:
+//   1. declare the graph: inputs, then indicators over earlier nodes, a node can only refer
+//      to nodes declared before it, so declaration order is an evaluation order
+//   2. Compile() flattens the declaration into a program, one step per node, and lays out the state:
+//        one value per node, one accumulator block per window, and one arena for all window history
+//   3. Set() the inputs and Update( dt ), or Update( dt, x ) for a single input,
+//      each update runs the program once over the state, no delegates, no series appended
+//   4. Value( node ) is the current value, NaN until the node has enough data (see Ready)
+//      Record( node, prices ) appends each update of a node to a series, for charting or inspection
+// windows follow TimeSeriesSlidingWindow: a time width and/or a count, the newest datum is always kept
+//   indicators over the same node with the same window share its history and accumulators
+//   count windows hold a fixed history, time windows start small and grow as the data rate requires,
+//   growing lays the arena out again, so it holds only the current rings, no abandoned regions
+// a compiled graph may be copied or assigned, for instance declared once then copied for each instrument,
+//   the copy starts from empty state, recording is not copied
+// the calculations match the TimeSeries based indicators:
+//   EMA as TSEMA, SMA as TSSWSMA, Mean/SD/Slope as RunningStats (slope per second, TSSWStatsPrice is per millisecond),
+//   Min/Max as RunningMinMax,
+//   RateOfChange as TSSWRateOfChange
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <TFTimeSeries/TimeSeries.h>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+class IndicatorGraph {
+public:
+
+  using node_t = uint32_t;
+  using ptime = boost::posix_time::ptime;
+  using time_duration = boost::posix_time::time_duration;
+
+  struct Window {
+    time_duration td;   // zero for a count only window
+    size_t nCount;      // zero for a time only window
+    Window( time_duration td_ ): td( td_ ), nCount {} {}
+    Window( size_t nCount_ ): td {}, nCount( nCount_ ) {}
+    Window( time_duration td_, size_t nCount_ ): td( td_ ), nCount( nCount_ ) {}
+  };
+
+  IndicatorGraph();
+  IndicatorGraph( const IndicatorGraph& ); // program and fresh state, no recording
+  IndicatorGraph& operator=( const IndicatorGraph& ); // as the copy, own recording is released
+  virtual ~IndicatorGraph();
+
+  // declaration, prior to Compile
+
+  node_t Input( const std::string& sName = std::string() );
+
+  node_t Add( node_t, node_t );
+  node_t Subtract( node_t, node_t );
+  node_t Multiply( node_t, node_t );
+  node_t Divide( node_t, node_t );
+  node_t Scale( node_t, double k ); // k * node
+
+  node_t EMA( node_t, time_duration );
+
+  node_t SMA( node_t, const Window& );
+  node_t Mean( node_t n, const Window& w ) { return SMA( n, w ); }
+  node_t SD( node_t, const Window& );    // population
+  node_t Slope( node_t, const Window& ); // least squares, per second
+  node_t Min( node_t, const Window& );
+  node_t Max( node_t, const Window& );
+  node_t RateOfChange( node_t, const Window& ); // newest less the last to leave the window, once one has
+
+  void Compile();
+  bool Compiled() const { return m_bCompiled; }
+
+  // evaluation
+
+  void Set( node_t input, double x ) { m_vValue[ input ] = x; }
+  void Update( ptime dt );
+  void Update( ptime dt, double x ); // single input graphs
+  void Reset(); // clears the state, keeps the program
+
+  double Value( node_t node ) const { return m_vValue[ node ]; }
+  bool Ready( node_t node ) const { return !std::isnan( m_vValue[ node ] ); }
+
+  void Record( node_t, ou::tf::Prices& ); // series must outlive the graph, or be released with Record( node, nullptr )
+  void Record( node_t, std::nullptr_t );
+
+  size_t Nodes() const { return m_vStep.size(); }
+  size_t HistoryCapacity() const { return m_vArena.size(); } // samples held across all windows
+
+protected:
+private:
+
+  enum class EOp: uint8_t {
+    Input,
+    Add, Subtract, Multiply, Divide, Scale,
+    EMA,
+    SMA, SD, Slope, Min, Max, RateOfChange
+  };
+
+  static constexpr uint32_t c_none = std::numeric_limits<uint32_t>::max();
+
+  struct Step {
+    EOp op;
+    node_t a;
+    node_t b;
+    uint32_t ixWindow;  // windowed ops
+    double k;           // Scale factor, EMA range in microseconds
+    // EMA state
+    double xPrev;
+    int64_t tPrev;
+    Step( EOp op_, node_t a_, node_t b_ = c_none, uint32_t ixWindow_ = c_none, double k_ = 0.0 )
+    : op( op_ ), a( a_ ), b( b_ ), ixWindow( ixWindow_ ), k( k_ ), xPrev {}, tPrev {} {}
+  };
+
+  struct Sample {
+    int64_t t; // microseconds from the first update, sequence number in a min/max deque
+    double x;
+  };
+
+  struct Ring { // region of the arena
+    size_t ixBegin;
+    size_t nCapacity;
+    size_t ixHead;  // oldest
+    size_t nSize;
+    Ring(): ixBegin {}, nCapacity {}, ixHead {}, nSize {} {}
+    size_t At( size_t ix ) const { return ixBegin + ( ( ixHead + ix ) % nCapacity ); } // ix from oldest
+  };
+
+  struct WindowState {
+    node_t source;
+    int64_t tdWidth; // microseconds, 0 for none
+    size_t nCount;   // 0 for none
+    bool bSums;      // SMA, SD, Slope
+    bool bMin;
+    bool bMax;
+    uint64_t nSequence; // of samples added, for the min/max deques
+    Ring history;
+    Ring dequeMin;   // monotonic, increasing values
+    Ring dequeMax;   // monotonic, decreasing values
+    double xExpired; // RateOfChange
+    // sums over the history, t in seconds
+    double n, sx, sxx, st, stt, stx;
+    WindowState( node_t source_, int64_t tdWidth_, size_t nCount_ )
+    : source( source_ ), tdWidth( tdWidth_ ), nCount( nCount_ )
+    , bSums( false ), bMin( false ), bMax( false ), nSequence {}
+    , xExpired( std::numeric_limits<double>::quiet_NaN() )
+    , n {}, sx {}, sxx {}, st {}, stt {}, stx {} {}
+    void ClearSums() { n = sx = sxx = st = stt = stx = 0.0; }
+  };
+
+  bool m_bCompiled;
+  bool m_bFirst;
+  ptime m_dtZero;
+
+  std::vector<Step> m_vStep;          // the program, one per node, in declaration order
+  std::vector<double> m_vValue;       // one per node
+  std::vector<WindowState> m_vWindow;
+  std::vector<Sample> m_vArena;       // history and deques of all windows
+  std::vector<node_t> m_vInput;
+
+  struct Recorder {
+    node_t node;
+    ou::tf::Prices* pPrices;
+  };
+  std::vector<Recorder> m_vRecorder;
+
+  node_t Declare( const Step& );
+  node_t Windowed( EOp, node_t, const Window& );
+
+  void Layout();
+  void Grow( WindowState& );
+  void Advance( WindowState&, int64_t t );
+
+  void Push( Ring&, const Sample& );
+  void PopHead( Ring& );
+  void PopTail( Ring& );
+  Sample& Head( Ring& r ) { return m_vArena[ r.ixBegin + r.ixHead ]; }
+  Sample& Tail( Ring& r ) { return m_vArena[ r.At( r.nSize - 1 ) ]; }
+
+  void Added( WindowState&, const Sample& );
+  void Expired( WindowState&, const Sample& );
+};
+
+} // namespace tf
+} // namespace ou
@@ -42,6 +42,7 @@ public:
   };
 
   void Reset();
+  void Insert( const value_t& ); // as Add, without the CRTP callback, for rebuilding the state after a batch
 
 protected:
   void UpdateOnAdd( const value_t min, const value_t max ) {} // CRTP callback
@@ -109,6 +110,11 @@ void RunningMinMax<CRTP,value_t>::Remove( const value_t& value ) {
   }
 }
 
+template<typename CRTP, typename value_t>
+void RunningMinMax<CRTP,value_t>::Insert( const value_t& value ) {
+  ++m_mapValueCount[ value ];
+}
+
 template<typename CRTP, typename value_t>
 void RunningMinMax<CRTP,value_t>::Reset() {
   m_mapValueCount.clear();
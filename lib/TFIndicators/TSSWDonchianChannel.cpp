@@ -48,6 +48,15 @@ void TSSWDonchianChannel::Expire( const Price& price ) { // from TSSW
 //void TSSWDonchianChannel::PostUpdate() { // from TSSW
 //}
 
+void TSSWDonchianChannel::Batch( size_type ixBegin, size_type, const vTrailing_t& vTrailing ) { // from TSSW
+  // nothing is emitted per datum, only the final window is required
+  minmax::Reset();
+  const size_type ixEnd( ixBegin + vTrailing.size() );
+  for ( size_type ix = vTrailing.back(); ix < ixEnd; ++ix ) {
+    minmax::Add( Datum( ix ).Value() );
+  }
+}
+
 
 } // namespace tf
 } // namespace ou
@@ -48,6 +48,7 @@ protected:
   void Add( const Price& );    // sliding window crtp recipient
   void Expire( const Price& ); // sliding window crtp recipient
   //void PostUpdate();           // sliding window crtp recipient
+  void Batch( size_type ixBegin, size_type ixTrailing, const vTrailing_t& ); // sliding window crtp recipient
 
   //void UpdateMax( const double& ); // CRTP runningminmax callback recipient
   //void UpdateMin( const double& ); // CRTP runningminmax callback recipient
@@ -16,6 +16,8 @@
 
 #include <math.h>
 
+#include <vector>
+
 #include "TSSWEfficiencyRatio.h"
 
 namespace ou { // One Unified
@@ -62,5 +64,35 @@ void TSSWEfficiencyRatio::PostUpdate( void ) {
   }
 }
 
+void TSSWEfficiencyRatio::Batch( size_type ixBegin, size_type ixTrailing, const vTrailing_t& vTrailing ) {
+  // Add/Expire amount to: with the window starting at ix, m_lastExpire is the price at ix - 1 (or at 0),
+  //   m_sum is the path length from there to the latest, so both come from prefix sums of the path
+  const size_type ixEnd( ixBegin + vTrailing.size() );
+  auto Expired = []( size_type ix ){ return ( 0 == ix ) ? ix : ix - 1; };
+  const size_type ixBase( Expired( ixTrailing ) );
+  std::vector<double> vPath( ixEnd - ixBase );
+  vPath[ 0 ] = 0.0;
+  for ( size_type ix = ixBase + 1; ix < ixEnd; ++ix ) {
+    vPath[ ix - ixBase ] = vPath[ ix - ixBase - 1 ] + fabs( Datum( ix ).Price() - Datum( ix - 1 ).Price() );
+  }
+  m_total += vPath[ ixEnd - 1 - ixBase ] - vPath[ Expired( ixBegin ) - ixBase ];
+  // the ratio is held from the latest datum with some path in its window
+  for ( size_type ix = vTrailing.size(); 0 < ix; ) {
+    --ix;
+    const size_type ixLeading( ixBegin + ix );
+    const size_type ixExpired( Expired( vTrailing[ ix ] ) );
+    const double sum( vPath[ ixLeading - ixBase ] - vPath[ ixExpired - ixBase ] );
+    if ( 0.0 != sum ) {
+      m_ratio = ( Datum( ixLeading ).Price() - Datum( ixExpired ).Price() ) / sum;
+      break;
+    }
+  }
+  // hand off the window to Add/Expire
+  const size_type ixExpired( Expired( vTrailing.back() ) );
+  m_lastAdd = Datum( ixEnd - 1 ).Price();
+  m_lastExpire = Datum( ixExpired ).Price();
+  m_sum = vPath[ ixEnd - 1 - ixBase ] - vPath[ ixExpired - ixBase ];
+}
+
 } // namespace tf
 } // namespace ou
@@ -36,6 +36,7 @@ protected:
   void Add( const Trade& );
   void Expire( const Trade& );
   void PostUpdate( void );
+  void Batch( size_type ixBegin, size_type ixTrailing, const vTrailing_t& vTrailing );
 private:
   double m_lastAdd;
   double m_lastExpire;
@@ -16,6 +16,8 @@
 
 #include <math.h>
 
+#include <vector>
+
 #include "TSSWRealizedVolatility.h"
 
 namespace ou { // One Unified
@@ -31,54 +33,71 @@ TSSWRealizedVolatility::TSSWRealizedVolatility( Prices& prices, time_duration td
 TSSWRealizedVolatility::~TSSWRealizedVolatility( void ) {
 }
 
-void TSSWRealizedVolatility::Add( const Price& price ) {
-  m_dt = price.DateTime();
-  double val( price.Value() );
-  ++m_n;
+double TSSWRealizedVolatility::Term( double val ) const {
   if ( 1.0 == m_dblP ) {
-    m_dblSum += val;
+    return val;
   }
   else {
     if ( 2.0 == m_dblP ) {
-      m_dblSum += val * val;
+      return val * val;
     }
     else {
-      m_dblSum += std::pow( std::abs( val ), m_dblP );
+      return std::pow( std::abs( val ), m_dblP );
     }
   }
 }
 
-void TSSWRealizedVolatility::Expire( const Price& price ) {
-  --m_n;
-  double val( price.Value() );
-  --m_n;
+double TSSWRealizedVolatility::Result( double sum, unsigned int n ) const {
   if ( 1.0 == m_dblP ) {
-    m_dblSum -= val;
+    return sum / n;
   }
   else {
     if ( 2.0 == m_dblP ) {
-      m_dblSum -= val * val;
+      return std::sqrt( sum / n );
     }
     else {
-      m_dblSum -= std::pow( std::abs( val ), m_dblP );
+      return std::pow( sum / n, 1.0 / m_dblP );
     }
   }
 }
 
+void TSSWRealizedVolatility::Add( const Price& price ) {
+  m_dt = price.DateTime();
+  ++m_n;
+  m_dblSum += Term( price.Value() );
+}
+
+void TSSWRealizedVolatility::Expire( const Price& price ) {
+  --m_n;
+  m_dblSum -= Term( price.Value() );
+}
+
 void TSSWRealizedVolatility::PostUpdate( void ) {
-  double result( 0.0 );
-  if ( 1.0 == m_dblP ) {
-    result = m_dblSum / m_n;
+  Prices::Append( Price( m_dt, Result( m_dblSum, m_n ) * m_dblScaleFactor ) );
+}
+
+void TSSWRealizedVolatility::Batch( size_type ixBegin, size_type ixTrailing, const vTrailing_t& vTrailing ) {
+  // prefix sums of the terms from the start of the window
+  const size_type ixEnd( ixBegin + vTrailing.size() );
+  std::vector<double> vSum( ixEnd - ixTrailing + 1 );
+  vSum[ 0 ] = 0.0;
+  for ( size_type ix = ixTrailing; ix < ixEnd; ++ix ) {
+    vSum[ ix - ixTrailing + 1 ] = vSum[ ix - ixTrailing ] + Term( Datum( ix ).Value() );
   }
-  else {
-    if ( 2.0 == m_dblP ) {
-      result = std::sqrt( m_dblSum / m_n );
-    }
-    else {
-      result = std::pow( m_dblSum / m_n, 1.0 / m_dblP );
-    }
+  Prices::Reserve( Prices::Size() + vTrailing.size() );
+  for ( size_type ix = 0; ix < vTrailing.size(); ++ix ) {
+    const size_type ixLeading( ixBegin + ix + 1 ); // one past the datum
+    const double sum( vSum[ ixLeading - ixTrailing ] - vSum[ vTrailing[ ix ] - ixTrailing ] );
+    const double result( Result( sum, ixLeading - vTrailing[ ix ] ) );
+    Prices::Append( Price( Datum( ixLeading - 1 ).DateTime(), result * m_dblScaleFactor ) );
+  }
+  // hand off the window to Add/Expire
+  m_n = ixEnd - vTrailing.back();
+  m_dblSum = 0.0;
+  for ( size_type ix = vTrailing.back(); ix < ixEnd; ++ix ) {
+    m_dblSum += Term( Datum( ix ).Value() );
   }
-  Prices::Append( Price( m_dt, result * m_dblScaleFactor ) );
+  m_dt = Datum( ixEnd - 1 ).DateTime();
 }
 
 void TSSWRealizedVolatility::CalcScaleFactor( void ) {
@@ -38,9 +38,11 @@ public:
   void SetScaleFactor( time_duration tdScaledWidth ) { m_tdScaledWidth = tdScaledWidth; CalcScaleFactor(); };
   time_duration GetScaleFactor( void  ) { return m_tdScaledWidth; };
 protected:
+  using size_type = TimeSeriesSlidingWindow<TSSWRealizedVolatility, Price>::size_type;
   void Add( const Price& price );
   void Expire( const Price& price );
   void PostUpdate( void );
+  void Batch( size_type ixBegin, size_type ixTrailing, const vTrailing_t& vTrailing );
 private:
   unsigned int m_n;
   double m_dblSum;
@@ -49,6 +51,8 @@ private:
   time_duration m_tdScaledWidth;
   double m_dblScaleFactor;
   void CalcScaleFactor( void );
+  double Term( double val ) const; // contribution of a datum to the sum
+  double Result( double sum, unsigned int n ) const;
 };
 
 } // namespace tf
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "TFTimeSeries/TimeSeries.h"
 #include "TimeSeriesSlidingWindow.h"
 
@@ -36,6 +38,8 @@ protected:
   void Add( const datum_t& datum );
   void Expire( const datum_t& datum );
   void PostUpdate( void );
+  typedef typename TimeSeriesSlidingWindow<TSSWSMA<TS>, datum_t>::vTrailing_t vTrailing_t;
+  void Batch( size_type ixBegin, size_type ixTrailing, const vTrailing_t& vTrailing );
 private:
   size_t m_n;
   ptime m_dt;
@@ -78,6 +82,32 @@ void TSSWSMA<TS>::PostUpdate( void ) {
   Prices::Append( Price( m_dt, m_sum / m_n ) );
 }
 
+template<typename TS>
+void TSSWSMA<TS>::Batch( size_type ixBegin, size_type ixTrailing, const vTrailing_t& vTrailing ) {
+  // prefix sums from the start of the window, relative to its first value to keep the differences small
+  const size_type ixEnd( ixBegin + vTrailing.size() );
+  const double base( this->Datum( ixTrailing ).Value() );
+  std::vector<double> vSum( ixEnd - ixTrailing + 1 );
+  vSum[ 0 ] = 0.0;
+  for ( size_type ix = ixTrailing; ix < ixEnd; ++ix ) {
+    vSum[ ix - ixTrailing + 1 ] = vSum[ ix - ixTrailing ] + ( this->Datum( ix ).Value() - base );
+  }
+  Prices::Reserve( Prices::Size() + vTrailing.size() );
+  for ( size_type ix = 0; ix < vTrailing.size(); ++ix ) {
+    const size_type ixLeading( ixBegin + ix + 1 ); // one past the datum
+    const size_type n( ixLeading - vTrailing[ ix ] );
+    const double sum( vSum[ ixLeading - ixTrailing ] - vSum[ vTrailing[ ix ] - ixTrailing ] );
+    Prices::Append( Price( this->Datum( ixLeading - 1 ).DateTime(), base + sum / n ) );
+  }
+  // hand off the window to Add/Expire
+  m_n = ixEnd - vTrailing.back();
+  m_sum = 0.0;
+  for ( size_type ix = vTrailing.back(); ix < ixEnd; ++ix ) {
+    m_sum += this->Datum( ix ).Value();
+  }
+  m_dt = this->Datum( ixEnd - 1 ).DateTime();
+}
+
 // == ou::tf::Option specialization
 /* in complete
 template<>
@@ -28,6 +28,8 @@ class TimeSeriesSlidingWindowStats
   friend TimeSeriesSlidingWindow<T,D>;
 public:
 
+  using size_type = typename TimeSeriesSlidingWindow<T,D>::size_type;
+
   TimeSeriesSlidingWindowStats<T,D>( TimeSeries<D>& Series, time_duration tdWindowWidth, size_t WindowSizeCount = 0 );
   TimeSeriesSlidingWindowStats<T,D>( TimeSeries<D>& Series, size_t nPeriods, time_duration tdPeriodWidth, size_t WindowSizeCount = 0 );
   TimeSeriesSlidingWindowStats<T,D>( const TimeSeriesSlidingWindowStats<T,D>& rhs );
@@ -74,6 +76,26 @@ private:
     m_stats.CalcStats();
     OnUpdate( Results( m_dtLast, m_stats.Get() ) );
   };
+
+  using vTrailing_t = typename TimeSeriesSlidingWindow<T,D>::vTrailing_t;
+
+  // CRTP based call, the sums slide rather than being differenced from prefix sums,
+  //   over a long series the squared time offsets would swamp those of the window
+  // the stats are calculated for each datum only when OnUpdate has a subscriber
+  void Batch( size_type ixBegin, size_type ixTrailing, const vTrailing_t& vTrailing ) {
+    const bool bUpdate( !OnUpdate.IsEmpty() );
+    size_type ixDatum( ixBegin );
+    for ( const size_type ixWindow: vTrailing ) {
+      static_cast<T*>( this )->Add( this->Datum( ixDatum ) );
+      ++ixDatum;
+      while ( ixTrailing < ixWindow ) {
+        static_cast<T*>( this )->Expire( this->Datum( ixTrailing ) );
+        ++ixTrailing;
+      }
+      if ( bUpdate ) PostUpdate();
+    }
+    if ( !bUpdate ) m_stats.CalcStats();
+  }
 };
 
 // constructor
@@ -115,6 +137,7 @@ template<class T, class D> TimeSeriesSlidingWindowStats<T,D>::~TimeSeriesSliding
 
 class TSSWStatsTrade: public TimeSeriesSlidingWindowStats<TSSWStatsTrade, Trade> {
   friend TimeSeriesSlidingWindow<TSSWStatsTrade, Trade>;
+  friend TimeSeriesSlidingWindowStats<TSSWStatsTrade, Trade>;
 public:
   TSSWStatsTrade( TimeSeries<Trade>& series, time_duration tdWindowWidth, size_t WindowSizeCount = 0 );
   TSSWStatsTrade( const TSSWStatsTrade& rhs );
@@ -131,6 +154,7 @@ private:
 
 class TSSWStatsQuote: public TimeSeriesSlidingWindowStats<TSSWStatsQuote, Quote> {
   friend TimeSeriesSlidingWindow<TSSWStatsQuote, Quote>;
+  friend TimeSeriesSlidingWindowStats<TSSWStatsQuote, Quote>;
 public:
   TSSWStatsQuote( TimeSeries<Quote>& series, time_duration tdWindowWidth, size_t WindowSizeCount = 0 );
   TSSWStatsQuote( const TSSWStatsQuote& rhs );
@@ -147,6 +171,7 @@ private:
 
 class TSSWStatsMidQuote: public TimeSeriesSlidingWindowStats<TSSWStatsMidQuote, Quote> {
   friend TimeSeriesSlidingWindow<TSSWStatsMidQuote, Quote>;
+  friend TimeSeriesSlidingWindowStats<TSSWStatsMidQuote, Quote>;
 public:
   TSSWStatsMidQuote( Quotes& series, time_duration tdWindowWidth, size_t WindowSizeCount = 0 );
   TSSWStatsMidQuote( Quotes& series, size_t nPeriods, time_duration tdPeriodWidth, size_type WindowSizeCount = 0 );
@@ -165,6 +190,7 @@ private:
 
 class TSSWStatsPrice: public TimeSeriesSlidingWindowStats<TSSWStatsPrice, Price> {
   friend TimeSeriesSlidingWindow<TSSWStatsPrice, Price>;
+  friend TimeSeriesSlidingWindowStats<TSSWStatsPrice, Price>;
 public:
   TSSWStatsPrice( TimeSeries<Price>& series, time_duration tdWindowWidth, size_t WindowSizeCount = 0 );
   TSSWStatsPrice( const TSSWStatsPrice& rhs );
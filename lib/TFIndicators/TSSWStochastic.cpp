@@ -12,6 +12,8 @@
  * See the file LICENSE.txt for redistribution information.             *
  ************************************************************************/
 
+#include <deque>
+
 #include "TSSWStochastic.h"
 
 namespace ou { // One Unified
@@ -40,13 +42,13 @@ double TSSWStochastic::Size() const {
 
 void TSSWStochastic::Add( const Quote& quote ) {
   if ( quote.IsNonZero() ) {
+    m_dtLatest = quote.DateTime(); // prior to minmax::Add, for UpdateOnAdd
+    m_bAvailable = true;
     double tmp = quote.Midpoint();
     if ( tmp != m_lastAdd ) {  // cut down on number of updates (can't use, needs to be replicated in Expire)
       m_lastAdd = tmp;
       minmax::Add( m_lastAdd );
     }
-    m_dtLatest = quote.DateTime();
-    m_bAvailable = true;
   }
   else {
     m_bAvailable = false;
@@ -81,6 +83,83 @@ void TSSWStochastic::UpdateOnAdd( double min, double max ) {
   }
 }
 
+double TSSWStochastic::Preceding( size_type ix ) {
+  while ( 0 < ix ) {
+    --ix;
+    const Quote& quote( Datum( ix ) );
+    if ( quote.IsNonZero() ) return quote.Midpoint();
+  }
+  return 0.0;
+}
+
+void TSSWStochastic::Batch( size_type ixBegin, size_type ixTrailing, const vTrailing_t& vTrailing ) {
+  // Add and Expire skip the same quotes: zero, or a midpoint repeating that of the prior non-zero quote,
+  //   so the map holds the midpoints of the remaining quotes in the window,
+  //   monotonic deques of those quotes provide the min and max without the map
+  struct Entry {
+    size_type ix;
+    double mid;
+  };
+  std::deque<Entry> dequeMin; // increasing midpoints
+  std::deque<Entry> dequeMax; // decreasing midpoints
+
+  auto Push = [&dequeMin,&dequeMax]( size_type ix, double mid ){
+    while ( !dequeMin.empty() && ( mid <= dequeMin.back().mid ) ) dequeMin.pop_back();
+    dequeMin.push_back( Entry{ ix, mid } );
+    while ( !dequeMax.empty() && ( mid >= dequeMax.back().mid ) ) dequeMax.pop_back();
+    dequeMax.push_back( Entry{ ix, mid } );
+  };
+
+  auto Trim = [&dequeMin,&dequeMax]( size_type ixTrailing ){
+    while ( dequeMin.front().ix < ixTrailing ) dequeMin.pop_front();
+    while ( dequeMax.front().ix < ixTrailing ) dequeMax.pop_front();
+  };
+
+  // quotes already in the window
+  double prior( Preceding( ixTrailing ) );
+  for ( size_type ix = ixTrailing; ix < ixBegin; ++ix ) {
+    const Quote& quote( Datum( ix ) );
+    if ( quote.IsNonZero() && ( quote.Midpoint() != prior ) ) {
+      prior = quote.Midpoint();
+      Push( ix, prior );
+    }
+  }
+
+  // as Add, UpdateOnAdd sees the window prior to the expiry of this update
+  for ( size_type ix = 0; ix < vTrailing.size(); ++ix ) {
+    const Quote& quote( Datum( ixBegin + ix ) );
+    if ( quote.IsNonZero() ) {
+      m_dtLatest = quote.DateTime();
+      m_bAvailable = true;
+      if ( quote.Midpoint() != prior ) {
+        prior = quote.Midpoint();
+        Push( ixBegin + ix, prior );
+        Trim( ixTrailing );
+        m_lastAdd = prior;
+        UpdateOnAdd( dequeMin.front().mid, dequeMax.front().mid );
+      }
+    }
+    else {
+      m_bAvailable = false;
+    }
+    ixTrailing = vTrailing[ ix ];
+  }
+
+  // hand off the window to Add/Expire
+  const size_type ixEnd( ixBegin + vTrailing.size() );
+  const double expired( Preceding( ixTrailing ) );
+  if ( 0.0 != expired ) m_lastExpire = expired;
+  minmax::Reset();
+  prior = expired;
+  for ( size_type ix = ixTrailing; ix < ixEnd; ++ix ) {
+    const Quote& quote( Datum( ix ) );
+    if ( quote.IsNonZero() && ( quote.Midpoint() != prior ) ) {
+      prior = quote.Midpoint();
+      minmax::Insert( prior );
+    }
+  }
+}
+
 void TSSWStochastic::Reset() {
   m_lastAdd = m_lastExpire = m_k = 0;
   minmax::Reset();
@@ -48,6 +48,7 @@ protected:
   void Add( const Quote& quote );
   void Expire( const Quote& quote );
   //void PostUpdate();
+  void Batch( size_type ixBegin, size_type ixTrailing, const vTrailing_t& vTrailing );
 private:
   bool m_bAvailable;
   double m_lastAdd;
@@ -57,6 +58,7 @@ private:
   fK_t m_fK;
 
   void UpdateOnAdd( double min, double max );
+  double Preceding( size_type ix ); // midpoint of the last non-zero quote prior to ix
 };
 
 } // namespace tf
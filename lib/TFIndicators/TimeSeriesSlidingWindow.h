@@ -19,6 +19,16 @@
 // Each time timeseries updated, run Update to continue
 // useful when timeseries serves multiple windows
 
+// Backfill, for a series already holding history when the window is constructed
+//   (history retrieval, a series loaded from hdf5), rather than replaying it through Update:
+//   the trailing index of each datum is found in one pass, then handed to the CRTP Batch override,
+//   which computes the indicator over the whole range (prefix sums, monotonic deques) and leaves its
+//   state as Add/Expire would have, so subsequent appends continue from there
+//   without a Batch override, Add/Expire/PostUpdate are replayed for each datum
+//   OnAppend is not emitted for backfilled datums
+
+#include <vector>
+
 #include <TFTimeSeries/TimeSeries.h>
 
 namespace ou { // One Unified
@@ -36,16 +46,24 @@ public:
   TimeSeriesSlidingWindow<T,D>( TimeSeriesSlidingWindow<T,D>&& ); // limited to the initial emplace operations
   virtual ~TimeSeriesSlidingWindow<T,D>();
   virtual void Reset();
+  void Backfill(); // process the datums already in the series as a batch
   ou::Delegate<const D&> OnAppend;
 protected:
+  using vTrailing_t = std::vector<size_type>;
+
   ptime m_dtZero;  // datetime of first element, used as offset
   time_duration WindowWidth() const { return m_tdWindowWidth; };
 
   void Update();
 
+  const D& Datum( size_type ix ) const { return *m_Series.at( ix ); }
+
   void Add( const D& datum ) {}; // CRTP override to process elements passing into window scope
   void Expire( const D& datum ) {};  // CRTP override to process elements passing out of window scope
   void PostUpdate() {};  // CRTP override to do final calcs
+  // CRTP override for Backfill: datums from ixBegin are new, ixTrailing is the trailing index prior,
+  //   vTrailing[ ix ] is the trailing index once datum ixBegin + ix has been added
+  void Batch( size_type, size_type, const vTrailing_t& ) {};
 private:
   TimeSeries<D>& m_Series;
   time_duration m_tdWindowWidth;
@@ -178,6 +196,65 @@ void TimeSeriesSlidingWindow<T,D>::Update() {
   }
 }
 
+template<class T, class D>
+void TimeSeriesSlidingWindow<T,D>::Backfill() {
+
+  const size_type ixEnd( m_Series.Size() );
+  if ( ixEnd == m_ixLeading ) return;
+
+  if ( !m_bFirstDatumFound ) {
+    m_dtZero = m_Series[ 0 ].DateTime();  // used for zeroing the statistics
+    m_bFirstDatumFound = true;
+  }
+
+  // the window as Update would find it, were each datum appended in turn
+  vTrailing_t vTrailing;
+  vTrailing.reserve( ixEnd - m_ixLeading );
+  const bool bWindowCount( 0 < m_nWindowSizeCount );
+  const bool bWindowWidth( 0 < m_tdWindowWidth.total_milliseconds() );
+  size_type ixTrailing( m_ixTrailing );
+  for ( size_type ixLeading = m_ixLeading; ixLeading < ixEnd; ) {
+    const ptime dtLeading( Datum( ixLeading ).DateTime() );
+    ++ixLeading;
+    if ( bWindowCount ) {
+      while ( ( ixLeading - ixTrailing ) > m_nWindowSizeCount ) {
+        ++ixTrailing;
+      }
+    }
+    if ( bWindowWidth ) {
+      while ( ( dtLeading - Datum( ixTrailing ).DateTime() ) > m_tdWindowWidth ) {
+        ++ixTrailing;
+        if ( ixTrailing >= ixLeading ) {
+          break;
+        }
+      }
+    }
+    vTrailing.push_back( ixTrailing );
+  }
+
+  if ( &TimeSeriesSlidingWindow<T,D>::Batch != &T::Batch ) {
+    static_cast<T*>( this )->Batch( m_ixLeading, m_ixTrailing, vTrailing );
+  }
+  else {
+    for ( size_type ix = 0; ix < vTrailing.size(); ++ix ) {
+      if ( &TimeSeriesSlidingWindow<T,D>::Add != &T::Add ) {
+        static_cast<T*>( this )->Add( Datum( m_ixLeading + ix ) );
+        while ( m_ixTrailing < vTrailing[ ix ] ) {
+          static_cast<T*>( this )->Expire( Datum( m_ixTrailing ) );
+          ++m_ixTrailing;
+        }
+      }
+      if ( &TimeSeriesSlidingWindow<T,D>::PostUpdate != &T::PostUpdate ) {
+        static_cast<T*>( this )->PostUpdate();
+      }
+    }
+  }
+
+  m_ixLeading = ixEnd;
+  m_ixTrailing = vTrailing.back();
+  m_dtLeading = Datum( ixEnd - 1 ).DateTime();
+}
+
 template<class T, class D>
 void TimeSeriesSlidingWindow<T,D>::HandleDatum( const D& datum ) {
   if ( m_bAutoUpdate ) Update();
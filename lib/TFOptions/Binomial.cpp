@@ -23,6 +23,11 @@
 
 #include <boost/lexical_cast.hpp>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "Formula.h"
 #include "Binomial.h"
 
 namespace ou { // One Unified
@@ -30,60 +35,146 @@ namespace tf { // TradeFrame
 namespace option { // options
 namespace binomial { // binomial
 
-void CRR( const structInput& input, structOutput& output ) {
+namespace {
 
-  std::vector<double> v; v.resize( input.n + 1 );
-  double u, d, p;
-  double dt;
-  double df;
-  double z;
+// node buffers are reused across calls, sized on demand, one set per thread
+struct Lattice {
+  std::vector<double> v;     // option value at each node of the current level
+  std::vector<double> even;  // S * u^k, k = -n, -n+2, ...
+  std::vector<double> odd;   // S * u^k, k = -n+1, -n+3, ...
+};
 
-  switch ( input.optionSide ) {
-  case ou::tf::OptionSide::Call:
-    z = 1;
-    break;
-  case ou::tf::OptionSide::Put:
-    z = -1;
-    break;
+thread_local Lattice lattice;
+
+// one backward induction step for nodes 0..j:
+//   v[i] = max( exercise, df * ( p * v[i+1] + q * v[i] ) )
+// v[i+1] is read before v[i] is written, so ascending in-place update is safe in blocks
+template<bool bCall, bool bAmerican>
+inline void Step( double* v, const double* price, long j, double dfp, double dfq, double X ) {
+
+  long i = 0;
+
+#if defined(__AVX2__)
+  const __m256d vdfp = _mm256_set1_pd( dfp );
+  const __m256d vdfq = _mm256_set1_pd( dfq );
+  const __m256d vX = _mm256_set1_pd( X );
+  for ( ; i + 4 <= j + 1; i += 4 ) {
+    __m256d vCur = _mm256_loadu_pd( v + i );
+    __m256d vUp  = _mm256_loadu_pd( v + i + 1 );
+    __m256d vEuro = _mm256_add_pd( _mm256_mul_pd( vdfp, vUp ), _mm256_mul_pd( vdfq, vCur ) );
+    if ( bAmerican ) {
+      __m256d vPrice = _mm256_loadu_pd( price + i );
+      __m256d vExercise = bCall ? _mm256_sub_pd( vPrice, vX ) : _mm256_sub_pd( vX, vPrice );
+      vEuro = _mm256_max_pd( vEuro, vExercise );
+    }
+    _mm256_storeu_pd( v + i, vEuro );
+  }
+#endif
+
+  for ( ; i <= j; ++i ) {
+    double euro = dfp * v[ i + 1 ] + dfq * v[ i ];
+    if ( bAmerican ) {
+      double exercise = bCall ? ( price[ i ] - X ) : ( X - price[ i ] );
+      v[ i ] = std::max<double>( exercise, euro );
+    }
+    else {
+      v[ i ] = euro;
+    }
   }
+}
+
+// node (j,i) has underlying price S * u^(2i-j), which lives in the even or odd
+// table depending upon the parity of n-j, so every level reads contiguous prices
+template<bool bCall, bool bAmerican>
+void CRR_Kernel( const structInput& input, structOutput& output ) {
 
-  dt = input.T / input.n;
-  u = exp( input.v * sqrt( dt ) );
-  d = 1.0 / u;
-  p = ( exp( input.b * dt ) - d ) / ( u - d );
-  df = exp( -input.r * dt );
+  const long n = input.n;
+  const double S = input.S;
+  const double X = input.X;
 
-  for ( int ix = 0; ix <= input.n; ++ix ) {
-    v[ ix ] = std::max<double>( 0.0, z * ( input.S * pow( u, ix ) * pow( d, input.n - ix ) - input.X ) );
+  const double dt = input.T / n;
+  const double u = std::exp( input.v * std::sqrt( dt ) );
+  const double d = 1.0 / u;
+  const double p = ( std::exp( input.b * dt ) - d ) / ( u - d );
+  const double df = std::exp( -input.r * dt );
+  const double dfp = df * p;
+  const double dfq = df * ( 1.0 - p );
+
+  Lattice& l( lattice );
+  if ( l.v.size() < (size_t)( n + 1 ) ) {
+    l.v.resize( n + 1 );
+    l.even.resize( n + 1 );
+    l.odd.resize( n + 1 );
   }
-  for ( int j = input.n - 1; j >= 0; --j ) {
-    for ( int i = 0; i <= j; ++i ) {
-      double europrice = df * ( p * v[ i + 1 ] + ( 1.0 - p ) * v[ i ] );
-      double exerciseprice;
-      switch ( input.optionStyle ) {
-      case ou::tf::OptionStyle::American:
-        exerciseprice = z * ( input.S * pow( u, i ) * pow( d, j - i ) - input.X );
-        v[ i ] = std::max<double>( exerciseprice, europrice );
-        break;
-      case ou::tf::OptionStyle::European:
-        v[ i ] = europrice;
-        break;
-      }
-      if ( 2 == j ) {
-        output.gamma = ( ( v[ 2 ] - v[ 1 ] ) / ( input.S * u * u - input.S )
-          - ( v[ 1 ] - v[ 0 ] ) / ( input.S - input.S * d * d ) )
-          / ( 0.5 * ( input.S * u * u - input.S * d * d ) );
-        output.theta = v[ 1 ];
-      }
-      if ( 1 == j ) {
-        output.delta = ( v[ 1 ] - v[ 0 ] ) / ( input.S * ( u - d ) );
-      }
+
+  // price powers by recurrence outward from S, k = 2m - n for even, 2m + 1 - n for odd
+  {
+    double* const even = l.even.data();
+    double* const odd = l.odd.data();
+    const double u2 = u * u;
+    const double d2 = d * d;
+    // anchor each table at the node nearest S
+    const long mEven = n / 2;        // k = 2*mEven - n, 0 or -1
+    const long mOdd = ( n - 1 ) / 2; // k = 2*mOdd + 1 - n, 0 or -1
+    even[ mEven ] = ( 0 == ( n % 2 ) ) ? S : S * d;
+    for ( long m = mEven + 1; m <= n; ++m ) even[ m ] = even[ m - 1 ] * u2;
+    for ( long m = mEven - 1; m >= 0; --m ) even[ m ] = even[ m + 1 ] * d2;
+    if ( 0 < n ) {
+      odd[ mOdd ] = ( 0 == ( n % 2 ) ) ? S * d : S;
+      for ( long m = mOdd + 1; m < n; ++m ) odd[ m ] = odd[ m - 1 ] * u2;
+      for ( long m = mOdd - 1; m >= 0; --m ) odd[ m ] = odd[ m + 1 ] * d2;
     }
   }
-  output.theta = ( output.theta - v[ 0 ] ) / ( 2.0 * dt ) / 365.0;
+
+  double* const v = l.v.data();
+
+  // terminal nodes, level n, k = 2i - n, all in the even table
+  for ( long ix = 0; ix <= n; ++ix ) {
+    const double price = l.even[ ix ];
+    v[ ix ] = std::max<double>( 0.0, bCall ? ( price - X ) : ( X - price ) );
+  }
+
+  double theta {};
+  for ( long j = n - 1; j >= 0; --j ) {
+    // level j node i: k = 2i - j = 2( i + (n-j)/2 ) - n when n-j even
+    const long shift = n - j;
+    const double* price = ( 0 == ( shift % 2 ) ) ? l.even.data() + shift / 2 : l.odd.data() + ( shift - 1 ) / 2;
+    Step<bCall, bAmerican>( v, price, j, dfp, dfq, X );
+    if ( 2 == j ) {
+      output.gamma = ( ( v[ 2 ] - v[ 1 ] ) / ( S * u * u - S )
+        - ( v[ 1 ] - v[ 0 ] ) / ( S - S * d * d ) )
+        / ( 0.5 * ( S * u * u - S * d * d ) );
+      theta = v[ 1 ];
+    }
+    if ( 1 == j ) {
+      output.delta = ( v[ 1 ] - v[ 0 ] ) / ( S * ( u - d ) );
+    }
+  }
+  output.theta = ( theta - v[ 0 ] ) / ( 2.0 * dt ) / 365.0;
   output.option = v[ 0 ];
 }
 
+} // namespace anonymous
+
+// call/put and american/european are resolved here, once, rather than per node
+void CRR( const structInput& input, structOutput& output ) {
+
+  const bool bAmerican( ou::tf::OptionStyle::American == input.optionStyle );
+
+  switch ( input.optionSide ) {
+  case ou::tf::OptionSide::Call:
+    if ( bAmerican ) CRR_Kernel<true, true>( input, output );
+    else             CRR_Kernel<true, false>( input, output );
+    break;
+  case ou::tf::OptionSide::Put:
+    if ( bAmerican ) CRR_Kernel<false, true>( input, output );
+    else             CRR_Kernel<false, false>( input, output );
+    break;
+  default:
+    throw std::runtime_error( "CRR: unknown option side" );
+  }
+}
+
 double CalcImpliedVolatility( const structInput& input_, double option, structOutput& output, double epsilon ) {
   // Black Scholes and Beyond, page 336  -- not sure if this is correct model used.  I didn't document model used
   // Option Pricing Formulas, page 453  -- or might have been this one
@@ -156,6 +247,91 @@ double CalcImpliedVolatility( const structInput& input_, double option, structOu
   return output.iv;
 }
 
+bool CalcImpliedVolatilitySeeded(
+  const structInput& input_, double option, structOutput& output, double epsilon, size_t nMaxSteps
+) {
+
+  static const double volMin = 0.005;
+  static const double volMax = 5.0;
+  static const double pct = 0.01;  // 1% change in rate for rho
+
+  structInput input( input_ );
+
+  double lo = volMin;
+  double hi = volMax;
+
+  double v = std::min( volMax, std::max( volMin, input.v ) );
+  input.v = v;
+  CRR( input, output );
+  double f = output.option - option;
+
+  bool bConverged( std::fabs( f ) < epsilon );
+  double slope = 0.0; // d(price)/d(vol)
+
+  double vPrev = 0.0;
+  double fPrev = 0.0;
+  bool bPrev = false;
+
+  for ( size_t ix = 0; !bConverged && ( ix < nMaxSteps ); ++ix ) {
+    if ( 0.0 < f ) hi = v; else lo = v;
+    if ( bPrev && ( v != vPrev ) ) {
+      slope = ( f - fPrev ) / ( v - vPrev );
+    }
+    else { // european vega is close enough for the first step
+      BSM_Euro bsm( input.r, v, input.T, input.r - input.b );
+      bsm.Set( input.S, input.X, v );
+      slope = bsm.Vega();
+    }
+    double vNew = ( 0.0 < slope ) ? v - f / slope : 0.5 * ( lo + hi );
+    if ( ( vNew <= lo ) || ( vNew >= hi ) ) vNew = 0.5 * ( lo + hi );
+    vPrev = v; fPrev = f; bPrev = true;
+    v = input.v = vNew;
+    CRR( input, output );
+    f = output.option - option;
+    bConverged = std::fabs( f ) < epsilon;
+  }
+
+  if ( !bConverged ) {
+    // fallback: confirm the bracket, then bisect
+    if ( 0.0 < f ) hi = v; else lo = v;
+    structOutput outputLo, outputHi;
+    input.v = lo; CRR( input, outputLo );
+    input.v = hi; CRR( input, outputHi );
+    if ( ( outputLo.option - option > 0.0 ) || ( outputHi.option - option < 0.0 ) ) {
+      return false;  // price is outside of what the lattice can produce
+    }
+    for ( size_t ix = 0; !bConverged && ( ix < 40 ); ++ix ) {
+      vPrev = v;
+      fPrev = f;
+      v = input.v = 0.5 * ( lo + hi );
+      CRR( input, output );
+      f = output.option - option;
+      if ( 0.0 < f ) hi = v; else lo = v;
+      bConverged = std::fabs( f ) < epsilon;
+    }
+    if ( !bConverged ) return false;
+    if ( v != vPrev ) slope = ( f - fPrev ) / ( v - vPrev );
+  }
+
+  if ( 0.0 == slope ) { // converged on the seed, no slope yet
+    BSM_Euro bsm( input.r, v, input.T, input.r - input.b );
+    bsm.Set( input.S, input.X, v );
+    slope = bsm.Vega();
+  }
+
+  output.iv = v;
+  output.vega = slope * 0.01; // same per 1% scaling as CalcImpliedVolatility
+
+  // bump the rate by 1%, or by a basis point when there is no rate to scale
+  structOutput outputTmp;
+  const double dr = ( 0.0 == input.r ) ? 0.0001 : pct * input.r;
+  input.r += dr;
+  CRR( input, outputTmp );
+  output.rho = ( outputTmp.option - output.option ) / dr;
+
+  return true;
+}
+
 } // namespace binomial
 } // namespace option
 } // namespace tf
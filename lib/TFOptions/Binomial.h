@@ -69,6 +69,13 @@ struct structOutput {
 void CRR( const structInput& input, structOutput& output );
 double CalcImpliedVolatility( const structInput& input, double option, structOutput& output, double epsilon = 0.0001 );
 
+// input.v is the seed (european closed form, or the last known greek),
+// american correction by safeguarded secant steps inside a volatility bracket, bisection as the fallback
+// returns false, rather than throwing, when the price can not be matched
+bool CalcImpliedVolatilitySeeded(
+  const structInput& input, double option, structOutput& output,
+  double epsilon = 0.0001, size_t nMaxSteps = 6 );
+
 } // namespace binomial
 } // namespace option
 } // namespace tf
@@ -0,0 +1,366 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    ChainSnapshot.h
+ * Author:  raymond@burkholder.net
+ * Project: TFOptions
+ * Created: October 17, 2026
+ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <unordered_map>
+
+#include <boost/date_time/gregorian/greg_date.hpp>
+
+#include "Chain.h"
+#include "Option.h"
+#include "Exceptions.h"
+
+// flattened, struct-of-arrays, view of a Chain or of a map of Chains:
+//   rows are ordered by expiry then strike, each column is contiguous,
+//   so strike lookups are binary searches and surface calculations are loops over arrays
+// Build/Rebuild when strikes are added/removed, Update/UpdateOption as quotes and greeks arrive
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace option { // options
+
+namespace chain {
+
+  // chain entries with a constructed option (OptionName derivatives with a pOption member)
+  template<typename T, typename = void>
+  struct has_option: std::false_type {};
+  template<typename T>
+  struct has_option<T, std::void_t<decltype( std::declval<T>().pOption )> >: std::true_type {};
+
+  template<typename T>
+  const Option* GetOption( const T& entry, std::true_type ) { return entry.pOption.get(); }
+  template<typename T>
+  const Option* GetOption( const T&, std::false_type ) { return nullptr; }
+}
+
+template<typename OptionEntry>
+class ChainSnapshot {
+public:
+
+  using chain_t = Chain<OptionEntry>;
+  using mapChains_t = std::map<boost::gregorian::date, chain_t>;
+  using size_type = std::size_t;
+
+  using exception_strike_not_found = typename chain_t::exception_strike_not_found;
+  using exception_at_start_of_chain = typename chain_t::exception_at_start_of_chain;
+
+  struct Side { // one set of columns per option side
+    std::vector<double> bid;
+    std::vector<double> ask;
+    std::vector<double> iv;
+    std::vector<double> delta;
+    std::vector<double> gamma;
+    std::vector<const Option*> option; // source for Update, nullptr when not constructed
+    void Clear() {
+      bid.clear(); ask.clear(); iv.clear(); delta.clear(); gamma.clear(); option.clear();
+    }
+    void Append( const Option* pOption ) {
+      bid.push_back( 0.0 ); ask.push_back( 0.0 ); iv.push_back( 0.0 );
+      delta.push_back( 0.0 ); gamma.push_back( 0.0 );
+      option.push_back( pOption );
+    }
+    void Update( size_type ix ) {
+      const Option* pOption( option[ ix ] );
+      if ( nullptr != pOption ) {
+        const ou::tf::Quote& quote( pOption->LastQuote() );
+        const ou::tf::Greek& greek( pOption->LastGreek() );
+        bid[ ix ] = quote.Bid();
+        ask[ ix ] = quote.Ask();
+        iv[ ix ] = greek.ImpliedVolatility();
+        delta[ ix ] = greek.Delta();
+        gamma[ ix ] = greek.Gamma();
+      }
+    }
+  };
+
+  struct Slice { // rows [begin, end) belonging to one expiry
+    size_type begin;
+    size_type end;
+    size_type Size() const { return end - begin; }
+  };
+
+  ChainSnapshot() {}
+  virtual ~ChainSnapshot() {}
+
+  void Build( boost::gregorian::date, const chain_t& ); // single expiry
+  void Build( const mapChains_t& ); // whole surface
+  bool Stale( const mapChains_t& ) const; // expiries, strikes or constructed options differ from the Build
+
+  void Update(); // refresh quote & greek columns for all rows
+  bool UpdateOption( const Option& ); // refresh the row for a single option, false if not in the snapshot
+
+  size_type Rows() const { return m_vStrike.size(); }
+  size_type Expiries() const { return m_vExpiry.size(); }
+  boost::gregorian::date Expiry( size_type ixExpiry ) const { return m_vExpiry[ ixExpiry ]; }
+  size_type FindExpiry( boost::gregorian::date ) const; // exact match
+  Slice Rows( size_type ixExpiry ) const { return Slice{ m_vExpiryBegin[ ixExpiry ], m_vExpiryBegin[ ixExpiry + 1 ] }; }
+
+  const std::vector<double>& Strike() const { return m_vStrike; }
+  const Side& Call() const { return m_call; }
+  const Side& Put() const { return m_put; }
+
+  // same semantics (and exceptions) as the Chain methods, restricted to one expiry
+  double Put_Itm( size_type ixExpiry, double ) const;
+  double Put_ItmAtm( size_type ixExpiry, double ) const;
+  double Put_OtmAtm( size_type ixExpiry, double ) const;
+  double Put_Otm( size_type ixExpiry, double ) const;
+
+  double Call_Itm( size_type ixExpiry, double value ) const { return Put_Otm( ixExpiry, value ); }
+  double Call_ItmAtm( size_type ixExpiry, double value ) const { return Put_OtmAtm( ixExpiry, value ); }
+  double Call_OtmAtm( size_type ixExpiry, double value ) const { return Put_ItmAtm( ixExpiry, value ); }
+  double Call_Otm( size_type ixExpiry, double value ) const { return Put_Itm( ixExpiry, value ); }
+
+  double Atm( size_type ixExpiry, double ) const;
+  double Call_Atm( size_type ixExpiry, double value ) const { return Atm( ixExpiry, value ); }
+  double Put_Atm( size_type ixExpiry, double value ) const { return Atm( ixExpiry, value ); }
+
+  int AdjacentStrikes( size_type ixExpiry, double strikeSource, double& strikeLower, double& strikeUpper ) const;
+
+  // implied volatility at price, linearly interpolated between bracketing strikes (as in IvAtm::CalcIvAtm)
+  // returns false when price is outside of the expiry's strikes
+  bool IvAt( size_type ixExpiry, double price, double& ivCall, double& ivPut ) const;
+
+protected:
+private:
+
+  using mapOptionRow_t = std::unordered_map<const Option*, size_type>;
+
+  static const size_type PutBit = size_type( 1 ) << ( sizeof( size_type ) * 8 - 1 ); // row index tag for puts
+
+  std::vector<boost::gregorian::date> m_vExpiry;
+  std::vector<size_type> m_vExpiryBegin; // Expiries() + 1 entries
+  std::vector<double> m_vStrike;
+
+  Side m_call;
+  Side m_put;
+
+  mapOptionRow_t m_mapOptionRow;
+
+  void Clear();
+  void Append( boost::gregorian::date, const chain_t& );
+  bool Differs( size_type ixExpiry, const chain_t& ) const;
+
+  size_type LowerBound( const Slice& slice, double value ) const { // first strike >= value
+    return std::lower_bound( m_vStrike.begin() + slice.begin, m_vStrike.begin() + slice.end, value ) - m_vStrike.begin();
+  }
+  size_type UpperBound( const Slice& slice, double value ) const { // first strike > value
+    return std::upper_bound( m_vStrike.begin() + slice.begin, m_vStrike.begin() + slice.end, value ) - m_vStrike.begin();
+  }
+};
+
+// methods:
+
+template<typename OptionEntry>
+void ChainSnapshot<OptionEntry>::Clear() {
+  m_vExpiry.clear();
+  m_vExpiryBegin.clear();
+  m_vExpiryBegin.push_back( 0 );
+  m_vStrike.clear();
+  m_call.Clear();
+  m_put.Clear();
+  m_mapOptionRow.clear();
+}
+
+template<typename OptionEntry>
+void ChainSnapshot<OptionEntry>::Append( boost::gregorian::date date, const chain_t& chain ) {
+  m_vExpiry.push_back( date );
+  chain.Strikes(
+    [this]( double strike, const typename chain_t::strike_t& entry ){
+      const size_type ix( m_vStrike.size() );
+      m_vStrike.push_back( strike );
+      const Option* pCall( chain::GetOption( entry.call, chain::has_option<OptionEntry>() ) );
+      const Option* pPut(  chain::GetOption( entry.put,  chain::has_option<OptionEntry>() ) );
+      m_call.Append( pCall );
+      m_put.Append( pPut );
+      if ( nullptr != pCall ) m_mapOptionRow[ pCall ] = ix;
+      if ( nullptr != pPut )  m_mapOptionRow[ pPut ] = ix | PutBit;
+    } );
+  m_vExpiryBegin.push_back( m_vStrike.size() );
+}
+
+template<typename OptionEntry>
+void ChainSnapshot<OptionEntry>::Build( boost::gregorian::date date, const chain_t& chain ) {
+  Clear();
+  Append( date, chain );
+  Update();
+}
+
+template<typename OptionEntry>
+void ChainSnapshot<OptionEntry>::Build( const mapChains_t& mapChains ) { // map is ordered by expiry
+  Clear();
+  for ( const typename mapChains_t::value_type& vt: mapChains ) {
+    Append( vt.first, vt.second );
+  }
+  Update();
+}
+
+template<typename OptionEntry>
+bool ChainSnapshot<OptionEntry>::Stale( const mapChains_t& mapChains ) const {
+  if ( mapChains.size() != m_vExpiry.size() ) return true;
+  size_type ix {};
+  for ( const typename mapChains_t::value_type& vt: mapChains ) {
+    if ( vt.first != m_vExpiry[ ix ] ) return true;
+    if ( Differs( ix, vt.second ) ) return true;
+    ix++;
+  }
+  return false;
+}
+
+template<typename OptionEntry>
+bool ChainSnapshot<OptionEntry>::Differs( size_type ixExpiry, const chain_t& chain ) const {
+  const Slice slice( Rows( ixExpiry ) );
+  if ( chain.Size() != slice.Size() ) return true;
+  bool bDiffers( false );
+  size_type ix( slice.begin );
+  chain.Strikes(
+    [this,&ix,&bDiffers]( double strike, const typename chain_t::strike_t& entry ){
+      if ( !bDiffers ) {
+        bDiffers
+          =  ( strike != m_vStrike[ ix ] )
+          || ( chain::GetOption( entry.call, chain::has_option<OptionEntry>() ) != m_call.option[ ix ] )
+          || ( chain::GetOption( entry.put,  chain::has_option<OptionEntry>() ) != m_put.option[ ix ] );
+      }
+      ix++;
+    } );
+  return bDiffers;
+}
+
+template<typename OptionEntry>
+void ChainSnapshot<OptionEntry>::Update() {
+  const size_type n( m_vStrike.size() );
+  for ( size_type ix = 0; ix < n; ++ix ) {
+    m_call.Update( ix );
+    m_put.Update( ix );
+  }
+}
+
+template<typename OptionEntry>
+bool ChainSnapshot<OptionEntry>::UpdateOption( const Option& option ) {
+  typename mapOptionRow_t::const_iterator iter = m_mapOptionRow.find( &option );
+  if ( m_mapOptionRow.end() == iter ) return false;
+  if ( 0 == ( PutBit & iter->second ) ) m_call.Update( iter->second );
+  else m_put.Update( iter->second & ~PutBit );
+  return true;
+}
+
+template<typename OptionEntry>
+typename ChainSnapshot<OptionEntry>::size_type ChainSnapshot<OptionEntry>::FindExpiry( boost::gregorian::date date ) const {
+  typename std::vector<boost::gregorian::date>::const_iterator iter
+    = std::lower_bound( m_vExpiry.begin(), m_vExpiry.end(), date );
+  if ( ( m_vExpiry.end() == iter ) || ( date != *iter ) ) {
+    throw ou::tf::option::exception_chain_not_found( "ChainSnapshot::FindExpiry" );
+  }
+  return iter - m_vExpiry.begin();
+}
+
+template<typename OptionEntry>
+double ChainSnapshot<OptionEntry>::Put_Itm( size_type ixExpiry, double value ) const { // price < strike
+  const Slice slice( Rows( ixExpiry ) );
+  const size_type ix = UpperBound( slice, value );
+  if ( slice.end == ix ) throw exception_strike_not_found( "Put_Itm not found" );
+  return m_vStrike[ ix ];
+}
+
+template<typename OptionEntry>
+double ChainSnapshot<OptionEntry>::Put_ItmAtm( size_type ixExpiry, double value ) const { // price <= strike
+  const Slice slice( Rows( ixExpiry ) );
+  const size_type ix = LowerBound( slice, value );
+  if ( slice.end == ix ) throw exception_strike_not_found( "Put_ItmAtm not found" );
+  return m_vStrike[ ix ];
+}
+
+template<typename OptionEntry>
+double ChainSnapshot<OptionEntry>::Put_OtmAtm( size_type ixExpiry, double value ) const { // price >= strike
+  const Slice slice( Rows( ixExpiry ) );
+  size_type ix = LowerBound( slice, value );
+  if ( slice.end == ix ) throw exception_strike_not_found( "Put_OtmAtm not found" );
+  if ( value != m_vStrike[ ix ] ) {
+    if ( slice.begin == ix ) throw exception_at_start_of_chain( "Put_OtmAtm at begin of chain" );
+    ix--; // strike will be OTM
+  }
+  return m_vStrike[ ix ];
+}
+
+template<typename OptionEntry>
+double ChainSnapshot<OptionEntry>::Put_Otm( size_type ixExpiry, double value ) const { // price > strike
+  const Slice slice( Rows( ixExpiry ) );
+  const size_type ix = LowerBound( slice, value );
+  if ( slice.end == ix ) throw exception_strike_not_found( "Put_Otm not found" );
+  if ( slice.begin == ix ) throw exception_at_start_of_chain( "Put_Otm at begin of chain" );
+  return m_vStrike[ ix - 1 ];
+}
+
+template<typename OptionEntry>
+double ChainSnapshot<OptionEntry>::Atm( size_type ixExpiry, double value ) const { // closest strike
+  const Slice slice( Rows( ixExpiry ) );
+  const size_type ix = LowerBound( slice, value );
+  if ( slice.end == ix ) throw exception_strike_not_found( "Atm not found" );
+  if ( ( value == m_vStrike[ ix ] ) || ( slice.begin == ix ) ) return value; // matches Chain::Atm
+  const double upper( m_vStrike[ ix ] );
+  const double lower( m_vStrike[ ix - 1 ] );
+  return ( ( upper - value ) < ( value - lower ) ) ? upper : lower;
+}
+
+template<typename OptionEntry>
+int ChainSnapshot<OptionEntry>::AdjacentStrikes( size_type ixExpiry, double strikeSource, double& strikeLower, double& strikeUpper ) const {
+  strikeLower = strikeUpper = 0.0;
+  int nReturn {};
+  const Slice slice( Rows( ixExpiry ) );
+  const size_type ix = LowerBound( slice, strikeSource );
+  if ( ( slice.end != ix ) && ( strikeSource == m_vStrike[ ix ] ) ) {
+    if ( slice.begin != ix ) {
+      strikeLower = m_vStrike[ ix - 1 ];
+      nReturn++;
+    }
+    if ( slice.end != ( ix + 1 ) ) {
+      strikeUpper = m_vStrike[ ix + 1 ];
+      nReturn++;
+    }
+  }
+  return nReturn;
+}
+
+template<typename OptionEntry>
+bool ChainSnapshot<OptionEntry>::IvAt( size_type ixExpiry, double price, double& ivCall, double& ivPut ) const {
+  const Slice slice( Rows( ixExpiry ) );
+  const size_type ix = LowerBound( slice, price );
+  if ( slice.end == ix ) return false;
+  if ( price == m_vStrike[ ix ] ) {
+    ivCall = m_call.iv[ ix ];
+    ivPut = m_put.iv[ ix ];
+    return true;
+  }
+  if ( slice.begin == ix ) return false;
+  const double ratio = ( price - m_vStrike[ ix - 1 ] ) / ( m_vStrike[ ix ] - m_vStrike[ ix - 1 ] );
+  ivCall = m_call.iv[ ix - 1 ] + ( m_call.iv[ ix ] - m_call.iv[ ix - 1 ] ) * ratio;
+  ivPut  = m_put.iv[ ix - 1 ]  + ( m_put.iv[ ix ]  - m_put.iv[ ix - 1 ] )  * ratio;
+  return true;
+}
+
+} // namespace option
+} // namespace tf
+} // namespace ou
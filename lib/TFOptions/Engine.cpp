@@ -43,20 +43,14 @@ namespace tf { // TradeFrame
 namespace option { // options
 
 OptionEntry::OptionEntry( OptionEntry&& rhs ) {
-  if ( 0 < rhs.m_cntInstances ) {
-    rhs.m_pUnderlying->OnQuote.Remove( MakeDelegate( &rhs, &OptionEntry::HandleUnderlyingQuote ) );
-  }
   m_cntInstances = rhs.m_cntInstances;
   m_pOption = std::move( rhs.m_pOption );
   m_pUnderlying = std::move( rhs.m_pUnderlying );
   m_fGreek = std::move( rhs.m_fGreek );
+  m_pCalcState = std::move( rhs.m_pCalcState );
   //m_bStartedWatch = rhs.m_bStartedWatch;
   //rhs.m_bStartedWatch = false;
   rhs.m_cntInstances = 0; // can this be set, what happens on delete?  what happens when tied to m_bStartedWatch?
-  //if ( m_bStartedWatch ) {
-  if ( 0 < m_cntInstances ) {
-    m_pUnderlying->OnQuote.Add( MakeDelegate( this, &OptionEntry::HandleUnderlyingQuote) );
-  }
   //PrintState( "OptionEntry::OptionEntry(0)" );
 }
 
@@ -68,7 +62,8 @@ OptionEntry::OptionEntry( OptionEntry&& rhs ) {
 OptionEntry::OptionEntry( pWatch_t pUnderlying_, pOption_t pOption_, fCallbackWithGreek_t&& fGreek_ ):
   m_pUnderlying( pUnderlying_ ), m_pOption( pOption_ ), m_fGreek( std::move( fGreek_ ) ),
   //m_bStartedWatch( false ),
-  m_cntInstances( 0 ) // handled by Inc, Dec
+  m_cntInstances( 0 ), // handled by Inc, Dec
+  m_pCalcState( std::make_shared<CalcState>() )
 {
   //m_pUnderlying->OnQuote.Add( MakeDelegate( this, &OptionEntry::HandleUnderlyingQuote) );
   //m_pUnderlying->StartWatch();
@@ -81,7 +76,8 @@ OptionEntry::OptionEntry( pWatch_t pUnderlying_, pOption_t pOption_, fCallbackWi
 OptionEntry::OptionEntry( pWatch_t pUnderlying_, pOption_t pOption_ ):
   m_pUnderlying( pUnderlying_ ), m_pOption( pOption_ ),
   //m_bStartedWatch( false ),
-  m_cntInstances( 0 )
+  m_cntInstances( 0 ),
+  m_pCalcState( std::make_shared<CalcState>() )
 {
   //m_pUnderlying->OnQuote.Add( MakeDelegate( this, &OptionEntry::HandleUnderlyingQuote) );
   //m_pUnderlying->StartWatch();
@@ -123,7 +119,6 @@ void OptionEntry::PrintState( const std::string id ) {
 
 void OptionEntry::Inc() {
   if ( 0 == m_cntInstances ) {
-    m_pUnderlying->OnQuote.Add( MakeDelegate( this, &OptionEntry::HandleUnderlyingQuote ) );
     m_pUnderlying->StartWatch();
     m_pOption->StartWatch();  }
   m_cntInstances++;
@@ -134,15 +129,12 @@ size_t OptionEntry::Dec() {
   if ( 0 == m_cntInstances ) {
     m_pUnderlying->StopWatch();
     m_pOption->StopWatch();
-    m_pUnderlying->OnQuote.Remove( MakeDelegate( this, &OptionEntry::HandleUnderlyingQuote ) );
   }
   return m_cntInstances;
 }
 
-
-void OptionEntry::HandleUnderlyingQuote(const ou::tf::Quote& quote_) {
-  m_quoteLastUnderlying = quote_;
-}
+// the underlying quote is read from the watch's last value cache when needed,
+//   rather than copied on each quote by a handler on the feed thread
 
 //void OptionEntry::HandleOptionQuote(const ou::tf::Quote& quote_) { // should this be kept?
 //  if ( ! m_quoteLastOption.SameBidAsk( quote_ ) ) {
@@ -152,18 +144,26 @@ void OptionEntry::HandleUnderlyingQuote(const ou::tf::Quote& quote_) {
 //}
 
 void OptionEntry::Calc( const fCalc_t& fCalc ) {
-  fCalc( m_pOption, m_quoteLastUnderlying, m_fGreek );
+  fCalc( m_pOption, m_pUnderlying->LastQuote(), m_fGreek );
 }
 
 // ====================
 
-Engine::Engine( const ou::tf::NoRiskInterestRateSeries& feed ):
-  m_InterestRateFeed( feed ),
+Engine::Engine( const ou::tf::NoRiskInterestRateSeries& feed, size_t nThreads, size_t nBatchSize ):
   m_srvcWork(boost::asio::make_work_guard( m_srvc )),
-  m_timerScan( m_srvc )
+  m_timerScan( m_srvc ),
+  m_InterestRateFeed( feed ),
+  m_nBatchSize( std::max<size_t>( 1, nBatchSize ) ),
+  m_cntScans( 0 ), m_cntScansOverlapped( 0 ),
+  m_cntCalcs( 0 ), m_cntCalcsDropped( 0 ), m_cntCalcsUnchanged( 0 ),
+  m_cntBatchesQueued( 0 ),
+  m_usLastScan( 0 ), m_usMaxScan( 0 ),
+  m_bShardsStale( false )
 {
 
-  for ( std::size_t ix = 0; ix < 1; ix++ ) {  // change the final value to add threads, and fix the TODO further down
+  // the timer handler and the calculation batches share the pool,
+  // an OptionEntry is only ever calculated by one thread at a time (see OptionEntry::TryBeginCalc)
+  for ( std::size_t ix = 0; ix < std::max<size_t>( 1, nThreads ); ix++ ) {
     m_threads.create_thread( boost::bind( &boost::asio::io_context::run, &m_srvc ) ); // add handlers
   }
 
@@ -192,12 +192,26 @@ Engine::~Engine( ) {
   m_srvcWork.reset();
   m_threads.join_all();
 
+  m_mapShard.clear();
   m_mapOptionEntry.clear();
 
   m_mapKnownOptions.clear();
   m_mapKnownWatches.clear();
 }
 
+Engine::Stats Engine::GetStats() const {
+  Stats stats;
+  stats.nScans = m_cntScans.load( std::memory_order_relaxed );
+  stats.nScansOverlapped = m_cntScansOverlapped.load( std::memory_order_relaxed );
+  stats.nCalcs = m_cntCalcs.load( std::memory_order_relaxed );
+  stats.nCalcsDropped = m_cntCalcsDropped.load( std::memory_order_relaxed );
+  stats.nCalcsUnchanged = m_cntCalcsUnchanged.load( std::memory_order_relaxed );
+  stats.nBatchesQueued = m_cntBatchesQueued.load( std::memory_order_relaxed );
+  stats.durLastScan = std::chrono::microseconds( m_usLastScan.load( std::memory_order_relaxed ) );
+  stats.durMaxScan = std::chrono::microseconds( m_usMaxScan.load( std::memory_order_relaxed ) );
+  return stats;
+}
+
 void Engine::RegisterUnderlying( const pWatch_t& pWatch ) {
   assert( pWatch );
   std::lock_guard<std::mutex> lock(m_mutexOptionEntryOperationQueue);
@@ -354,6 +368,7 @@ void Engine::ProcessOptionEntryOperationQueue() {
           mapOptionEntry_t::iterator iterOption = m_mapOptionEntry.find( MapKey );
           if ( m_mapOptionEntry.end() == iterOption ) {
             iterOption = m_mapOptionEntry.insert( m_mapOptionEntry.begin(), mapOptionEntry_t::value_type(MapKey, std::move( oe.m_oe ) ) );
+            m_bShardsStale = true;
             //std::cout << "Engine::AddOption: " << MapKey << " added" << std::endl;
           }
           else {
@@ -374,6 +389,7 @@ void Engine::ProcessOptionEntryOperationQueue() {
           OptionEntry::size_type cnt = iterOption->second.Dec();
           if ( 0 == cnt ) {
             m_mapOptionEntry.erase( iterOption );
+            m_bShardsStale = true;
             //std::cout << "Engine::RemoveOption: " << MapKey << " erased" << std::endl;
           }
           else {
@@ -388,57 +404,143 @@ void Engine::ProcessOptionEntryOperationQueue() {
   }
 }
 
-// TODO: sort map by expiry?  // then Option::CalcRate is required less often
+// entries are sharded by underlying, and sorted by expiry so Option::CalcRate can be reused within a batch
+void Engine::BuildShards() {
+
+  m_mapShard.clear();
+
+  for ( mapOptionEntry_t::value_type& vt: m_mapOptionEntry ) {
+    m_mapShard[ vt.second.UnderlyingName() ].emplace_back( &vt.second );
+  }
+
+  for ( mapShard_t::value_type& vt: m_mapShard ) {
+    std::sort(
+      vt.second.begin(), vt.second.end(),
+      []( const ShardEntry& lhs, const ShardEntry& rhs )->bool{
+        if ( lhs.dtExpiryUtc == rhs.dtExpiryUtc ) return lhs.pEntry->GetOption()->GetStrike() < rhs.pEntry->GetOption()->GetStrike();
+        return lhs.dtExpiryUtc < rhs.dtExpiryUtc;
+      } );
+  }
+
+  m_bShardsStale = false;
+}
+
 void Engine::ScanOptionEntryQueue() {
 
   ProcessOptionEntryOperationQueue();
 
+  if ( m_bShardsStale ) BuildShards();
+
+  m_cntScans++;
+  if ( 0 < m_cntBatchesQueued.load( std::memory_order_acquire ) ) {
+    m_cntScansOverlapped++;
+  }
+
   // dtUtcNow needs to be passed by value
   boost::posix_time::ptime dtUtcNow = ou::TimeSource::GlobalInstance().External();
 
-  // TODO:  process only those being watched
-
-  // three step lambda call:
-  //  1) lambda for each active mapOptionEntry
-  //  2) capture private values from the OptionEntry
-  //  3) use the values in a background thread for calculations via post to io_service
-  std::for_each(
-    m_mapOptionEntry.begin(), m_mapOptionEntry.end(),
-    [this, dtUtcNow](mapOptionEntry_t::value_type& vt){
-      //std::cout << "for each " << vt.second.GetUnderlying()->GetInstrument()->GetInstrumentName() << std::endl;
-      //std::cout << "         " << vt.second.GetOption()->GetInstrument()->GetInstrumentName() << std::endl;
-      vt.second.Calc(
-        [this, dtUtcNow](OptionEntry::pOption_t pOption, const ou::tf::Quote& quoteUnderlying, fCallbackWithGreek_t& fCallbackWithGreek ){
-          if ( !quoteUnderlying.IsNonZero() ) {
-            // underlying is unstable
-          }
-          else {
-            double midpointUnderlying( quoteUnderlying.Midpoint() );
-            if ( 0.0 < midpointUnderlying ) {  // only start calculations once underlying has quotes
-              // TODO: add flag to start calculation only after previous calculation is complete
-              boost::asio::post( m_srvc,
-                [this, dtUtcNow, pOption, midpointUnderlying, fCallbackWithGreek](){
-                  try {
-                    //boost::timer::auto_cpu_timer t;
-                    ou::tf::option::binomial::structInput input;
-                    input.S = midpointUnderlying;
-                    pOption->CalcRate( input, dtUtcNow, m_InterestRateFeed );
-                    pOption->CalcGreeks( input, dtUtcNow, true ); // TODO, don't proceed if option quote is bad (test on exit)
-                    if ( nullptr != fCallbackWithGreek ) {
-                      fCallbackWithGreek( pOption->LastGreek() ); // need to create the method
-                    }
-                  }
-                  catch ( std::runtime_error& e ) {
-                    std::cout << "Engine::ScanOptionEntryQueue runtime: " << e.what() << std::endl;
-                  }
-                  catch (...) {
-                    std::cout << "Engine::ScanOptionEntryQueue exception: unknown" << std::endl;
-                  }
-              });
-            }
+  // the scan holds one reference on nBatchesRemaining until all batches have been posted
+  pScan_t pScan = std::make_shared<Scan>();
+
+  for ( mapShard_t::value_type& vt: m_mapShard ) {
+
+    if ( vt.second.empty() ) continue;
+
+    // a shard shares one underlying, so its quote is taken once, as a consistent snapshot
+    ou::tf::Quote quoteUnderlying;
+    const OptionEntry::version_t versionUnderlying = vt.second.front().pEntry->GetUnderlying()->LastQuote( quoteUnderlying );
+    if ( !quoteUnderlying.IsNonZero() ) continue; // underlying is unstable
+    const double midpointUnderlying( quoteUnderlying.Midpoint() );
+    if ( 0.0 >= midpointUnderlying ) continue; // only start calculations once underlying has quotes
+
+    vCalcItem_t vCalcItem;
+    vCalcItem.reserve( std::min( m_nBatchSize, vt.second.size() ) );
+    for ( const ShardEntry& se: vt.second ) {
+      OptionEntry* pEntry( se.pEntry );
+      if ( !pEntry->TryBeginCalc() ) {
+        m_cntCalcsDropped++;
+      }
+      else {
+        // the versions are taken before the calculation reads the quotes,
+        //   so a quote arriving during the calculation is picked up by the next scan
+        const OptionEntry::version_t versionOption( pEntry->GetOption()->QuoteVersion() );
+        if ( !pEntry->QuotesChanged( versionUnderlying, versionOption ) ) {
+          pEntry->EndCalc();
+          m_cntCalcsUnchanged++;
+        }
+        else {
+          vCalcItem.emplace_back( se, midpointUnderlying, versionUnderlying, versionOption );
+          if ( m_nBatchSize == vCalcItem.size() ) {
+            PostBatch( pScan, dtUtcNow, std::move( vCalcItem ) );
+            vCalcItem = vCalcItem_t();
+            vCalcItem.reserve( m_nBatchSize );
           }
-      });
-    });
+        }
+      }
+    }
+    if ( !vCalcItem.empty() ) { // batches do not span underlyings
+      PostBatch( pScan, dtUtcNow, std::move( vCalcItem ) );
+    }
+  }
+
+  CompleteBatch( pScan ); // release the scan's own reference
+}
+
+void Engine::PostBatch( pScan_t pScan, boost::posix_time::ptime dtUtcNow, vCalcItem_t&& vCalcItem ) {
+  pScan->nBatchesRemaining++;
+  m_cntBatchesQueued++;
+  boost::asio::post( m_srvc,
+    [this, pScan, dtUtcNow, vCalcItem_=std::move( vCalcItem )]() mutable {
+      CalcBatch( dtUtcNow, vCalcItem_ );
+      m_cntBatchesQueued--;
+      CompleteBatch( pScan );
+    } );
+}
+
+void Engine::CalcBatch( boost::posix_time::ptime dtUtcNow, const vCalcItem_t& vCalcItem ) {
+
+  ou::tf::option::binomial::structInput input;
+  boost::posix_time::ptime dtExpiryLast( boost::posix_time::not_a_date_time );
+  bool bRateValid( false );
+
+  for ( const CalcItem& item: vCalcItem ) {
+    try {
+      //boost::timer::auto_cpu_timer t;
+      Option& option( *item.pOption );
+      if ( !bRateValid || ( item.dtExpiryUtc != dtExpiryLast ) ) { // items are sorted by utc expiry
+        bRateValid = false;
+        dtExpiryLast = item.dtExpiryUtc;
+        option.CalcRate( input, dtUtcNow, m_InterestRateFeed );
+        bRateValid = true;
+      }
+      input.S = item.midpointUnderlying;
+      option.CalcGreeks( input, dtUtcNow, true ); // TODO, don't proceed if option quote is bad (test on exit)
+      m_cntCalcs++;
+      // only now is the entry current, a failed calculation is retried on the next scan
+      item.pCalcState->versionUnderlying = item.versionUnderlying;
+      item.pCalcState->versionOption = item.versionOption;
+      if ( nullptr != item.fCallbackWithGreek ) {
+        item.fCallbackWithGreek( option.LastGreek() ); // need to create the method
+      }
+    }
+    catch ( std::runtime_error& e ) {
+      std::cout << "Engine::CalcBatch runtime: " << e.what() << std::endl;
+    }
+    catch (...) {
+      std::cout << "Engine::CalcBatch exception: unknown" << std::endl;
+    }
+    item.pCalcState->bInProgress.store( false, std::memory_order_release );
+  }
+}
+
+void Engine::CompleteBatch( pScan_t& pScan ) {
+  if ( 1 == pScan->nBatchesRemaining.fetch_sub( 1, std::memory_order_acq_rel ) ) {
+    int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - pScan->start ).count();
+    m_usLastScan.store( us, std::memory_order_relaxed );
+    int64_t usMax = m_usMaxScan.load( std::memory_order_relaxed );
+    while ( ( usMax < us ) && !m_usMaxScan.compare_exchange_weak( usMax, us, std::memory_order_relaxed ) ) {}
+  }
 }
 
 } // namespace option
@@ -24,7 +24,10 @@
 
 #include <queue>
 #include <mutex>
+#include <atomic>
 #include <chrono>
+#include <vector>
+#include <memory>
 #include <functional>
 #include <unordered_map>
 
@@ -56,6 +59,18 @@ public:
   using pOption_t = Option::pOption_t;
   using fCallbackWithGreek_t = Option::fCallbackWithGreek_t;
   using fCalc_t = std::function<void(pOption_t, const ou::tf::Quote&, fCallbackWithGreek_t&)>; // underlying quote
+  using version_t = ou::tf::Watch::version_t;
+
+  // shared with in-flight calculation batches, outlives the entry if it is removed mid calculation
+  struct CalcState {
+    std::atomic<bool> bInProgress;
+    // quote versions (Watch::QuoteVersion) at the most recent successful calculation,
+    //   accessed only by the holder of bInProgress
+    version_t versionUnderlying;
+    version_t versionOption;
+    CalcState(): bInProgress( false ), versionUnderlying {}, versionOption {} {}
+  };
+  using pCalcState_t = std::shared_ptr<CalcState>;
 
 private:
   size_type m_cntInstances; // when pOption and pUnderlying are added in
@@ -63,15 +78,12 @@ private:
   pOption_t m_pOption;
   pWatch_t m_pUnderlying;
   fCallbackWithGreek_t m_fGreek;
-
-  ou::tf::Quote m_quoteLastUnderlying;
-  //ou::tf::Quote m_quoteLastOption;  // is this actually needed?
-  //double m_dblLastUnderlyingQuote;  // should these be atomic as well?  can doubles be atomic?
-  //double m_dblLastOptionQuote;
+  pCalcState_t m_pCalcState;
 
 public:
 
-  OptionEntry(): m_cntInstances( 0 ) {};
+  OptionEntry()
+  : m_cntInstances( 0 ), m_pCalcState( std::make_shared<CalcState>() ) {};
   //OptionEntry( pOption_t pOption);  // used for storing deletion aspect
   OptionEntry( const OptionEntry& rhs ) = delete;
   OptionEntry( OptionEntry&& rhs );
@@ -88,12 +100,24 @@ public:
 
   void Calc( const fCalc_t& );  // supply underlying and option quotes
 
+  // claim the entry for a calculation, false if the previous calculation is still running
+  bool TryBeginCalc() { return !m_pCalcState->bInProgress.exchange( true, std::memory_order_acq_rel ); }
+  void EndCalc() { m_pCalcState->bInProgress.store( false, std::memory_order_release ); }
+  const pCalcState_t& GetCalcState() const { return m_pCalcState; }
+  const fCallbackWithGreek_t& CallbackWithGreek() const { return m_fGreek; }
+  ou::tf::Quote LastUnderlyingQuote() const { return m_pUnderlying->LastQuote(); }
+
+  // true when the underlying or the option quote has moved since the last successful calculation,
+  //   only while the entry is claimed with TryBeginCalc
+  bool QuotesChanged( version_t versionUnderlying, version_t versionOption ) const {
+    return ( m_pCalcState->versionUnderlying != versionUnderlying ) || ( m_pCalcState->versionOption != versionOption );
+  }
+
   pWatch_t GetUnderlying() { return m_pUnderlying; }
   pOption_t GetOption() { return m_pOption; }
 
 private:
 
-  void HandleUnderlyingQuote( const ou::tf::Quote& );
   void PrintState( const std::string id );
 
 };
@@ -121,11 +145,29 @@ public:
   using fBuildWatch_t = std::function<pWatch_t(pInstrument_t)>;  // constructed elsewhere as it needs provider
   using fBuildOption_t = std::function<pOption_t(pInstrument_t)>;  // constructed elsewhere as it needs provider
 
+  struct Stats {
+    size_t nScans;           // timer driven scans started
+    size_t nScansOverlapped; // scans started while batches from the previous scan were still running
+    size_t nCalcs;           // option calculations completed
+    size_t nCalcsDropped;    // entries skipped as their previous calculation was still running
+    size_t nCalcsUnchanged;  // entries skipped as neither quote moved since their previous calculation
+    size_t nBatchesQueued;   // batches posted but not yet completed
+    std::chrono::microseconds durLastScan; // scan start through completion of its final batch
+    std::chrono::microseconds durMaxScan;
+    Stats()
+    : nScans {}, nScansOverlapped {}, nCalcs {}, nCalcsDropped {}, nCalcsUnchanged {}, nBatchesQueued {}
+    , durLastScan {}, durMaxScan {}
+    {}
+  };
+
   //Engine( const ou::tf::LiborFromIQFeed& );
   //Engine( const ou::tf::FedRateFromIQFeed& );
-  Engine( const ou::tf::NoRiskInterestRateSeries& );
+  // nThreads: size of the calculation pool, nBatchSize: options handed to a worker per post
+  Engine( const ou::tf::NoRiskInterestRateSeries&, size_t nThreads = 1, size_t nBatchSize = 32 );
   virtual ~Engine( );
 
+  Stats GetStats() const;
+
   // these register the underlying, an option, or both [may deprecate the Find functions)
   void RegisterUnderlying( const pWatch_t& ); // register an underlying
   void RegisterOption( const pOption_t& ); // register an option
@@ -152,6 +194,42 @@ private:
   using mapKnownOptions_t = std::unordered_map<idInstrument_t, pOption_t>;
   using mapOptionEntry_t  = std::unordered_map<idInstrument_t, OptionEntry>;
 
+  // entries grouped by underlying, ordered by expiry then strike, rebuilt on add/remove
+  //   expiry is the utc expiry, which distinguishes am and pm settlement on the same date
+  struct ShardEntry {
+    boost::posix_time::ptime dtExpiryUtc;
+    OptionEntry* pEntry;
+    ShardEntry( OptionEntry* pEntry_ )
+    : dtExpiryUtc( pEntry_->GetOption()->GetExpiryUtc() ), pEntry( pEntry_ ) {}
+  };
+  using vOptionEntry_t = std::vector<ShardEntry>;
+  using mapShard_t = std::unordered_map<idInstrument_t, vOptionEntry_t>;
+
+  struct CalcItem {
+    pOption_t pOption;
+    boost::posix_time::ptime dtExpiryUtc;
+    double midpointUnderlying;
+    fCallbackWithGreek_t fCallbackWithGreek;
+    OptionEntry::pCalcState_t pCalcState;
+    OptionEntry::version_t versionUnderlying; // recorded in pCalcState once the calculation succeeds
+    OptionEntry::version_t versionOption;
+    CalcItem( const ShardEntry& se, double midpoint, OptionEntry::version_t versionUnderlying_, OptionEntry::version_t versionOption_ )
+    : pOption( se.pEntry->GetOption() ), dtExpiryUtc( se.dtExpiryUtc ), midpointUnderlying( midpoint )
+    , fCallbackWithGreek( se.pEntry->CallbackWithGreek() ), pCalcState( se.pEntry->GetCalcState() )
+    , versionUnderlying( versionUnderlying_ ), versionOption( versionOption_ )
+    {}
+  };
+
+  using vCalcItem_t = std::vector<CalcItem>;
+
+  struct Scan { // tracks completion of the batches posted by one scan
+    std::chrono::steady_clock::time_point start;
+    std::atomic<size_t> nBatchesRemaining;
+    Scan(): start( std::chrono::steady_clock::now() ), nBatchesRemaining( 1 ) {}
+  };
+
+  using pScan_t = std::shared_ptr<Scan>;
+
   //std::atomic<size_t> m_cntOptionEntryOperationQueueCount;
   std::mutex m_mutexOptionEntryOperationQueue;
 
@@ -164,6 +242,17 @@ private:
   //const FedRateFromIQFeed& m_InterestRateFeed;
   const NoRiskInterestRateSeries& m_InterestRateFeed;
 
+  const size_t m_nBatchSize;
+
+  std::atomic<size_t> m_cntScans;
+  std::atomic<size_t> m_cntScansOverlapped;
+  std::atomic<size_t> m_cntCalcs;
+  std::atomic<size_t> m_cntCalcsDropped;
+  std::atomic<size_t> m_cntCalcsUnchanged;
+  std::atomic<size_t> m_cntBatchesQueued;
+  std::atomic<int64_t> m_usLastScan;
+  std::atomic<int64_t> m_usMaxScan;
+
   struct OptionEntryOperation {
     Action m_action;
     OptionEntry m_oe;
@@ -182,9 +271,16 @@ private:
   mapKnownOptions_t m_mapKnownOptions;
   mapOptionEntry_t m_mapOptionEntry;
 
+  bool m_bShardsStale;
+  mapShard_t m_mapShard;
+
   void HandleTimerScan( const boost::system::error_code &ec );
   void ProcessOptionEntryOperationQueue();
+  void BuildShards();
   void ScanOptionEntryQueue();
+  void PostBatch( pScan_t, boost::posix_time::ptime dtUtcNow, vCalcItem_t&& );
+  void CalcBatch( boost::posix_time::ptime dtUtcNow, const vCalcItem_t& );
+  void CompleteBatch( pScan_t& );
 
 };
 
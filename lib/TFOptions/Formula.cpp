@@ -13,6 +13,8 @@
  ************************************************************************/
 
 #include <math.h>
+#include <cmath>
+#include <algorithm>
 #include <stdexcept>
 #include <iostream>
 
@@ -75,6 +77,56 @@ double BSM_Euro_NonDiv_Put( double S, double K, double r, double vol, double tue
   return -Nd1 * S + exp( -r * tue ) * K * Nd2;
 }
 
+namespace {
+  inline double NormCdf( double x ) { return 0.5 * std::erfc( -x * boost::math::double_constants::one_div_root_two ); }
+  inline double NormPdf( double x ) { return boost::math::double_constants::one_div_root_two_pi * std::exp( -0.5 * x * x ); }
+}
+
+double ImpliedVolatilityEuro( bool bCall, double price, double S, double K, double r, double tue, double q, size_t nSteps ) {
+
+  if ( ( 0.0 >= S ) || ( 0.0 >= K ) || ( 0.0 >= tue ) || ( 0.0 >= price ) ) return 0.0;
+
+  const double Sq = S * std::exp( -q * tue ); // discounted spot, forward in present value terms
+  const double Kr = K * std::exp( -r * tue ); // discounted strike
+
+  // work with the call, use parity for puts
+  const double call = bCall ? price : price + Sq - Kr;
+  const double intrinsic = std::max( 0.0, Sq - Kr );
+  if ( ( call <= intrinsic ) || ( call >= Sq ) ) return 0.0;
+
+  const double rootTUE = std::sqrt( tue );
+
+  // Corrado-Miller, pg 455 Option Pricing Formulas
+  const double half = 0.5 * ( Sq - Kr );
+  const double a = call - half;
+  const double disc = std::max( 0.0, a * a - ( Sq - Kr ) * ( Sq - Kr ) / boost::math::double_constants::pi );
+  double vol = boost::math::double_constants::root_two_pi / ( Sq + Kr ) * ( a + std::sqrt( disc ) ) / rootTUE;
+  if ( !( 0.0 < vol ) ) {
+    vol = std::sqrt( std::abs( std::log( Sq / Kr ) ) * 2.0 / tue ); // pg 454 Option Pricing Formulas
+    if ( !( 0.0 < vol ) ) vol = 0.2;
+  }
+
+  const double lsk = std::log( Sq / Kr );
+  for ( size_t ix = 0; ix < nSteps; ++ix ) {
+    const double volRootTUE = vol * rootTUE;
+    const double d1 = lsk / volRootTUE + 0.5 * volRootTUE;
+    const double d2 = d1 - volRootTUE;
+    const double diff = Sq * NormCdf( d1 ) - Kr * NormCdf( d2 ) - call;
+    const double vega = Sq * rootTUE * NormPdf( d1 );
+    if ( 1e-12 >= vega ) break;
+    const double step = diff / vega;
+    const double volga = vega * d1 * d2 / vol;
+    const double denom = 1.0 - 0.5 * step * volga / vega;
+    const double halley = ( 0.5 < denom ) ? step / denom : step;
+    double volNew = vol - halley;
+    if ( !( 0.0 < volNew ) ) volNew = 0.5 * vol;
+    vol = volNew;
+    if ( 1e-10 > std::abs( halley ) ) break;
+  }
+
+  return vol;
+}
+
 BSM_Euro::BSM_Euro( double r, double vol, double tue )
   : m_vol( vol ), m_r( r ), m_q( 0.0 ), m_tue( tue ),
   m_K( 1.0 ), m_S( 1.0 ),
@@ -43,6 +43,11 @@ inline double CallFromPut( double Put, double Stock, double InterestRate, double
 double BSM_Euro_Call( double S, double K, double r, double vol, double tue );
 double BSM_Euro_Put( double S, double K, double r, double vol, double tue );
 
+// European implied volatility without a lattice:
+//   Corrado-Miller closed form for the starting value, then Halley steps on BSM (vega and volga are analytic)
+// price outside of the no-arbitrage bounds returns 0.0, no exceptions
+double ImpliedVolatilityEuro( bool bCall, double price, double S, double K, double r, double tue, double q = 0.0, size_t nSteps = 3 );
+
 class BSM_Euro {
 public:
   BSM_Euro( double r, double vol, double tue );
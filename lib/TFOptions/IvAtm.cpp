@@ -32,14 +32,17 @@ namespace option { // options
 
 IvAtm::IvAtm( pWatch_t pWatchUnderlying, fConstructOption_t fConstructOption, fStartCalc_t fStartCalc, fStopCalc_t fStopCalc )
 :
-  m_stateOptionWatch( EOptionWatchState::EOWSNoWatch ),
+  m_bSnapshotStale( true ),
+  m_dblStrikeUpper {}, m_dblStrikeMid {}, m_dblStrikeLower {},
+  m_dblUpperTrigger {}, m_dblLowerTrigger {},
   m_pWatchUnderlying( pWatchUnderlying ),
   //m_fConstructOption( std::move( fConstructOption ) ),
   //m_fStartCalc( std::move( fStartCalc ) ),
   //m_fStopCalc( std::move( fStopCalc ) )
   m_fConstructOption( fConstructOption ),
   m_fStartCalc( fStartCalc ),
-  m_fStopCalc( fStopCalc )
+  m_fStopCalc( fStopCalc ),
+  m_stateOptionWatch( EOptionWatchState::EOWSNoWatch )
 { 
   //assert( 0 != m_pWatchUnderlying.use_count() );
   //assert( nullptr != m_pWatchUnderlying.get() );
@@ -51,14 +54,36 @@ IvAtm::IvAtm( pWatch_t pWatchUnderlying, fConstructOption_t fConstructOption, fS
 
 IvAtm::IvAtm( IvAtm&& rhs  )
 :
-  m_stateOptionWatch( rhs.m_stateOptionWatch ),
+  m_chain( std::move( rhs.m_chain ) ),
+  m_bSnapshotStale( true ),
+  m_dblStrikeUpper {}, m_dblStrikeMid {}, m_dblStrikeLower {},
+  m_dblUpperTrigger {}, m_dblLowerTrigger {},
   m_pWatchUnderlying( rhs.m_pWatchUnderlying ),
   m_fConstructOption( std::move( rhs.m_fConstructOption ) ),
   m_fStartCalc( std::move( rhs.m_fStartCalc ) ),
-  m_fStopCalc( std::move( rhs.m_fStopCalc ) ) 
-{}
+  m_fStopCalc( std::move( rhs.m_fStopCalc ) ),
+  m_stateOptionWatch( rhs.m_stateOptionWatch )
+{
+  assert( EOWSNoWatch == m_stateOptionWatch ); // started entries hold callbacks into rhs
+}
+
+IvAtm::~IvAtm() {
+  if ( EOWSWatching == m_stateOptionWatch ) {
+    StopStrike( m_dblStrikeUpper );
+    StopStrike( m_dblStrikeMid );
+    StopStrike( m_dblStrikeLower );
+  }
+}
+
+void IvAtm::SetIQFeedNameCall( double strike, const std::string& sIQFeedSymbolName ) {
+  m_chain.SetIQFeedNameCall( strike, sIQFeedSymbolName );
+  m_bSnapshotStale = true;
+}
 
-IvAtm::~IvAtm() {}
+void IvAtm::SetIQFeedNamePut( double strike, const std::string& sIQFeedSymbolName ) {
+  m_chain.SetIQFeedNamePut( strike, sIQFeedSymbolName );
+  m_bSnapshotStale = true;
+}
 
 // lower_bound: key value eq or gt than query
 // upper_bound: key value gt than query
@@ -73,20 +98,21 @@ IvAtm::tupleAdjacentStrikes_t IvAtm::FindAdjacentStrikes() const {
   
   double dblUnderlying = CurrentUnderlying();
 
-  mapChain_t::const_iterator iter = m_mapChain.lower_bound( dblUnderlying ); 
-  if ( m_mapChain.end() == iter ) {
+  const std::vector<double>& vStrike( m_snapshot.Strike() );
+  std::vector<double>::const_iterator iter = std::lower_bound( vStrike.begin(), vStrike.end(), dblUnderlying );
+  if ( vStrike.end() == iter ) {
     throw exception_at_end_of_chain( "IvAtm::FindAdjacentStrikes: no upper strike available" );
   }
-  dblStrikeUpper = iter->first;
+  dblStrikeUpper = *iter;
   if ( dblUnderlying == dblStrikeUpper ) {
     dblStrikeLower = dblStrikeUpper;
   }
   else {
-    if ( m_mapChain.begin() == iter ) {
+    if ( vStrike.begin() == iter ) {
       throw exception_at_start_of_chain( "IvAtm::FindAdjacentStrikes: already at lower lower end of strikes" );
     }
     --iter;
-    dblStrikeLower = iter->first;
+    dblStrikeLower = *iter;
   }
   
   return strikes;
@@ -99,61 +125,85 @@ void IvAtm::RecalcATMWatch( double dblUnderlying ) { // keeps underlying consist
   // uses a 50% hysterisis level to select new set of three containing options
   //   ie underlying has to be within +/- 50% of mid strike to choose midstrike and corresponding upper/lower strikes
   
-  mapChain_t::iterator iterUpper;
-  mapChain_t::iterator iterLower;
+  using iterStrike_t = std::vector<double>::const_iterator;
+  const std::vector<double>& vStrike( m_snapshot.Strike() ); // strikes in order, a single expiry
+
+  iterStrike_t iterUpper;
+  iterStrike_t iterLower;
   
   auto& sUnderlying( m_pWatchUnderlying->GetInstrument()->GetInstrumentName() );
   
-  iterUpper = m_mapChain.lower_bound( dblUnderlying ); 
+  iterUpper = std::lower_bound( vStrike.begin(), vStrike.end(), dblUnderlying );
   
-  if ( m_mapChain.end() == iterUpper ) {
+  if ( vStrike.end() == iterUpper ) {
     std::cout << sUnderlying << ": IvAtm::RecalcATMWatch - no upper strike available" << std::endl; // stay in no watch state
     m_stateOptionWatch = EOWSNoWatch;
   }
   else {
     iterLower = iterUpper;
-    if ( m_mapChain.begin() == iterLower ) {
+    if ( vStrike.begin() == iterLower ) {
       std::cout << sUnderlying << ": IvAtm::RecalcATMWatch - no lower strike available" << std::endl;  // stay in no watch state
       m_stateOptionWatch = EOWSNoWatch;
     }
     else {
       --iterLower;
-      double dblMidPoint = ( iterUpper->first + iterLower->first ) * 0.5;
+      double dblMidPoint = ( *iterUpper + *iterLower ) * 0.5;
       if ( dblUnderlying >= dblMidPoint ) { // third strike is above
-        m_iterUpper = iterUpper;
-        ++m_iterUpper;
-        if ( m_mapChain.end() == m_iterUpper ) {
+        iterStrike_t iterUpperUpper( iterUpper );
+        ++iterUpperUpper;
+        if ( vStrike.end() == iterUpperUpper ) {
           std::cout << sUnderlying << ": IvAtm::RecalcATMWatch - no upper upper strike available" << std::endl;  // stay in no watch state
           m_stateOptionWatch = EOWSNoWatch;
         }
         else {
-          m_iterMid = iterUpper;
-          m_iterLower = iterLower;
+          m_dblStrikeUpper = *iterUpperUpper;
+          m_dblStrikeMid = *iterUpper;
+          m_dblStrikeLower = *iterLower;
           m_stateOptionWatch = EOWSWatching;
         }
       }
       else { // third strike is below
-        m_iterLower = iterLower;
-        if ( m_mapChain.begin() == m_iterLower ) {
+        if ( vStrike.begin() == iterLower ) {
           std::cout << sUnderlying << ": IvAtm::RecalcATMWatch - no lower lower strike available" << std::endl;  // stay in no watch state
           m_stateOptionWatch = EOWSNoWatch;
         }
         else {
-          --m_iterLower;
-          m_iterMid = iterLower;
-          m_iterUpper = iterUpper;
+          iterStrike_t iterLowerLower( iterLower );
+          --iterLowerLower;
+          m_dblStrikeLower = *iterLowerLower;
+          m_dblStrikeMid = *iterLower;
+          m_dblStrikeUpper = *iterUpper;
           m_stateOptionWatch = EOWSWatching;
         }
       }
       if ( EOWSWatching == m_stateOptionWatch ) {
-        m_dblUpperTrigger = m_iterUpper->first - ( m_iterUpper->first - m_iterMid->first ) * 0.25;
-        m_dblLowerTrigger = m_iterLower->first + ( m_iterMid->first - m_iterLower->first ) * 0.25;
+        m_dblUpperTrigger = m_dblStrikeUpper - ( m_dblStrikeUpper - m_dblStrikeMid ) * 0.25;
+        m_dblLowerTrigger = m_dblStrikeLower + ( m_dblStrikeMid - m_dblStrikeLower ) * 0.25;
         std::cout << m_dblLowerTrigger << " < " << dblUnderlying << " < " << m_dblUpperTrigger << std::endl;
       }
     }
   }
 }
 
+void IvAtm::StartStrike( double strike ) {
+  chain_t::strike_t& entry( m_chain.GetStrike( strike ) );
+  for ( OptionAtStrike* pEntry: { &entry.call, &entry.put } ) {
+    pEntry->fGreek = [this]( const Option& option ){ HandleGreek( option ); };
+    pEntry->Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption, [this](){ m_bSnapshotStale = true; } );
+  }
+}
+
+void IvAtm::StopStrike( double strike ) {
+  chain_t::strike_t& entry( m_chain.GetStrike( strike ) );
+  entry.call.Stop( m_fStopCalc, m_pWatchUnderlying );
+  entry.put.Stop( m_fStopCalc, m_pWatchUnderlying );
+}
+
+void IvAtm::HandleGreek( const Option& option ) {
+  std::lock_guard<std::mutex> lock( m_mutexSnapshot );
+  m_snapshot.UpdateOption( option ); // false until the snapshot has been rebuilt with this option
+}
+
 // 2018/09/12 care is needed with UpdateATMWatch/CalcAtmIv combo, as no values may be available on that transition
 //   more complicated:  make transition when data is available
 void IvAtm::UpdateATMWatch( double dblUnderlying ) {
@@ -169,31 +219,32 @@ void IvAtm::UpdateATMWatch( double dblUnderlying ) {
       case EOWSNoWatch:
         break;
       case EOWSWatching:
-        m_iterUpper->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption );
-        m_iterMid  ->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption );
-        m_iterLower->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption );
+        StartStrike( m_dblStrikeUpper );
+        StartStrike( m_dblStrikeMid );
+        StartStrike( m_dblStrikeLower );
         break;
     }
     break;
   case EOWSWatching:
     if ( ( dblUnderlying > m_dblUpperTrigger ) || ( dblUnderlying < m_dblLowerTrigger ) ) {
-      mapChain_t::iterator iterUpper( m_iterUpper );
-      mapChain_t::iterator iterMid( m_iterMid );
-      mapChain_t::iterator iterLower( m_iterLower );
+      const double dblStrikeUpper( m_dblStrikeUpper );
+      const double dblStrikeMid( m_dblStrikeMid );
+      const double dblStrikeLower( m_dblStrikeLower );
+      // stop first, so strikes common to both sets are restarted cleanly
+      StopStrike( dblStrikeUpper );
+      StopStrike( dblStrikeMid );
+      StopStrike( dblStrikeLower );
       RecalcATMWatch( dblUnderlying );
       stateAfter = m_stateOptionWatch;
       switch ( stateAfter ) {
         case EOWSNoWatch: 
           break;
         case EOWSWatching:
-          m_iterUpper->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption );
-          m_iterMid  ->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption );
-          m_iterLower->second.Start( m_fStartCalc, m_pWatchUnderlying, m_fConstructOption );
+          StartStrike( m_dblStrikeUpper );
+          StartStrike( m_dblStrikeMid );
+          StartStrike( m_dblStrikeLower );
           break;
       }
-      iterUpper->second.Stop( m_fStopCalc, m_pWatchUnderlying );
-      iterMid  ->second.Stop( m_fStopCalc, m_pWatchUnderlying );
-      iterLower->second.Stop( m_fStopCalc, m_pWatchUnderlying );
     }
     break;
   }
@@ -205,50 +256,31 @@ void IvAtm::CalcIvAtm( ptime dtNow, fOnPriceIV_t& fOnPriceIV ) {
   double dblIvPut = 0.0;
   
   double dblUnderlying = CurrentUnderlying();
-  
+
+  std::lock_guard<std::mutex> lock( m_mutexSnapshot );
+
+  if ( m_bSnapshotStale.exchange( false ) ) { // strikes added, or options constructed since the last build
+    m_snapshot.Build( boost::gregorian::date(), m_chain );
+  }
+
   UpdateATMWatch( dblUnderlying );
 
   switch ( m_stateOptionWatch ) {
+    case EOWSNoWatch:
+      break;
     case EOWSWatching:
-      if ( dblUnderlying == m_iterMid->first ) {
-        dblIvCall = m_iterMid->second.pCall->ImpliedVolatility();
-        dblIvPut = m_iterMid->second.pPut->ImpliedVolatility();
-      }
-      else {
-        if ( dblUnderlying > m_iterMid->first ) { // linear interpolation
-          double ratio = ( dblUnderlying - m_iterMid->first ) / ( m_iterUpper->first - m_iterMid->first );
-
-          double iv1, iv2;
-          iv1 = m_iterMid->second.pCall->ImpliedVolatility();
-          iv2 = m_iterUpper->second.pCall->ImpliedVolatility();
-          dblIvCall = iv1 + ( iv2 - iv1 ) * ratio; 
-
-          iv1 = m_iterMid->second.pPut->ImpliedVolatility();
-          iv2 = m_iterUpper->second.pPut->ImpliedVolatility();
-          dblIvPut = iv1 + ( iv2 - iv1 ) * ratio; 
-        }
-        else { // linear interpolation
-          double ratio = ( dblUnderlying - m_iterLower->first ) / ( m_iterMid->first - m_iterLower->first );
+      // the snapshot columns are maintained by HandleGreek, interpolation is between the bracketing strikes
+      if ( m_snapshot.IvAt( 0, dblUnderlying, dblIvCall, dblIvPut ) ) {
+        PriceIV ivATM( dtNow, dblUnderlying, dblIvCall, dblIvPut);
+        m_tsIvAtm.Append( ivATM );
+        //m_bfIVUnderlyingCall.Add( now, dblIvCall, 0 );
+        //m_bfIVUnderlyingPut.Add( now, dblIvPut, 0 );
+        //OnIvAtmCalc( ivATM );
 
-          double iv1, iv2;
-          iv1 = m_iterLower->second.pCall->ImpliedVolatility();
-          iv2 = m_iterMid->second.pCall->ImpliedVolatility();
-          dblIvCall = iv1 + ( iv2 - iv1 ) * ratio; 
+        if ( nullptr != fOnPriceIV ) fOnPriceIV( ivATM );
 
-          iv1 = m_iterLower->second.pPut->ImpliedVolatility();
-          iv2 = m_iterMid->second.pPut->ImpliedVolatility();
-          dblIvPut = iv1 + ( iv2 - iv1 ) * ratio; 
-        }
+        //  std::cout << "AtmIV " << now << "" << m_dtExpiry << " " << dblUnderlying << "," << dblIvCall << "," << dblIvPut << std::endl;
       }
-      PriceIV ivATM( dtNow, dblUnderlying, dblIvCall, dblIvPut);
-      m_tsIvAtm.Append( ivATM );
-      //m_bfIVUnderlyingCall.Add( now, dblIvCall, 0 );
-      //m_bfIVUnderlyingPut.Add( now, dblIvPut, 0 );
-      //OnIvAtmCalc( ivATM );
-      
-      if ( nullptr != fOnPriceIV ) fOnPriceIV( ivATM );
-
-      //  std::cout << "AtmIV " << now << "" << m_dtExpiry << " " << dblUnderlying << "," << dblIvCall << "," << dblIvPut << std::endl;
       break;
   }
 
@@ -261,9 +293,8 @@ void IvAtm::CalcIvAtm( ptime dtNow, fOnPriceIV_t& fOnPriceIV ) {
 //}
 
 void IvAtm::EmitValues( void ) {
-  std::for_each( m_mapChain.begin(), m_mapChain.end(), [](const mapChain_t::value_type& vt){
-    std::cout << vt.first << ": " << vt.second.sCall << ", " << vt.second.sPut << std::endl;
-    //std::cout << vt.first << ": " << vt.second.pCall->EmitValues() << ", " << vt.second.pPut->EmitValues() << std::endl;
+  m_chain.Strikes( []( double strike, const chain_t::strike_t& entry ){
+    std::cout << strike << ": " << entry.call.sIQFeedSymbolName << ", " << entry.put.sIQFeedSymbolName << std::endl;
   });
 }
 
@@ -322,8 +353,9 @@ void IvAtm::SaveIvAtm( const std::string& sPrefix, const std::string& sPrefix864
 
 void IvAtm::SaveSeries( const std::string& sPrefix, const std::string& sPrefix86400sec ) {
   
-  std::for_each( m_mapChain.begin(), m_mapChain.end(), [&sPrefix](mapChain_t::value_type& vt){
-    vt.second.SaveSeries( sPrefix );
+  m_chain.Strikes( [&sPrefix]( double, const chain_t::strike_t& entry ){
+    entry.call.SaveSeries( sPrefix );
+    entry.put.SaveSeries( sPrefix );
   } );
   
   SaveIvAtm( sPrefix, sPrefix86400sec );
@@ -23,10 +23,14 @@
 
 #include <map>
 #include <tuple>
+#include <mutex>
+#include <atomic>
 #include <string>
 #include <functional>
 
+#include <TFOptions/Chain.h>
 #include <TFOptions/Option.h>
+#include <TFOptions/ChainSnapshot.h>
 
 namespace ou { // One Unified
 namespace tf { // TradeFrame
@@ -36,6 +40,7 @@ namespace option { // options
 
 // 2019/06/23 refactored some code to Chain
 //   code here not used elsewhere - may need some work - may need to contain or inherit Chain.h
+// 2026/10/17 strikes held in a Chain, iv read from a ChainSnapshot kept current by OnGreek events
 
 class IvAtm {
 public:
@@ -61,9 +66,13 @@ public:
 
 
   IvAtm( pWatch_t pWatchUnderlying, fConstructOption_t, fStartCalc_t, fStopCalc_t );
-  IvAtm( IvAtm&& rhs );
+  IvAtm( IvAtm&& rhs ); // only before watching has started
   virtual ~IvAtm( );
 
+  // populate the strikes, the options are constructed as they come into the atm watch
+  void SetIQFeedNameCall( double strike, const std::string& sIQFeedSymbolName );
+  void SetIQFeedNamePut(  double strike, const std::string& sIQFeedSymbolName );
+
   using fOnPriceIV_t = std::function<void(const PriceIV&)>;
 
   void CalcIvAtm( ptime dtNow, fOnPriceIV_t& );
@@ -74,62 +83,58 @@ public:
 protected:
 private:
 
-  struct OptionsAtStrike {
-    typedef ou::tf::option::Option::pOption_t pOption_t;
-    std::string sCall;
-    pOption_t pCall;
-    std::string sPut;
-    pOption_t pPut;
+  struct OptionAtStrike: public chain::OptionName { // one side of a strike, pOption is picked up by ChainSnapshot
+    pOption_t pOption;
     bool bStarted;
-    OptionsAtStrike(): bStarted( false ) {}
-    OptionsAtStrike( OptionsAtStrike&& rhs )
-    : sCall( std::move( rhs.sCall ) ),
-      pCall( std::move( rhs.pCall ) ),
-      sPut( std::move( rhs.sPut ) ),
-      pPut( std::move( rhs.pPut ) ),
-      bStarted( rhs.bStarted )
-    { }
-
-    void Start( fStartCalc_t& fStart, pWatch_t pWatchUnderlying, fConstructOption_t& fConstruct ) {
-      assert( !bStarted );
+    std::function<void(const Option&)> fGreek; // forwards greek events to the snapshot
+    OptionAtStrike(): bStarted( false ) {}
 
-      pInstrument_t pInstrumentUnderlying = pWatchUnderlying->GetInstrument();
-
-      if ( nullptr == pCall.get() ) {
-        fConstruct( sCall, pInstrumentUnderlying, [this,pWatchUnderlying,fStart](pOption_t pOption){
-          pCall = pOption;
-          fStart( pCall, pWatchUnderlying );
+    void Start( fStartCalc_t& fStart, pWatch_t pWatchUnderlying, fConstructOption_t& fConstruct, std::function<void()> fConstructed ) {
+      assert( !bStarted );
+      bStarted = true;
+      if ( nullptr == pOption.get() ) {
+        fConstruct( sIQFeedSymbolName, pWatchUnderlying->GetInstrument(), [this,pWatchUnderlying,fStart,fConstructed](pOption_t pOption_){
+          pOption = pOption_;
+          fConstructed();
+          if ( bStarted ) Watch( fStart, pWatchUnderlying );
         } );
       }
-
-      if ( nullptr == pPut.get() ) {
-        fConstruct( sPut, pInstrumentUnderlying, [this,pWatchUnderlying,fStart](pOption_t pOption){
-          pPut = pOption;
-         fStart( pPut, pWatchUnderlying );
-        } );
+      else {
+        Watch( fStart, pWatchUnderlying );
       }
-
-      bStarted = true;
     }
     void Stop( fStopCalc_t& fStop, pWatch_t pUnderlying ) {
       assert( bStarted );
-      fStop( pCall, pUnderlying );
-      fStop( pPut, pUnderlying );
+      if ( nullptr != pOption.get() ) {
+        pOption->OnGreek.Remove( MakeDelegate( this, &OptionAtStrike::HandleGreek ) );
+        fStop( pOption, pUnderlying );
+      }
       bStarted = false;
     }
-    void SaveSeries( const std::string& sPrefix ) {
-      if ( nullptr != pCall.get() ) pCall->SaveSeries( sPrefix );
-      if ( nullptr != pPut.get() ) pPut->SaveSeries( sPrefix );
+    void SaveSeries( const std::string& sPrefix ) const {
+      if ( nullptr != pOption.get() ) pOption->SaveSeries( sPrefix );
+    }
+  private:
+    void Watch( const fStartCalc_t& fStart, pWatch_t pWatchUnderlying ) {
+      pOption->OnGreek.Add( MakeDelegate( this, &OptionAtStrike::HandleGreek ) );
+      fStart( pOption, pWatchUnderlying );
+    }
+    void HandleGreek( const ou::tf::Greek& ) {
+      if ( fGreek ) fGreek( *pOption );
     }
   };
 
-  using mapChain_t = std::map<double, OptionsAtStrike>;
+  using chain_t = Chain<OptionAtStrike>;
+  using snapshot_t = ChainSnapshot<OptionAtStrike>;
 
-  mapChain_t::iterator m_iterUpper;
-  mapChain_t::iterator m_iterMid;
-  mapChain_t::iterator m_iterLower;
+  chain_t m_chain;
+  std::mutex m_mutexSnapshot; // greek events arrive on the feed thread
+  snapshot_t m_snapshot; // single expiry, rebuilt when strikes or constructed options change
+  std::atomic<bool> m_bSnapshotStale;
 
-  mapChain_t m_mapChain;
+  double m_dblStrikeUpper;
+  double m_dblStrikeMid;
+  double m_dblStrikeLower;
 
   double m_dblUpperTrigger;
   double m_dblLowerTrigger;
@@ -155,6 +160,10 @@ private:
   void RecalcATMWatch( double dblUnderlying );
   void UpdateATMWatch( double dblUnderlying );
 
+  void StartStrike( double strike );
+  void StopStrike( double strike );
+  void HandleGreek( const Option& );
+
   void SaveIvAtm( const std::string& sPrefix, const std::string& sPrefix86400sec );
 
 };
@@ -23,6 +23,7 @@
 #include <TFHDF5TimeSeries/HDF5Attribute.h>
 
 #include "Option.h"
+#include "Formula.h"
 #include "Binomial.h"
 
 namespace ou { // One Unified
@@ -32,7 +33,8 @@ namespace option { // options
 Option::Option( pInstrument_t& pInstrument, pProvider_t pDataProvider, pProvider_t pGreekProvider )
 : Watch( pInstrument, pDataProvider ),
   m_pGreekProvider( pGreekProvider ),
-  m_dblStrike( pInstrument->GetStrike() )
+  m_dblStrike( pInstrument->GetStrike() ),
+  m_eIvSolver( EIvSolver::Newton ), m_tdWarmStartAge( 0, 1, 0 )
 {
   //std::cout << "Option::Option construction 1: " << pInstrument->GetInstrumentName() << std::endl;
   Initialize();
@@ -40,7 +42,8 @@ Option::Option( pInstrument_t& pInstrument, pProvider_t pDataProvider, pProvider
 
 Option::Option( pInstrument_t& pInstrument, pProvider_t pDataProvider )
 : Watch( pInstrument, pDataProvider ),
-  m_dblStrike( pInstrument->GetStrike() )
+  m_dblStrike( pInstrument->GetStrike() ),
+  m_eIvSolver( EIvSolver::Newton ), m_tdWarmStartAge( 0, 1, 0 )
 {
   //std::cout << "Option::Option construction 2: " << pInstrument->GetInstrumentName() << std::endl;
   Initialize();
@@ -51,6 +54,7 @@ Option::Option( const Option& rhs )
 , m_dblStrike( rhs.m_dblStrike )
 , m_greek( rhs.m_greek )
 , m_pGreekProvider( rhs.m_pGreekProvider )
+, m_eIvSolver( rhs.m_eIvSolver ), m_tdWarmStartAge( rhs.m_tdWarmStartAge )
 {
   //std::cout << "Option::Option construction 3: " << m_pInstrument->GetInstrumentName() << std::endl;
   Initialize();
@@ -66,6 +70,8 @@ Option& Option::operator=( const Option& rhs ) {
   m_dblStrike = rhs.m_dblStrike;
   m_greek = rhs.m_greek;
   m_pGreekProvider = rhs.m_pGreekProvider;
+  m_eIvSolver = rhs.m_eIvSolver;
+  m_tdWarmStartAge = rhs.m_tdWarmStartAge;
   Initialize();
   return *this;
 }
@@ -147,6 +153,30 @@ void Option::CalcGreeks( // TODO: need to not calc if quote is bad
   input.X = m_dblStrike;
   //input.S = underlying
 
+  if ( EIvSolver::Rational == m_eIvSolver ) {
+    input.optionSide = m_pInstrument->GetOptionSide();
+    const double price( LastQuote().Midpoint() );
+    const double ivLast( m_greek.ImpliedVolatility() );
+    if ( ( 0.0 < ivLast ) && ( m_greek.DateTime() + m_tdWarmStartAge >= dtUtcNow ) ) {
+      input.v = ivLast;  // warm start, already american
+    }
+    else {
+      input.v = ImpliedVolatilityEuro(
+        ou::tf::OptionSide::Call == input.optionSide, price,
+        input.S, input.X, input.r, input.T, input.r - input.b );
+      if ( 0.0 >= input.v ) { // outside of european bounds, use the regular guess
+        input.v = std::sqrt( std::abs( std::log( input.S / input.X ) + input.r * input.T ) * 2.0 / input.T );
+      }
+    }
+    input.Check();
+    ou::tf::option::binomial::structOutput output;
+    if ( ou::tf::option::binomial::CalcImpliedVolatilitySeeded( input, price, output ) ) {
+      ou::tf::Greek greek( dtUtcNow, output.iv, output.delta, output.gamma, output.theta, output.vega, output.rho );
+      AppendGreek( greek );
+    }
+    return;
+  }
+
   // todo: use the haskell book to get an estimator
   // Manaster and Koehler Start Value, Option Pricing Formulas, pg 454
   if ( bNeedsGuess ) {
@@ -195,24 +225,25 @@ bool Option::StopWatch() {
 Option::premium_t Option::Premium( double dblPriceUnderlying ) const {
 
   premium_t premium;
+  const double midpoint( LastQuote().Midpoint() );
 
   switch ( m_pInstrument->GetOptionSide() ) {
     case ou::tf::OptionSide::Call:
       if ( m_dblStrike < dblPriceUnderlying ) { // ITM
         premium.intrinsic = dblPriceUnderlying - m_dblStrike;
-        premium.extrinsic = m_quote.Midpoint() - premium.intrinsic;
+        premium.extrinsic = midpoint - premium.intrinsic;
       }
       else { // OTM
-        premium.extrinsic = m_quote.Midpoint();
+        premium.extrinsic = midpoint;
       }
       break;
     case ou::tf::OptionSide::Put:
       if ( m_dblStrike > dblPriceUnderlying ) { // ITM
         premium.intrinsic = m_dblStrike - dblPriceUnderlying;
-        premium.extrinsic = m_quote.Midpoint() - premium.intrinsic;
+        premium.extrinsic = midpoint - premium.intrinsic;
       }
       else { // OTM
-        premium.extrinsic = m_quote.Midpoint();
+        premium.extrinsic = midpoint;
       }
       break;
     default:
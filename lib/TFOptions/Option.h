@@ -38,6 +38,11 @@ public:
 
   using fCallbackWithGreek_t = std::function<void(const Greek&)>;
 
+  enum class EIvSolver {
+    Newton,   // binomial::CalcImpliedVolatility, finite difference vega on the lattice
+    Rational  // european closed form seed (or last greek), then a few american correction steps
+  };
+
   Option( pInstrument_t& pInstrument, pProvider_t pDataProvider, pProvider_t pGreekProvider );
   Option( pInstrument_t& pInstrument, pProvider_t pDataProvider );  // Greek calculations locally
   Option( const Option& );
@@ -50,6 +55,7 @@ public:
 
   double GetStrike() const { return m_dblStrike; }
   boost::gregorian::date GetExpiry() const { return m_pInstrument->GetExpiry(); }
+  boost::posix_time::ptime GetExpiryUtc() const { return m_pInstrument->GetExpiryUtc(); } // includes the settlement time
   ou::tf::OptionSide::EOptionSide GetOptionSide() const { return m_pInstrument->GetOptionSide(); }
 
   static void CalcRate( // basic libor calcs
@@ -61,6 +67,11 @@ public:
   // caller needs to have updated input with CalcRate
   void CalcGreeks( ou::tf::option::binomial::structInput& input, ptime dtUtcNow, bool bNeedsGuess = true ); // Calc and Append
 
+  void SetIvSolver( EIvSolver eIvSolver ) { m_eIvSolver = eIvSolver; }
+  EIvSolver GetIvSolver() const { return m_eIvSolver; }
+  // EIvSolver::Rational: last greek is used as the seed when no older than this
+  void SetWarmStartAge( time_duration td ) { m_tdWarmStartAge = td; }
+
   struct premium_t {
     double intrinsic;
     double extrinsic;
@@ -107,6 +118,9 @@ protected:
 
 private:
 
+  EIvSolver m_eIvSolver;
+  time_duration m_tdWarmStartAge;
+
   void Initialize();
 
   void HandleGreek( const Greek& greek );
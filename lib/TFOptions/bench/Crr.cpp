@@ -0,0 +1,154 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// binomial::CRR against the original scalar lattice, for accuracy and time per evaluation
+//   exit status is non-zero when any output differs by more than the tolerance
+
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+#include <TFOptions/Binomial.h>
+
+namespace binomial = ou::tf::option::binomial;
+
+namespace {
+
+// the lattice as it was before the templated kernel, kept as the reference
+void CRR_Reference( const binomial::structInput& input, binomial::structOutput& output ) {
+
+  std::vector<double> v; v.resize( input.n + 1 );
+
+  const double z = ( ou::tf::OptionSide::Call == input.optionSide ) ? 1.0 : -1.0;
+  const double dt = input.T / input.n;
+  const double u = std::exp( input.v * std::sqrt( dt ) );
+  const double d = 1.0 / u;
+  const double p = ( std::exp( input.b * dt ) - d ) / ( u - d );
+  const double df = std::exp( -input.r * dt );
+
+  for ( int ix = 0; ix <= input.n; ++ix ) {
+    v[ ix ] = std::max<double>( 0.0, z * ( input.S * std::pow( u, ix ) * std::pow( d, input.n - ix ) - input.X ) );
+  }
+  for ( int j = input.n - 1; j >= 0; --j ) {
+    for ( int i = 0; i <= j; ++i ) {
+      const double europrice = df * ( p * v[ i + 1 ] + ( 1.0 - p ) * v[ i ] );
+      if ( ou::tf::OptionStyle::American == input.optionStyle ) {
+        const double exerciseprice = z * ( input.S * std::pow( u, i ) * std::pow( d, j - i ) - input.X );
+        v[ i ] = std::max<double>( exerciseprice, europrice );
+      }
+      else {
+        v[ i ] = europrice;
+      }
+      if ( 2 == j ) {
+        output.gamma = ( ( v[ 2 ] - v[ 1 ] ) / ( input.S * u * u - input.S )
+          - ( v[ 1 ] - v[ 0 ] ) / ( input.S - input.S * d * d ) )
+          / ( 0.5 * ( input.S * u * u - input.S * d * d ) );
+        output.theta = v[ 1 ];
+      }
+      if ( 1 == j ) {
+        output.delta = ( v[ 1 ] - v[ 0 ] ) / ( input.S * ( u - d ) );
+      }
+    }
+  }
+  output.theta = ( output.theta - v[ 0 ] ) / ( 2.0 * dt ) / 365.0;
+  output.option = v[ 0 ];
+}
+
+double Diff( const binomial::structOutput& lhs, const binomial::structOutput& rhs ) {
+  return std::max( {
+    std::abs( lhs.option - rhs.option ),
+    std::abs( lhs.delta - rhs.delta ),
+    std::abs( lhs.gamma - rhs.gamma ),
+    std::abs( lhs.theta - rhs.theta )
+  } );
+}
+
+} // namespace anonymous
+
+int main( int, char*[] ) {
+
+  static const double tolerance = 1e-9;
+  static const size_t nRepeat = 200;
+
+  double diffMax {};
+  size_t nCases {};
+  bool bOk( true );
+
+  for ( const long n: { 31L, 91L, 201L, 501L } ) {
+
+    std::chrono::nanoseconds nsReference {};
+    std::chrono::nanoseconds nsCRR {};
+    size_t nEvaluations {};
+    double sum {}; // keeps the timed loops from being optimized away
+
+    for ( const auto side: { ou::tf::OptionSide::Call, ou::tf::OptionSide::Put } ) {
+      for ( const auto style: { ou::tf::OptionStyle::American, ou::tf::OptionStyle::European } ) {
+        for ( double strike = 80.0; strike <= 120.0; strike += 10.0 ) {
+
+          binomial::structInput input;
+          input.optionSide = side;
+          input.optionStyle = style;
+          input.n = n;
+          input.S = 100.0;
+          input.X = strike;
+          input.T = 45.0 / 365.0;
+          input.r = input.b = 0.04;
+          input.v = 0.3;
+
+          binomial::structOutput outputReference;
+          binomial::structOutput output;
+
+          auto start = std::chrono::steady_clock::now();
+          for ( size_t ix = 0; ix < nRepeat; ++ix ) {
+            CRR_Reference( input, outputReference );
+            sum += outputReference.option;
+          }
+          nsReference += std::chrono::steady_clock::now() - start;
+
+          start = std::chrono::steady_clock::now();
+          for ( size_t ix = 0; ix < nRepeat; ++ix ) {
+            binomial::CRR( input, output );
+            sum += output.option;
+          }
+          nsCRR += std::chrono::steady_clock::now() - start;
+
+          nEvaluations += nRepeat;
+          ++nCases;
+
+          const double diff = Diff( outputReference, output );
+          diffMax = std::max( diffMax, diff );
+          if ( tolerance < diff ) {
+            bOk = false;
+            std::cout
+              << "mismatch: n=" << n << ",side=" << side << ",style=" << style
+              << ",strike=" << strike << ",diff=" << diff << std::endl;
+          }
+        }
+      }
+    }
+
+    std::cout
+      << "n=" << n
+      << ": reference " << nsReference.count() / nEvaluations << " ns"
+      << ", CRR " << nsCRR.count() / nEvaluations << " ns"
+      << " (" << sum << ")"
+      << std::endl;
+  }
+
+  std::cout << "cases=" << nCases << ",max diff=" << diffMax << std::endl;
+
+  return bOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,130 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// regression of binomial::CalcImpliedVolatilitySeeded against binomial::CalcImpliedVolatility
+//   prices are generated by CRR over a grid of side/expiry/strike/vol, then both solvers recover the vol
+//   exit status is non-zero when the seeded solver disagrees, or fails where the newton solver succeeds
+
+#include <cmath>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+#include <TFOptions/Binomial.h>
+#include <TFOptions/Formula.h>
+
+namespace binomial = ou::tf::option::binomial;
+
+int main( int, char*[] ) {
+
+  static const double tolerance = 1e-4;   // implied vol difference allowed
+  static const double vegaMin = 0.01;     // price change per vol point below which the vol is not observable
+
+  size_t nCases {};
+  size_t nNewtonFail {};
+  size_t nSeededFail {};
+  size_t nMismatch {};
+  size_t nRhoBad {};
+  double diffMax {};
+
+  std::chrono::nanoseconds nsNewton {};
+  std::chrono::nanoseconds nsSeeded {};
+
+  for ( const double r: { 0.0, 0.02, 0.05 } ) {
+    for ( const auto side: { ou::tf::OptionSide::Call, ou::tf::OptionSide::Put } ) {
+      for ( const double days: { 7.0, 30.0, 90.0, 365.0 } ) {
+        for ( double strike = 70.0; strike <= 130.0; strike += 5.0 ) {
+          for ( double vol = 0.1; vol <= 0.81; vol += 0.1 ) {
+
+            binomial::structInput input;
+            input.optionSide = side;
+            input.S = 100.0;
+            input.X = strike;
+            input.T = days / 365.0;
+            input.r = input.b = r;
+            input.v = vol;
+
+            binomial::structOutput output;
+            input.v = vol - 0.01;
+            binomial::CRR( input, output );
+            const double priceLower( output.option );
+            input.v = vol;
+            binomial::CRR( input, output );
+            const double price( output.option );
+            if ( vegaMin > ( price - priceLower ) ) continue;  // at intrinsic, or far out of the money, any nearby vol fits
+            ++nCases;
+
+            input.v = std::sqrt( std::abs( std::log( input.S / input.X ) + input.r * input.T ) * 2.0 / input.T );
+            binomial::structOutput outputNewton;
+            bool bNewton( true );
+            auto start = std::chrono::steady_clock::now();
+            try {
+              binomial::CalcImpliedVolatility( input, price, outputNewton );
+            }
+            catch ( const std::runtime_error& ) {
+              bNewton = false;
+              ++nNewtonFail;
+            }
+            nsNewton += std::chrono::steady_clock::now() - start;
+
+            start = std::chrono::steady_clock::now();
+            input.v = ou::tf::option::ImpliedVolatilityEuro(
+              ou::tf::OptionSide::Call == side, price, input.S, input.X, input.r, input.T );
+            binomial::structOutput outputSeeded;
+            const bool bSeeded = binomial::CalcImpliedVolatilitySeeded( input, price, outputSeeded );
+            nsSeeded += std::chrono::steady_clock::now() - start;
+
+            if ( !bSeeded ) {
+              ++nSeededFail;
+              std::cout
+                << "fail: side=" << side << ",r=" << r << ",days=" << days
+                << ",strike=" << strike << ",vol=" << vol << std::endl;
+              continue;
+            }
+            if ( !std::isfinite( outputSeeded.rho ) ) ++nRhoBad;
+
+            const double diff = std::abs( outputSeeded.iv - vol );
+            diffMax = std::max( diffMax, diff );
+            if ( tolerance < diff ) {
+              ++nMismatch;
+              std::cout
+                << "mismatch: side=" << side << ",r=" << r << ",days=" << days
+                << ",strike=" << strike << ",vol=" << vol
+                << ",seeded=" << outputSeeded.iv
+                << ",newton=" << ( bNewton ? outputNewton.iv : 0.0 )
+                << std::endl;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  std::cout
+    << "cases=" << nCases
+    << ",newton fail=" << nNewtonFail
+    << ",seeded fail=" << nSeededFail
+    << ",mismatch=" << nMismatch
+    << ",rho not finite=" << nRhoBad
+    << ",max diff=" << diffMax
+    << std::endl;
+  if ( 0 < nCases ) {
+    std::cout
+      << "newton " << nsNewton.count() / nCases << " ns/solve"
+      << ", seeded " << nsSeeded.count() / nCases << " ns/solve"
+      << std::endl;
+  }
+
+  return ( 0 == nSeededFail && 0 == nMismatch && 0 == nRhoBad ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -19,6 +19,8 @@
  * Created: 2022/08/02 21:34:35
  */
 
+#include <OUCommon/JsonScanner.h>
+
 #include "GatewayTrades.hpp"
 
 namespace ou {
@@ -27,6 +29,30 @@ namespace phemex {
 namespace gateway {
 namespace trades {
 
+bool Decode( ou::JsonScanner& scan, trade& trade ) {
+
+  std::string_view side;
+
+  bool bOk
+    =  scan.Array()
+    && scan.Element() && scan.Number( trade.time_stamp )
+    && scan.Element() && scan.String( side )
+    && scan.Element() && scan.Number( trade.price )
+    && scan.Element() && scan.Number( trade.quantity )
+    ;
+
+  if ( bOk ) {
+    while ( scan.Element() ) scan.Skip(); // any later additions
+    bOk = !scan.Failed();
+  }
+
+  if ( "Buy" == side ) trade.side = ESide::Buy;
+  else if ( "Sell" == side ) trade.side = ESide::Sell;
+  else trade.side = ESide::Unknown;
+
+  return bOk;
+}
+
 } // namespace trades
 } // namespace gateway
 } // namespace phemex
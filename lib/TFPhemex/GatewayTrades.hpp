@@ -25,16 +25,10 @@
 #include <string>
 #include <cstdint>
 
-namespace boost {
-namespace json {
-  class array;
-  class value;
-}
-}
+namespace ou {
 
-//namespace json = boost::json;
+class JsonScanner;
 
-namespace ou {
 namespace tf {
 namespace phemex {
 namespace gateway {
@@ -42,15 +36,20 @@ namespace trades {
 
 // == Trades ==
 
+enum class ESide: char { Unknown, Buy, Sell };
+
 struct trade {
   std::uint64_t time_stamp;
-  std::string side;
+  ESide side;
   std::uint64_t price;
   std::uint64_t quantity;
 };
 
 using v_trade_t = std::vector<trade>;
 
+// one element of the trades array: [ time_stamp, side, priceEp, quantity ]
+bool Decode( ou::JsonScanner&, trade& );
+
 } // namespace trades
 } // namespace gateway
 } // namespace phemex
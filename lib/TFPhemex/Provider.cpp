@@ -31,6 +31,8 @@
 #include <boost/log/trivial.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <OUCommon/JsonScanner.h>
+
 #include <TFTrading/OrderManager.h>
 
 #include "one_shot.hpp"
@@ -274,30 +276,66 @@ void Provider::DataGateWayUp() {
       ProviderInterfaceBase::OnDisconnected( 0 );
     },
     [this]( std::string&& sMessage){ // fMessage_t
-      json::error_code jec;
-      json::value jv = json::parse( sMessage, jec );
-      if ( jec.failed() ) {
+
+      // one pass over the frame, nothing is allocated once m_vTrade has grown,
+      //   members may arrive in any order, so trades are held until the type is known
+      ou::JsonScanner scan( sMessage );
+      std::string_view key;
+
+      bool bError( false );
+      bool bErrorNull( true );
+      bool bTrades( false );
+      uint64_t id {};
+      uint64_t sequence {};
+      std::string_view svSymbol;
+      std::string_view svType;
+
+      m_vTrade.clear();
+
+      if ( scan.Object() ) {
+        while ( scan.Key( key ) ) {
+          if ( "error" == key ) {
+            bError = true;
+            bErrorNull = scan.Null();
+            if ( !bErrorNull ) scan.Skip();
+          }
+          else if ( "id" == key ) {
+            if ( !scan.Null() ) scan.Number( id );
+          }
+          else if ( "trades" == key ) {
+            bTrades = true;
+            if ( scan.Array() ) {
+              while ( scan.Element() ) {
+                m_vTrade.emplace_back();
+                gateway::trades::Decode( scan, m_vTrade.back() );
+              }
+            }
+          }
+          else if ( "sequence" == key ) scan.Number( sequence );
+          else if ( "symbol" == key ) scan.String( svSymbol );
+          else if ( "type" == key ) scan.String( svType );
+          else scan.Skip();
+        }
+      }
+
+      if ( scan.Failed() ) {
         BOOST_LOG_TRIVIAL(error) << "provider/phemex failed to parse web_socket stream: " << sMessage;
       }
-      else { // TODO: use spirit here at some point
+      else {
         bool bMessageProcessed( false );
-        json::object const& obj = jv.as_object();
-        if ( auto p = obj.if_contains( "error" ) ) {
-          int id = json::value_to<int>( obj.at( "id" ) );
+        if ( bError ) {
           switch ( id ) {
-            case (int)session::web_socket::EMessageId::HeartBeat:
+            case (uint64_t)session::web_socket::EMessageId::HeartBeat:
               // todo: signal back into web_socket for timeout reset
               break;
-            case (int)session::web_socket::EMessageId::StartTradeWatch:
-              if ( !obj.at( "error" ).is_null() ) {
-                json::object error = json::value_to<json::object>( obj.at( "error" ) );
+            case (uint64_t)session::web_socket::EMessageId::StartTradeWatch:
+              if ( !bErrorNull ) {
                 BOOST_LOG_TRIVIAL(error)
                   << "provider/phemex gw start watch: " << sMessage;
               }
               break;
-            case (int)session::web_socket::EMessageId::StopTradeWatch:
-              if ( !obj.at( "error" ).is_null() ) {
-                json::object error = json::value_to<json::object>( obj.at( "error" ) );
+            case (uint64_t)session::web_socket::EMessageId::StopTradeWatch:
+              if ( !bErrorNull ) {
                 BOOST_LOG_TRIVIAL(error)
                   << "provider/phemex gw stop watch: " << sMessage;
               }
@@ -309,40 +347,17 @@ void Provider::DataGateWayUp() {
           bMessageProcessed = true;
         }
         else {
-          if ( auto p = obj.if_contains( "trades" ) ) {
-            uint64_t sequence = json::value_to<uint64_t>( obj.at( "sequence" ) );
-            std::string sSymbol = json::value_to<std::string>( obj.at( "symbol" ) );
-            json::array trades = json::value_to<json::array>( obj.at( "trades" ) );
-            std::string sType = json::value_to<std::string>( obj.at( "type" ) );
-
+          if ( bTrades ) {
+            const std::string sSymbol( svSymbol ); // short, held in place
             mapSymbols_t::iterator iterSymbol = m_mapSymbols.find( sSymbol );
             if ( m_mapSymbols.end() == iterSymbol ) {
               BOOST_LOG_TRIVIAL(error) << "provider/phemex DataGateway can not find symbol " << sSymbol;
             }
             else {
-              if ( "snapshot" == sType ) {}
-              if ( "incremental" == sType ) {
-                gateway::trades::v_trade_t v_trade;
-                try {
-                  for ( const auto& item: trades ) {
-
-                    json::array trade_items = json::value_to<json::array>( item );
-                    json::array::const_iterator citer = trade_items.begin();
-
-                    v_trade.push_back( gateway::trades::trade() );
-                    auto& back( v_trade.back() );
-                    back.time_stamp = json::value_to<uint64_t>( *citer ); citer++;
-                    back.side = json::value_to<std::string>( *citer ); citer++;
-                    back.price = json::value_to<uint64_t>( *citer ); citer++;
-                    back.quantity = json::value_to<uint64_t>( *citer );
-                  }
-                }
-                catch (...) {
-                  BOOST_LOG_TRIVIAL(error) << "provider/phemex DataGateWay error";
-                }
-
+              if ( "snapshot" == svType ) {}
+              if ( "incremental" == svType ) {
                 uint64_t value1 {}, value2 {};
-                for ( gateway::trades::v_trade_t::const_reverse_iterator iter = v_trade.rbegin(); v_trade.rend() != iter; iter++ ) {
+                for ( gateway::trades::v_trade_t::const_reverse_iterator iter = m_vTrade.rbegin(); m_vTrade.rend() != iter; iter++ ) {
                   value2 = iter->time_stamp;
                   if ( value2 < value1 ) {
                     BOOST_LOG_TRIVIAL(error)
@@ -107,6 +107,8 @@ private:
 
   enum EState { start, connect, authorized, listening, error } m_state;
 
+  gateway::trades::v_trade_t m_vTrade; // decode buffer, reused frame to frame
+
   ssl::context m_ssl_context;
 
   std::string m_sDomainAPI;
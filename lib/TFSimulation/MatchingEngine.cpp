@@ -0,0 +1,617 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    MatchingEngine.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFSimulation
+ * Created: October 17, 2026 18:20
+ */
+
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+
+#include "MatchingEngine.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace sim { // simulation
+
+namespace {
+  const size_t nInitialNodes = 256;
+  const size_t nInitialLevels = 1024;
+  const size_t nMarginLevels = 256;
+  const size_t nMaxRecordedLevels = 1 << 16; // recorded depth beyond this span is not tracked
+}
+
+MatchingEngine::MatchingEngine()
+: m_dblTicksPerUnit( 100.0 )
+, m_tDelay {}
+, m_bQueuePosition( false )
+, m_ixFree( npos )
+, m_nShift {}
+, m_tCursor {}
+, m_nWheel {}
+, m_nResting {}
+, m_mapOrderState( 1024 )
+, m_mapRecorded( 4096 )
+, m_nSequence {}
+, m_tickQuoteBid {}, m_tickQuoteAsk {}
+, m_nQuoteBidSize {}, m_nQuoteAskSize {}
+{
+  m_vNode.reserve( nInitialNodes );
+  m_vSlot.resize( nSlots );
+  SetOrderDelay( boost::posix_time::milliseconds( 250 ) );
+}
+
+MatchingEngine::~MatchingEngine() {
+}
+
+void MatchingEngine::SetTickSize( double dblTickSize ) {
+  assert( 0 == m_nResting );
+  if ( 0.0 < dblTickSize ) m_dblTicksPerUnit = 1.0 / dblTickSize;
+}
+
+void MatchingEngine::SetOrderDelay( const boost::posix_time::time_duration& td ) {
+  m_tDelay = td.total_microseconds();
+  if ( 0 == m_nWheel ) { // slot width set so the wheel spans twice the delay
+    const usec_t width( ( 2 * m_tDelay ) / (usec_t)nSlots );
+    m_nShift = 0;
+    while ( ( usec_t( 1 ) << m_nShift ) < width ) m_nShift++;
+  }
+}
+
+void MatchingEngine::Reset() {
+
+  m_vNode.clear();
+  m_ixFree = npos;
+
+  for ( List& list: m_vSlot ) list = List();
+  m_tCursor = 0;
+  m_nWheel = 0;
+
+  m_listMarket = List();
+  m_listStop = List();
+  for ( Book& book: m_rBook ) {
+    book.vLevel.clear();
+    book.tickBase = book.tickBest = 0;
+    book.nOrders = 0;
+  }
+  m_nResting = 0;
+
+  m_mapOrderState.Clear();
+  m_mapRecorded.Clear();
+  m_nSequence = 0;
+
+  m_tickQuoteBid = m_tickQuoteAsk = 0;
+  m_nQuoteBidSize = m_nQuoteAskSize = 0;
+}
+
+MatchingEngine::ix_t MatchingEngine::Allocate() {
+  ix_t ix;
+  if ( npos == m_ixFree ) {
+    ix = m_vNode.size();
+    m_vNode.emplace_back();
+  }
+  else {
+    ix = m_ixFree;
+    m_ixFree = m_vNode[ ix ].ixNext;
+    m_vNode[ ix ] = Node();
+  }
+  return ix;
+}
+
+void MatchingEngine::Release( ix_t ix ) {
+  Node& node( At( ix ) );
+  node.pOrder.reset();
+  node.ixPrev = npos;
+  node.ixNext = m_ixFree;
+  m_ixFree = ix;
+}
+
+void MatchingEngine::PushBack( List& list, ix_t ix ) {
+  Node& node( At( ix ) );
+  node.ixNext = npos;
+  node.ixPrev = list.ixTail;
+  if ( npos == list.ixTail ) list.ixHead = ix;
+  else At( list.ixTail ).ixNext = ix;
+  list.ixTail = ix;
+}
+
+void MatchingEngine::Unlink( List& list, ix_t ix ) {
+  Node& node( At( ix ) );
+  if ( npos == node.ixPrev ) list.ixHead = node.ixNext;
+  else At( node.ixPrev ).ixNext = node.ixNext;
+  if ( npos == node.ixNext ) list.ixTail = node.ixPrev;
+  else At( node.ixNext ).ixPrev = node.ixPrev;
+  node.ixPrev = node.ixNext = npos;
+}
+
+MatchingEngine::tick_t MatchingEngine::Tick( double price ) const {
+  return std::llround( price * m_dblTicksPerUnit );
+}
+
+MatchingEngine::usec_t MatchingEngine::Time( const boost::posix_time::ptime& dt ) {
+  static const boost::posix_time::ptime epoch( boost::gregorian::date( 1970, 1, 1 ) );
+  return ( dt - epoch ).total_microseconds();
+}
+
+// ==== delay
+
+void MatchingEngine::Submit( pOrder_t pOrder, const boost::posix_time::ptime& dtSubmitted ) {
+  const ix_t ix( Allocate() );
+  Node& node( At( ix ) );
+  node.idOrder = pOrder->GetOrderId();
+  node.pOrder = std::move( pOrder );
+  node.kind = EKind::Submit;
+  node.tDue = Time( dtSubmitted ) + m_tDelay;
+  m_mapOrderState.Emplace( node.idOrder, OrderState() ); // a change keeps the existing state
+  Schedule( ix );
+}
+
+void MatchingEngine::Cancel( idOrder_t idOrder, const boost::posix_time::ptime& dtRequested ) {
+  const ix_t ix( Allocate() );
+  Node& node( At( ix ) );
+  node.idOrder = idOrder;
+  node.kind = EKind::Cancel;
+  node.tDue = Time( dtRequested ) + m_tDelay;
+  Schedule( ix );
+}
+
+void MatchingEngine::Schedule( ix_t ix ) {
+  const usec_t tDue( At( ix ).tDue );
+  if ( 0 == m_nWheel ) m_tCursor = ( tDue - m_tDelay ) >> m_nShift; // the wheel is only advanced while occupied
+  const usec_t slot( std::max( tDue >> m_nShift, m_tCursor ) );
+  PushBack( m_vSlot[ slot & ( nSlots - 1 ) ], ix );
+  m_nWheel++;
+}
+
+void MatchingEngine::Advance( usec_t tNow ) {
+  // as the original queue: an entry fires once its due time is strictly before the market time
+  const usec_t slotNow( tNow >> m_nShift );
+  const usec_t nSpan( std::min<usec_t>( slotNow - m_tCursor, nSlots - 1 ) );
+  for ( usec_t slot = m_tCursor; ( slot <= ( m_tCursor + nSpan ) ) && ( 0 < m_nWheel ); slot++ ) {
+    List& list( m_vSlot[ slot & ( nSlots - 1 ) ] );
+    ix_t ix( list.ixHead );
+    while ( npos != ix ) {
+      const ix_t ixNext( At( ix ).ixNext );
+      if ( At( ix ).tDue < tNow ) {
+        Unlink( list, ix );
+        m_nWheel--;
+        Fire( ix );
+      }
+      ix = ixNext;
+    }
+  }
+  if ( slotNow > m_tCursor ) m_tCursor = slotNow;
+}
+
+void MatchingEngine::Fire( ix_t ix ) {
+
+  const idOrder_t idOrder( At( ix ).idOrder );
+  OrderState* pState( m_mapOrderState.Find( idOrder ) );
+
+  if ( EKind::Cancel == At( ix ).kind ) {
+    Release( ix );
+    if ( ( nullptr != pState ) && ( OrderState::EState::Active == pState->state ) ) {
+      Remove( pState->ixNode );
+      Release( pState->ixNode );
+      pState->state = OrderState::EState::Archive;
+      pState->ixNode = npos;
+      if ( nullptr != OnCancelled ) OnCancelled( idOrder );
+    }
+    else {
+      if ( nullptr != OnNoOrderFound ) OnNoOrderFound( idOrder );
+    }
+    return;
+  }
+
+  assert( nullptr != pState );
+  switch ( pState->state ) {
+    case OrderState::EState::Archive: // filled or cancelled while the change was in the delay
+      Release( ix );
+      return;
+    case OrderState::EState::Active: // a change replaces the resting version, and loses its priority
+      Remove( pState->ixNode );
+      Release( pState->ixNode );
+      break;
+    case OrderState::EState::Delay:
+      break;
+  }
+
+  if ( Activate( ix ) ) {
+    pState->state = OrderState::EState::Active;
+    pState->ixNode = ix;
+  }
+  else {
+    Release( ix );
+    pState->state = OrderState::EState::Archive;
+    pState->ixNode = npos;
+    if ( nullptr != OnCancelled ) OnCancelled( idOrder );
+  }
+}
+
+bool MatchingEngine::Activate( ix_t ix ) {
+
+  Node& node( At( ix ) );
+  const Order& order( *node.pOrder );
+
+  node.nRemaining = order.GetQuanRemaining();
+  if ( 0 == node.nRemaining ) return false;
+
+  node.side = ( OrderSide::Buy == order.GetOrderSide() ) ? Bid : Ask;
+
+  switch ( order.GetOrderType() ) {
+    case OrderType::Market:
+      node.kind = EKind::Market;
+      PushBack( m_listMarket, ix );
+      break;
+    case OrderType::Limit:
+      assert( 0 < order.GetPrice1() );
+      node.kind = EKind::Limit;
+      node.tick = Tick( order.GetPrice1() );
+      Insert( ix );
+      break;
+    case OrderType::Stop:
+      assert( 0 < order.GetPrice1() );
+      node.kind = EKind::Stop;
+      node.tick = Tick( order.GetPrice1() );
+      PushBack( m_listStop, ix );
+      break;
+    default:
+      return false;
+  }
+
+  m_nResting++;
+  return true;
+}
+
+void MatchingEngine::Remove( ix_t ix ) {
+  switch ( At( ix ).kind ) {
+    case EKind::Market:
+    case EKind::Triggered:
+      Unlink( m_listMarket, ix );
+      break;
+    case EKind::Stop:
+      Unlink( m_listStop, ix );
+      break;
+    case EKind::Limit:
+      Withdraw( ix );
+      break;
+    default:
+      assert( false );
+      break;
+  }
+  m_nResting--;
+}
+
+// ==== price levels
+
+bool MatchingEngine::Reserve( Book& book, tick_t tick, bool bForce ) {
+  if ( book.Contains( tick ) ) return true;
+  if ( book.vLevel.empty() ) {
+    book.tickBase = tick - nInitialLevels / 2;
+    book.vLevel.resize( nInitialLevels );
+    return true;
+  }
+  const tick_t tickLo( std::min<tick_t>( book.tickBase, tick - nMarginLevels ) );
+  const tick_t tickHi( std::max<tick_t>( book.tickBase + (tick_t)book.vLevel.size(), tick + nMarginLevels ) );
+  if ( !bForce && ( ( tickHi - tickLo ) > (tick_t)nMaxRecordedLevels ) ) return false;
+  if ( tickLo < book.tickBase ) {
+    book.vLevel.insert( book.vLevel.begin(), book.tickBase - tickLo, Level() );
+    book.tickBase = tickLo;
+  }
+  if ( tickHi > ( book.tickBase + (tick_t)book.vLevel.size() ) ) {
+    book.vLevel.resize( tickHi - book.tickBase );
+  }
+  return true;
+}
+
+void MatchingEngine::Insert( ix_t ix ) {
+
+  Node& node( At( ix ) );
+  Book& book( m_rBook[ node.side ] );
+  Reserve( book, node.tick, true );
+  Level& level( book.At( node.tick ) );
+  PushBack( level.list, ix );
+
+  node.nSequence = ++m_nSequence;
+  node.nTradedAhead = 0;
+  if ( !m_bQueuePosition ) {
+    node.nQueueAhead = 0;
+  }
+  else {
+    if ( 0 < m_mapRecorded.Size() ) {
+      node.nQueueAhead = level.nRecorded;
+    }
+    else { // no depth recorded, use the displayed size when joining the inside
+      if ( Bid == node.side ) node.nQueueAhead = ( node.tick == m_tickQuoteBid ) ? m_nQuoteBidSize : 0;
+      else                    node.nQueueAhead = ( node.tick == m_tickQuoteAsk ) ? m_nQuoteAskSize : 0;
+    }
+  }
+
+  if ( 0 == book.nOrders ) book.tickBest = node.tick;
+  else {
+    if ( Bid == node.side ) book.tickBest = std::max( book.tickBest, node.tick );
+    else                    book.tickBest = std::min( book.tickBest, node.tick );
+  }
+  book.nOrders++;
+}
+
+void MatchingEngine::Withdraw( ix_t ix ) {
+  const Node& node( At( ix ) );
+  const ESide side( (ESide)node.side );
+  const tick_t tick( node.tick );
+  Book& book( m_rBook[ side ] );
+  Level& level( book.At( tick ) );
+  Unlink( level.list, ix );
+  book.nOrders--;
+  if ( ( 0 < book.nOrders ) && ( tick == book.tickBest ) && level.list.Empty() ) {
+    Best( book, side );
+  }
+}
+
+void MatchingEngine::Best( Book& book, ESide side ) {
+  // walk away from the inside to the next level holding an own order
+  tick_t ix( book.tickBest - book.tickBase );
+  if ( Bid == side ) {
+    while ( book.vLevel[ ix ].list.Empty() ) ix--;
+  }
+  else {
+    while ( book.vLevel[ ix ].list.Empty() ) ix++;
+  }
+  book.tickBest = book.tickBase + ix;
+}
+
+// ==== matching
+
+void MatchingEngine::Fill( ix_t ix, double price, quantity_t quan, EFill eFill ) {
+  Node& node( At( ix ) );
+  assert( quan <= node.nRemaining );
+  pOrder_t pOrder( node.pOrder );
+  node.nRemaining -= quan;
+  if ( 0 == node.nRemaining ) {
+    const idOrder_t idOrder( node.idOrder );
+    Remove( ix );
+    Release( ix );
+    OrderState* pState( m_mapOrderState.Find( idOrder ) );
+    assert( nullptr != pState );
+    pState->state = OrderState::EState::Archive;
+    pState->ixNode = npos;
+  }
+  // structures are consistent before the callback, which may submit or cancel (those only reach the wheel)
+  if ( nullptr != OnFill ) OnFill( *pOrder, price, quan, eFill );
+}
+
+void MatchingEngine::NewQuote( const Quote& quote ) {
+
+  if ( 0 < m_nWheel ) Advance( Time( quote.DateTime() ) );
+
+  m_tickQuoteBid = Tick( quote.Bid() );
+  m_tickQuoteAsk = Tick( quote.Ask() );
+  m_nQuoteBidSize = quote.BidSize();
+  m_nQuoteAskSize = quote.AskSize();
+
+  if ( 0 == m_nResting ) return;
+
+  if ( !m_listStop.Empty() ) MatchStops( quote );
+
+  // displayed size is shared by everything filled against this quote
+  uint64_t nBid( quote.BidSize() );
+  uint64_t nAsk( quote.AskSize() );
+
+  if ( !m_listMarket.Empty() ) MatchMarket( quote, nBid, nAsk );
+
+  if ( 0.0 < quote.Bid() ) MatchLimit( Ask, m_tickQuoteBid, quote.Bid(), nBid );
+  if ( 0.0 < quote.Ask() ) MatchLimit( Bid, m_tickQuoteAsk, quote.Ask(), nAsk );
+}
+
+void MatchingEngine::MatchStops( const Quote& quote ) {
+  const bool bBid( 0.0 < quote.Bid() );
+  const bool bAsk( 0.0 < quote.Ask() );
+  ix_t ix( m_listStop.ixHead );
+  while ( npos != ix ) {
+    Node& node( At( ix ) );
+    const ix_t ixNext( node.ixNext );
+    const bool bTriggered(
+      ( Bid == node.side ) ? ( bAsk && ( m_tickQuoteAsk >= node.tick ) )  // buy stop
+                           : ( bBid && ( m_tickQuoteBid <= node.tick ) ) ); // sell stop
+    if ( bTriggered ) {
+      Unlink( m_listStop, ix );
+      node.kind = EKind::Triggered;
+      PushBack( m_listMarket, ix );
+    }
+    ix = ixNext;
+  }
+}
+
+void MatchingEngine::MatchMarket( const Quote& quote, uint64_t& nBid, uint64_t& nAsk ) {
+  ix_t ix( m_listMarket.ixHead );
+  while ( ( npos != ix ) && ( ( 0 < nBid ) || ( 0 < nAsk ) ) ) {
+    const Node& node( At( ix ) );
+    const ix_t ixNext( node.ixNext );
+    const EFill eFill( ( EKind::Triggered == node.kind ) ? EFill::Stop : EFill::Market );
+    if ( Bid == node.side ) {
+      if ( ( 0 < nAsk ) && ( 0.0 < quote.Ask() ) ) {
+        const quantity_t quan( std::min<uint64_t>( node.nRemaining, nAsk ) );
+        nAsk -= quan;
+        Fill( ix, quote.Ask(), quan, eFill );
+      }
+    }
+    else {
+      if ( ( 0 < nBid ) && ( 0.0 < quote.Bid() ) ) {
+        const quantity_t quan( std::min<uint64_t>( node.nRemaining, nBid ) );
+        nBid -= quan;
+        Fill( ix, quote.Bid(), quan, eFill );
+      }
+    }
+    ix = ixNext;
+  }
+}
+
+void MatchingEngine::MatchLimit( ESide side, tick_t tickLimit, double price, uint64_t& nPool ) {
+  // own orders, best level first, FIFO within the level, while they cross tickLimit
+  Book& book( m_rBook[ side ] );
+  while ( ( 0 < nPool ) && ( 0 < book.nOrders ) ) {
+    if ( Bid == side ? ( book.tickBest < tickLimit ) : ( book.tickBest > tickLimit ) ) break;
+    const ix_t ix( book.At( book.tickBest ).list.ixHead );
+    const Node& node( At( ix ) );
+    const quantity_t quan( std::min<uint64_t>( node.nRemaining, nPool ) );
+    const double dblPrice( ( 0.0 == price ) ? node.pOrder->GetPrice1() : price );
+    nPool -= quan;
+    Fill( ix, dblPrice, quan, EFill::Limit );
+  }
+}
+
+void MatchingEngine::NewTrade( const Trade& trade ) {
+
+  if ( 0 < m_nWheel ) Advance( Time( trade.DateTime() ) );
+
+  if ( 0 == ( m_rBook[ Bid ].nOrders + m_rBook[ Ask ].nOrders ) ) return;
+
+  const tick_t tick( Tick( trade.Price() ) );
+  uint64_t nPool( trade.Volume() );
+
+  // printed through an own limit: it would have been taken first, at the limit price
+  MatchLimit( Ask, tick - 1, 0.0, nPool );
+  MatchLimit( Bid, tick + 1, 0.0, nPool );
+
+  // printed at an own limit: only with the queue modelled is there a basis for a fill
+  if ( m_bQueuePosition && ( 0 < nPool ) ) {
+    MatchTrade( Ask, tick, nPool );
+    MatchTrade( Bid, tick, nPool );
+  }
+}
+
+void MatchingEngine::MatchTrade( ESide side, tick_t tick, uint64_t nVolume ) {
+
+  Book& book( m_rBook[ side ] );
+  if ( !book.Contains( tick ) ) return;
+
+  // nQueueAhead is cumulative recorded volume, so each order sees the whole print,
+  //   less what went to own orders in front of it
+  uint64_t nOwn {};
+  ix_t ix( book.At( tick ).list.ixHead );
+  while ( ( npos != ix ) && ( nOwn < nVolume ) ) {
+    Node& node( At( ix ) );
+    const ix_t ixNext( node.ixNext );
+    const uint64_t nAvailable( nVolume - nOwn );
+    const uint64_t nAhead( std::min( node.nQueueAhead, nAvailable ) );
+    node.nQueueAhead -= nAhead;
+    node.nTradedAhead += nAhead;
+    if ( ( 0 == node.nQueueAhead ) && ( nAvailable > nAhead ) ) {
+      const quantity_t quan( std::min<uint64_t>( node.nRemaining, nAvailable - nAhead ) );
+      nOwn += quan;
+      Fill( ix, node.pOrder->GetPrice1(), quan, EFill::Limit );
+    }
+    ix = ixNext;
+  }
+}
+
+// ==== recorded depth
+
+void MatchingEngine::NewDepthByOrder( const DepthByOrder& depth ) {
+
+  if ( !m_bQueuePosition ) return;
+
+  if ( 0 < m_nWheel ) Advance( Time( depth.DateTime() ) );
+
+  const ESide side( ( 'B' == depth.Side() ) ? Bid : Ask );
+  const tick_t tick( Tick( depth.Price() ) );
+  const uint64_t nVolume( depth.Volume() );
+
+  switch ( depth.MsgType() ) {
+    case '3': // add
+    case '4': // update
+    case '6': // summary
+      {
+        Recorded recorded;
+        recorded.tick = tick;
+        recorded.nVolume = nVolume;
+        recorded.nSequence = ++m_nSequence;
+        recorded.side = side;
+        auto result = m_mapRecorded.Emplace( depth.OrderID(), recorded );
+        if ( result.second ) {
+          Record( side, tick, nVolume );
+        }
+        else {
+          Recorded& existing( *result.first );
+          if ( ( existing.tick != tick ) || ( existing.side != side ) || ( existing.nVolume < nVolume ) ) {
+            // moved, or grew: leaves its place, joins the back
+            Record( (ESide)existing.side, existing.tick, -(int64_t)existing.nVolume );
+            Reduce( (ESide)existing.side, existing.tick, existing.nSequence, existing.nVolume );
+            existing = recorded;
+            Record( side, tick, nVolume );
+          }
+          else {
+            if ( existing.nVolume > nVolume ) { // partial, keeps its place
+              const uint64_t nReduce( existing.nVolume - nVolume );
+              Record( side, tick, -(int64_t)nReduce );
+              Reduce( side, tick, existing.nSequence, nReduce );
+              existing.nVolume = nVolume;
+            }
+          }
+        }
+      }
+      break;
+    case '5': // delete
+      {
+        const Recorded* pRecorded( m_mapRecorded.Find( depth.OrderID() ) );
+        if ( nullptr != pRecorded ) {
+          const Recorded recorded( *pRecorded );
+          m_mapRecorded.Erase( depth.OrderID() );
+          Record( (ESide)recorded.side, recorded.tick, -(int64_t)recorded.nVolume );
+          Reduce( (ESide)recorded.side, recorded.tick, recorded.nSequence, recorded.nVolume );
+        }
+      }
+      break;
+    case 'C': // clear
+      m_mapRecorded.Clear();
+      for ( Book& book: m_rBook ) {
+        for ( Level& level: book.vLevel ) level.nRecorded = 0;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void MatchingEngine::Record( ESide side, tick_t tick, int64_t nVolume ) {
+  Book& book( m_rBook[ side ] );
+  if ( Reserve( book, tick, false ) ) {
+    Level& level( book.At( tick ) );
+    if ( ( 0 > nVolume ) && ( level.nRecorded < (uint64_t)-nVolume ) ) level.nRecorded = 0;
+    else level.nRecorded += nVolume;
+  }
+}
+
+void MatchingEngine::Reduce( ESide side, tick_t tick, uint64_t nSequence, uint64_t nVolume ) {
+  Book& book( m_rBook[ side ] );
+  if ( !book.Contains( tick ) ) return;
+  ix_t ix( book.At( tick ).list.ixHead );
+  while ( npos != ix ) {
+    Node& node( At( ix ) );
+    if ( nSequence < node.nSequence ) { // was ahead
+      const uint64_t nCredit( std::min( node.nTradedAhead, nVolume ) ); // already taken out by a trade
+      node.nTradedAhead -= nCredit;
+      node.nQueueAhead -= std::min( node.nQueueAhead, nVolume - nCredit );
+    }
+    ix = node.ixNext;
+  }
+}
+
+} // namespace sim
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,229 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    MatchingEngine.h
+ * Author:  raymond@burkholder.net
+ * Project: TFSimulation
+ * Created: October 17, 2026 18:20
+ */
+
+#pragma once
+
+// book mode for OrderExecution:
+//   * resting limit orders live in tick indexed price levels, one vector per side, each level
+//     an intrusive FIFO list of nodes, the best level per side is tracked, so a quote only visits
+//     levels which actually cross
+//   * market orders and triggered stops are intrusive FIFO lists, stops trigger on the quote
+//   * submit and cancel delays are held in a hashed timer wheel, fired in due order once
+//     the market time passes the due time
+//   * all nodes come from one pool with a free list, Reset() empties everything but keeps the
+//     capacity, so an instance is reused symbol to symbol without heap churn
+//   * optionally, queue position: resting volume ahead of each order is taken from a recorded
+//     DepthByOrder stream, reduced by deletes/reductions of the orders ahead, and by trades at
+//     the level, an order at the trade price fills only once the volume ahead is consumed
+
+#include <vector>
+#include <cstdint>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <OUCommon/OrderMap.h>
+#include <OUCommon/FastDelegate.h>
+
+#include <TFTimeSeries/DatedDatum.h>
+
+#include <TFTrading/Order.h>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace sim { // simulation
+
+class MatchingEngine {
+public:
+
+  using pOrder_t = Order::pOrder_t;
+  using idOrder_t = Order::idOrder_t;
+  using quantity_t = Order::quantity_t;
+
+  enum class EFill { Market, Stop, Limit };
+
+  MatchingEngine();
+  MatchingEngine( const MatchingEngine& ) = delete;
+  MatchingEngine& operator=( const MatchingEngine& ) = delete;
+  ~MatchingEngine();
+
+  using OnFillHandler = fastdelegate::FastDelegate4<Order&, double, quantity_t, EFill>; // order, price, quantity, how
+  void SetOnFill( OnFillHandler function ) {
+    OnFill = function;
+  }
+  using OnCancelledHandler = fastdelegate::FastDelegate1<idOrder_t>;
+  void SetOnCancelled( OnCancelledHandler function ) {
+    OnCancelled = function;
+  }
+  using OnNoOrderFoundHandler = fastdelegate::FastDelegate1<idOrder_t>;
+  void SetOnNoOrderFound( OnNoOrderFoundHandler function ) {
+    OnNoOrderFound = function;
+  }
+
+  void SetTickSize( double );
+  void SetOrderDelay( const boost::posix_time::time_duration& );
+  void SetQueuePosition( bool bQueuePosition ) { m_bQueuePosition = bQueuePosition; }
+
+  void Submit( pOrder_t, const boost::posix_time::ptime& dtSubmitted ); // new or change
+  void Cancel( idOrder_t, const boost::posix_time::ptime& dtRequested );
+
+  void NewQuote( const Quote& );
+  void NewTrade( const Trade& );
+  void NewDepthByOrder( const DepthByOrder& ); // used only with queue position
+
+  void Reset(); // drop all orders and recorded depth, keep the allocations
+
+  size_t Pending() const { return m_nWheel; } // submits and cancels in the delay
+  size_t Resting() const { return m_nResting; } // market, stop, limit
+
+protected:
+private:
+
+  using ix_t = uint32_t;
+  static constexpr ix_t npos = 0xffffffff;
+
+  using tick_t = int64_t;
+  using usec_t = int64_t; // microseconds
+
+  enum class EKind: uint8_t { Submit, Cancel, Market, Stop, Triggered, Limit }; // Triggered: a stop, now in the market list
+  enum ESide { Bid = 0, Ask = 1 }; // buy orders rest on the bid side
+
+  struct Node {
+    pOrder_t pOrder;
+    idOrder_t idOrder;
+    usec_t tDue;
+    tick_t tick;
+    uint64_t nSequence;    // position relative to the recorded orders at the level
+    uint64_t nQueueAhead;  // recorded volume ahead
+    uint64_t nTradedAhead; // traded out of the volume ahead, not yet seen as a depth reduction
+    quantity_t nRemaining;
+    EKind kind;
+    uint8_t side;
+    ix_t ixPrev;
+    ix_t ixNext;
+    Node()
+    : idOrder {}, tDue {}, tick {}, nSequence {}, nQueueAhead {}, nTradedAhead {}
+    , nRemaining {}, kind( EKind::Submit ), side {}, ixPrev( npos ), ixNext( npos ) {}
+  };
+
+  struct List { // intrusive, doubly linked through Node::ixPrev/ixNext
+    ix_t ixHead;
+    ix_t ixTail;
+    List(): ixHead( npos ), ixTail( npos ) {}
+    bool Empty() const { return npos == ixHead; }
+  };
+
+  struct Level {
+    List list;          // own orders, FIFO
+    uint64_t nRecorded; // recorded depth volume
+    Level(): nRecorded {} {}
+  };
+
+  struct Book { // one per side
+    std::vector<Level> vLevel;
+    tick_t tickBase;  // tick of vLevel[ 0 ]
+    tick_t tickBest;  // best tick holding an own order, valid when 0 < nOrders
+    size_t nOrders;
+    Book(): tickBase {}, tickBest {}, nOrders {} {}
+    bool Contains( tick_t tick ) const { return ( tick >= tickBase ) && ( tick < ( tickBase + (tick_t)vLevel.size() ) ); }
+    Level& At( tick_t tick ) { return vLevel[ tick - tickBase ]; }
+  };
+
+  struct OrderState {
+    enum class EState: uint8_t { Delay, Active, Archive } state;
+    ix_t ixNode; // when active
+    OrderState(): state( EState::Delay ), ixNode( npos ) {}
+  };
+
+  struct Recorded { // an order from the depth stream
+    tick_t tick;
+    uint64_t nVolume;
+    uint64_t nSequence;
+    uint8_t side;
+    Recorded(): tick {}, nVolume {}, nSequence {}, side {} {}
+  };
+
+  static const size_t nSlots = 256; // timer wheel
+
+  double m_dblTicksPerUnit; // 1 / tick size
+  usec_t m_tDelay;
+  bool m_bQueuePosition;
+
+  std::vector<Node> m_vNode;
+  ix_t m_ixFree;
+
+  std::vector<List> m_vSlot;
+  unsigned int m_nShift; // slot width is 1 << m_nShift microseconds
+  usec_t m_tCursor;      // slot number last fired, stale while the wheel is empty
+  size_t m_nWheel;
+
+  List m_listMarket; // market orders, and stops once triggered
+  List m_listStop;
+  Book m_rBook[ 2 ];
+  size_t m_nResting;
+
+  ou::OrderMap<OrderState> m_mapOrderState;
+  ou::OrderMap<Recorded> m_mapRecorded;
+  uint64_t m_nSequence;
+
+  tick_t m_tickQuoteBid;
+  tick_t m_tickQuoteAsk;
+  uint64_t m_nQuoteBidSize;
+  uint64_t m_nQuoteAskSize;
+
+  OnFillHandler OnFill;
+  OnCancelledHandler OnCancelled;
+  OnNoOrderFoundHandler OnNoOrderFound;
+
+  Node& At( ix_t ix ) { return m_vNode[ ix ]; }
+  ix_t Allocate();
+  void Release( ix_t );
+
+  void PushBack( List&, ix_t );
+  void Unlink( List&, ix_t );
+
+  tick_t Tick( double price ) const;
+  static usec_t Time( const boost::posix_time::ptime& );
+
+  void Schedule( ix_t );
+  void Advance( usec_t tNow ); // fire the entries due before tNow
+  void Fire( ix_t );
+  bool Activate( ix_t ); // false when the order type is not simulated
+  void Remove( ix_t ); // from whichever structure holds the active order
+
+  bool Reserve( Book&, tick_t, bool bForce );
+  void Insert( ix_t );  // limit, into its level
+  void Withdraw( ix_t ); // limit, out of its level
+  void Best( Book&, ESide );
+
+  void Fill( ix_t, double price, quantity_t, EFill ); // releases the node when complete
+
+  void MatchStops( const Quote& );
+  void MatchMarket( const Quote&, uint64_t& nBid, uint64_t& nAsk );
+  void MatchLimit( ESide, tick_t tickLimit, double price, uint64_t& nPool ); // own orders through tickLimit, 0 == price fills at the limit
+  void MatchTrade( ESide, tick_t, uint64_t nVolume ); // own orders at the trade price, behind the queue
+
+  void Reduce( ESide, tick_t, uint64_t nSequence, uint64_t nVolume ); // recorded order ahead shrank
+  void Record( ESide, tick_t, int64_t nVolume );
+};
+
+} // namespace sim
+} // namespace tf
+} // namespace ou
@@ -22,6 +22,7 @@ using namespace fastdelegate;
 #include <OUCommon/TimeSource.h>
 
 #include <TFTimeSeries/TimeSeries.h>
+#include <TFTimeSeries/ColumnStore.h>
 
 // Each carrier holds a TimeSeries.  The carrier holds an index to the current DatedDatum in each TimeSeries.
 // The current DatedDatum timestamp is maintained for the merge process to figure out which DatedDatum to
@@ -56,21 +57,21 @@ private:
 
 // MergeCarrier
 
-template<class T> // T is a DatedDatum type
+template<class T, class Series = TimeSeries<T> > // T is a DatedDatum type, Series supplies First/Next/Size
 class MergeCarrier: public MergeCarrierBase {
   friend class MergeDatedDatums;
 public:
-  MergeCarrier<T>( TimeSeries<T>& series, OnDatumHandler function );
-  virtual ~MergeCarrier<T>();
+  MergeCarrier( Series& series, OnDatumHandler function );
+  virtual ~MergeCarrier();
   void ProcessDatum();
   void Reset();
 protected:
-  TimeSeries<T>& m_series;  // series from which a datum is to be merged to output
+  Series& m_series;  // series from which a datum is to be merged to output
 private:
 };
 
-template<class T>
-MergeCarrier<T>::MergeCarrier( TimeSeries<T>& series, OnDatumHandler function )
+template<class T, class Series>
+MergeCarrier<T,Series>::MergeCarrier( Series& series, OnDatumHandler function )
   : MergeCarrierBase(), m_series( series )
 {
   assert( 0 != m_series.Size() );
@@ -81,12 +82,12 @@ MergeCarrier<T>::MergeCarrier( TimeSeries<T>& series, OnDatumHandler function )
     : m_pDatum->DateTime();
 }
 
-template<class T>
-MergeCarrier<T>::~MergeCarrier() {
+template<class T, class Series>
+MergeCarrier<T,Series>::~MergeCarrier() {
 }
 
-template<class T>
-void MergeCarrier<T>::ProcessDatum() {
+template<class T, class Series>
+void MergeCarrier<T,Series>::ProcessDatum() {
   if ( ou::TimeSource::LocalCommonInstance().GetSimulationMode() ) {
     ou::TimeSource::LocalCommonInstance().SetSimulationTime( m_pDatum->DateTime() );
   }
@@ -98,8 +99,8 @@ void MergeCarrier<T>::ProcessDatum() {
     : m_pDatum->DateTime();
 }
 
-template<class T>
-void MergeCarrier<T>::Reset() {
+template<class T, class Series>
+void MergeCarrier<T,Series>::Reset() {
   m_pDatum = m_series.First();  // preload with first datum so we have it's time available for comparison
   m_dt = ( 0 == m_pDatum )
     ? boost::date_time::special_values::not_a_date_time
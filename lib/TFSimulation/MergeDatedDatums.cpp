@@ -23,6 +23,7 @@ namespace tf { // TradeFrame
 
 MergeDatedDatums::MergeDatedDatums()
 : m_state( eInit ), m_request( eUnknown )
+, m_cntProcessedDatums {}
 {
 }
 
@@ -57,6 +58,18 @@ void MergeDatedDatums::Add( TimeSeries<DepthByOrder>& series, MergeDatedDatums::
   m_mhCarriers.Append( new MergeCarrier<DepthByOrder>( series, function ) );
 }
 
+void MergeDatedDatums::Add( ColumnStoreView<Quote>& series, MergeDatedDatums::OnDatumHandler function ) {
+  m_mhCarriers.Append( new MergeCarrier<Quote, ColumnStoreView<Quote> >( series, function ) );
+}
+
+void MergeDatedDatums::Add( ColumnStoreView<Trade>& series, MergeDatedDatums::OnDatumHandler function ) {
+  m_mhCarriers.Append( new MergeCarrier<Trade, ColumnStoreView<Trade> >( series, function ) );
+}
+
+void MergeDatedDatums::Add( ColumnStoreView<Bar>& series, MergeDatedDatums::OnDatumHandler function ) {
+  m_mhCarriers.Append( new MergeCarrier<Bar, ColumnStoreView<Bar> >( series, function ) );
+}
+
 // http://www.codeguru.com/forum/archive/index.php/t-344661.html
 
 /*
@@ -77,21 +90,30 @@ void MergeDatedDatums::Run() {
 //  LOG << "#carriers: " << cntCarriers;  // need cross thread writing
   MergeCarrierBase* pCarrier = nullptr;
   m_cntProcessedDatums = 0;
+  m_tpRunStart = std::chrono::steady_clock::now();
   m_state = eRunning;
-  while ( ( 0 != cntCarriers ) && ( eRun == m_request ) ) {  // once all series have been depleted, end of run
-    pCarrier = m_mhCarriers.GetRoot();
-    pCarrier->ProcessDatum();  // automatically loads next datum when done
-    ++m_cntProcessedDatums;
-    if ( nullptr == pCarrier->GetDatedDatum() ) {
-      // retire the consumed carrier
-      m_mhCarriers.ArchiveRoot();
-      --cntCarriers;
-    }
-    else {
-      // reorder the carriers
-      m_mhCarriers.SiftDown();
+  try {
+    while ( ( 0 != cntCarriers ) && ( eRun == m_request ) ) {  // once all series have been depleted, end of run
+      pCarrier = m_mhCarriers.GetRoot();
+      pCarrier->ProcessDatum();  // automatically loads next datum when done
+      ++m_cntProcessedDatums;
+      if ( nullptr == pCarrier->GetDatedDatum() ) {
+        // retire the consumed carrier
+        m_mhCarriers.ArchiveRoot();
+        --cntCarriers;
+      }
+      else {
+        // reorder the carriers
+        m_mhCarriers.SiftDown();
+      }
     }
   }
+  catch (...) { // a streamed series failed to read, the run ends here
+    m_tpRunStop = std::chrono::steady_clock::now();
+    m_state = eStopped;
+    throw;
+  }
+  m_tpRunStop = std::chrono::steady_clock::now();
   m_state = eStopped;
 //  LOG << "Merge stats: " << m_cntProcessedDatums << ", " << m_cntReorders;
 }
@@ -100,5 +122,29 @@ void MergeDatedDatums::Stop() {
   m_request = eStop;
 }
 
+std::chrono::nanoseconds MergeDatedDatums::GetRunTime() const {
+  switch ( m_state ) {
+    case eInit:
+      return std::chrono::nanoseconds::zero();
+    case eRunning:
+      return std::chrono::steady_clock::now() - m_tpRunStart;
+    default:
+      return m_tpRunStop - m_tpRunStart;
+  }
+}
+
+double MergeDatedDatums::GetDatumsPerSecond() const {
+  const std::chrono::duration<double> dur( GetRunTime() );
+  return ( 0.0 == dur.count() ) ? 0.0 : (double)m_cntProcessedDatums / dur.count();
+}
+
+std::chrono::nanoseconds MergeDatedDatums::GetStallTime() const {
+  std::chrono::nanoseconds ns {};
+  for ( const HDF5ChunkedSeriesBase* p: m_vChunked ) {
+    ns += p->Stalled();
+  }
+  return ns;
+}
+
 } // namespace tf
 } // namespace ou
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <vector>
+#include <chrono>
 
 // 2012/08/12 could try using std:priority_queue instead or boost::max_heap
 #include <OUCommon/MinHeap.h>
@@ -24,6 +25,8 @@ using namespace fastdelegate;
 
 #include <TFTimeSeries/TimeSeries.h>
 
+#include <TFHDF5TimeSeries/HDF5ChunkedSeries.h>
+
 #include "MergeDatedDatumCarrier.h"
 
 namespace ou { // One Unified
@@ -45,12 +48,27 @@ public:
   void Add( TimeSeries<Greek>& series, OnDatumHandler );
   void Add( TimeSeries<DepthByMM>& series, OnDatumHandler );
   void Add( TimeSeries<DepthByOrder>& series, OnDatumHandler );
+
+  // memory mapped column store, decoded as the merge proceeds
+  void Add( ColumnStoreView<Quote>& series, OnDatumHandler );
+  void Add( ColumnStoreView<Trade>& series, OnDatumHandler );
+  void Add( ColumnStoreView<Bar>& series, OnDatumHandler );
+
+  // streamed from hdf5 in chunks, series needs to outlive the merge
+  template<typename T>
+  void Add( HDF5ChunkedSeries<T>& series, OnDatumHandler function ) {
+    m_vChunked.push_back( &series );
+    m_mhCarriers.Append( new MergeCarrier<T, HDF5ChunkedSeries<T> >( series, function ) );
+  }
   void Run();
   void Stop();
 
   enumMergingState GetState() const { return m_state; };
 
   unsigned long GetCountProcessedDatums() const { return m_cntProcessedDatums; };
+  std::chrono::nanoseconds GetRunTime() const; // of the current, or most recent, Run
+  double GetDatumsPerSecond() const;
+  std::chrono::nanoseconds GetStallTime() const; // waiting on reads, summed over chunked series
 
 protected:
 
@@ -64,6 +82,12 @@ protected:
 
   unsigned long m_cntProcessedDatums;
 
+  std::chrono::steady_clock::time_point m_tpRunStart;
+  std::chrono::steady_clock::time_point m_tpRunStop;
+
+  using vChunked_t = std::vector<const HDF5ChunkedSeriesBase*>;
+  vChunked_t m_vChunked;
+
 private:
 
 };
@@ -31,7 +31,10 @@ int OrderExecution::m_nExecId( 1000 );
 OrderExecution::OrderExecution()
 : m_dtQueueDelay( milliseconds( 250 ) )
 , m_dblCommission( 1.00 )
+, m_eMatching( EMatching::Queue )
 {
+  m_engine.SetOrderDelay( m_dtQueueDelay );
+  m_engine.SetOnFill( MakeDelegate( this, &OrderExecution::HandleEngineFill ) );
 }
 
 OrderExecution::~OrderExecution() {
@@ -43,8 +46,24 @@ std::string OrderExecution::GetExecId() {
   return sId;
 }
 
+void OrderExecution::SetMatching( EMatching eMatching, double dblTickSize, bool bQueuePosition ) {
+  m_eMatching = eMatching;
+  m_engine.Reset();
+  m_engine.SetTickSize( dblTickSize );
+  m_engine.SetQueuePosition( bQueuePosition );
+}
+
+void OrderExecution::Reset() {
+  m_engine.Reset();
+}
+
 void OrderExecution::NewQuote( const Quote& quote ) {
-  ProcessOrderQueues( quote );
+  if ( EMatching::Book == m_eMatching ) {
+    m_engine.NewQuote( quote );
+  }
+  else {
+    ProcessOrderQueues( quote );
+  }
   m_lastQuote = quote; // should this be: before or after?
 }
 
@@ -52,13 +71,21 @@ void OrderExecution::NewDepthByMM( const DepthByMM& depth ) {
 }
 
 void OrderExecution::NewDepthByOrder( const DepthByOrder& depth ) {
+  if ( EMatching::Book == m_eMatching ) {
+    m_engine.NewDepthByOrder( depth );
+  }
   // might use this to populate the bid/ask tables
   // queue in the locally generated orders for proper execution sequencing
   // then apply the ou::tf::Trade orders against this list
 }
 
 void OrderExecution::NewTrade( const Trade& trade ) {
-  ProcessLimitOrders( trade );
+  if ( EMatching::Book == m_eMatching ) {
+    m_engine.NewTrade( trade );
+  }
+  else {
+    ProcessLimitOrders( trade );
+  }
 }
 
 void OrderExecution::SubmitOrder( pOrder_t pOrder ) {
@@ -66,6 +93,10 @@ void OrderExecution::SubmitOrder( pOrder_t pOrder ) {
   Order::idOrder_t idOrder( pOrder->GetOrderId() );
   BOOST_LOG_TRIVIAL(info)
     << "simulate," << idOrder << ",queued,submit," << pOrder->GetInstrument()->GetInstrumentName();
+  if ( EMatching::Book == m_eMatching ) {
+    m_engine.Submit( pOrder, pOrder->GetDateTimeOrderSubmitted() );
+    return;
+  }
   m_lOrderDelay.push_back( pOrder );
   TrackOrder( idOrder, OrderState::State::Delay ); // might be new or a change
 }
@@ -73,11 +104,55 @@ void OrderExecution::SubmitOrder( pOrder_t pOrder ) {
 void OrderExecution::CancelOrder( Order::idOrder_t idOrder ) {
   BOOST_LOG_TRIVIAL(info)
     << "simulate," << idOrder << ",queued,cancel";
+  if ( EMatching::Book == m_eMatching ) {
+    m_engine.Cancel( idOrder, ou::TimeSource::LocalCommonInstance().Internal() );
+    return;
+  }
   QueuedCancelOrder qco( ou::TimeSource::LocalCommonInstance().Internal(), idOrder );
   m_lCancelDelay.push_back( qco );
   TrackOrder( idOrder, OrderState::State::Delay ); // should match an existing order
 }
 
+void OrderExecution::HandleEngineFill( Order& order, double dblPrice, MatchingEngine::quantity_t quan, MatchingEngine::EFill eFill ) {
+
+  const ou::tf::Order::idOrder_t idOrder( order.GetOrderId() );
+  const OrderSide::EOrderSide orderSide( order.GetOrderSide() );
+  int nId( m_nExecId );  // before it gets incremented in next function
+  std::string id = GetExecId();
+
+  const char* szExchange {};
+  switch ( eFill ) {
+    case MatchingEngine::EFill::Market:
+      szExchange = "SIMMkt";
+      break;
+    case MatchingEngine::EFill::Stop:
+      szExchange = "SIMStop";
+      break;
+    case MatchingEngine::EFill::Limit:
+      szExchange = ( OrderSide::Buy == orderSide ) ? "SIMLmtBuy" : "SIMLmtSell";
+      break;
+  }
+
+  BOOST_LOG_TRIVIAL(info)
+    << "simulate,"
+    << idOrder
+    << "," << szExchange
+    << "," << nId
+    << "," << orderSide
+    << "," << quan << "," << dblPrice
+    ;
+
+  if ( nullptr != OnOrderFill ) {
+    Execution exec( nId, idOrder, dblPrice, quan, orderSide, szExchange, id );
+    OnOrderFill( idOrder, exec );
+  }
+  else {
+    // the engine tracks the remaining quantity itself
+  }
+
+  CalculateCommission( order, quan );
+}
+
 void OrderExecution::CalculateCommission( Order& order, Trade::tradesize_t quan ) {
   // Order or Instrument should have commission calculation?
   if ( 0 != quan ) {
@@ -32,6 +32,8 @@ using namespace fastdelegate;
 #include <TFTrading/Order.h>
 #include <TFTrading/Execution.h>
 
+#include "MatchingEngine.h"
+
 namespace ou { // One Unified
 namespace tf { // TradeFrame
 namespace sim { // simulation
@@ -47,6 +49,7 @@ public:
   using OnOrderCancelledHandler = FastDelegate1<Order::idOrder_t>;
   void SetOnOrderCancelled( OnOrderCancelledHandler function ) {
     OnOrderCancelled = function;
+    m_engine.SetOnCancelled( function );
   }
   using OnOrderFillHandler = FastDelegate2<Order::idOrder_t, const Execution&>;
   void SetOnOrderFill( OnOrderFillHandler function ) {
@@ -55,15 +58,23 @@ public:
   using OnNoOrderFoundHandler = FastDelegate1<Order::idOrder_t>;  // cancelling a non existant order
   void SetOnNoOrderFound( OnNoOrderFoundHandler function ) {
     OnNoOrderFound = function;
+    m_engine.SetOnNoOrderFound( function );
   }
   using OnCommissionHandler = FastDelegate2<Order::idOrder_t, double>;  // calculated once order filled
   void SetOnCommission( OnCommissionHandler function ) {
     OnCommission = function;
   }
 
-  void SetOrderDelay( const time_duration &dtOrderDelay ) { m_dtQueueDelay = dtOrderDelay; };
+  void SetOrderDelay( const time_duration &dtOrderDelay ) { m_dtQueueDelay = dtOrderDelay; m_engine.SetOrderDelay( dtOrderDelay ); };
   void SetCommission( double dblCommission ) { m_dblCommission = dblCommission; };
 
+  // Queue: the original lists and maps, one market or one limit fill per quote, at the quote
+  // Book: MatchingEngine, tick indexed levels, all fills the displayed size allows, stops trigger,
+  //   trades through a limit fill it, with bQueuePosition, depth by order places orders in the queue
+  enum class EMatching { Queue, Book };
+  void SetMatching( EMatching, double dblTickSize = 0.01, bool bQueuePosition = false ); // before any orders
+  void Reset(); // book mode: drop all orders, keep the allocations, for reuse on another symbol
+
   void NewQuote( const Quote& quote );
   void NewDepthByMM( const DepthByMM& depth ); // has no influence on the self administred order books
   void NewDepthByOrder( const DepthByOrder& depth ); // has no influence on the self administred order books
@@ -105,6 +116,10 @@ private:
 
   Quote m_lastQuote;
 
+  EMatching m_eMatching;
+  MatchingEngine m_engine;
+  void HandleEngineFill( Order&, double price, MatchingEngine::quantity_t, MatchingEngine::EFill );
+
   OnOrderCancelledHandler OnOrderCancelled;
   OnOrderFillHandler OnOrderFill;
   OnNoOrderFoundHandler OnNoOrderFound;
@@ -53,6 +53,7 @@ public:
   {}
 
   void SetCommission( const std::string& sSymbol, double commission );
+  void SetMatching( const std::string& sSymbol, OrderExecution::EMatching, double dblTickSize, bool bQueuePosition = false );
 
   void PlaceOrder( pOrder_t pOrder );
   void CancelOrder( pOrder_t pOrder );
@@ -269,6 +270,17 @@ void SimulationInterface<P,S>::SetCommission( const std::string& sSymbol, double
 
 }
 
+template <typename P, typename S>
+void SimulationInterface<P,S>::SetMatching( const std::string& sSymbol, OrderExecution::EMatching eMatching, double dblTickSize, bool bQueuePosition ) {
+
+  Update(
+    sSymbol,
+    [eMatching,dblTickSize,bQueuePosition]( EventHolders& eh ){
+      eh.oe.SetMatching( eMatching, dblTickSize, bQueuePosition );
+    } );
+
+}
+
 template <typename P, typename S>
 void SimulationInterface<P,S>::PlaceOrder( pOrder_t pOrder ) {
 
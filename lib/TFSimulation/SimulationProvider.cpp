@@ -16,6 +16,7 @@
 #include <stdexcept>
 
 #include <TFHDF5TimeSeries/HDF5DataManager.h>
+#include <TFHDF5TimeSeries/HDF5ChunkedSeries.h>
 
 #include <TFTrading/KeyTypes.h>
 #include <TFTrading/OrderManager.h>
@@ -26,10 +27,34 @@
 namespace ou { // One Unified
 namespace tf { // TradeFrame
 
+namespace {
+
+  // open a chunked series for the merge, missing series are skipped as with the loaded series
+  template<typename T>
+  void AddChunked(
+    HDF5ReadAhead& ra, std::vector<std::unique_ptr<HDF5ChunkedSeriesBase> >& vSeries,
+    MergeDatedDatums& merge, const std::string& sPath, size_t nChunkSize,
+    MergeDatedDatums::OnDatumHandler handler
+  ) {
+    try {
+      auto pSeries = std::make_unique<HDF5ChunkedSeries<T> >( ra, sPath, nChunkSize );
+      if ( 0 != pSeries->Size() ) {
+        merge.Add( *pSeries, handler );
+        vSeries.emplace_back( std::move( pSeries ) );
+      }
+    }
+    catch ( std::runtime_error& e ) {
+      // couldn't open, so leave out of the merge
+    }
+  }
+
+}
+
 SimulationProvider::SimulationProvider()
 : sim::SimulationInterface<SimulationProvider,SimulationSymbol>()
-, m_pMerge( nullptr )
 , m_sHdf5FileName( HDF5DataManager::GetHdf5FileDefault() )
+, m_pMerge( nullptr )
+, m_nChunkSize {}
 {
   m_sName = "Simulator";
   m_nID = keytypes::EProviderSimulator;
@@ -51,6 +76,9 @@ SimulationProvider::~SimulationProvider() {
     delete m_pMerge;
     m_pMerge = nullptr;
   }
+
+  m_vChunkedSeries.clear(); // before the read ahead thread is removed
+  m_pReadAhead.reset();
 }
 
 void SimulationProvider::SetHdf5FileName( const std::string& sHdf5FileName ) {
@@ -98,7 +126,7 @@ SimulationProvider::pSymbol_t SimulationProvider::NewCSymbol( pInstrument_t pIns
 
 // these need to open the data file, load the data, and prepare to simulate
 void SimulationProvider::StartQuoteWatch( pSymbol_t pSymbol ) {
-  pSymbol->StartQuoteWatch();
+  if ( 0 == m_nChunkSize ) pSymbol->StartQuoteWatch(); // otherwise streamed in Merge
 }
 
 void SimulationProvider::StopQuoteWatch( pSymbol_t pSymbol ) {
@@ -106,7 +134,7 @@ void SimulationProvider::StopQuoteWatch( pSymbol_t pSymbol ) {
 }
 
 void SimulationProvider::StartTradeWatch( pSymbol_t pSymbol ) {
-  pSymbol->StartTradeWatch();
+  if ( 0 == m_nChunkSize ) pSymbol->StartTradeWatch(); // otherwise streamed in Merge
 }
 
 void SimulationProvider::StopTradeWatch( pSymbol_t pSymbol ) {
@@ -114,7 +142,7 @@ void SimulationProvider::StopTradeWatch( pSymbol_t pSymbol ) {
 }
 
 void SimulationProvider::StartDepthByMMWatch( pSymbol_t pSymbol ) {
-  pSymbol->StartDepthByMMWatch();
+  if ( 0 == m_nChunkSize ) pSymbol->StartDepthByMMWatch(); // otherwise streamed in Merge
 }
 
 void SimulationProvider::StopDepthByMMWatch( pSymbol_t pSymbol ) {
@@ -122,7 +150,7 @@ void SimulationProvider::StopDepthByMMWatch( pSymbol_t pSymbol ) {
 }
 
 void SimulationProvider::StartDepthByOrderWatch( pSymbol_t pSymbol ) {
-  pSymbol->StartDepthByOrderWatch();
+  if ( 0 == m_nChunkSize ) pSymbol->StartDepthByOrderWatch(); // otherwise streamed in Merge
 }
 
 void SimulationProvider::StopDepthByOrderWatch( pSymbol_t pSymbol ) {
@@ -130,7 +158,7 @@ void SimulationProvider::StopDepthByOrderWatch( pSymbol_t pSymbol ) {
 }
 
 void SimulationProvider::StartGreekWatch( pSymbol_t pSymbol ) {
-  pSymbol->StartGreekWatch();
+  if ( 0 == m_nChunkSize ) pSymbol->StartGreekWatch(); // otherwise streamed in Merge
 }
 
 void SimulationProvider::StopGreekWatch( pSymbol_t pSymbol ) {
@@ -142,6 +170,19 @@ void SimulationProvider::Merge() {
 
   if ( nullptr != m_OnSimulationThreadStarted ) m_OnSimulationThreadStarted();
 
+  bool bReadAhead( 0 != m_nChunkSize );
+  if ( bReadAhead ) {
+    try {
+      m_pReadAhead = std::make_unique<HDF5ReadAhead>( m_sHdf5FileName );
+    }
+    catch ( std::exception& e ) { // nothing to stream, the merge runs empty and completes
+      bReadAhead = false;
+      m_sErrorText = e.what();
+      std::cout << "SimulationProvider::Merge can not open " << m_sHdf5FileName << ": " << e.what() << std::endl;
+      OnError( ReadAheadOpen );
+    }
+  }
+
   // for each of the symbols, add the quote, trade and greek series
   // datums from each series will be merged and emitted in chronological order
   for ( mapSymbols_t::iterator iter = m_mapSymbols.begin();
@@ -150,6 +191,34 @@ void SimulationProvider::Merge() {
 
       pSymbol_t sym( iter->second );
 
+      if ( 0 != m_nChunkSize ) {
+        if ( !bReadAhead ) continue;
+        const std::string sBase( m_sGroupDirectory );
+        const std::string& sId( sym->GetId() );
+        SimulationSymbol* pSym( sym.get() );
+        if ( sym->QuoteWatchNeeded() ) {
+          AddChunked<Quote>( *m_pReadAhead, m_vChunkedSeries, *m_pMerge, sBase + Quotes::Directory() + sId, m_nChunkSize,
+            MakeDelegate( pSym, &SimulationSymbol::HandleQuoteEvent ) );
+        }
+        if ( sym->DepthByMMWatchNeeded() ) {
+          AddChunked<DepthByMM>( *m_pReadAhead, m_vChunkedSeries, *m_pMerge, sBase + DepthsByMM::Directory() + sId, m_nChunkSize,
+            MakeDelegate( pSym, &SimulationSymbol::HandleDepthByMMEvent ) );
+        }
+        if ( sym->DepthByOrderWatchNeeded() ) {
+          AddChunked<DepthByOrder>( *m_pReadAhead, m_vChunkedSeries, *m_pMerge, sBase + DepthsByOrder::Directory() + sId, m_nChunkSize,
+            MakeDelegate( pSym, &SimulationSymbol::HandleDepthByOrderEvent ) );
+        }
+        if ( sym->TradeWatchNeeded() ) {
+          AddChunked<Trade>( *m_pReadAhead, m_vChunkedSeries, *m_pMerge, sBase + Trades::Directory() + sId, m_nChunkSize,
+            MakeDelegate( pSym, &SimulationSymbol::HandleTradeEvent ) );
+        }
+        if ( sym->GreekWatchNeeded() && sym->GetInstrument()->IsOption() ) {
+          AddChunked<Greek>( *m_pReadAhead, m_vChunkedSeries, *m_pMerge, sBase + Greeks::Directory() + sId, m_nChunkSize,
+            MakeDelegate( pSym, &SimulationSymbol::HandleGreekEvent ) );
+        }
+        continue;
+      }
+
       Quotes& quotes( sym->m_quotes );
       if ( 0 != quotes.Size() ) {
         m_pMerge -> Add(
@@ -193,7 +262,14 @@ void SimulationProvider::Merge() {
   bool bOldMode = ou::TimeSource::LocalCommonInstance().GetSimulationMode();
   ou::TimeSource::LocalCommonInstance().SetSimulationMode();
 
-  m_pMerge->Run();
+  try {
+    m_pMerge->Run();
+  }
+  catch ( std::exception& e ) { // a failed chunk read, rethrown from HDF5ChunkedSeries::Next
+    m_sErrorText = e.what();
+    std::cout << "SimulationProvider::Merge read failed: " << e.what() << std::endl;
+    OnError( ReadAheadRead );
+  }
 
   m_nProcessedDatums = m_pMerge->GetCountProcessedDatums();
 
@@ -236,6 +312,12 @@ void SimulationProvider::EmitStats( std::stringstream& ss ) {
   //  ss << m_nProcessedDatums << " datums in " << nDuration << " seconds, " << nDatumsPerSecond << " datums/second." << std::endl;
     ss << m_nProcessedDatums << " datums in " << nDuration << " milliseconds, " << nDatumsPerSecond << " datums/millisecond.";
   }
+  if ( ( nullptr != m_pMerge ) && ( 0 != m_nChunkSize ) ) {
+    ss
+      << " " << m_vChunkedSeries.size() << " series streamed, "
+      << std::chrono::duration_cast<std::chrono::milliseconds>( m_pMerge->GetStallTime() ).count()
+      << " milliseconds waiting on reads.";
+  }
 }
 
 // at some point:  run, stop, pause, resume, reset
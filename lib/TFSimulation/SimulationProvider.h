@@ -16,6 +16,8 @@
 
 #include <thread>
 #include <string>
+#include <memory>
+#include <vector>
 #include <sstream>
 
 #include <OUCommon/FastDelegate.h>
@@ -32,6 +34,8 @@ namespace ou { // One Unified
 namespace tf { // TradeFrame
 
 class MergeDatedDatums;
+class HDF5ReadAhead;
+class HDF5ChunkedSeriesBase;
 
 // simulation provider needs to send an open event on each symbol it does
 //  will need to be based upon time
@@ -76,6 +80,14 @@ public:
   void SetGroupDirectory( const std::string& );  // eg /basket/20080620
   const std::string& GetGroupDirectory() const { return m_sGroupDirectory; }
 
+  // 0 (default): series are loaded completely as watches start
+  // otherwise:   series are streamed during Run in chunks of this many datums, read ahead in the background
+  //   the read ahead thread makes hdf5 calls for the whole Run, and libhdf5 is not built thread safe:
+  //   while a chunked Run is active nothing else in the process may use hdf5 (HDF5DataManager,
+  //   HDF5TimeSeriesContainer, HDF5WriteTimeSeries, SimulationSymbol loads, ...), on any file
+  void SetChunkSize( size_t nChunkSize ) { m_nChunkSize = nChunkSize; }
+  size_t GetChunkSize() const { return m_nChunkSize; }
+
   void Run( bool bAsync = true );
   void Stop();
 
@@ -95,6 +107,10 @@ public:
 
   void EmitStats( std::stringstream& ss );
 
+  // chunked Run failures, reported through OnError from the merge thread, the run then completes
+  enum EChunkedError: size_t { ReadAheadOpen = 1, ReadAheadRead };
+  const std::string& GetErrorText() const { return m_sErrorText; } // detail of the last OnError
+
 protected:
 
   std::string m_sHdf5FileName;
@@ -106,6 +122,12 @@ protected:
 
   MergeDatedDatums* m_pMerge;
 
+  size_t m_nChunkSize;
+  std::unique_ptr<HDF5ReadAhead> m_pReadAhead;
+  std::string m_sErrorText;
+  using vChunkedSeries_t = std::vector<std::unique_ptr<HDF5ChunkedSeriesBase> >;
+  vChunkedSeries_t m_vChunkedSeries;
+
   pSymbol_t virtual NewCSymbol( pInstrument_t pInstrument );
 
   void StartQuoteWatch( pSymbol_t pSymbol );
@@ -0,0 +1,242 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// sim::OrderExecution replay:  one synthetic stream of quotes, trades, depth by order, submits and cancels,
+//   recorded once, then handed to the legacy queue, the book, and the book with queue position
+//   usage: TFSimulationMatching [quotes [resting orders [order rate per mille of quotes]]]
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <iostream>
+
+#include <boost/log/core.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/log/expressions.hpp>
+
+#include <OUCommon/TimeSource.h>
+
+#include <TFSimulation/SimulateOrderExecution.h>
+
+namespace {
+
+namespace pt = boost::posix_time;
+using Order = ou::tf::Order;
+
+struct Event {
+  enum class EType { Quote, Trade, Depth, Submit, Cancel } eType;
+  pt::ptime dt;
+  ou::tf::Quote quote;
+  ou::tf::Trade trade;
+  ou::tf::DepthByOrder depth;
+  Order::idOrder_t idOrder;
+  Event( EType eType_, pt::ptime dt_ ): eType( eType_ ), dt( dt_ ), idOrder {} {}
+};
+
+struct OrderSpec {
+  ou::tf::OrderType::EOrderType eType;
+  ou::tf::OrderSide::EOrderSide eSide;
+  double dblPrice;
+  pt::ptime dt;
+};
+
+using vEvent_t = std::vector<Event>;
+using vOrderSpec_t = std::vector<OrderSpec>; // index is the order id, [0] unused
+
+// random walk at one quote per millisecond, depth churn around the inside, orders a few ticks from it
+void Record( size_t nQuotes, size_t nResting, int nRate, vEvent_t& vEvent, vOrderSpec_t& vOrderSpec ) {
+
+  std::mt19937_64 rng( 42 );
+  std::uniform_int_distribution<int> step( -1, 1 ), size( 1, 500 ), offset( 0, 20 ), pct( 0, 999 );
+
+  pt::ptime dt( boost::gregorian::date( 2026, 10, 16 ), pt::hours( 14 ) );
+  int64_t mid( 40000 ); // cents
+
+  std::vector<std::pair<Order::idOrder_t, pt::ptime> > vLive;
+  std::vector<uint64_t> vDepth;
+  uint64_t idDepth {};
+
+  vOrderSpec.resize( 1 );
+
+  for ( size_t ix = 0; ix < nQuotes; ix++ ) {
+
+    dt += pt::microseconds( 1000 );
+    if ( 0 == ( ix % 4 ) ) mid += step( rng );
+    const double bid( mid * 0.01 );
+    const double ask( ( mid + 1 ) * 0.01 );
+
+    if ( 300 > pct( rng ) ) {
+      Event event( Event::EType::Depth, dt );
+      if ( ( 200 > vDepth.size() ) || ( 500 > pct( rng ) ) ) {
+        const bool bBid( 500 > pct( rng ) );
+        const double price = bBid ? ( mid - offset( rng ) / 4 ) * 0.01 : ( mid + 1 + offset( rng ) / 4 ) * 0.01;
+        event.depth = ou::tf::DepthByOrder( dt, dt, ++idDepth, 0, '3', bBid ? 'B' : 'A', price, size( rng ) );
+        vDepth.push_back( idDepth );
+      }
+      else {
+        const size_t ixDepth( rng() % vDepth.size() );
+        event.depth = ou::tf::DepthByOrder( dt, dt, vDepth[ ixDepth ], 0, '5', 'B', 0.0, 0 );
+        vDepth[ ixDepth ] = vDepth.back();
+        vDepth.pop_back();
+      }
+      vEvent.push_back( event );
+    }
+
+    if ( ( vLive.size() < nResting ) && ( nRate > pct( rng ) ) ) {
+      const Order::idOrder_t id( vOrderSpec.size() );
+      const int r( pct( rng ) );
+      if ( 20 > r ) {
+        vOrderSpec.push_back( OrderSpec { ou::tf::OrderType::Market, ( r & 1 ) ? ou::tf::OrderSide::Buy : ou::tf::OrderSide::Sell, 0.0, dt } );
+      }
+      else {
+        if ( 500 > r ) {
+          vOrderSpec.push_back( OrderSpec { ou::tf::OrderType::Limit, ou::tf::OrderSide::Buy, ( mid - offset( rng ) ) * 0.01, dt } );
+        }
+        else {
+          vOrderSpec.push_back( OrderSpec { ou::tf::OrderType::Limit, ou::tf::OrderSide::Sell, ( mid + 1 + offset( rng ) ) * 0.01, dt } );
+        }
+        vLive.emplace_back( id, dt );
+      }
+      Event event( Event::EType::Submit, dt );
+      event.idOrder = id;
+      vEvent.push_back( event );
+    }
+
+    if ( !vLive.empty() && ( nRate > pct( rng ) ) ) {
+      const size_t ixLive( rng() % vLive.size() );
+      if ( ( dt - vLive[ ixLive ].second ) > pt::seconds( 1 ) ) {
+        Event event( Event::EType::Cancel, dt );
+        event.idOrder = vLive[ ixLive ].first;
+        vEvent.push_back( event );
+        vLive[ ixLive ] = vLive.back();
+        vLive.pop_back();
+      }
+    }
+
+    Event quote( Event::EType::Quote, dt );
+    quote.quote = ou::tf::Quote( dt, bid, size( rng ), ask, size( rng ) );
+    vEvent.push_back( quote );
+
+    Event trade( Event::EType::Trade, dt );
+    trade.trade = ou::tf::Trade( dt, ( 500 > pct( rng ) ) ? bid : ask, size( rng ) / 4 + 1 );
+    vEvent.push_back( trade );
+  }
+}
+
+struct Counter {
+  size_t nFills;
+  size_t nQuantity;
+  size_t nCancelled;
+  size_t nNotFound;
+  double dblNotional;
+  std::vector<Order::pOrder_t>& vOrder;
+  Counter( std::vector<Order::pOrder_t>& vOrder_ )
+  : nFills {}, nQuantity {}, nCancelled {}, nNotFound {}, dblNotional {}, vOrder( vOrder_ ) {}
+  void HandleFill( Order::idOrder_t id, const ou::tf::Execution& exec ) {
+    nFills++;
+    nQuantity += exec.GetSize();
+    dblNotional += exec.GetPrice() * exec.GetSize();
+    vOrder[ id ]->ReportExecution( exec );
+  }
+  void HandleCancelled( Order::idOrder_t ) { nCancelled++; }
+  void HandleNoOrderFound( Order::idOrder_t ) { nNotFound++; }
+  void HandleCommission( Order::idOrder_t, double ) {}
+};
+
+void Replay( const std::string& sLabel, ou::tf::sim::OrderExecution::EMatching eMatching, bool bQueuePosition,
+  size_t nQuotes, const vEvent_t& vEvent, const vOrderSpec_t& vOrderSpec
+) {
+
+  ou::tf::Instrument::pInstrument_t pInstrument(
+    std::make_shared<ou::tf::Instrument>( "SPY", ou::tf::InstrumentType::Stock, "SMART" ) );
+
+  // fresh orders for each run, they carry fill state
+  std::vector<Order::pOrder_t> vOrder( 1 );
+  for ( size_t id = 1; id < vOrderSpec.size(); id++ ) {
+    const OrderSpec& spec( vOrderSpec[ id ] );
+    const Order::TableRowDef row(
+      id, 0, "SPY", "", ou::tf::OrderStatus::Created, spec.eType, spec.eSide,
+      spec.dblPrice, 0.0, 0.0, 100, 100, 0, 0.0, 0.0, spec.dt, spec.dt, pt::not_a_date_time );
+    vOrder.push_back( std::make_shared<Order>( row, pInstrument ) );
+  }
+
+  Counter counter( vOrder );
+
+  ou::tf::sim::OrderExecution oe;
+  oe.SetOnOrderFill( fastdelegate::MakeDelegate( &counter, &Counter::HandleFill ) );
+  oe.SetOnOrderCancelled( fastdelegate::MakeDelegate( &counter, &Counter::HandleCancelled ) );
+  oe.SetOnNoOrderFound( fastdelegate::MakeDelegate( &counter, &Counter::HandleNoOrderFound ) );
+  oe.SetOnCommission( fastdelegate::MakeDelegate( &counter, &Counter::HandleCommission ) );
+  oe.SetMatching( eMatching, 0.01, bQueuePosition );
+
+  const auto start = std::chrono::steady_clock::now();
+  for ( const Event& event: vEvent ) {
+    switch ( event.eType ) {
+      case Event::EType::Quote:
+        oe.NewQuote( event.quote );
+        break;
+      case Event::EType::Trade:
+        oe.NewTrade( event.trade );
+        break;
+      case Event::EType::Depth:
+        oe.NewDepthByOrder( event.depth );
+        break;
+      case Event::EType::Submit:
+        ou::TimeSource::GlobalInstance().ForceSimulationTime( event.dt );
+        vOrder[ event.idOrder ]->SetSendingToProvider();
+        oe.SubmitOrder( vOrder[ event.idOrder ] );
+        break;
+      case Event::EType::Cancel:
+        ou::TimeSource::GlobalInstance().ForceSimulationTime( event.dt );
+        oe.CancelOrder( event.idOrder );
+        break;
+    }
+  }
+  const std::chrono::nanoseconds ns( std::chrono::steady_clock::now() - start );
+
+  std::cout
+    << sLabel
+    << ": " << ns.count() / nQuotes << " ns/quote step"
+    << ", orders " << vOrder.size() - 1
+    << ", fills " << counter.nFills
+    << ", quantity " << counter.nQuantity
+    << ", vwap " << ( ( 0 == counter.nQuantity ) ? 0.0 : counter.dblNotional / counter.nQuantity )
+    << ", cancelled " << counter.nCancelled
+    << ", not found " << counter.nNotFound
+    << std::endl;
+}
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nQuotes = ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 300'000;
+  const size_t nResting = ( 2 < argc ) ? std::stoul( argv[ 2 ] ) : 200;
+  const int nRate = ( 3 < argc ) ? std::stoi( argv[ 3 ] ) : 50;
+
+  boost::log::core::get()->set_filter( boost::log::trivial::severity >= boost::log::trivial::warning );
+
+  vEvent_t vEvent;
+  vOrderSpec_t vOrderSpec;
+  Record( nQuotes, nResting, nRate, vEvent, vOrderSpec );
+
+  std::cout << nQuotes << " quotes, " << vEvent.size() << " events, <= " << nResting << " resting" << std::endl;
+
+  using EMatching = ou::tf::sim::OrderExecution::EMatching;
+  Replay( "legacy    ", EMatching::Queue, false, nQuotes, vEvent, vOrderSpec );
+  Replay( "book      ", EMatching::Book,  false, nQuotes, vEvent, vOrderSpec );
+  Replay( "book+queue", EMatching::Book,  true,  nQuotes, vEvent, vOrderSpec );
+
+  return EXIT_SUCCESS;
+}
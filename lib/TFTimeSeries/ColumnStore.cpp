@@ -0,0 +1,320 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    ColumnStore.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFTimeSeries
+ * Created: October 17, 2026 11:20
+ */
+
+#include <cmath>
+#include <limits>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+
+#include "ColumnStore.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace cs { // column store
+
+namespace {
+  static const char rchMagic[ 4 ] = { 'O', 'U', 'C', 'S' };
+  static const uint16_t nVersion = 1;
+  static const uint32_t nBlock = 1024;
+  static const int32_t nMaxDigits = 8;
+
+  static const boost::posix_time::ptime dtEpoch( boost::gregorian::date( 1970, 1, 1 ) );
+
+  size_t Align( size_t n ) { return ( n + 7 ) & ~size_t( 7 ); }
+}
+
+int64_t ToNanoseconds( const boost::posix_time::ptime& dt ) {
+  return ( dt - dtEpoch ).total_nanoseconds();
+}
+
+boost::posix_time::ptime FromNanoseconds( int64_t ns ) {
+  static const int64_t nsPerSecond( 1000000000 );
+  static const int64_t nTicksPerSecond( boost::posix_time::time_duration::ticks_per_second() );
+  int64_t nSeconds( ns / nsPerSecond );
+  int64_t nsFraction( ns % nsPerSecond );
+  if ( 0 > nsFraction ) { // floor, so times before the epoch truncate toward the earlier tick as well
+    nSeconds--;
+    nsFraction += nsPerSecond;
+  }
+  const int64_t nTicks( ( nTicksPerSecond >= nsPerSecond )
+    ? nsFraction * ( nTicksPerSecond / nsPerSecond )
+    : nsFraction / ( nsPerSecond / nTicksPerSecond ) );
+  return dtEpoch + boost::posix_time::seconds( nSeconds ) + boost::posix_time::time_duration( 0, 0, 0, nTicks );
+}
+
+// ==== Writer
+
+Writer::Writer( EDatum eDatum, size_t nPrices, size_t nSizes )
+: m_eDatum( eDatum ), m_nPrices( nPrices ), m_nSizes( nSizes )
+{
+  assert( max_columns >= ( 1 + nPrices + nSizes ) );
+}
+
+void Writer::Clear() {
+  m_vTime.clear();
+  m_vPrice.clear();
+  m_vSize.clear();
+}
+
+void Writer::Append( int64_t nsTime, const double* rPrice, const uint64_t* rSize ) {
+  m_vTime.push_back( nsTime );
+  m_vPrice.insert( m_vPrice.end(), rPrice, rPrice + m_nPrices );
+  m_vSize.insert( m_vSize.end(), rSize, rSize + m_nSizes );
+}
+
+void Writer::Save( const std::string& sPath ) const {
+
+  const size_t nRows( m_vTime.size() );
+
+  // fewest digits which represent every price exactly, a price needing more is not rounded silently
+  int32_t nDigits {};
+  double dblScale( 1.0 );
+  size_t ixInexact {}; // first price not exact at the current scale, those before it stay exact as the scale grows
+  for ( ; ; nDigits++, dblScale *= 10.0 ) {
+    for ( ; ixInexact < m_vPrice.size(); ixInexact++ ) {
+      const double scaled( m_vPrice[ ixInexact ] * dblScale );
+      if ( 1e-6 < std::abs( scaled - std::round( scaled ) ) ) break;
+    }
+    if ( m_vPrice.size() == ixInexact ) break;
+    if ( nMaxDigits == nDigits ) {
+      throw std::runtime_error(
+        "cs::Writer::Save price " + std::to_string( m_vPrice[ ixInexact ] )
+        + " at row " + std::to_string( ixInexact / m_nPrices )
+        + " is not exact in " + std::to_string( nMaxDigits ) + " digits: " + sPath );
+    }
+  }
+
+  std::vector<int64_t> vScaled( m_vPrice.size() );
+  for ( size_t ix = 0; ix < m_vPrice.size(); ix++ ) {
+    const double scaled( std::round( m_vPrice[ ix ] * dblScale ) );
+    if ( std::numeric_limits<int64_t>::max() < std::abs( scaled ) ) {
+      throw std::runtime_error( "cs::Writer::Save price out of range: " + sPath );
+    }
+    vScaled[ ix ] = (int64_t)scaled;
+  }
+
+  Header header;
+  std::memset( &header, 0, sizeof( header ) );
+  std::memcpy( header.rchMagic, rchMagic, sizeof( rchMagic ) );
+  header.nVersion = nVersion;
+  header.eDatum = (uint8_t)m_eDatum;
+  header.nColumns = 1 + m_nPrices + m_nSizes;
+  header.nRows = nRows;
+  header.nBlock = nBlock;
+  header.nDigits = nDigits;
+
+  // column widths: narrow when everything fits
+  size_t ixOffset( Align( sizeof( Header ) ) );
+
+  header.rColumn[ 0 ].ixOffset = ixOffset;
+  header.rColumn[ 0 ].nWidth = 8;
+  ixOffset = Align( ixOffset + 8 * nRows );
+
+  for ( size_t ixPrice = 0; ixPrice < m_nPrices; ixPrice++ ) {
+    bool bNarrow( true );
+    int64_t prior {};
+    for ( size_t ix = 0; ix < nRows; ix++ ) {
+      const int64_t value( vScaled[ ix * m_nPrices + ixPrice ] );
+      const int64_t delta( value - prior );
+      if ( ( std::numeric_limits<int32_t>::min() > delta ) || ( std::numeric_limits<int32_t>::max() < delta ) ) {
+        bNarrow = false;
+        break;
+      }
+      prior = value;
+    }
+    Column& column( header.rColumn[ 1 + ixPrice ] );
+    column.ixOffset = ixOffset;
+    column.nWidth = bNarrow ? 4 : 8;
+    ixOffset = Align( ixOffset + column.nWidth * nRows );
+  }
+
+  for ( size_t ixSize = 0; ixSize < m_nSizes; ixSize++ ) {
+    bool bNarrow( true );
+    for ( size_t ix = 0; ix < nRows; ix++ ) {
+      if ( std::numeric_limits<uint32_t>::max() < m_vSize[ ix * m_nSizes + ixSize ] ) {
+        bNarrow = false;
+        break;
+      }
+    }
+    Column& column( header.rColumn[ 1 + m_nPrices + ixSize ] );
+    column.ixOffset = ixOffset;
+    column.nWidth = bNarrow ? 4 : 8;
+    ixOffset = Align( ixOffset + column.nWidth * nRows );
+  }
+
+  header.ixAnchor = ixOffset;
+
+  std::ofstream out( sPath, std::ios::binary | std::ios::trunc );
+  if ( !out ) {
+    throw std::runtime_error( "cs::Writer::Save can not open: " + sPath );
+  }
+
+  auto pad = [&out](){
+    static const char rchZero[ 8 ] {};
+    const size_t n( Align( out.tellp() ) - out.tellp() );
+    out.write( rchZero, n );
+  };
+
+  out.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+  pad();
+
+  out.write( reinterpret_cast<const char*>( m_vTime.data() ), 8 * nRows );
+  pad();
+
+  for ( size_t ixPrice = 0; ixPrice < m_nPrices; ixPrice++ ) {
+    const bool bNarrow( 4 == header.rColumn[ 1 + ixPrice ].nWidth );
+    int64_t prior {};
+    for ( size_t ix = 0; ix < nRows; ix++ ) {
+      const int64_t value( vScaled[ ix * m_nPrices + ixPrice ] );
+      const int64_t delta( value - prior );
+      if ( bNarrow ) {
+        const int32_t delta32( delta );
+        out.write( reinterpret_cast<const char*>( &delta32 ), 4 );
+      }
+      else {
+        out.write( reinterpret_cast<const char*>( &delta ), 8 );
+      }
+      prior = value;
+    }
+    pad();
+  }
+
+  for ( size_t ixSize = 0; ixSize < m_nSizes; ixSize++ ) {
+    const bool bNarrow( 4 == header.rColumn[ 1 + m_nPrices + ixSize ].nWidth );
+    for ( size_t ix = 0; ix < nRows; ix++ ) {
+      const uint64_t size( m_vSize[ ix * m_nSizes + ixSize ] );
+      if ( bNarrow ) {
+        const uint32_t size32( size );
+        out.write( reinterpret_cast<const char*>( &size32 ), 4 );
+      }
+      else {
+        out.write( reinterpret_cast<const char*>( &size ), 8 );
+      }
+    }
+    pad();
+  }
+
+  // anchors: absolute value of each price at the first row of each block
+  for ( size_t ix = 0; ix < nRows; ix += nBlock ) {
+    out.write( reinterpret_cast<const char*>( &vScaled[ ix * m_nPrices ] ), 8 * m_nPrices );
+  }
+
+  if ( !out ) {
+    throw std::runtime_error( "cs::Writer::Save write failed: " + sPath );
+  }
+}
+
+// ==== File
+
+File::File( const std::string& sPath, EDatum eDatum )
+: m_pBase( nullptr ), m_pHeader( nullptr ), m_pAnchor( nullptr )
+, m_nPrices {}, m_nSizes {}, m_dblDivisor( 1.0 )
+{
+  try {
+    m_file = boost::interprocess::file_mapping( sPath.c_str(), boost::interprocess::read_only );
+    m_region = boost::interprocess::mapped_region( m_file, boost::interprocess::read_only );
+  }
+  catch ( const boost::interprocess::interprocess_exception& e ) {
+    throw std::runtime_error( "cs::File can not map " + sPath + ": " + e.what() );
+  }
+
+  const size_t nFileSize( m_region.get_size() );
+  m_pBase = static_cast<const char*>( m_region.get_address() );
+  m_pHeader = reinterpret_cast<const Header*>( m_pBase );
+
+  if ( ( sizeof( Header ) > nFileSize ) || ( 0 != std::memcmp( m_pHeader->rchMagic, rchMagic, sizeof( rchMagic ) ) ) ) {
+    throw std::runtime_error( "cs::File not a column store: " + sPath );
+  }
+  if ( nVersion != m_pHeader->nVersion ) {
+    throw std::runtime_error( "cs::File unknown version: " + sPath );
+  }
+  if ( (uint8_t)eDatum != m_pHeader->eDatum ) {
+    throw std::runtime_error( "cs::File datum type mismatch: " + sPath );
+  }
+
+  switch ( eDatum ) {
+    case EDatum::Quote:
+      m_nPrices = Traits<Quote>::nPrices;
+      m_nSizes = Traits<Quote>::nSizes;
+      break;
+    case EDatum::Trade:
+      m_nPrices = Traits<Trade>::nPrices;
+      m_nSizes = Traits<Trade>::nSizes;
+      break;
+    case EDatum::Bar:
+      m_nPrices = Traits<Bar>::nPrices;
+      m_nSizes = Traits<Bar>::nSizes;
+      break;
+    default:
+      throw std::runtime_error( "cs::File unknown datum type: " + sPath );
+  }
+
+  const size_t nRows( m_pHeader->nRows );
+  if ( ( ( 1 + m_nPrices + m_nSizes ) != m_pHeader->nColumns ) || ( 0 == m_pHeader->nBlock ) ) {
+    throw std::runtime_error( "cs::File bad header: " + sPath );
+  }
+  for ( size_t ix = 0; ix < m_pHeader->nColumns; ix++ ) {
+    const Column& column( m_pHeader->rColumn[ ix ] );
+    if ( ( ( 4 != column.nWidth ) && ( 8 != column.nWidth ) ) || ( nFileSize < ( column.ixOffset + column.nWidth * nRows ) ) ) {
+      throw std::runtime_error( "cs::File truncated column: " + sPath );
+    }
+  }
+  const size_t nBlocks( ( nRows + m_pHeader->nBlock - 1 ) / m_pHeader->nBlock );
+  if ( nFileSize < ( m_pHeader->ixAnchor + 8 * m_nPrices * nBlocks ) ) {
+    throw std::runtime_error( "cs::File truncated anchors: " + sPath );
+  }
+
+  m_pAnchor = reinterpret_cast<const int64_t*>( m_pBase + m_pHeader->ixAnchor );
+  if ( ( 0 > m_pHeader->nDigits ) || ( nMaxDigits < m_pHeader->nDigits ) ) {
+    throw std::runtime_error( "cs::File bad price scale: " + sPath );
+  }
+  // 10^-n is not exact in binary, so multiplying by it does not return the written price
+  for ( int32_t nDigits = 0; nDigits < m_pHeader->nDigits; nDigits++ ) {
+    m_dblDivisor *= 10.0;
+  }
+}
+
+File::~File() {}
+
+void File::Prices( size_t ix, int64_t* rPrice ) const {
+  assert( ix < m_pHeader->nRows );
+  const size_t ixBlock( ix / m_pHeader->nBlock );
+  const size_t ixFirst( ixBlock * m_pHeader->nBlock );
+  const int64_t* pAnchor( m_pAnchor + ixBlock * m_nPrices );
+  for ( size_t ixPrice = 0; ixPrice < m_nPrices; ixPrice++ ) {
+    int64_t value( pAnchor[ ixPrice ] );
+    for ( size_t ixRow = ixFirst + 1; ixRow <= ix; ixRow++ ) {
+      value += PriceDelta( ixPrice, ixRow );
+    }
+    rPrice[ ixPrice ] = value;
+  }
+}
+
+size_t File::LowerBound( int64_t nsTime ) const {
+  const int64_t* pTime( reinterpret_cast<const int64_t*>( m_pBase + m_pHeader->rColumn[ 0 ].ixOffset ) );
+  return std::lower_bound( pTime, pTime + m_pHeader->nRows, nsTime ) - pTime;
+}
+
+} // namespace cs
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,305 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    ColumnStore.h
+ * Author:  raymond@burkholder.net
+ * Project: TFTimeSeries
+ * Created: October 17, 2026 11:20
+ */
+
+#pragma once
+
+// memory mapped columnar storage for replay, one symbol-day per file
+//   time:   int64 nanoseconds since 1970-01-01
+//   prices: integers scaled by 10^digits, delta encoded, with an absolute anchor every block of rows,
+//           the fewest digits, at most 8, which hold every price exactly, otherwise Save throws
+//   sizes:  plain unsigned
+// the reader maps the file and decodes on access, pages are brought in by the os as replay proceeds
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "DatedDatum.h"
+#include "TimeSeries.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace cs { // column store
+
+enum class EDatum: uint8_t { Unknown = 0, Quote = 1, Trade = 2, Bar = 3 };
+
+static const size_t max_columns = 8;
+
+struct Column {
+  uint64_t ixOffset; // from start of file
+  uint8_t nWidth;    // bytes per entry
+  uint8_t rchPad[7];
+};
+
+struct Header {     // all sections are 8 byte aligned
+  char rchMagic[4]; // OUCS
+  uint16_t nVersion;
+  uint8_t eDatum;
+  uint8_t nColumns; // time, prices, sizes
+  uint64_t nRows;
+  uint32_t nBlock;  // rows per price anchor
+  int32_t nDigits;  // price scale
+  uint64_t ixAnchor; // nBlocks x nPrices int64 absolute values
+  Column rColumn[ max_columns ];
+};
+
+int64_t ToNanoseconds( const boost::posix_time::ptime& );
+// to the resolution of ptime: microseconds, unless boost is built with BOOST_DATE_TIME_POSIX_TIME_STD_CONFIG,
+//   finer times, as appended directly to a Writer, are truncated toward the earlier tick
+boost::posix_time::ptime FromNanoseconds( int64_t );
+
+// ==== datum column layout
+
+template<typename T> struct Traits;
+
+template<> struct Traits<Quote> {
+  static const EDatum datum = EDatum::Quote;
+  static const size_t nPrices = 2;
+  static const size_t nSizes = 2;
+  static void Split( const Quote& quote, double* rPrice, uint64_t* rSize ) {
+    rPrice[ 0 ] = quote.Bid(); rPrice[ 1 ] = quote.Ask();
+    rSize[ 0 ] = quote.BidSize(); rSize[ 1 ] = quote.AskSize();
+  }
+  static Quote Compose( const Quote::dt_t dt, const double* rPrice, const uint64_t* rSize ) {
+    return Quote( dt, rPrice[ 0 ], rSize[ 0 ], rPrice[ 1 ], rSize[ 1 ] );
+  }
+};
+
+template<> struct Traits<Trade> {
+  static const EDatum datum = EDatum::Trade;
+  static const size_t nPrices = 1;
+  static const size_t nSizes = 1;
+  static void Split( const Trade& trade, double* rPrice, uint64_t* rSize ) {
+    rPrice[ 0 ] = trade.Price();
+    rSize[ 0 ] = trade.Volume();
+  }
+  static Trade Compose( const Trade::dt_t dt, const double* rPrice, const uint64_t* rSize ) {
+    return Trade( dt, rPrice[ 0 ], rSize[ 0 ] );
+  }
+};
+
+template<> struct Traits<Bar> {
+  static const EDatum datum = EDatum::Bar;
+  static const size_t nPrices = 4;
+  static const size_t nSizes = 1;
+  static void Split( const Bar& bar, double* rPrice, uint64_t* rSize ) {
+    rPrice[ 0 ] = bar.Open(); rPrice[ 1 ] = bar.High(); rPrice[ 2 ] = bar.Low(); rPrice[ 3 ] = bar.Close();
+    rSize[ 0 ] = bar.Volume();
+  }
+  static Bar Compose( const Bar::dt_t dt, const double* rPrice, const uint64_t* rSize ) {
+    return Bar( dt, rPrice[ 0 ], rPrice[ 1 ], rPrice[ 2 ], rPrice[ 3 ], rSize[ 0 ] );
+  }
+};
+
+// ==== Writer: accumulates a series in memory, encodes on Save
+
+class Writer {
+public:
+
+  Writer( EDatum, size_t nPrices, size_t nSizes );
+
+  size_t Size() const { return m_vTime.size(); }
+  void Clear();
+
+  void Append( int64_t nsTime, const double* rPrice, const uint64_t* rSize );
+
+  void Save( const std::string& sPath ) const; // throws std::runtime_error, including for a price not exact in 8 digits
+
+protected:
+private:
+
+  const EDatum m_eDatum;
+  const size_t m_nPrices;
+  const size_t m_nSizes;
+
+  std::vector<int64_t> m_vTime;
+  std::vector<double> m_vPrice;   // row major, m_nPrices per row
+  std::vector<uint64_t> m_vSize;  // row major, m_nSizes per row
+};
+
+// ==== File: read only mapping of a column store
+
+class File {
+public:
+
+  File( const std::string& sPath, EDatum ); // throws std::runtime_error
+  ~File();
+
+  size_t Rows() const { return m_pHeader->nRows; }
+  size_t Prices() const { return m_nPrices; }
+  size_t Sizes() const { return m_nSizes; }
+  double Divisor() const { return m_dblDivisor; } // divide the decoded integer by this to obtain the price, 10^digits exactly
+
+  int64_t Time( size_t ix ) const {
+    return reinterpret_cast<const int64_t*>( m_pBase + m_pHeader->rColumn[ 0 ].ixOffset )[ ix ];
+  }
+  int64_t PriceDelta( size_t ixPrice, size_t ix ) const {
+    const Column& column( m_pHeader->rColumn[ 1 + ixPrice ] );
+    const char* p = m_pBase + column.ixOffset;
+    return ( 4 == column.nWidth )
+      ? reinterpret_cast<const int32_t*>( p )[ ix ]
+      : reinterpret_cast<const int64_t*>( p )[ ix ];
+  }
+  uint64_t Size( size_t ixSize, size_t ix ) const {
+    const Column& column( m_pHeader->rColumn[ 1 + m_nPrices + ixSize ] );
+    const char* p = m_pBase + column.ixOffset;
+    return ( 4 == column.nWidth )
+      ? reinterpret_cast<const uint32_t*>( p )[ ix ]
+      : reinterpret_cast<const uint64_t*>( p )[ ix ];
+  }
+
+  void Prices( size_t ix, int64_t* rPrice ) const; // random access, decodes from the nearest anchor
+  size_t LowerBound( int64_t nsTime ) const; // first row at or after
+
+protected:
+private:
+
+  boost::interprocess::file_mapping m_file;
+  boost::interprocess::mapped_region m_region;
+
+  const char* m_pBase;
+  const Header* m_pHeader;
+  const int64_t* m_pAnchor;
+
+  size_t m_nPrices;
+  size_t m_nSizes;
+  double m_dblDivisor;
+};
+
+} // namespace cs
+
+// ==== read only view, with the read interface of TimeSeries<T>
+
+template<typename T>
+class ColumnStoreView {
+public:
+
+  using datum_t = T;
+  using dt_t = typename datum_t::dt_t;
+  using size_type = size_t;
+  using traits_t = cs::Traits<T>;
+
+  ColumnStoreView( const std::string& sPath )
+  : m_file( sPath, traits_t::datum ), m_ix {}, m_sName( sPath ) {}
+
+  size_type Size() const { return m_file.Rows(); }
+
+  void SetName( const std::string& sName ) { m_sName = sName; }
+  const std::string& GetName() const { return m_sName; }
+
+  T At( size_type ix ) const {
+    assert( ix < m_file.Rows() );
+    int64_t rPrice[ traits_t::nPrices ];
+    m_file.Prices( ix, rPrice );
+    return Compose( ix, rPrice );
+  }
+
+  T operator[]( size_type ix ) const { return At( ix ); }
+
+  size_type AtOrAfter( const dt_t& dt ) const { return m_file.LowerBound( cs::ToNanoseconds( dt ) ); }
+
+  // sequential cursor, as used by MergeCarrier, pointer is valid until the next call
+  const T* First() {
+    m_ix = 0;
+    if ( 0 == m_file.Rows() ) return nullptr;
+    m_file.Prices( 0, m_rPrice );
+    m_datum = Compose( 0, m_rPrice );
+    return &m_datum;
+  }
+
+  const T* Next() {
+    if ( m_file.Rows() <= ( m_ix + 1 ) ) return nullptr;
+    ++m_ix;
+    for ( size_t ix = 0; ix < traits_t::nPrices; ix++ ) {
+      m_rPrice[ ix ] += m_file.PriceDelta( ix, m_ix );
+    }
+    m_datum = Compose( m_ix, m_rPrice );
+    return &m_datum;
+  }
+
+  using fForEach_t = std::function<void(const T&)>;
+  void ForEach( fForEach_t&& f ) const {
+    int64_t rPrice[ traits_t::nPrices ] {};
+    const size_t nRows( m_file.Rows() );
+    for ( size_t ix = 0; ix < nRows; ix++ ) {
+      for ( size_t ixPrice = 0; ixPrice < traits_t::nPrices; ixPrice++ ) {
+        rPrice[ ixPrice ] += m_file.PriceDelta( ixPrice, ix ); // row 0 delta is from zero
+      }
+      f( Compose( ix, rPrice ) );
+    }
+  }
+
+  void Load( TimeSeries<T>& series ) const { // materialize, when random write access is required
+    series.Reserve( series.Size() + Size() );
+    ForEach( [&series]( const T& datum ){ series.Append( datum ); } );
+  }
+
+protected:
+private:
+
+  cs::File m_file;
+
+  size_type m_ix;
+  int64_t m_rPrice[ traits_t::nPrices ];
+  T m_datum;
+
+  std::string m_sName;
+
+  T Compose( size_type ix, const int64_t* rScaled ) const {
+    double rPrice[ traits_t::nPrices ];
+    uint64_t rSize[ traits_t::nSizes ];
+    for ( size_t ixPrice = 0; ixPrice < traits_t::nPrices; ixPrice++ ) {
+      rPrice[ ixPrice ] = rScaled[ ixPrice ] / m_file.Divisor(); // a correctly rounded quotient, as the written price
+    }
+    for ( size_t ixSize = 0; ixSize < traits_t::nSizes; ixSize++ ) {
+      rSize[ ixSize ] = m_file.Size( ixSize, ix );
+    }
+    return traits_t::Compose( cs::FromNanoseconds( m_file.Time( ix ) ), rPrice, rSize );
+  }
+
+};
+
+// ==== write a series, or part of one, as a column store file
+
+template<typename T>
+void WriteColumnStore( const std::string& sPath, typename TimeSeries<T>::const_iterator begin, typename TimeSeries<T>::const_iterator end ) {
+  using traits_t = cs::Traits<T>;
+  cs::Writer writer( traits_t::datum, traits_t::nPrices, traits_t::nSizes );
+  double rPrice[ traits_t::nPrices ];
+  uint64_t rSize[ traits_t::nSizes ];
+  for ( typename TimeSeries<T>::const_iterator iter = begin; iter != end; iter++ ) {
+    traits_t::Split( *iter, rPrice, rSize );
+    writer.Append( cs::ToNanoseconds( iter->DateTime() ), rPrice, rSize );
+  }
+  writer.Save( sPath );
+}
+
+template<typename T>
+void WriteColumnStore( const std::string& sPath, const TimeSeries<T>& series ) {
+  WriteColumnStore<T>( sPath, series.begin(), series.end() );
+}
+
+} // namespace tf
+} // namespace ou
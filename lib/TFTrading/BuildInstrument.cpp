@@ -19,6 +19,9 @@
  * Created: Sept 20, 2021, 21:52
  */
 
+#include <vector>
+#include <algorithm>
+
 #include <boost/log/trivial.hpp>
 
 #include <TFIQFeed/BuildInstrument.h>
@@ -33,10 +36,21 @@ namespace tf { // TradeFrame
 
 using pWatch_t = Watch::pWatch_t;
 
+namespace {
+  double Seconds( std::chrono::steady_clock::duration duration ) {
+    return std::chrono::duration<double>( duration ).count();
+  }
+  double Milliseconds( double dblSeconds, size_t n ) { // average
+    return ( 0 == n ) ? 0.0 : ( 1000.0 * dblSeconds / n );
+  }
+}
+
 // basic instrument
 BuildInstrument::BuildInstrument( pProviderIQFeed_t pIQFeed )
 : m_pIQ( std::move( pIQFeed ) )
 , m_bDeleteIterator( false )
+, m_nInFlight {}, m_nMaxInFlight( 50 )
+, m_dblWindow( 5.0 ), m_dblThreshold( 50.0 )
 {
   assert( m_pIQ );
 }
@@ -46,6 +60,8 @@ BuildInstrument::BuildInstrument( pProviderIQFeed_t pIQFeed, pProviderIBTWS_t pI
 : m_pIQ( std::move( pIQFeed ) )
 , m_pIB( std::move( pIB ) )
 , m_bDeleteIterator( false )
+, m_nInFlight {}, m_nMaxInFlight( 50 )
+, m_dblWindow( 5.0 ), m_dblThreshold( 50.0 )
 {
   assert( m_pIQ );
   assert( m_pIB );
@@ -57,7 +73,14 @@ void BuildInstrument::Queue( const std::string& sIQFeedSymbol, fInstrument_t&& f
 
   ou::tf::InstrumentManager& im( ou::tf::InstrumentManager::GlobalInstance() );
 
+  const steady_clock_t::time_point tLoad( steady_clock_t::now() );
   pInstrument = im.LoadInstrument( ou::tf::keytypes::EProviderIQF, sIQFeedSymbol );
+  {
+    std::lock_guard<std::mutex> lock( m_mutexMap );
+    m_stats.dblLoad += Seconds( steady_clock_t::now() - tLoad );
+    if ( pInstrument ) m_stats.nLoaded++;
+  }
+
   if ( pInstrument ) { // skip the build
     //BOOST_LOG_TRIVIAL(debug) << "BuildInstrument::Build existing: " << pInstrument->GetInstrumentName();
     if ( m_pIB ) {
@@ -71,7 +94,10 @@ void BuildInstrument::Queue( const std::string& sIQFeedSymbol, fInstrument_t&& f
 
     {
       std::lock_guard<std::mutex> lock( m_mutexMap );
-      m_mapSymbol.emplace( std::make_pair( sIQFeedSymbol, std::move( fInstrument ) ) );
+      if ( m_mapSymbol.empty() && ( 0 == m_nInFlight ) ) {
+        m_tBurst = steady_clock_t::now();
+      }
+      m_mapSymbol.emplace( std::make_pair( sIQFeedSymbol, Waiting( std::move( fInstrument ) ) ) );
     }
 
     Update();
@@ -91,8 +117,7 @@ void BuildInstrument::Update( mapInProgress_t::iterator iter ) {
 
 void BuildInstrument::Update() {
 
-  bool bDoBuild( false );
-  mapInProgress_t::iterator iterInProgress;
+  std::vector<mapInProgress_t::iterator> vBuild;
 
   {
     std::lock_guard<std::mutex> lock( m_mutexMap );
@@ -102,30 +127,93 @@ void BuildInstrument::Update() {
       m_mapInProgress.erase( m_iterToDelete );
     }
 
-    // 5 may not be important any more as IB manages queue
-    // but why is queue not being replenished?
-    if ( 5 > m_mapInProgress.size() ) { // 5 is set in m_pIB
-      if ( 0 != m_mapSymbol.size() ) {
+    // IB paces the contract requests with its own queue,
+    //   the window keeps fundamentals arriving ahead of that queue
+    while ( ( m_nInFlight < (size_t)m_dblWindow ) && !m_mapSymbol.empty() ) {
 
-        mapSymbol_t::iterator iterSymbol = m_mapSymbol.begin();
+      mapSymbol_t::iterator iterSymbol = m_mapSymbol.begin();
+      auto& [ sIQFeedSymbol, waiting ] = *iterSymbol;
 
-        {
-          auto& [ sIQFeedSymbol_, fInstrument_ ] = *iterSymbol;
-          const std::string sIQFeedSymbol( sIQFeedSymbol_ );
+      if ( m_mapInProgress.end() != m_mapInProgress.find( sIQFeedSymbol ) ) break; // a duplicate, retried on a completion
 
-          auto result = m_mapInProgress.emplace( std::make_pair( sIQFeedSymbol, InProgress( std::move( fInstrument_ ) ) ) );
-          assert( result.second );
-          iterInProgress = result.first;
-          bDoBuild = true;
-        }
+      auto result = m_mapInProgress.emplace( std::make_pair( sIQFeedSymbol, InProgress( std::move( waiting.fInstrument ) ) ) );
+      assert( result.second );
+      m_stats.dblWait += Seconds( result.first->second.tStarted - waiting.tQueued );
+      vBuild.push_back( result.first );
+
+      //BOOST_LOG_TRIVIAL(debug) << "BuildInstrument::Update erase " << iterSymbol->first;
+      m_mapSymbol.erase( iterSymbol );
+      m_nInFlight++;
+    }
+    m_stats.nWindowMax = std::max( m_stats.nWindowMax, m_nInFlight );
+  }
+
+  for ( mapInProgress_t::iterator iterInProgress: vBuild ) {
+    Build( iterInProgress );
+  }
+
+}
+
+void BuildInstrument::Complete( bool bBuilt, const InProgress& ip ) {
+
+  const steady_clock_t::time_point tNow( steady_clock_t::now() );
 
-        //BOOST_LOG_TRIVIAL(debug) << "BuildInstrument::Update erase " << iterSymbol->first;
-        m_mapSymbol.erase( iterSymbol );
+  bool bDrained( false );
+  Stats stats;
+
+  {
+    std::lock_guard<std::mutex> lock( m_mutexMap );
+
+    assert( 0 < m_nInFlight );
+    m_nInFlight--;
+
+    m_stats.dblFundamentals += Seconds( ip.tFundamentals - ip.tStarted );
+    if ( bBuilt ) {
+      m_stats.nBuilt++;
+      if ( m_pIB ) {
+        m_stats.dblContract += Seconds( tNow - ip.tFundamentals );
       }
+      m_dblWindow += ( m_dblWindow < m_dblThreshold ) ? 1.0 : ( 1.0 / m_dblWindow );
+      m_dblWindow = std::min( m_dblWindow, (double)m_nMaxInFlight );
+    }
+    else { // ib timed out, or has no contract
+      m_stats.nFailed++;
+      m_dblThreshold = std::max( 1.0, m_dblWindow / 2.0 );
+      m_dblWindow = m_dblThreshold;
+    }
+
+    if ( ( 0 == m_nInFlight ) && m_mapSymbol.empty() ) {
+      m_stats.dblElapsed += Seconds( tNow - m_tBurst );
+      stats = m_stats;
+      bDrained = true;
     }
   }
 
-  if ( bDoBuild ) Build( iterInProgress );
+  if ( bDrained ) {
+
+    BOOST_LOG_TRIVIAL(info)
+      << "BuildInstrument drained: "
+      << "loaded " << stats.nLoaded << ","
+      << "built " << stats.nBuilt << ","
+      << "failed " << stats.nFailed << ","
+      << "window " << stats.nWindowMax << ","
+      << "load " << Milliseconds( stats.dblLoad, stats.nLoaded + stats.nBuilt + stats.nFailed ) << "ms,"
+      << "wait " << Milliseconds( stats.dblWait, stats.nBuilt + stats.nFailed ) << "ms,"
+      << "fundamentals " << Milliseconds( stats.dblFundamentals, stats.nBuilt + stats.nFailed ) << "ms,"
+      << "contract " << Milliseconds( stats.dblContract, stats.nBuilt ) << "ms,"
+      << "elapsed " << stats.dblElapsed << "s"
+      ;
+
+    InstrumentCache::pInstrumentCache_t pCache( ou::tf::InstrumentManager::GlobalInstance().GetCache() );
+    if ( pCache ) {
+      try {
+        pCache->Save();
+      }
+      catch ( std::runtime_error& e ) {
+        BOOST_LOG_TRIVIAL(error) << "BuildInstrument cache: " << e.what();
+      }
+    }
+  }
 
 }
 
@@ -153,6 +241,8 @@ void BuildInstrument::Build( mapInProgress_t::iterator iterInProgress ) {
 
           //BOOST_LOG_TRIVIAL(debug) << "AcquireFundamentals_done enter: " << iterInProgress->first;
 
+          iterInProgress->second.tFundamentals = steady_clock_t::now();
+
           const ou::tf::Watch::Fundamentals& fundamentals( pWatchOld->GetFundamentals() );
           pInstrument_t pInstrument
             = ou::tf::iqfeed::BuildInstrument( fundamentals );
@@ -194,6 +284,8 @@ void BuildInstrument::Build( mapInProgress_t::iterator iterInProgress ) {
                 //BOOST_LOG_TRIVIAL(debug) << "BuildInstrument::Build contract: " << pInstrument->GetInstrumentName();
                 assert( 0 != pInstrument->GetContract() );
                 m_pIB->Sync( pInstrument );
+                InstrumentCache::pInstrumentCache_t pCache( ou::tf::InstrumentManager::GlobalInstance().GetCache() );
+                if ( pCache ) pCache->Add( pInstrument );
                 //ou::tf::InstrumentManager& im( ou::tf::InstrumentManager::GlobalInstance() );
                 //im.Register( pInstrument );  // is a CallAfter required, or can this run in a thread?
                 iterInProgress->second.fInstrument( pInstrument, true );
@@ -216,6 +308,7 @@ void BuildInstrument::Build( mapInProgress_t::iterator iterInProgress ) {
                     ;
                   iterInProgress->second.fInstrument( nullptr, false );
                 }
+                Complete( bStatus, iterInProgress->second );
                 {
                   std::lock_guard<std::mutex> lock( m_mutexMap );
                   m_mapInProgress.erase( iterInProgress );
@@ -227,8 +320,11 @@ void BuildInstrument::Build( mapInProgress_t::iterator iterInProgress ) {
           else {
             //ou::tf::InstrumentManager& im( ou::tf::InstrumentManager::GlobalInstance() );
             //im.Register( pInstrument );  // is a CallAfter required, or can this run in a thread?
+            InstrumentCache::pInstrumentCache_t pCache( ou::tf::InstrumentManager::GlobalInstance().GetCache() );
+            if ( pCache ) pCache->Add( pInstrument );
             iterInProgress->second.fInstrument( pInstrument, true );
             pInstrument.reset();
+            Complete( true, iterInProgress->second );
             Update( iterInProgress );
           }
           //BOOST_LOG_TRIVIAL(debug) << "AcquireFundamentals_done exit: " << iterInProgress->first;
@@ -242,12 +338,25 @@ void BuildInstrument::Build( mapInProgress_t::iterator iterInProgress ) {
 
 void BuildInstrument::Clear() {
   std::lock_guard<std::mutex> lock( m_mutexMap );
-  assert( 0 == m_mapInProgress.size() );
+  assert( 0 == m_nInFlight );
   m_mapSymbol.clear();
 }
 
 bool BuildInstrument::Active() {
-  return !( m_mapSymbol.empty() && m_mapInProgress.empty() );
+  std::lock_guard<std::mutex> lock( m_mutexMap );
+  return !( m_mapSymbol.empty() && ( 0 == m_nInFlight ) );
+}
+
+void BuildInstrument::SetMaxInFlight( size_t nMaxInFlight ) {
+  std::lock_guard<std::mutex> lock( m_mutexMap );
+  m_nMaxInFlight = std::max<size_t>( 1, nMaxInFlight );
+  m_dblWindow = std::min( m_dblWindow, (double)m_nMaxInFlight );
+  m_dblThreshold = std::min( m_dblThreshold, (double)m_nMaxInFlight );
+}
+
+BuildInstrument::Stats BuildInstrument::GetStats() {
+  std::lock_guard<std::mutex> lock( m_mutexMap );
+  return m_stats;
 }
 
 } // namespace tf
@@ -23,6 +23,7 @@
 
 #include <set>
 #include <map>
+#include <chrono>
 #include <functional>
 
 #include <TFIQFeed/Provider.h>
@@ -35,6 +36,12 @@ namespace ou { // One Unified
 namespace tf { // TradeFrame
 
 // can be run as shared_ptr, queues are thread safe
+// InstrumentManager::LoadInstrument is tried first, which includes the InstrumentCache, when set,
+//   built instruments are added to the cache, which is saved each time the queue drains
+// builds in flight are an adaptive window: starting at 5, grown by one per completed build
+//   until the first failure (ib pacing timeout or unknown contract), then halved on each failure
+//   and grown by 1/window per completion, never more than the maximum
+// the time spent in each phase is summed, and logged as each burst of requests drains
 
 class BuildInstrument {
 public:
@@ -54,21 +61,52 @@ public:
 
   bool Active();
 
+  void SetMaxInFlight( size_t nMaxInFlight ); // default 50
+
+  struct Stats {
+    size_t nLoaded;  // from the database, or the cache
+    size_t nBuilt;
+    size_t nFailed;
+    size_t nWindowMax;
+    double dblLoad;         // seconds, summed: in LoadInstrument
+    double dblWait;         // queued until started
+    double dblFundamentals; // started until fundamentals arrive
+    double dblContract;     // fundamentals until the contract arrives
+    double dblElapsed;      // first queued until drained, per burst
+    Stats()
+    : nLoaded {}, nBuilt {}, nFailed {}, nWindowMax {}
+    , dblLoad {}, dblWait {}, dblFundamentals {}, dblContract {}, dblElapsed {}
+    {}
+  };
+
+  Stats GetStats();
+
 protected:
 private:
 
+  using steady_clock_t = std::chrono::steady_clock;
+
   using pAcquireFundamentals_t = AcquireFundamentals::pAcquireFundamentals_t;
 
   using setSymbol_t = std::set<std::string>;
 
-  using mapSymbol_t = std::map<std::string,fInstrument_t>;
+  struct Waiting {
+    fInstrument_t fInstrument;
+    steady_clock_t::time_point tQueued;
+    Waiting( fInstrument_t&& fInstrument_ )
+    : fInstrument( std::move( fInstrument_ ) ), tQueued( steady_clock_t::now() ) {}
+  };
+
+  using mapSymbol_t = std::map<std::string,Waiting>;
 
   // TODO: need a completion function?
   struct InProgress {
     pAcquireFundamentals_t pAcquireFundamentals;
     fInstrument_t fInstrument;
+    steady_clock_t::time_point tStarted;
+    steady_clock_t::time_point tFundamentals;
     InProgress( fInstrument_t&& fInstrument_ )
-    : fInstrument( std::move( fInstrument_ ) ) {}
+    : fInstrument( std::move( fInstrument_ ) ), tStarted( steady_clock_t::now() ) {}
   };
 
   using mapInProgress_t = std::map<std::string,InProgress>;
@@ -83,12 +121,22 @@ private:
   bool m_bDeleteIterator;
   mapInProgress_t::iterator m_iterToDelete; // used to break the recursive problem when only iqf is available
 
+  size_t m_nInFlight; // started, not complete, a deferred delete is not counted
+  size_t m_nMaxInFlight;
+  double m_dblWindow;
+  double m_dblThreshold; // growth is one per completion below, 1/window above
+
+  steady_clock_t::time_point m_tBurst; // first queued since last drained
+  Stats m_stats;
+
   pProviderIQFeed_t m_pIQ;
   pProviderIBTWS_t m_pIB;
 
   void Update();
   void Update( mapInProgress_t::iterator );
 
+  void Complete( bool bBuilt, const InProgress& ); // adjusts the window, summarizes when drained
+
   void Build( mapInProgress_t::iterator );
 };
 
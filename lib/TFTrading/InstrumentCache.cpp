@@ -0,0 +1,240 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    InstrumentCache.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFTrading
+ * Created: October 17, 2026 20:05
+ */
+
+#include <cstdio>
+#include <cassert>
+#include <fstream>
+#include <stdexcept>
+
+#include <boost/log/trivial.hpp>
+
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/utility.hpp>
+
+#include <boost/date_time/posix_time/time_serialize.hpp>
+
+#include "InstrumentCache.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+namespace {
+
+  const unsigned int nFormat = 1; // increment when Instrument::TableRowDef changes
+
+  // presents an archive as an ou::db action, so the row is archived in Fields() order
+  template<typename Archive>
+  struct ArchiveFields {
+    Archive& ar;
+    ArchiveFields( Archive& ar_ ): ar( ar_ ) {}
+    template<typename T>
+    void Field( const std::string&, T& var ) { ar & var; }
+    template<typename T>
+    void Field( const std::string&, T& var, const std::string& ) { ar & var; }
+  };
+
+  bool Constructible( InstrumentType::EInstrumentType eType ) { // as accepted by Instrument( const TableRowDef& )
+    switch ( eType ) {
+      case InstrumentType::Stock:
+      case InstrumentType::Index:
+      case InstrumentType::Option:
+      case InstrumentType::FuturesOption:
+      case InstrumentType::Future:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  bool Expired( const Instrument::TableRowDef& row, const boost::posix_time::ptime& dtNow ) {
+    if ( !row.dtExpiry.is_special() ) {
+      return row.dtExpiry < dtNow;
+    }
+    if ( ( 0 != row.nYear ) && ( 0 != row.nMonth ) && ( 0 != row.nDay ) ) {
+      return boost::gregorian::date( row.nYear, row.nMonth, row.nDay ) < dtNow.date();
+    }
+    return false;
+  }
+
+}
+
+template<typename Archive>
+void InstrumentCache::Entry::serialize( Archive& ar, const unsigned int ) {
+  ArchiveFields<Archive> fields( ar );
+  row.Fields( fields );
+  ar & mapAlternateNames;
+  ar & dtCached;
+}
+
+InstrumentCache::InstrumentCache( const std::string& sFileName, bool bRequireContract, unsigned int nMaxAgeDays )
+: m_sFileName( sFileName )
+, m_bRequireContract( bRequireContract )
+, m_bChanged( false )
+{
+  assert( !m_sFileName.empty() );
+  Read( nMaxAgeDays );
+}
+
+InstrumentCache::~InstrumentCache() {
+  try {
+    Save();
+  }
+  catch ( std::exception& e ) {
+    BOOST_LOG_TRIVIAL(error) << "InstrumentCache::~InstrumentCache: " << m_sFileName << " " << e.what();
+  }
+}
+
+void InstrumentCache::Read( unsigned int nMaxAgeDays ) {
+
+  std::ifstream ifs( m_sFileName, std::ios::binary );
+  if ( !ifs.is_open() ) return; // first use
+
+  mapEntry_t mapEntry;
+  try {
+    boost::archive::binary_iarchive ia( ifs );
+    unsigned int nFormat_;
+    ia >> nFormat_;
+    if ( nFormat != nFormat_ ) {
+      BOOST_LOG_TRIVIAL(warning) << "InstrumentCache::Read: " << m_sFileName << " format " << nFormat_ << " ignored";
+      return;
+    }
+    ia >> mapEntry;
+  }
+  catch ( std::exception& e ) {
+    BOOST_LOG_TRIVIAL(warning) << "InstrumentCache::Read: " << m_sFileName << " ignored, " << e.what();
+    return;
+  }
+
+  const boost::posix_time::ptime dtNow( boost::posix_time::second_clock::universal_time() );
+  const boost::posix_time::ptime dtOldest( dtNow - boost::gregorian::days( nMaxAgeDays ) );
+
+  size_t nDropped {};
+  for ( mapEntry_t::value_type& vt: mapEntry ) {
+    const Entry& entry( vt.second );
+    if ( ( entry.dtCached < dtOldest ) || Expired( entry.row, dtNow ) ) {
+      nDropped++;
+    }
+    else {
+      Index( vt.first, entry );
+      m_mapEntry.emplace( std::move( vt ) );
+    }
+  }
+  m_bChanged = ( 0 < nDropped );
+
+  BOOST_LOG_TRIVIAL(info)
+    << "InstrumentCache::Read: " << m_sFileName << " "
+    << m_mapEntry.size() << " loaded, " << nDropped << " dropped";
+}
+
+void InstrumentCache::Index( const std::string& sName, const Entry& entry ) {
+  for ( const mapAlternateNames_t::value_type& vt: entry.mapAlternateNames ) {
+    m_mapAlternate[ keyAlternate_t( vt.first, vt.second ) ] = sName;
+  }
+}
+
+InstrumentCache::pInstrument_t InstrumentCache::Load( eidProvider_t idProvider, const std::string& sAlternateName ) const {
+
+  pInstrument_t pInstrument;
+
+  std::lock_guard<std::mutex> lock( m_mutex );
+
+  mapAlternate_t::const_iterator iterAlternate = m_mapAlternate.find( keyAlternate_t( idProvider, sAlternateName ) );
+  if ( m_mapAlternate.end() != iterAlternate ) {
+    mapEntry_t::const_iterator iterEntry = m_mapEntry.find( iterAlternate->second );
+    assert( m_mapEntry.end() != iterEntry );
+    const Entry& entry( iterEntry->second );
+    if ( !m_bRequireContract || ( 0 != entry.row.nIBContract ) ) {
+      pInstrument = std::make_shared<Instrument>( entry.row );
+      for ( const mapAlternateNames_t::value_type& vt: entry.mapAlternateNames ) {
+        pInstrument->SetAlternateName( vt.first, vt.second );
+      }
+    }
+  }
+
+  return pInstrument;
+}
+
+void InstrumentCache::Add( pInstrument_cref pInstrument ) {
+
+  assert( pInstrument );
+  if ( !Constructible( pInstrument->GetInstrumentType() ) ) return;
+
+  Entry entry;
+  entry.row = pInstrument->GetRow();
+  pInstrument->ScanAlternateNames(
+    [&entry]( eidProvider_t idProvider, const std::string& sAlternate, const std::string& ){
+      entry.mapAlternateNames[ idProvider ] = sAlternate;
+    } );
+  entry.dtCached = boost::posix_time::second_clock::universal_time();
+
+  const std::string& sName( pInstrument->GetInstrumentName() );
+
+  std::lock_guard<std::mutex> lock( m_mutex );
+
+  mapEntry_t::iterator iterEntry = m_mapEntry.find( sName );
+  if ( m_mapEntry.end() == iterEntry ) {
+    iterEntry = m_mapEntry.emplace( sName, std::move( entry ) ).first;
+  }
+  else {
+    for ( const mapAlternateNames_t::value_type& vt: iterEntry->second.mapAlternateNames ) {
+      m_mapAlternate.erase( keyAlternate_t( vt.first, vt.second ) );
+    }
+    iterEntry->second = std::move( entry );
+  }
+  Index( sName, iterEntry->second );
+  m_bChanged = true;
+}
+
+void InstrumentCache::Save() {
+
+  std::lock_guard<std::mutex> lock( m_mutex );
+
+  if ( !m_bChanged ) return;
+
+  const std::string sTemp( m_sFileName + ".tmp" ); // replaced in one step, a partial write leaves the previous file
+  {
+    std::ofstream ofs( sTemp, std::ios::binary | std::ios::trunc );
+    if ( !ofs.is_open() ) {
+      throw std::runtime_error( "InstrumentCache::Save: can not open " + sTemp );
+    }
+    boost::archive::binary_oarchive oa( ofs );
+    oa << nFormat;
+    oa << m_mapEntry;
+  }
+  if ( 0 != std::rename( sTemp.c_str(), m_sFileName.c_str() ) ) {
+    throw std::runtime_error( "InstrumentCache::Save: can not rename " + sTemp );
+  }
+  m_bChanged = false;
+
+  BOOST_LOG_TRIVIAL(info) << "InstrumentCache::Save: " << m_sFileName << " " << m_mapEntry.size() << " instruments";
+}
+
+size_t InstrumentCache::Size() const {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  return m_mapEntry.size();
+}
+
+} // namespace tf
+} // namespace ou
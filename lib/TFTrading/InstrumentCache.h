@@ -0,0 +1,97 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    InstrumentCache.h
+ * Author:  raymond@burkholder.net
+ * Project: TFTrading
+ * Created: October 17, 2026 20:05
+ */
+
+#pragma once
+
+// persistent cache of resolved instruments, carried from session to session:
+//   * each entry is the instrument row (fundamentals, ib contract id, exchange rules)
+//     plus the alternate names, looked up by any alternate name, typically the iqfeed symbol
+//   * InstrumentManager::LoadInstrument consults the cache after the database,
+//     a hit skips the fundamentals and contract round trips in BuildInstrument
+//   * expired entries, and entries older than the maximum age, are dropped on open
+//   * written as a boost binary archive, on Save(), and on destruction when changed,
+//     a file which can not be read is ignored, the cache is only advisory
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <string>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include "KeyTypes.h"
+#include "Instrument.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+class InstrumentCache {
+public:
+
+  using pInstrumentCache_t = std::shared_ptr<InstrumentCache>;
+  using pInstrument_t = Instrument::pInstrument_t;
+  using pInstrument_cref = Instrument::pInstrument_cref;
+  using eidProvider_t = keytypes::eidProvider_t;
+
+  InstrumentCache(
+    const std::string& sFileName,
+    bool bRequireContract = false, // entries without an ib contract are not returned
+    unsigned int nMaxAgeDays = 30
+    );
+  ~InstrumentCache();
+
+  pInstrument_t Load( eidProvider_t, const std::string& sAlternateName ) const; // constructed, not registered
+  void Add( pInstrument_cref ); // replaces an entry of the same name
+  void Save(); // when changed
+
+  size_t Size() const;
+
+protected:
+private:
+
+  using mapAlternateNames_t = std::map<eidProvider_t, std::string>;
+
+  struct Entry {
+    Instrument::TableRowDef row;
+    mapAlternateNames_t mapAlternateNames;
+    boost::posix_time::ptime dtCached;
+    template<typename Archive> void serialize( Archive&, const unsigned int );
+  };
+
+  using mapEntry_t = std::map<std::string, Entry>; // by instrument name
+  using keyAlternate_t = std::pair<eidProvider_t, std::string>;
+  using mapAlternate_t = std::map<keyAlternate_t, std::string>; // to instrument name
+
+  const std::string m_sFileName;
+  const bool m_bRequireContract;
+
+  mutable std::mutex m_mutex;
+
+  mapEntry_t m_mapEntry;
+  mapAlternate_t m_mapAlternate;
+  bool m_bChanged;
+
+  void Index( const std::string& sName, const Entry& );
+  void Read( unsigned int nMaxAgeDays );
+};
+
+} // namespace tf
+} // namespace ou
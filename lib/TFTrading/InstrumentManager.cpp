@@ -253,11 +253,11 @@ struct InstrumentName {
 
 InstrumentManager::pInstrument_t InstrumentManager::LoadInstrument( keytypes::eidProvider_t idProvider, const idInstrument_t& idInstrument ) {
   pInstrument_t pInstrument;
-  AltNameKey key( idProvider, idInstrument );
-  ou::db::QueryFields<AltNameKey>::pQueryFields_t pExistsQuery
-    = m_pSession->SQL<AltNameKey>( "select instrumentid from altinstrumentnames", key )
-        .Where( "providerid = ? and alternateid = ?" ).NoExecute();
   if ( m_pSession ) {
+    AltNameKey key( idProvider, idInstrument );
+    ou::db::QueryFields<AltNameKey>::pQueryFields_t pExistsQuery
+      = m_pSession->SQL<AltNameKey>( "select instrumentid from altinstrumentnames", key )
+          .Where( "providerid = ? and alternateid = ?" ).NoExecute();
     m_pSession->Bind<AltNameKey>( pExistsQuery );
     InstrumentName result;
     if ( m_pSession->Execute( pExistsQuery ) ) { // should only be once
@@ -266,6 +266,18 @@ InstrumentManager::pInstrument_t InstrumentManager::LoadInstrument( keytypes::ei
       bool bFound = Exists( result.idInstrument, pInstrument );
     }
   }
+  if ( !pInstrument && m_pCache ) {
+    pInstrument = m_pCache->Load( idProvider, idInstrument );
+    if ( pInstrument ) {
+      pInstrument_t pExisting;
+      if ( Exists( pInstrument->GetInstrumentName(), pExisting ) ) { // registered under another alternate name
+        pInstrument = pExisting;
+      }
+      else {
+        Register( pInstrument );
+      }
+    }
+  }
   return pInstrument;
 }
 
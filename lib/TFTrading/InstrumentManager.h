@@ -24,6 +24,7 @@
 #include "KeyTypes.h"
 
 #include "Instrument.h"
+#include "InstrumentCache.h"
 
 namespace ou { // One Unified
 namespace tf { // TradeFrame
@@ -73,6 +74,11 @@ public:
 
   pInstrument_t LoadInstrument( keytypes::eidProvider_t, const idInstrument_t& ); // may have exeption?
 
+  // consulted by LoadInstrument after the database, a hit is registered
+  using pInstrumentCache_t = InstrumentCache::pInstrumentCache_t;
+  void SetCache( pInstrumentCache_t pCache ) { m_pCache = std::move( pCache ); }
+  pInstrumentCache_t GetCache() const { return m_pCache; }
+
   template<typename F> void ScanOptions( F f, idInstrument_cref, boost::uint16_t year, boost::uint16_t month, boost::uint16_t day );
 
   virtual void AttachToSession( ou::db::Session* pSession );
@@ -107,6 +113,8 @@ private:
 
   std::mutex m_mutexLoadInstrument;
 
+  pInstrumentCache_t m_pCache;
+
   void SaveAlternateInstrumentName(
     const keytypes::eidProvider_t&,
     const keytypes::idInstrument_t&, const keytypes::idInstrument_t&,
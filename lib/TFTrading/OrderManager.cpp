@@ -14,6 +14,7 @@
 #include <OUCommon/TimeSource.h>
 
 #include "OrderManager.h"
+#include "RiskManager.h"
 
 namespace ou { // One Unified
 namespace tf { // TradeFrame
@@ -22,7 +23,9 @@ namespace tf { // TradeFrame
 // OrderManager
 //
 
-OrderManager::OrderManager() {
+OrderManager::OrderManager()
+: m_idExecutionLast {}
+{
 }
 
 OrderManager::~OrderManager() {
@@ -112,8 +115,7 @@ bool OrderManager::ConstructOrder( pOrder_t& pOrder ) {
 
       if ( nullptr != m_pSession ) { // add to database
         assert( 0 != pOrder->GetRow().idPosition );
-        ou::db::QueryFields<Order::TableRowDef>::pQueryFields_t pQuery
-          = m_pSession->Insert<Order::TableRowDef>( const_cast<Order::TableRowDef&>( pOrder->GetRow() ) );
+        m_pSession->WriteInsert( const_cast<Order::TableRowDef&>( pOrder->GetRow() ) );
       }
       bOk = true;
     }
@@ -175,6 +177,12 @@ void OrderManager::PlaceOrder(ProviderInterfaceBase *pProvider, pOrder_t pOrder)
     iterOrders_t iter;
     if ( LocateOrder( pOrder->GetOrderId(), iter ) ) {
       assert( NULL != pProvider );
+      const RiskManager::ECheck eCheck( RiskManager::LocalCommonInstance().Check( *pOrder ) );
+      if ( RiskManager::ECheck::Accept != eCheck ) {
+        std::cout << "OrderManager::PlaceOrder:  " << pOrder->GetOrderId() << " rejected by risk, " << RiskManager::Name( eCheck ) << std::endl;
+        ReportErrors( pOrder->GetOrderId(), OrderError::Rejected );
+        return;
+      }
       iter->second.pProvider = pProvider;
       pOrder->SetSendingToProvider();
       pProvider->PlaceOrder( pOrder );
@@ -186,14 +194,14 @@ void OrderManager::PlaceOrder(ProviderInterfaceBase *pProvider, pOrder_t pOrder)
             , pOrder->GetOrderId(), pOrder->GetRow().eOrderStatus, pOrder->GetRow().dtOrderSubmitted
             , pOrder->GetRow().dblSignalPrice, pOrder->GetRow().sDescription
           );
-        ou::db::QueryFields<OrderManagerQueries::UpdateAtPlaceOrder1>::pQueryFields_t pQuery
-          = m_pSession->SQL<OrderManagerQueries::UpdateAtPlaceOrder1>( // todo:  cache this query
+        m_pSession->Write<OrderManagerQueries::UpdateAtPlaceOrder1>(
             "update orders set"
             " timeinforce=?, goodtilldate=?, goodaftertime=?"
             ", parentid=?, transmit=?, outsiderth=?"
             ", orderstatus=?, datetimesubmitted=?"
             ", signalprice=?, description=?"
-            , update ).Where( "orderid=?" );
+            " where orderid=?"
+            , update );
       }
     }
     else {
@@ -233,9 +241,8 @@ void OrderManager::UpdateOrder(ProviderInterfaceBase *pProvider, pOrder_t pOrder
       if ( nullptr != m_pSession ) {
         OrderManagerQueries::UpdateAtPlaceOrder2
           update( pOrder->GetOrderId(), pOrder->GetRow().dblPrice1, pOrder->GetRow().dblPrice2 );
-        ou::db::QueryFields<OrderManagerQueries::UpdateAtPlaceOrder2>::pQueryFields_t pQuery
-          = m_pSession->SQL<OrderManagerQueries::UpdateAtPlaceOrder2>( // todo:  cache this query
-            "update orders set price1=?, price2=?", update ).Where( "orderid=?" );
+        m_pSession->Write<OrderManagerQueries::UpdateAtPlaceOrder2>(
+            "update orders set price1=?, price2=? where orderid=?", update );
       }
     }
     else {
@@ -358,12 +365,12 @@ void OrderManager::ReportCancellation( idOrder_t nOrderId ) {
     if ( LocateOrder( nOrderId, iter ) ) {
       pOrder_t pOrder = iter->second.pOrder;
       pOrder->MarkAsCancelled();
+      RiskManager::LocalCommonInstance().Release( *pOrder );
       if ( nullptr != m_pSession ) {
         OrderManagerQueries::UpdateAtOrderClose
           close( pOrder->GetOrderId(), pOrder->GetRow().eOrderStatus, pOrder->GetRow().dtOrderClosed );
-        ou::db::QueryFields<OrderManagerQueries::UpdateAtOrderClose>::pQueryFields_t pQuery
-          = m_pSession->SQL<OrderManagerQueries::UpdateAtOrderClose>( // todo:  cache this query
-            "update orders set orderstatus=?, datetimeclosed=?", close ).Where( "orderid=?" );
+        m_pSession->Write<OrderManagerQueries::UpdateAtOrderClose>(
+            "update orders set orderstatus=?, datetimeclosed=? where orderid=?", close );
       }
     }
     else {
@@ -399,7 +406,7 @@ namespace OrderManagerQueries {
       dblAverageFillPrice( dblAverageFillPrice_ ), dtClosed( dtClosed_ ) {};
   };
 
-  std::string sUpdateOrderQuery( "update orders set orderstatus=?, quantityremaining=?, quantityfilled=?, averagefillprice=?, datetimeclosed=?" );
+  std::string sUpdateOrderQuery( "update orders set orderstatus=?, quantityremaining=?, quantityfilled=?, averagefillprice=?, datetimeclosed=? where orderid=?" );
 }
 
 void OrderManager::ReportExecution( idOrder_t nOrderId, const Execution& exec) {
@@ -408,6 +415,7 @@ void OrderManager::ReportExecution( idOrder_t nOrderId, const Execution& exec) {
     if ( LocateOrder( nOrderId, iter ) ) {
       pOrder_t pOrder = iter->second.pOrder;
       OrderStatus::EOrderStatus status = pOrder->ReportExecution( exec );
+      RiskManager::LocalCommonInstance().ReportExecution( *pOrder, exec );
       if ( nullptr != m_pSession ) {
         const Order::TableRowDef& row( pOrder->GetRow() );
         switch ( status ) {
@@ -416,28 +424,31 @@ void OrderManager::ReportExecution( idOrder_t nOrderId, const Execution& exec) {
           {
             OrderManagerQueries::UpdateOrder
               order( nOrderId, row.eOrderStatus, row.nQuantityRemaining, row.nQuantityFilled, row.dblAverageFillPrice, ou::TimeSource::LocalCommonInstance().Internal() );
-            ou::db::QueryFields<OrderManagerQueries::UpdateOrder>::pQueryFields_t pQuery
-              = m_pSession->SQL<OrderManagerQueries::UpdateOrder>( // todo:  cache this query
-              OrderManagerQueries::sUpdateOrderQuery, order ).Where( "orderid=?" );
+            m_pSession->Write<OrderManagerQueries::UpdateOrder>( OrderManagerQueries::sUpdateOrderQuery, order );
           }
           break;
         default:
           {
             OrderManagerQueries::UpdateOrder
               order( nOrderId, row.eOrderStatus, row.nQuantityRemaining, row.nQuantityFilled, row.dblAverageFillPrice );
-            ou::db::QueryFields<OrderManagerQueries::UpdateOrder>::pQueryFields_t pQuery
-              = m_pSession->SQL<OrderManagerQueries::UpdateOrder>( // todo:  cache this query
-              OrderManagerQueries::sUpdateOrderQuery, order ).Where( "orderid=?" );
+            m_pSession->Write<OrderManagerQueries::UpdateOrder>( OrderManagerQueries::sUpdateOrderQuery, order );
           }
           break;
         }
         // add execution record
         pExecution_t pExecution = std::make_shared<ou::tf::Execution>( exec );
         pExecution->SetOrderId( nOrderId );
-        ou::db::QueryFields<Execution::TableRowDefNoKey>::pQueryFields_t pQueryExecutionWrite
-          = m_pSession->Insert<Execution::TableRowDefNoKey>(
+        idExecution_t idExecution {};
+        if ( m_pSession->IsWriteBehind() ) { // the row is written later, so the key is assigned here
+          Execution::TableRowDef row( pExecution->GetRow() );
+          row.idExecution = idExecution = ++m_idExecutionLast;
+          m_pSession->WriteInsert( row );
+        }
+        else {
+          m_pSession->WriteInsert(
             const_cast<Execution::TableRowDefNoKey&>( dynamic_cast<const Execution::TableRowDefNoKey&>( pExecution->GetRow() ) ) );
-        idExecution_t idExecution = m_pSession->GetLastRowId();
+          idExecution = m_idExecutionLast = m_pSession->GetLastRowId();
+        }
         pairExecution_t pair( idExecution, pExecution );
         iter->second.pmapExecutions->insert( pair );
       }
@@ -478,9 +489,8 @@ void OrderManager::ReportCommission( idOrder_t nOrderId, double dblCommission )
       if ( nullptr != m_pSession ) {
         OrderManagerQueries::UpdateCommission
           commission( pOrder->GetOrderId(), dblCommission );
-        ou::db::QueryFields<OrderManagerQueries::UpdateCommission>::pQueryFields_t pQuery
-          = m_pSession->SQL<OrderManagerQueries::UpdateCommission>( // todo:  cache this query
-            "update orders set commission=?", commission ).Where( "orderid=?" );
+        m_pSession->Write<OrderManagerQueries::UpdateCommission>(
+            "update orders set commission=? where orderid=?", commission );
       }
       pOrder->SetCommission( dblCommission );  // need to do afterwards as delegated objects may query the db (other stuff above may not obey this format)
       // as a result, may need to set delegates here so database is updated before order calls delegates.
@@ -515,14 +525,17 @@ void OrderManager::ReportErrors( idOrder_t nOrderId, OrderError::EOrderError eEr
     mapOrders_t::iterator iter;
     if ( LocateOrder( nOrderId, iter ) ) {
       pOrder_t pOrder = iter->second.pOrder;
+      const bool bSent( OrderStatus::Created != pOrder->GetRow().eOrderStatus ); // not when rejected by risk before sending
       pOrder->ActOnError( eError );
+      if ( bSent && ( OrderError::NotCancellable != eError ) ) {
+        RiskManager::LocalCommonInstance().Release( *pOrder );
+      }
       //MoveActiveOrderToCompleted( nOrderId );
       if ( nullptr != m_pSession ) {
         OrderManagerQueries::UpdateOnOrderError
           error( pOrder->GetOrderId(), pOrder->GetRow().eOrderStatus, pOrder->GetRow().dtOrderClosed );
-        ou::db::QueryFields<OrderManagerQueries::UpdateOnOrderError>::pQueryFields_t pQuery
-          = m_pSession->SQL<OrderManagerQueries::UpdateOnOrderError>( // todo:  cache this query
-            "update orders set orderstatus=?, datetimeclosed=?", error ).Where( "orderid=?" );
+        m_pSession->Write<OrderManagerQueries::UpdateOnOrderError>(
+            "update orders set orderstatus=?, datetimeclosed=? where orderid=?", error );
       }
     }
     else {
@@ -542,7 +555,7 @@ namespace OrderManagerQueries {
       ou::db::Field( a, "orderid", idOrder );
     }
     Order::idOrder_t idOrder;
-    const std::string& sReference;
+    std::string sReference; // a copy, as the update may be queued
     UpdateReference( Order::idOrder_t idOrder_, const std::string& sReference_ )
     : idOrder( idOrder_ ), sReference( sReference_ ) {}
   };
@@ -556,9 +569,8 @@ void OrderManager::UpdateReference( idOrder_t idOrder, const std::string& sRefer
       pOrder->SetReference( sReference );
       if ( nullptr != m_pSession ) {
         OrderManagerQueries::UpdateReference reference( idOrder, sReference );
-        ou::db::QueryFields<OrderManagerQueries::UpdateReference>::pQueryFields_t pQuery
-          = m_pSession->SQL<OrderManagerQueries::UpdateReference>( // todo:  cache this query
-            "update orders set reference=?", reference ).Where( "orderid=?" );
+        m_pSession->Write<OrderManagerQueries::UpdateReference>(
+            "update orders set reference=? where orderid=?", reference );
       }
     }
     else {
@@ -592,6 +604,14 @@ namespace OrderManagerQueries {
     }
     Order::idOrder_t idOrder;
   };
+
+  struct ColumnMaxExecutionId {
+    template<typename A>
+    void Fields( A& a ) {
+      ou::db::Field( a, "executionid", idExecution );
+    }
+    Execution::idExecution_t idExecution;
+  };
 }
 
 void OrderManager::HandleLoadTables( ou::db::Session& session ) {
@@ -610,6 +630,16 @@ void OrderManager::HandleLoadTables( ou::db::Session& session ) {
   catch ( const std::runtime_error& error ) {
     std::cout << "OrderManager::HandleLoadTables: no orders found, " << error.what() << std::endl;
   }
+  try { // execution keys are assigned locally with write-behind
+    ou::db::QueryFields<ou::db::NoBind>::pQueryFields_t pQuery
+      = m_pSession->SQL<ou::db::NoBind>( "select max(executionid) as executionid from executions;" ); // immediately executed
+    OrderManagerQueries::ColumnMaxExecutionId result;
+    m_pSession->Columns<ou::db::NoBind,OrderManagerQueries::ColumnMaxExecutionId>( pQuery, result );
+    m_idExecutionLast = result.idExecution;
+  }
+  catch ( const std::runtime_error& error ) {
+    std::cout << "OrderManager::HandleLoadTables: no executions found, " << error.what() << std::endl;
+  }
 }
 
 // this stuff could probably be rolled into Session with a template
@@ -137,6 +137,8 @@ private:
     int GetCurrentId() { return key; };
   } m_orderIds;
 
+  idExecution_t m_idExecutionLast; // key of the most recent execution, assigned locally with write-behind
+
   mapOrders_t m_mapOrders; // all orders for when checking for consistency
 
 //  iterOrders_t LocateOrder( idOrder_t nOrderId );  // in memory or from disk
@@ -85,9 +85,8 @@ void PortfolioManager::HandlePositionOnExecution( const Position& position ) {
     const Position::TableRowDef& row( position.GetRow() );
     PortfolioManagerQueries::UpdatePositionData update( row.idPosition, row.eOrderSidePending, row.nPositionPending,
       row.eOrderSideActive, row.nPositionActive, row.dblConstructedValue, row.dblUnRealizedPL, row.dblRealizedPL );
-    ou::db::QueryFields<PortfolioManagerQueries::UpdatePositionData>::pQueryFields_t pQuery
-      = m_pSession->SQL<PortfolioManagerQueries::UpdatePositionData>(
-        "update positions set ordersidepending=?, quantitypending=?, ordersideactive=?, quantityactive=?, constructedvalue=?, unrealizedpl=?, realizedpl=?", update ).Where( "positionid=?" );
+    m_pSession->Write<PortfolioManagerQueries::UpdatePositionData>(
+        "update positions set ordersidepending=?, quantitypending=?, ordersideactive=?, quantityactive=?, constructedvalue=?, unrealizedpl=?, realizedpl=? where positionid=?", update );
   }
 }
 
@@ -111,11 +110,9 @@ void PortfolioManager::HandlePositionOnCommission( const Position& position ) {
   if ( nullptr != m_pSession ) {
     const Position::TableRowDef& row( position.GetRow() );
     PortfolioManagerQueries::UpdatePositionCommission update( row.idPosition, row.dblCommissionPaid );
-    ou::db::QueryFields<PortfolioManagerQueries::UpdatePositionCommission>::pQueryFields_t pQuery
-      = m_pSession->SQL<PortfolioManagerQueries::UpdatePositionCommission>( "update positions set commission=?", update ).Where( "positionid=?" );
+    m_pSession->Write<PortfolioManagerQueries::UpdatePositionCommission>( "update positions set commission=? where positionid=?", update );
   }
 }  // the Where could be appended with boost::fusion type structure for the fields, and bind?
-  // need to cache the queries
 
 /////
 
@@ -137,8 +134,7 @@ void PortfolioManager::HandlePortfolioOnExecution( const Portfolio& portfolio )
   if ( nullptr != m_pSession ) {
     const Portfolio::TableRowDef& row( portfolio.GetRow() );
     PortfolioManagerQueries::UpdatePortfolioRealizedPL update( row.idPortfolio, row.dblRealizedPL );
-    ou::db::QueryFields<PortfolioManagerQueries::UpdatePortfolioRealizedPL>::pQueryFields_t pQuery
-      = m_pSession->SQL<PortfolioManagerQueries::UpdatePortfolioRealizedPL>( "update portfolios set realizedpl=?", update ).Where( "portfolioid=?" );
+    m_pSession->Write<PortfolioManagerQueries::UpdatePortfolioRealizedPL>( "update portfolios set realizedpl=? where portfolioid=?", update );
   }
 }
 
@@ -162,8 +158,7 @@ void PortfolioManager::HandlePortfolioOnCommission( const Portfolio& portfolio )
   if ( nullptr != m_pSession ) {
     const Portfolio::TableRowDef& row( portfolio.GetRow() );
     PortfolioManagerQueries::UpdatePortfolioCommission update( row.idPortfolio, row.dblCommissionsPaid );
-    ou::db::QueryFields<PortfolioManagerQueries::UpdatePortfolioCommission>::pQueryFields_t pQuery
-      = m_pSession->SQL<PortfolioManagerQueries::UpdatePortfolioCommission>( "update portfolios set commission=?", update ).Where( "portfolioid=?" );
+    m_pSession->Write<PortfolioManagerQueries::UpdatePortfolioCommission>( "update portfolios set commission=? where portfolioid=?", update );
   }
 }
 
@@ -239,8 +234,7 @@ void PortfolioManager::PortfolioUpdateActive( pPortfolio_t pPortfolio ) {
   if ( nullptr != m_pSession ) {
     const Portfolio::TableRowDef& row( pPortfolio->GetRow() );
     PortfolioManagerQueries::UpdatePortfolioActive update( row.idPortfolio, row.bActive );
-    ou::db::QueryFields<PortfolioManagerQueries::UpdatePortfolioActive>::pQueryFields_t pQuery
-      = m_pSession->SQL<PortfolioManagerQueries::UpdatePortfolioActive>( "update portfolios set active=?", update ).Where( "portfolioid=?" );
+    m_pSession->Write<PortfolioManagerQueries::UpdatePortfolioActive>( "update portfolios set active=? where portfolioid=?", update );
   }
 }
 
@@ -264,11 +258,9 @@ void PortfolioManager::PositionUpdateNotes( pPosition_t pPosition ) {
   if ( nullptr != m_pSession ) {
     const Position::TableRowDef& row( pPosition->GetRow() );
     PortfolioManagerQueries::UpdatePositionNotes update( row.idPosition, row.sNotes );
-    ou::db::QueryFields<PortfolioManagerQueries::UpdatePositionNotes>::pQueryFields_t pQuery
-      = m_pSession->SQL<PortfolioManagerQueries::UpdatePositionNotes>( "update positions set notes=?", update ).Where( "positionid=?" );
+    m_pSession->Write<PortfolioManagerQueries::UpdatePositionNotes>( "update positions set notes=? where positionid=?", update );
   }
 }  // the Where could be appended with boost::fusion type structure for the fields, and bind?
-  // need to cache the queries
 
 //////
 
@@ -225,7 +225,7 @@ public:
 
 protected:
 
-  using mapSymbols_t = std::map<idSymbol_t, pSymbol_t>;
+  using mapSymbols_t = std::map<idSymbol_t, pSymbol_t, std::less<> >; // transparent, allows lookup with a string_view
   mapSymbols_t m_mapSymbols;
 
   //void Connecting( void );
@@ -15,15 +15,643 @@
 
 #include "stdafx.h"
 
+#include <cmath>
+#include <limits>
+#include <cstdlib>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+
+#include <TFOptions/Margin.h>
+#include <TFOptions/Option.h>
+
+#include "PositionGreek.h"
 #include "RiskManager.h"
 
 namespace ou { // One Unified
 namespace tf { // TradeFrame
 
-RiskManager::RiskManager(void): ou::db::ManagerBase<RiskManager>() {
+namespace {
+
+  const double c_dblNoLimit( std::numeric_limits<double>::max() );
+
+  size_t PowerOfTwo( size_t n ) { // at least twice n, so a probe always ends on an empty entry
+    size_t size( 16 );
+    while ( size < ( 2 * n ) ) size <<= 1;
+    return size;
+  }
+
+  size_t HashPosition( int64_t id ) {
+    uint64_t key( id );
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return key;
+  }
+
+  template<typename Index>
+  void Insert( Index& rIndex, size_t mask, size_t hash, uint32_t ixSlot ) {
+    size_t ix = hash & mask;
+    while ( 0 != rIndex[ ix ].load( std::memory_order_relaxed ) ) {
+      ix = ( ix + 1 ) & mask;
+    }
+    rIndex[ ix ].store( ixSlot + 1, std::memory_order_release );
+  }
+
+}
+
+RiskManager::Limits::Limits()
+: dblNotional( c_dblNoLimit ), dblDelta( c_dblNoLimit ), dblGamma( c_dblNoLimit ), dblVega( c_dblNoLimit ), dblMargin( c_dblNoLimit )
+, dblOrderQuantity( c_dblNoLimit ), dblOrderNotional( c_dblNoLimit ), dblPosition( c_dblNoLimit )
+{}
+
+RiskManager::Portfolio::Portfolio() {
+  for ( atomic_t& value: rValue ) value.store( 0.0, std::memory_order_relaxed );
+  for ( atomic_t& limit: rLimit ) limit.store( c_dblNoLimit, std::memory_order_relaxed );
+}
+
+RiskManager::Holding::Holding()
+: idPosition {}, ixPortfolio( npos ), ixMarket( npos ), ixNext( npos ), nQuantity( 0 )
+{
+  for ( std::atomic<uint64_t>& pending: rPending ) pending.store( 0, std::memory_order_relaxed );
+  for ( atomic_t& value: rValue ) value.store( 0.0, std::memory_order_relaxed );
+  for ( atomic_t& limit: rLimit ) limit.store( c_dblNoLimit, std::memory_order_relaxed );
+}
+
+RiskManager::Market::Market()
+: pRiskManager( nullptr ), dblMultiplier( 1.0 ), ixHolding( npos ), ixDefault( npos )
+, dblMark( 0.0 ), dblUnderlying( 0.0 )
+{
+  for ( atomic_t& greek: rGreek ) greek.store( 0.0, std::memory_order_relaxed );
+  for ( atomic_t& unit: rUnit ) unit.store( 0.0, std::memory_order_relaxed );
+}
+
+void RiskManager::Market::HandleQuote( const Quote& quote ) {
+  if ( ( 0.0 < quote.Bid() ) && ( 0.0 < quote.Ask() ) ) {
+    dblMark.store( quote.Midpoint(), std::memory_order_relaxed );
+    pRiskManager->UpdateUnits( *this );
+    pRiskManager->Revalue( *this );
+  }
+}
+
+void RiskManager::Market::HandleUnderlyingQuote( const Quote& quote ) {
+  if ( ( 0.0 < quote.Bid() ) && ( 0.0 < quote.Ask() ) ) {
+    dblUnderlying.store( quote.Midpoint(), std::memory_order_relaxed );
+    pRiskManager->UpdateUnits( *this );
+    pRiskManager->Revalue( *this );
+  }
+}
+
+void RiskManager::Market::HandleGreek( const Greek& greek ) {
+  rGreek[ 0 ].store( greek.Delta(), std::memory_order_relaxed );
+  rGreek[ 1 ].store( greek.Gamma(), std::memory_order_relaxed );
+  rGreek[ 2 ].store( greek.Vega(), std::memory_order_relaxed );
+  pRiskManager->UpdateUnits( *this );
+  pRiskManager->Revalue( *this );
+}
+
+const char* RiskManager::Name( ECheck eCheck ) {
+  static const char* rName[] = {
+    "Accept", "Unknown", "OrderQuantity", "OrderNotional", "Position", "Notional", "Delta", "Gamma", "Vega", "Margin"
+  };
+  return rName[ (size_t)eCheck ];
+}
+
+RiskManager::RiskManager(void)
+: ou::db::ManagerBase<RiskManager>()
+, m_nCapacityMarket( 1024 ), m_nCapacityHolding( 1024 ), m_nCapacityPortfolio( 64 )
+, m_nMarket( 0 ), m_nHolding( 0 ), m_nPortfolio( 0 )
+, m_maskMarket {}, m_maskHolding {}
+, m_bRejectUnknown( false ), m_nChecks( 0 ), m_nRejects( 0 )
+{
 }
 
 RiskManager::~RiskManager(void) {
+  const size_t nMarket( m_nMarket.load( std::memory_order_acquire ) );
+  for ( size_t ix = 0; ix < nMarket; ix++ ) {
+    Market& market( m_rMarket[ ix ] );
+    if ( market.pWatch ) {
+      market.pWatch->OnQuote.Remove( MakeDelegate( &market, &Market::HandleQuote ) );
+    }
+    if ( market.pOption ) {
+      std::static_pointer_cast<option::Option>( market.pOption )->OnGreek.Remove( MakeDelegate( &market, &Market::HandleGreek ) );
+    }
+    if ( market.pUnderlying ) {
+      market.pUnderlying->OnQuote.Remove( MakeDelegate( &market, &Market::HandleUnderlyingQuote ) );
+    }
+  }
+}
+
+void RiskManager::SetCapacity( size_t nInstruments, size_t nHoldings, size_t nPortfolios ) {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  if ( m_rMarket ) {
+    throw std::runtime_error( "RiskManager::SetCapacity: already allocated" );
+  }
+  m_nCapacityMarket = nInstruments;
+  m_nCapacityHolding = nHoldings;
+  m_nCapacityPortfolio = nPortfolios;
+}
+
+void RiskManager::Allocate() { // under the lock
+  if ( !m_rMarket ) {
+    m_rPortfolio = std::make_unique<Portfolio[]>( m_nCapacityPortfolio );
+    m_rHolding = std::make_unique<Holding[]>( m_nCapacityHolding );
+    m_rMarket = std::make_unique<Market[]>( m_nCapacityMarket );
+    for ( size_t ix = 0; ix < m_nCapacityMarket; ix++ ) {
+      m_rMarket[ ix ].pRiskManager = this;
+    }
+
+    const size_t nIndexMarket( PowerOfTwo( m_nCapacityMarket ) );
+    m_rIndexMarket = std::make_unique<std::atomic<ix_t>[]>( nIndexMarket );
+    for ( size_t ix = 0; ix < nIndexMarket; ix++ ) m_rIndexMarket[ ix ].store( 0, std::memory_order_relaxed );
+    m_maskMarket = nIndexMarket - 1;
+
+    const size_t nIndexHolding( PowerOfTwo( m_nCapacityHolding ) );
+    m_rIndexHolding = std::make_unique<std::atomic<ix_t>[]>( nIndexHolding );
+    for ( size_t ix = 0; ix < nIndexHolding; ix++ ) m_rIndexHolding[ ix ].store( 0, std::memory_order_relaxed );
+    m_maskHolding = nIndexHolding - 1;
+  }
+}
+
+RiskManager::ix_t RiskManager::FindMarket( const idInstrument_t& idInstrument ) const {
+  if ( 0 == m_nMarket.load( std::memory_order_acquire ) ) return npos;
+  size_t ix = std::hash<idInstrument_t>()( idInstrument ) & m_maskMarket;
+  while ( true ) {
+    const ix_t entry( m_rIndexMarket[ ix ].load( std::memory_order_acquire ) );
+    if ( 0 == entry ) return npos;
+    if ( idInstrument == m_rMarket[ entry - 1 ].idInstrument ) return entry - 1;
+    ix = ( ix + 1 ) & m_maskMarket;
+  }
+}
+
+RiskManager::ix_t RiskManager::FindHolding( idPosition_t idPosition ) const {
+  if ( 0 == m_nHolding.load( std::memory_order_acquire ) ) return npos;
+  size_t ix = HashPosition( idPosition ) & m_maskHolding;
+  while ( true ) {
+    const ix_t entry( m_rIndexHolding[ ix ].load( std::memory_order_acquire ) );
+    if ( 0 == entry ) return npos;
+    if ( idPosition == m_rHolding[ entry - 1 ].idPosition ) return entry - 1;
+    ix = ( ix + 1 ) & m_maskHolding;
+  }
+}
+
+RiskManager::ix_t RiskManager::Locate( const Order& order ) const {
+  const Order::TableRowDef& row( order.GetRow() );
+  if ( 0 != row.idPosition ) {
+    const ix_t ixHolding( FindHolding( row.idPosition ) );
+    if ( npos != ixHolding ) return ixHolding;
+  }
+  const ix_t ixMarket( FindMarket( row.idInstrument ) );
+  if ( npos == ixMarket ) return npos;
+  return m_rMarket[ ixMarket ].ixDefault.load( std::memory_order_acquire );
+}
+
+bool RiskManager::ToSide( OrderSide::EOrderSide eOrderSide, ESide& side ) {
+  switch ( eOrderSide ) {
+    case OrderSide::Buy:
+    case OrderSide::BuyMinus:
+    case OrderSide::BuyStop:
+      side = Buy;
+      return true;
+    case OrderSide::Sell:
+    case OrderSide::SellShort:
+    case OrderSide::SellPlus:
+    case OrderSide::SellStop:
+      side = Sell;
+      return true;
+    default:
+      return false;
+  }
+}
+
+RiskManager::ix_t RiskManager::AddPortfolio( const idPortfolio_t& idPortfolio ) { // under the lock
+  mapPortfolio_t::const_iterator iter = m_mapPortfolio.find( idPortfolio );
+  if ( m_mapPortfolio.end() != iter ) return iter->second;
+  if ( m_nCapacityPortfolio == m_nPortfolio ) {
+    throw std::runtime_error( "RiskManager::AddPortfolio: capacity reached" );
+  }
+  const ix_t ixPortfolio( m_nPortfolio++ );
+  m_rPortfolio[ ixPortfolio ].idPortfolio = idPortfolio;
+  m_mapPortfolio.emplace( idPortfolio, ixPortfolio );
+  return ixPortfolio;
+}
+
+RiskManager::ix_t RiskManager::AddMarket( pInstrument_t pInstrument ) { // under the lock
+  const idInstrument_t& idInstrument( pInstrument->GetInstrumentName() );
+  ix_t ixMarket( FindMarket( idInstrument ) );
+  if ( npos == ixMarket ) {
+    ixMarket = m_nMarket.load( std::memory_order_relaxed );
+    if ( m_nCapacityMarket == ixMarket ) {
+      throw std::runtime_error( "RiskManager::AddMarket: capacity reached" );
+    }
+    Market& market( m_rMarket[ ixMarket ] );
+    market.idInstrument = idInstrument;
+    market.pInstrument = pInstrument;
+    const boost::uint32_t nMultiplier( pInstrument->GetMultiplier() );
+    market.dblMultiplier = ( 0 == nMultiplier ) ? 1.0 : nMultiplier;
+    UpdateUnits( market );
+    Insert( m_rIndexMarket, m_maskMarket, std::hash<idInstrument_t>()( idInstrument ), ixMarket );
+    m_nMarket.store( ixMarket + 1, std::memory_order_release );
+  }
+  return ixMarket;
+}
+
+RiskManager::ix_t RiskManager::AddHolding( ix_t ixPortfolio, ix_t ixMarket, idPosition_t idPosition, int64_t nQuantity ) { // under the lock
+  const ix_t ixHolding( m_nHolding.load( std::memory_order_relaxed ) );
+  if ( m_nCapacityHolding == ixHolding ) {
+    throw std::runtime_error( "RiskManager::AddHolding: capacity reached" );
+  }
+  Holding& holding( m_rHolding[ ixHolding ] );
+  holding.idPosition = idPosition;
+  holding.ixPortfolio = ixPortfolio;
+  holding.ixMarket = ixMarket;
+  holding.nQuantity.store( nQuantity, std::memory_order_relaxed );
+  LoadLimits( holding );
+
+  Market& market( m_rMarket[ ixMarket ] );
+  holding.ixNext.store( market.ixHolding.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+  market.ixHolding.store( ixHolding, std::memory_order_release );
+  if ( npos == market.ixDefault.load( std::memory_order_relaxed ) ) {
+    market.ixDefault.store( ixHolding, std::memory_order_release );
+  }
+  if ( 0 != idPosition ) {
+    Insert( m_rIndexHolding, m_maskHolding, HashPosition( idPosition ), ixHolding );
+  }
+  m_nHolding.store( ixHolding + 1, std::memory_order_release );
+
+  Revalue( holding );
+  return ixHolding;
+}
+
+void RiskManager::Add( pPosition_t pPosition ) {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  Allocate();
+  const Position::TableRowDef& row( pPosition->GetRow() );
+  if ( ( 0 != row.idPosition ) && ( npos != FindHolding( row.idPosition ) ) ) return; // already registered
+  const ix_t ixPortfolio( AddPortfolio( row.idPortfolio ) );
+  const ix_t ixMarket( AddMarket( pPosition->GetInstrument() ) );
+  Attach( m_rMarket[ ixMarket ], pPosition );
+  int64_t nQuantity( row.nPositionActive );
+  if ( OrderSide::Sell == row.eOrderSideActive ) nQuantity = -nQuantity;
+  AddHolding( ixPortfolio, ixMarket, row.idPosition, nQuantity );
+}
+
+void RiskManager::Add( const idPortfolio_t& idPortfolio, pInstrument_t pInstrument, idPosition_t idPosition ) {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  Allocate();
+  if ( ( 0 != idPosition ) && ( npos != FindHolding( idPosition ) ) ) return; // already registered
+  const ix_t ixPortfolio( AddPortfolio( idPortfolio ) );
+  const ix_t ixMarket( AddMarket( pInstrument ) );
+  AddHolding( ixPortfolio, ixMarket, idPosition, 0 );
+}
+
+void RiskManager::Attach( Market& market, pPosition_t pPosition ) { // under the lock, once per market
+  if ( market.pWatch ) return;
+
+  market.pWatch = pPosition->GetWatch();
+  const Quote quote( market.pWatch->LastQuote() );
+  if ( ( 0.0 < quote.Bid() ) && ( 0.0 < quote.Ask() ) ) {
+    market.dblMark.store( quote.Midpoint(), std::memory_order_relaxed );
+  }
+  market.pWatch->OnQuote.Add( MakeDelegate( &market, &Market::HandleQuote ) );
+
+  option::Option::pOption_t pOption;
+  PositionGreek::pPositionGreek_t pPositionGreek = std::dynamic_pointer_cast<PositionGreek>( pPosition );
+  if ( pPositionGreek ) {
+    pOption = pPositionGreek->GetOption();
+    market.pUnderlying = pPositionGreek->GetUnderlying();
+    const Quote quote( market.pUnderlying->LastQuote() );
+    if ( ( 0.0 < quote.Bid() ) && ( 0.0 < quote.Ask() ) ) {
+      market.dblUnderlying.store( quote.Midpoint(), std::memory_order_relaxed );
+    }
+    market.pUnderlying->OnQuote.Add( MakeDelegate( &market, &Market::HandleUnderlyingQuote ) );
+  }
+  else {
+    pOption = std::dynamic_pointer_cast<option::Option>( market.pWatch );
+  }
+  if ( pOption ) {
+    market.pOption = pOption;
+    const Greek& greek( pOption->LastGreek() );
+    market.rGreek[ 0 ].store( greek.Delta(), std::memory_order_relaxed );
+    market.rGreek[ 1 ].store( greek.Gamma(), std::memory_order_relaxed );
+    market.rGreek[ 2 ].store( greek.Vega(), std::memory_order_relaxed );
+    pOption->OnGreek.Add( MakeDelegate( &market, &Market::HandleGreek ) );
+  }
+
+  UpdateUnits( market );
+}
+
+void RiskManager::LoadLimits( Holding& holding ) { // under the lock
+  const Limits& instrument( m_rMarket[ holding.ixMarket ].limits );
+  const Limits& portfolio( m_rPortfolio[ holding.ixPortfolio ].limits );
+  holding.rLimit[ Notional ].store( instrument.dblNotional, std::memory_order_relaxed );
+  holding.rLimit[ Delta ].store( instrument.dblDelta, std::memory_order_relaxed );
+  holding.rLimit[ Gamma ].store( instrument.dblGamma, std::memory_order_relaxed );
+  holding.rLimit[ Vega ].store( instrument.dblVega, std::memory_order_relaxed );
+  holding.rLimit[ Margin ].store( instrument.dblMargin, std::memory_order_relaxed );
+  holding.rLimit[ OrderQuantity ].store( std::min( instrument.dblOrderQuantity, portfolio.dblOrderQuantity ), std::memory_order_relaxed );
+  holding.rLimit[ OrderNotional ].store( std::min( instrument.dblOrderNotional, portfolio.dblOrderNotional ), std::memory_order_relaxed );
+  holding.rLimit[ PositionSize ].store( instrument.dblPosition, std::memory_order_relaxed );
+}
+
+void RiskManager::SetPortfolioLimits( const idPortfolio_t& idPortfolio, const Limits& limits ) {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  Allocate();
+  const ix_t ixPortfolio( AddPortfolio( idPortfolio ) );
+  Portfolio& portfolio( m_rPortfolio[ ixPortfolio ] );
+  portfolio.limits = limits;
+  portfolio.rLimit[ Notional ].store( limits.dblNotional, std::memory_order_relaxed );
+  portfolio.rLimit[ Delta ].store( limits.dblDelta, std::memory_order_relaxed );
+  portfolio.rLimit[ Gamma ].store( limits.dblGamma, std::memory_order_relaxed );
+  portfolio.rLimit[ Vega ].store( limits.dblVega, std::memory_order_relaxed );
+  portfolio.rLimit[ Margin ].store( limits.dblMargin, std::memory_order_relaxed );
+  const size_t nHolding( m_nHolding.load( std::memory_order_relaxed ) );
+  for ( size_t ix = 0; ix < nHolding; ix++ ) {
+    Holding& holding( m_rHolding[ ix ] );
+    if ( ixPortfolio == holding.ixPortfolio ) LoadLimits( holding );
+  }
+}
+
+void RiskManager::SetInstrumentLimits( const idInstrument_t& idInstrument, const Limits& limits ) {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  const ix_t ixMarket( FindMarket( idInstrument ) );
+  if ( npos == ixMarket ) {
+    throw std::runtime_error( "RiskManager::SetInstrumentLimits: " + idInstrument + " not registered" );
+  }
+  Market& market( m_rMarket[ ixMarket ] );
+  market.limits = limits;
+  for ( ix_t ix = market.ixHolding.load( std::memory_order_relaxed ); npos != ix; ix = m_rHolding[ ix ].ixNext.load( std::memory_order_relaxed ) ) {
+    LoadLimits( m_rHolding[ ix ] );
+  }
+}
+
+void RiskManager::UpdateQuote( const idInstrument_t& idInstrument, double dblMark ) {
+  const ix_t ixMarket( FindMarket( idInstrument ) );
+  if ( npos != ixMarket ) {
+    Market& market( m_rMarket[ ixMarket ] );
+    market.dblMark.store( dblMark, std::memory_order_relaxed );
+    UpdateUnits( market );
+    Revalue( market );
+  }
+}
+
+void RiskManager::UpdateUnderlying( const idInstrument_t& idInstrument, double dblPrice ) {
+  const ix_t ixMarket( FindMarket( idInstrument ) );
+  if ( npos != ixMarket ) {
+    Market& market( m_rMarket[ ixMarket ] );
+    market.dblUnderlying.store( dblPrice, std::memory_order_relaxed );
+    UpdateUnits( market );
+    Revalue( market );
+  }
+}
+
+void RiskManager::UpdateGreek( const idInstrument_t& idInstrument, double dblDelta, double dblGamma, double dblVega ) {
+  const ix_t ixMarket( FindMarket( idInstrument ) );
+  if ( npos != ixMarket ) {
+    Market& market( m_rMarket[ ixMarket ] );
+    market.rGreek[ 0 ].store( dblDelta, std::memory_order_relaxed );
+    market.rGreek[ 1 ].store( dblGamma, std::memory_order_relaxed );
+    market.rGreek[ 2 ].store( dblVega, std::memory_order_relaxed );
+    UpdateUnits( market );
+    Revalue( market );
+  }
+}
+
+// per unit sensitivities, a unit is one contract, ie, multiplier shares
+void RiskManager::UpdateUnits( Market& market ) {
+
+  namespace margin = ou::tf::option::margin;
+
+  const Instrument& instrument( *market.pInstrument );
+  const double dblMark( market.dblMark.load( std::memory_order_relaxed ) );
+  const double dblMultiplier( market.dblMultiplier );
+  const unsigned int nMultiplier( dblMultiplier );
+
+  market.rUnit[ UnitNotional ].store( dblMark * dblMultiplier, std::memory_order_relaxed );
+
+  if ( instrument.IsOption() || instrument.IsFuturesOption() ) {
+    market.rUnit[ UnitDelta ].store( market.rGreek[ 0 ].load( std::memory_order_relaxed ) * dblMultiplier, std::memory_order_relaxed );
+    market.rUnit[ UnitGamma ].store( market.rGreek[ 1 ].load( std::memory_order_relaxed ) * dblMultiplier, std::memory_order_relaxed );
+    market.rUnit[ UnitVega ].store( market.rGreek[ 2 ].load( std::memory_order_relaxed ) * dblMultiplier, std::memory_order_relaxed );
+
+    margin::MarginRequirement mrLong;
+    margin::Calc( mrLong, margin::LongOption { { { market.pInstrument, nMultiplier, dblMark } } } );
+    market.rUnit[ UnitMarginLong ].store( mrLong.margin, std::memory_order_relaxed );
+
+    const margin::ZeroUnderlying underlying { { market.pInstrument, nMultiplier, market.dblUnderlying.load( std::memory_order_relaxed ) } };
+    margin::RegTInitial mrShort;
+    if ( OptionSide::Call == instrument.GetOptionSide() ) {
+      margin::Calc( mrShort, underlying, margin::ShortCall { { { { market.pInstrument, nMultiplier, dblMark } } } } );
+    }
+    else {
+      margin::Calc( mrShort, underlying, margin::ShortPut { { { { market.pInstrument, nMultiplier, dblMark } } } } );
+    }
+    market.rUnit[ UnitMarginShort ].store( mrShort.margin, std::memory_order_relaxed );
+  }
+  else {
+    market.rUnit[ UnitDelta ].store( dblMultiplier, std::memory_order_relaxed );
+    market.rUnit[ UnitGamma ].store( 0.0, std::memory_order_relaxed );
+    market.rUnit[ UnitVega ].store( 0.0, std::memory_order_relaxed );
+
+    margin::RegTInitial mrLong;
+    margin::Calc( mrLong, margin::LongUnderlying { { { market.pInstrument, nMultiplier, dblMark } } } );
+    market.rUnit[ UnitMarginLong ].store( mrLong.margin, std::memory_order_relaxed );
+
+    margin::RegTInitial mrShort;
+    margin::Calc( mrShort, margin::ShortUnderlying { { { market.pInstrument, nMultiplier, dblMark } } } );
+    market.rUnit[ UnitMarginShort ].store( mrShort.margin, std::memory_order_relaxed );
+  }
+}
+
+double RiskManager::Value( EMeasure measure, const Market& market, int64_t nQuantity ) const {
+  const double dblQuantity( nQuantity );
+  switch ( measure ) {
+    case Notional:
+      return std::abs( dblQuantity ) * market.rUnit[ UnitNotional ].load( std::memory_order_relaxed );
+    case Delta:
+      return dblQuantity * market.rUnit[ UnitDelta ].load( std::memory_order_relaxed );
+    case Gamma:
+      return dblQuantity * market.rUnit[ UnitGamma ].load( std::memory_order_relaxed );
+    case Vega:
+      return dblQuantity * market.rUnit[ UnitVega ].load( std::memory_order_relaxed );
+    case Margin:
+      return ( 0 <= nQuantity )
+        ? ( dblQuantity * market.rUnit[ UnitMarginLong ].load( std::memory_order_relaxed ) )
+        : ( -dblQuantity * market.rUnit[ UnitMarginShort ].load( std::memory_order_relaxed ) );
+    default:
+      return 0.0;
+  }
+}
+
+void RiskManager::Accumulate( atomic_t& total, double dblAmount ) {
+  double dblTotal( total.load( std::memory_order_relaxed ) );
+  while ( !total.compare_exchange_weak( dblTotal, dblTotal + dblAmount, std::memory_order_relaxed ) ) {}
+}
+
+void RiskManager::Revalue( Holding& holding ) {
+  const Market& market( m_rMarket[ holding.ixMarket ] );
+  Portfolio& portfolio( m_rPortfolio[ holding.ixPortfolio ] );
+  while ( holding.flag.test_and_set( std::memory_order_acquire ) ) {}
+  const int64_t nQuantity( holding.nQuantity.load( std::memory_order_relaxed ) );
+  for ( int ix = 0; ix < nMeasures; ix++ ) {
+    const double dblValue( Value( EMeasure( ix ), market, nQuantity ) );
+    const double dblPrior( holding.rValue[ ix ].exchange( dblValue, std::memory_order_relaxed ) );
+    if ( dblValue != dblPrior ) Accumulate( portfolio.rValue[ ix ], dblValue - dblPrior );
+  }
+  holding.flag.clear( std::memory_order_release );
+}
+
+void RiskManager::Revalue( Market& market ) {
+  for ( ix_t ix = market.ixHolding.load( std::memory_order_acquire ); npos != ix; ix = m_rHolding[ ix ].ixNext.load( std::memory_order_relaxed ) ) {
+    Revalue( m_rHolding[ ix ] );
+  }
+}
+
+RiskManager::ECheck RiskManager::Check( const Order& order ) {
+
+  m_nChecks.fetch_add( 1, std::memory_order_relaxed );
+
+  ESide side;
+  const ix_t ixHolding( Locate( order ) );
+  if ( ( npos == ixHolding ) || !ToSide( order.GetOrderSide(), side ) ) {
+    if ( m_bRejectUnknown.load( std::memory_order_relaxed ) ) {
+      m_nRejects.fetch_add( 1, std::memory_order_relaxed );
+      return ECheck::Unknown;
+    }
+    return ECheck::Accept;
+  }
+
+  Holding& holding( m_rHolding[ ixHolding ] );
+  const Market& market( m_rMarket[ holding.ixMarket ] );
+  const Portfolio& portfolio( m_rPortfolio[ holding.ixPortfolio ] );
+
+  const Order::quantity_t nOrder( order.GetQuanOrdered() );
+  double dblPrice( order.GetPrice1() );
+  if ( ( OrderType::Market == order.GetOrderType() ) || ( 0.0 >= dblPrice ) ) {
+    dblPrice = market.dblMark.load( std::memory_order_relaxed );
+  }
+
+  ECheck eCheck( ECheck::Accept );
+
+  if ( nOrder > holding.rLimit[ OrderQuantity ].load( std::memory_order_relaxed ) ) {
+    eCheck = ECheck::OrderQuantity;
+  }
+  else
+  if ( ( nOrder * dblPrice * market.dblMultiplier ) > holding.rLimit[ OrderNotional ].load( std::memory_order_relaxed ) ) {
+    eCheck = ECheck::OrderNotional;
+  }
+  else {
+    // worst case: this order, and those pending on the same side, fill
+    const int64_t nQuantity( holding.nQuantity.load( std::memory_order_relaxed ) );
+    const int64_t nChange( holding.rPending[ side ].load( std::memory_order_relaxed ) + nOrder );
+    const int64_t nProjected( nQuantity + ( ( Buy == side ) ? nChange : -nChange ) );
+
+    if ( ( std::llabs( nProjected ) > holding.rLimit[ PositionSize ].load( std::memory_order_relaxed ) )
+      && ( std::llabs( nProjected ) > std::llabs( nQuantity ) ) ) {
+      eCheck = ECheck::Position;
+    }
+    else {
+      static const ECheck rCheck[ nMeasures ] = { ECheck::Notional, ECheck::Delta, ECheck::Gamma, ECheck::Vega, ECheck::Margin };
+      for ( int ix = 0; ix < nMeasures; ix++ ) {
+        const double dblHolding( holding.rValue[ ix ].load( std::memory_order_relaxed ) );
+        const double dblHoldingProjected( Value( EMeasure( ix ), market, nProjected ) );
+        if ( ( std::abs( dblHoldingProjected ) > holding.rLimit[ ix ].load( std::memory_order_relaxed ) )
+          && ( std::abs( dblHoldingProjected ) > std::abs( dblHolding ) ) ) {
+          eCheck = rCheck[ ix ];
+          break;
+        }
+        const double dblPortfolio( portfolio.rValue[ ix ].load( std::memory_order_relaxed ) );
+        const double dblPortfolioProjected( dblPortfolio + dblHoldingProjected - dblHolding );
+        if ( ( std::abs( dblPortfolioProjected ) > portfolio.rLimit[ ix ].load( std::memory_order_relaxed ) )
+          && ( std::abs( dblPortfolioProjected ) > std::abs( dblPortfolio ) ) ) {
+          eCheck = rCheck[ ix ];
+          break;
+        }
+      }
+    }
+  }
+
+  if ( ECheck::Accept == eCheck ) {
+    holding.rPending[ side ].fetch_add( nOrder, std::memory_order_relaxed );
+  }
+  else {
+    m_nRejects.fetch_add( 1, std::memory_order_relaxed );
+  }
+
+  return eCheck;
+}
+
+void RiskManager::ReleasePending( Holding& holding, ESide side, uint64_t nQuantity ) {
+  std::atomic<uint64_t>& pending( holding.rPending[ side ] );
+  uint64_t nPending( pending.load( std::memory_order_relaxed ) );
+  while ( !pending.compare_exchange_weak( nPending, ( nQuantity < nPending ) ? ( nPending - nQuantity ) : 0, std::memory_order_relaxed ) ) {}
+}
+
+void RiskManager::ReportExecution( const Order& order, const Execution& exec ) {
+  ESide side;
+  const ix_t ixHolding( Locate( order ) );
+  if ( ( npos != ixHolding ) && ToSide( exec.GetOrderSide(), side ) ) {
+    Holding& holding( m_rHolding[ ixHolding ] );
+    const int64_t nQuantity( exec.GetSize() );
+    holding.nQuantity.fetch_add( ( Buy == side ) ? nQuantity : -nQuantity, std::memory_order_relaxed );
+    ReleasePending( holding, side, nQuantity );
+    Market& market( m_rMarket[ holding.ixMarket ] );
+    if ( 0.0 == market.dblMark.load( std::memory_order_relaxed ) ) { // no quotes yet
+      market.dblMark.store( exec.GetPrice(), std::memory_order_relaxed );
+      UpdateUnits( market );
+      Revalue( market );
+    }
+    else {
+      Revalue( holding );
+    }
+  }
+}
+
+void RiskManager::Release( const Order& order ) {
+  ESide side;
+  const ix_t ixHolding( Locate( order ) );
+  if ( ( npos != ixHolding ) && ToSide( order.GetOrderSide(), side ) ) {
+    ReleasePending( m_rHolding[ ixHolding ], side, order.GetQuanRemaining() );
+  }
+}
+
+void RiskManager::GetSnapshot( Snapshot& snapshot ) const {
+
+  std::lock_guard<std::mutex> lock( m_mutex );
+
+  snapshot.nChecks = m_nChecks.load( std::memory_order_relaxed );
+  snapshot.nRejects = m_nRejects.load( std::memory_order_relaxed );
+
+  auto Load = []( const atomic_t* rValue, Exposure& exposure ){
+    exposure.dblNotional = rValue[ Notional ].load( std::memory_order_relaxed );
+    exposure.dblDelta = rValue[ Delta ].load( std::memory_order_relaxed );
+    exposure.dblGamma = rValue[ Gamma ].load( std::memory_order_relaxed );
+    exposure.dblVega = rValue[ Vega ].load( std::memory_order_relaxed );
+    exposure.dblMargin = rValue[ Margin ].load( std::memory_order_relaxed );
+  };
+
+  snapshot.vPortfolio.resize( m_nPortfolio );
+  for ( size_t ix = 0; ix < m_nPortfolio; ix++ ) {
+    Snapshot::Portfolio& portfolio( snapshot.vPortfolio[ ix ] );
+    portfolio.idPortfolio = m_rPortfolio[ ix ].idPortfolio;
+    Load( m_rPortfolio[ ix ].rValue, portfolio.exposure );
+  }
+
+  const size_t nHolding( m_nHolding.load( std::memory_order_acquire ) );
+  snapshot.vHolding.resize( nHolding );
+  for ( size_t ix = 0; ix < nHolding; ix++ ) {
+    const Holding& from( m_rHolding[ ix ] );
+    const Market& market( m_rMarket[ from.ixMarket ] );
+    Snapshot::Holding& to( snapshot.vHolding[ ix ] );
+    to.idPortfolio = m_rPortfolio[ from.ixPortfolio ].idPortfolio;
+    to.idInstrument = market.idInstrument;
+    to.idPosition = from.idPosition;
+    to.nQuantity = from.nQuantity.load( std::memory_order_relaxed );
+    to.nPendingBuy = from.rPending[ Buy ].load( std::memory_order_relaxed );
+    to.nPendingSell = from.rPending[ Sell ].load( std::memory_order_relaxed );
+    to.dblMark = market.dblMark.load( std::memory_order_relaxed );
+    Load( from.rValue, to.exposure );
+  }
 }
 
 } // namespace tf
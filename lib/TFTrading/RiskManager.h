@@ -15,17 +15,226 @@
 
 #pragma once
 
+// pre-trade risk:
+//   * exposure (notional, delta, gamma, vega, reg-t margin) is kept per holding (portfolio x instrument)
+//     and summed per portfolio, revalued incrementally on executions, quotes, and greeks
+//   * per unit sensitivities are kept per instrument, so a quote revalues only the holdings in that instrument
+//   * OrderManager::PlaceOrder calls Check, which projects the order, plus pending orders on the same side,
+//     onto the holding and the portfolio, and compares with limit tables precomputed at SetLimits time,
+//     an order which reduces an exposure is not rejected by that exposure
+//   * the order path takes no locks: slots are fixed capacity and never move, indexes are insert only,
+//     and all values read by Check are atomics, Add and SetLimits serialize on a mutex
+//   * an instrument not registered is accepted, unless SetRejectUnknown( true )
+//   * margin is per leg, naked short options use the reg-t naked formula, spreads are not recognized
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdint>
+
 #include <OUCommon/ManagerBase.h>
 
+#include "KeyTypes.h"
+#include "Order.h"
+#include "Watch.h"
+#include "Position.h"
+#include "Execution.h"
+
 namespace ou { // One Unified
 namespace tf { // TradeFrame
 
 class RiskManager: public ou::db::ManagerBase<RiskManager> {
 public:
+
+  using pPosition_t = Position::pPosition_t;
+  using pInstrument_t = Instrument::pInstrument_t;
+  using pWatch_t = Watch::pWatch_t;
+  using idPortfolio_t = keytypes::idPortfolio_t;
+  using idPosition_t = keytypes::idPosition_t;
+  using idInstrument_t = keytypes::idInstrument_t;
+
+  enum class ECheck { Accept, Unknown, OrderQuantity, OrderNotional, Position, Notional, Delta, Gamma, Vega, Margin };
+  static const char* Name( ECheck );
+
+  struct Limits { // default is no limit
+    double dblNotional;      // absolute exposure
+    double dblDelta;
+    double dblGamma;
+    double dblVega;
+    double dblMargin;
+    double dblOrderQuantity; // per order
+    double dblOrderNotional;
+    double dblPosition;      // absolute quantity, instrument limits only
+    Limits();
+  };
+
+  struct Exposure {
+    double dblNotional;
+    double dblDelta;
+    double dblGamma;
+    double dblVega;
+    double dblMargin;
+    Exposure(): dblNotional {}, dblDelta {}, dblGamma {}, dblVega {}, dblMargin {} {}
+  };
+
+  struct Snapshot { // for display, each value is read atomically, the set as a whole is not
+    struct Portfolio {
+      idPortfolio_t idPortfolio;
+      Exposure exposure;
+    };
+    struct Holding {
+      idPortfolio_t idPortfolio;
+      idInstrument_t idInstrument;
+      idPosition_t idPosition;
+      int64_t nQuantity;
+      uint64_t nPendingBuy;
+      uint64_t nPendingSell;
+      double dblMark;
+      Exposure exposure;
+    };
+    std::vector<Portfolio> vPortfolio;
+    std::vector<Holding> vHolding;
+    uint64_t nChecks;
+    uint64_t nRejects;
+    Snapshot(): nChecks {}, nRejects {} {}
+  };
+
   RiskManager(void);
   ~RiskManager(void);
+
+  // before the first Add, defaults are 1024 instruments, 1024 holdings, 64 portfolios
+  void SetCapacity( size_t nInstruments, size_t nHoldings, size_t nPortfolios );
+
+  // registers the holding, attaches to the quotes of the watch, and for PositionGreek, to the greeks and the underlying
+  void Add( pPosition_t );
+  // registers a holding fed by the Update methods
+  void Add( const idPortfolio_t&, pInstrument_t, idPosition_t idPosition = 0 );
+
+  void SetPortfolioLimits( const idPortfolio_t&, const Limits& );
+  void SetInstrumentLimits( const idInstrument_t&, const Limits& );
+  void SetRejectUnknown( bool bRejectUnknown ) { m_bRejectUnknown.store( bRejectUnknown, std::memory_order_relaxed ); }
+
+  void UpdateQuote( const idInstrument_t&, double dblMark );
+  void UpdateUnderlying( const idInstrument_t&, double dblPrice ); // required for short option margin
+  void UpdateGreek( const idInstrument_t&, double dblDelta, double dblGamma, double dblVega );
+
+  // order path, called by OrderManager
+  ECheck Check( const Order& ); // on accept, the order quantity is held as pending
+  void ReportExecution( const Order&, const Execution& );
+  void Release( const Order& ); // cancelled or rejected, pending is released
+
+  void GetSnapshot( Snapshot& ) const;
+
 protected:
 private:
+
+  using ix_t = uint32_t;
+  static constexpr ix_t npos = 0xffffffff;
+
+  enum EMeasure { Notional = 0, Delta, Gamma, Vega, Margin, nMeasures };
+  enum ELimit { OrderQuantity = nMeasures, OrderNotional, PositionSize, nLimits };
+  enum EUnit { UnitNotional = 0, UnitDelta, UnitGamma, UnitVega, UnitMarginLong, UnitMarginShort, nUnits };
+  enum ESide { Buy = 0, Sell = 1 };
+
+  using atomic_t = std::atomic<double>;
+
+  struct Market; // per instrument, quote and greek input
+
+  struct Portfolio {
+    idPortfolio_t idPortfolio;
+    atomic_t rValue[ nMeasures ];
+    atomic_t rLimit[ nMeasures ];
+    Limits limits; // as set, writer only
+    Portfolio();
+  };
+
+  struct Holding {
+    idPosition_t idPosition;
+    ix_t ixPortfolio;
+    ix_t ixMarket;
+    std::atomic<ix_t> ixNext; // next holding in the same market
+    std::atomic<int64_t> nQuantity; // signed
+    std::atomic<uint64_t> rPending[ 2 ]; // ESide
+    atomic_t rValue[ nMeasures ]; // contribution to the portfolio, written under the flag
+    atomic_t rLimit[ nLimits ];   // effective: instrument limits, order limits are the lesser of instrument and portfolio
+    std::atomic_flag flag = ATOMIC_FLAG_INIT; // revaluation
+    Holding();
+  };
+
+  struct Market {
+    RiskManager* pRiskManager;
+    idInstrument_t idInstrument;
+    pInstrument_t pInstrument;
+    pWatch_t pWatch;      // when attached
+    pWatch_t pOption;     // greek source, when attached
+    pWatch_t pUnderlying; // when attached
+    double dblMultiplier;
+    std::atomic<ix_t> ixHolding; // head of the holdings in this market
+    std::atomic<ix_t> ixDefault; // first registered, for orders without a position id
+    atomic_t dblMark;
+    atomic_t dblUnderlying;
+    atomic_t rGreek[ 3 ]; // delta, gamma, vega
+    atomic_t rUnit[ nUnits ];
+    Limits limits; // as set, writer only
+    Market();
+    void HandleQuote( const Quote& );
+    void HandleUnderlyingQuote( const Quote& );
+    void HandleGreek( const Greek& );
+  };
+
+  mutable std::mutex m_mutex; // writers, and the snapshot
+
+  size_t m_nCapacityMarket;
+  size_t m_nCapacityHolding;
+  size_t m_nCapacityPortfolio;
+
+  std::unique_ptr<Market[]> m_rMarket;
+  std::unique_ptr<Holding[]> m_rHolding;
+  std::unique_ptr<Portfolio[]> m_rPortfolio;
+
+  std::atomic<size_t> m_nMarket; // published counts
+  std::atomic<size_t> m_nHolding;
+  size_t m_nPortfolio;
+
+  // open addressing, insert only, entry is slot + 1, 0 is empty
+  std::unique_ptr<std::atomic<ix_t>[]> m_rIndexMarket;
+  std::unique_ptr<std::atomic<ix_t>[]> m_rIndexHolding;
+  size_t m_maskMarket;
+  size_t m_maskHolding;
+
+  using mapPortfolio_t = std::map<idPortfolio_t, ix_t>;
+  mapPortfolio_t m_mapPortfolio; // writer only
+
+  std::atomic<bool> m_bRejectUnknown;
+  std::atomic<uint64_t> m_nChecks;
+  std::atomic<uint64_t> m_nRejects;
+
+  void Allocate();
+
+  ix_t FindMarket( const idInstrument_t& ) const;
+  ix_t FindHolding( idPosition_t ) const;
+  ix_t Locate( const Order& ) const; // holding for the order
+
+  ix_t AddPortfolio( const idPortfolio_t& );
+  ix_t AddMarket( pInstrument_t );
+  ix_t AddHolding( ix_t ixPortfolio, ix_t ixMarket, idPosition_t, int64_t nQuantity );
+
+  void LoadLimits( Holding& );
+  void Attach( Market&, pPosition_t );
+
+  void UpdateUnits( Market& );
+  void Revalue( Market& );
+  void Revalue( Holding& );
+  double Value( EMeasure, const Market&, int64_t nQuantity ) const;
+
+  void ReleasePending( Holding&, ESide, uint64_t );
+
+  static bool ToSide( OrderSide::EOrderSide, ESide& );
+
+  static void Accumulate( atomic_t&, double );
 };
 
 } // namespace tf
@@ -53,6 +53,8 @@ Watch::Watch( const Watch& rhs ) :
   assert( 0 == rhs.m_cntWatching );
   assert( 0 == rhs.m_nEnableStats );
   assert( !rhs.m_bWatching );
+  SetLastQuote( rhs.m_quote );
+  SetLastTrade( rhs.m_trade );
   Initialize();
 }
 
@@ -94,6 +96,36 @@ void Watch::Initialize() {
   //  EnableWatch takes care of some of that, but doesn't confirm contract if using IBTWS as provider
 }
 
+Watch::version_t Watch::LastQuote( Quote& quote ) const {
+  LastQuote_t last;
+  const version_t version = m_slQuote.Load( last );
+  if ( 0 != version ) {
+    quote = Quote( last.dt, last.dblBid, last.nBidSize, last.dblAsk, last.nAskSize );
+  }
+  return version;
+}
+
+Watch::version_t Watch::LastTrade( Trade& trade ) const {
+  LastTrade_t last;
+  const version_t version = m_slTrade.Load( last );
+  if ( 0 != version ) {
+    trade = Trade( last.dt, last.dblPrice, last.nVolume );
+  }
+  return version;
+}
+
+// feed thread
+void Watch::SetLastQuote( const Quote& quote ) {
+  m_quote = quote;
+  m_slQuote.Store( LastQuote_t{ quote.DateTime(), quote.Bid(), quote.Ask(), quote.BidSize(), quote.AskSize() } );
+}
+
+// feed thread
+void Watch::SetLastTrade( const Trade& trade ) {
+  m_trade = trade;
+  m_slTrade.Store( LastTrade_t{ trade.DateTime(), trade.Price(), trade.Volume() } );
+}
+
 void Watch::AddEvents() {
   assert( !m_bEventsAttached );
   m_pDataProvider->OnConnected.Add( MakeDelegate( this, &Watch::HandleConnected ) );
@@ -225,19 +257,21 @@ void Watch::EmitValues( bool bEmitName ) const {
   if ( bEmitName ) {
     std::cout << m_pInstrument->GetInstrumentName() << ": ";
   }
+  const Trade trade( LastTrade() );
   if ( m_pDataProvider->ProvidesQuotes() ) {
+    const Quote quote( LastQuote() );
     std::cout
       << "Cnt=" << m_quotes.Size() << "(q)," << m_trades.Size() << "(t)"
-      << ",P=" << m_trade.Price()
-      << ",B=" << m_quote.Bid()
-      << ",A=" << m_quote.Ask()
+      << ",P=" << trade.Price()
+      << ",B=" << quote.Bid()
+      << ",A=" << quote.Ask()
       //<< std::endl
       ;
   }
   else {
     std::cout
       << "Cnt=" << m_trades.Size() << "(t)"
-      << ",P=" << m_trade.Price()
+      << ",P=" << trade.Price()
       //<< std::endl
       ;
   }
@@ -285,7 +319,7 @@ void Watch::HandleQuote( const Quote& quote ) {
         }
       }
 
-      m_quote = quote;
+      SetLastQuote( quote );
       if ( m_bRecordSeries ) {
         m_quotes.Append( quote );
       }
@@ -293,7 +327,7 @@ void Watch::HandleQuote( const Quote& quote ) {
       OnQuote( quote );
     }
     else {
-        m_quote = quote;
+        SetLastQuote( quote );
         //OnPossibleResizeBegin( stateTimeSeries_t( m_quotes.Capacity(), m_quotes.Size() ) );
         {
           //boost::mutex::scoped_lock lock(m_mutexLockAppend);
@@ -316,7 +350,7 @@ void Watch::HandleQuote( const Quote& quote ) {
 }
 
 void Watch::HandleTrade( const Trade& trade ) {
-  m_trade = trade;
+  SetLastTrade( trade );
   if ( trade.Price() > m_PriceMax ) m_PriceMax = trade.Price();
   if ( trade.Price() < m_PriceMin ) m_PriceMin = trade.Price();
   m_VolumeTotal += trade.Volume();
@@ -357,8 +391,8 @@ void Watch::HandleIQFeedSummaryMessage( ou::tf::iqfeed::IQFeedSymbol::pSummary_t
   m_summary.dblOpen = summary.dblOpen;
   m_summary.dblTrade = summary.dblTrade;
 
-  m_quote = ou::tf::Quote( ou::TimeSource::GlobalInstance().External(), summary.dblBid, 0, summary.dblAsk, 0 );
-  m_trade = ou::tf::Trade( ou::TimeSource::GlobalInstance().External(), summary.dblTrade, 0 );
+  SetLastQuote( ou::tf::Quote( ou::TimeSource::GlobalInstance().External(), summary.dblBid, 0, summary.dblAsk, 0 ) );
+  SetLastTrade( ou::tf::Trade( ou::TimeSource::GlobalInstance().External(), summary.dblTrade, 0 ) );
 
   OnSummary( m_summary );
 }
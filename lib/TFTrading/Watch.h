@@ -19,6 +19,7 @@
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/archive/text_iarchive.hpp>
 
+#include <OUCommon/SeqLock.h>
 #include <OUCommon/Delegate.h>
 
 #include <TFTimeSeries/TimeSeries.h>
@@ -74,9 +75,17 @@ public:
 
   bool Watching() const { return 0 != m_cntWatching; };
 
+  // last quote/trade: consistent copies from any thread, without holding up the feed thread
+  //   the version advances with each update, compare with a prior version to skip unchanged values
+  using version_t = uint64_t;
+  Quote LastQuote() const { Quote quote; LastQuote( quote ); return quote; }
+  Trade LastTrade() const { Trade trade; LastTrade( trade ); return trade; }
+  version_t LastQuote( Quote& ) const;
+  version_t LastTrade( Trade& ) const;
+  version_t QuoteVersion() const { return m_slQuote.Version(); }
+  version_t TradeVersion() const { return m_slTrade.Version(); }
+
   // TODO: these need spinlocks
-  inline const Quote& LastQuote() const { return m_quote; };  // may have thread sync issue
-  inline const Trade& LastTrade() const { return m_trade; };  // may have thread sync issue
   inline const DepthByMM& LastDepthByMM() const { return m_depth_mm; };  // may have thread sync issue
   inline const DepthByOrder& LastDepthByOrder() const { return m_depth_order; };  // may have thread sync issue
 
@@ -124,8 +133,8 @@ protected:
 
   bool m_bRecordSeries;
 
-  ou::tf::Quote m_quote;
-  ou::tf::Trade m_trade;
+  ou::tf::Quote m_quote; // feed thread only, use LastQuote elsewhere
+  ou::tf::Trade m_trade; // feed thread only, use LastTrade elsewhere
   ou::tf::DepthByMM m_depth_mm;
   ou::tf::DepthByOrder m_depth_order;
 
@@ -163,6 +172,26 @@ private:
   size_t m_cntBestSpread;
   double m_dblBestSpread;
 
+  struct LastQuote_t { // trivially copyable image of Quote for the SeqLock
+    Quote::dt_t dt;
+    Quote::price_t dblBid;
+    Quote::price_t dblAsk;
+    Quote::bidsize_t nBidSize;
+    Quote::asksize_t nAskSize;
+  };
+
+  struct LastTrade_t { // trivially copyable image of Trade for the SeqLock
+    Trade::dt_t dt;
+    Trade::price_t dblPrice;
+    Trade::volume_t nVolume;
+  };
+
+  ou::SeqLock<LastQuote_t> m_slQuote;
+  ou::SeqLock<LastTrade_t> m_slTrade;
+
+  void SetLastQuote( const Quote& );
+  void SetLastTrade( const Trade& );
+
   void Initialize();
 
   void AddEvents();
@@ -0,0 +1,171 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// InstrumentCache round trip:  option chains are cached by iqfeed name and written, the file is reopened,
+//   every entry is loaded back and compared field by field; expired options, and entries without an
+//   ib contract when a contract is required, must not come back; open, save and load are timed
+//   usage: TFTradingInstrumentCache [entries]
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <boost/filesystem.hpp>
+
+#include <TFTrading/Instrument.h>
+#include <TFTrading/InstrumentCache.h>
+
+namespace {
+
+using Instrument = ou::tf::Instrument;
+using InstrumentCache = ou::tf::InstrumentCache;
+using clock_t_ = std::chrono::steady_clock;
+
+const ou::tf::keytypes::eidProvider_t idIQF( ou::tf::keytypes::EProviderIQF );
+
+double Microseconds( clock_t_::time_point start ) {
+  return std::chrono::duration<double, std::micro>( clock_t_::now() - start ).count();
+}
+
+struct Spec {
+  std::string sIQF;
+  Instrument::pInstrument_t pInstrument;
+};
+
+std::vector<Spec> Chains( size_t nEntries ) {
+  static const char* rszUnderlying[] = { "SPY", "QQQ", "IWM", "GLD", "TLT" };
+  std::vector<Spec> vSpec;
+  vSpec.reserve( nEntries );
+  for ( size_t ix = 0; ix < nEntries; ++ix ) {
+    const char* szUnderlying = rszUnderlying[ ix % 5 ];
+    const boost::uint16_t nMonth = 1 + ( ix / 5 ) % 12;
+    const bool bCall = 0 == ( ix / 60 ) % 2;
+    const double dblStrike = 100.0 + ( ix / 120 ) * 0.5;
+    char szName[ 64 ];
+    char szIQF[ 64 ];
+    snprintf( szName, sizeof( szName ), "%s 27%02u15%c%.1f", szUnderlying, nMonth, bCall ? 'C' : 'P', dblStrike );
+    snprintf( szIQF, sizeof( szIQF ), "%s27%02u%c%.1f", szUnderlying, nMonth, char( ( bCall ? 'A' : 'M' ) + nMonth - 1 ), dblStrike );
+    Instrument::pInstrument_t p = std::make_shared<Instrument>(
+      szName, ou::tf::InstrumentType::Option, "SMART", 2027, nMonth, 15,
+      bCall ? ou::tf::OptionSide::Call : ou::tf::OptionSide::Put, dblStrike );
+    p->SetContract( 100000 + ix );
+    p->SetMultiplier( 100 );
+    p->SetExchangeRules( "SMART:26" );
+    p->SetAlternateName( idIQF, szIQF );
+    vSpec.push_back( Spec { szIQF, p } );
+  }
+  return vSpec;
+}
+
+bool Same( const Instrument& a, const Instrument& b ) {
+  return ( a.GetInstrumentName() == b.GetInstrumentName() )
+    && ( a.GetInstrumentName( idIQF ) == b.GetInstrumentName( idIQF ) )
+    && ( a.GetContract() == b.GetContract() )
+    && ( a.GetStrike() == b.GetStrike() )
+    && ( a.GetOptionSide() == b.GetOptionSide() )
+    && ( a.GetExpiry() == b.GetExpiry() )
+    && ( a.GetMultiplier() == b.GetMultiplier() )
+    && ( a.GetRow().sExchangeRules == b.GetRow().sExchangeRules );
+}
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nEntries = ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 20000;
+
+  const boost::filesystem::path path( boost::filesystem::temp_directory_path() / boost::filesystem::unique_path( "instrument-cache-%%%%%%%%.bin" ) );
+  const std::string sFileName( path.string() );
+
+  const std::vector<Spec> vSpec( Chains( nEntries ) );
+
+  Instrument::pInstrument_t pExpired = std::make_shared<Instrument>(
+    "SPY 200117P300", ou::tf::InstrumentType::Option, "SMART", 2020, 1, 17, ou::tf::OptionSide::Put, 300.0 );
+  pExpired->SetContract( 99 );
+  pExpired->SetAlternateName( idIQF, "SPY2017M300" );
+
+  Instrument::pInstrument_t pNoContract = std::make_shared<Instrument>( "IBM", ou::tf::InstrumentType::Stock, "NYSE" );
+  pNoContract->SetAlternateName( idIQF, "IBM" );
+
+  bool bOk( true );
+  double dblSave {};
+  double dblOpen {};
+  double dblLoad {};
+
+  {
+    InstrumentCache cache( sFileName );
+    for ( const Spec& spec: vSpec ) cache.Add( spec.pInstrument );
+    cache.Add( pExpired );
+    cache.Add( pNoContract );
+    const auto start = clock_t_::now();
+    cache.Save();
+    dblSave = Microseconds( start );
+  }
+
+  {
+    const auto startOpen = clock_t_::now();
+    InstrumentCache cache( sFileName, true );
+    dblOpen = Microseconds( startOpen );
+
+    if ( nEntries + 1 != cache.Size() ) { // the expired option is dropped on open
+      std::cout << "size " << cache.Size() << ", expected " << nEntries + 1 << std::endl;
+      bOk = false;
+    }
+
+    size_t nMismatch {};
+    const auto startLoad = clock_t_::now();
+    for ( const Spec& spec: vSpec ) {
+      Instrument::pInstrument_t p = cache.Load( idIQF, spec.sIQF );
+      if ( !p || !Same( *p, *spec.pInstrument ) ) ++nMismatch;
+    }
+    dblLoad = Microseconds( startLoad );
+    if ( 0 != nMismatch ) {
+      std::cout << nMismatch << " entries did not round trip" << std::endl;
+      bOk = false;
+    }
+
+    if ( cache.Load( idIQF, "SPY2017M300" ) ) {
+      std::cout << "expired entry returned" << std::endl;
+      bOk = false;
+    }
+    if ( cache.Load( idIQF, "IBM" ) ) {
+      std::cout << "entry without contract returned" << std::endl;
+      bOk = false;
+    }
+  }
+
+  {
+    InstrumentCache cache( sFileName ); // contract not required
+    if ( !cache.Load( idIQF, "IBM" ) ) {
+      std::cout << "entry without contract not returned" << std::endl;
+      bOk = false;
+    }
+  }
+
+  boost::system::error_code ec;
+  const uintmax_t nBytes = boost::filesystem::file_size( path, ec );
+  boost::filesystem::remove( path, ec );
+
+  std::cout
+    << nEntries << " entries, " << nBytes << " bytes, "
+    << "save " << dblSave / 1000.0 << " ms, "
+    << "open " << dblOpen / 1000.0 << " ms, "
+    << "load " << 1000.0 * dblLoad / nEntries << " ns/entry"
+    << std::endl;
+  std::cout << ( bOk ? "round trip matches" : "round trip failed" ) << std::endl;
+
+  return bOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,160 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// RiskManager::Check load:  instruments spread over portfolios, a thread revaluing quotes in the background,
+//   orders checked at a paced rate with each check timed, then unpaced check plus release
+//   usage: TFTradingRiskManager [orders [orders per second [instruments]]]
+
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+#include <TFTrading/Order.h>
+#include <TFTrading/Execution.h>
+#include <TFTrading/Instrument.h>
+#include <TFTrading/RiskManager.h>
+
+int main( int argc, char* argv[] ) {
+
+  const size_t nOrders = ( 1 < argc ) ? std::stoul( argv[ 1 ] ) : 200'000;
+  const size_t nRate = ( 2 < argc ) ? std::stoul( argv[ 2 ] ) : 100'000;
+  const size_t nInstruments = ( 3 < argc ) ? std::stoul( argv[ 3 ] ) : 2000;
+  static const size_t nPortfolios = 8;
+
+  using Order = ou::tf::Order;
+  using RiskManager = ou::tf::RiskManager;
+
+  RiskManager& rm( RiskManager::LocalCommonInstance() );
+  rm.SetCapacity( 2 * nInstruments, 4 * nInstruments, 8 * nPortfolios );
+
+  std::vector<ou::tf::Instrument::pInstrument_t> vInstrument;
+  for ( size_t ix = 0; ix < nInstruments; ix++ ) {
+    vInstrument.push_back(
+      std::make_shared<ou::tf::Instrument>( "SYM" + std::to_string( ix ), ou::tf::InstrumentType::Stock, "SMART" ) );
+    rm.Add( "pf" + std::to_string( ix % nPortfolios ), vInstrument.back() );
+    rm.UpdateQuote( vInstrument.back()->GetInstrumentName(), 10.0 + ix % 100 );
+  }
+
+  RiskManager::Limits limitsPortfolio;
+  limitsPortfolio.dblNotional = 5e6;
+  limitsPortfolio.dblMargin = 2e6;
+  limitsPortfolio.dblOrderQuantity = 900;
+  limitsPortfolio.dblDelta = 200000;
+  for ( size_t ix = 0; ix < nPortfolios; ix++ ) {
+    rm.SetPortfolioLimits( "pf" + std::to_string( ix ), limitsPortfolio );
+  }
+
+  RiskManager::Limits limitsInstrument;
+  limitsInstrument.dblPosition = 5000;
+  for ( const auto& pInstrument: vInstrument ) {
+    rm.SetInstrumentLimits( pInstrument->GetInstrumentName(), limitsInstrument );
+  }
+
+  // orders built ahead of time, so only the check is timed
+  std::vector<Order::pOrder_t> vOrder;
+  vOrder.reserve( nOrders );
+  uint32_t seed( 1 );
+  const boost::posix_time::ptime dtNow( boost::posix_time::microsec_clock::universal_time() );
+  for ( size_t ix = 0; ix < nOrders; ix++ ) {
+    seed = seed * 1664525 + 1013904223;
+    ou::tf::Instrument::pInstrument_t& pInstrument( vInstrument[ ( seed >> 8 ) % nInstruments ] );
+    const ou::tf::OrderSide::EOrderSide side = ( seed & 0x10000 ) ? ou::tf::OrderSide::Buy : ou::tf::OrderSide::Sell;
+    const Order::quantity_t quantity( 1 + ( seed >> 20 ) % 1000 );
+    const Order::TableRowDef row(
+      ix + 1, 0, pInstrument->GetInstrumentName(), "", ou::tf::OrderStatus::Created, ou::tf::OrderType::Limit, side,
+      10.0 + ( seed % 100 ), 0.0, 0.0, quantity, quantity, 0, 0.0, 0.0, dtNow, dtNow, boost::posix_time::not_a_date_time );
+    vOrder.push_back( std::make_shared<Order>( row, pInstrument ) );
+  }
+
+  std::atomic<bool> bRun( true );
+  std::thread threadQuotes(
+    [&rm,&vInstrument,&bRun,nInstruments](){
+      size_t n {};
+      while ( bRun.load( std::memory_order_relaxed ) ) {
+        rm.UpdateQuote( vInstrument[ n % nInstruments ]->GetInstrumentName(), 10.0 + ( n % 97 ) );
+        n++;
+        if ( 0 == n % 64 ) std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+      }
+    } );
+
+  std::vector<uint32_t> vLatency;
+  vLatency.reserve( nOrders );
+  size_t nAccepted {};
+  const std::chrono::nanoseconds nsInterval( 1'000'000'000 / nRate );
+
+  const auto start = std::chrono::steady_clock::now();
+  for ( size_t ix = 0; ix < nOrders; ix++ ) {
+    const auto due = start + ix * nsInterval;
+    while ( std::chrono::steady_clock::now() < due ) {}
+    Order& order( *vOrder[ ix ] );
+    const auto begin = std::chrono::steady_clock::now();
+    const RiskManager::ECheck check = rm.Check( order );
+    vLatency.push_back( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - begin ).count() );
+    if ( RiskManager::ECheck::Accept == check ) {
+      nAccepted++;
+      if ( 0 == ix % 2 ) { // fill half, cancel the rest
+        ou::tf::Execution exec( order.GetPrice1(), order.GetQuanOrdered(), order.GetOrderSide(), "SIM", "1" );
+        rm.ReportExecution( order, exec );
+      }
+      else {
+        rm.Release( order );
+      }
+    }
+  }
+  const double dblSeconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+  bRun = false;
+  threadQuotes.join();
+
+  std::sort( vLatency.begin(), vLatency.end() );
+  std::cout
+    << nOrders << " orders in " << dblSeconds << "s"
+    << ", " << nOrders / dblSeconds << "/s"
+    << ", accepted " << nAccepted
+    << std::endl;
+  std::cout
+    << "check ns p50 " << vLatency[ nOrders / 2 ]
+    << ", p99 " << vLatency[ ( nOrders * 99 ) / 100 ]
+    << ", p99.9 " << vLatency[ ( nOrders * 999 ) / 1000 ]
+    << ", max " << vLatency.back()
+    << std::endl;
+
+  const auto startUnpaced = std::chrono::steady_clock::now();
+  for ( size_t ix = 0; ix < nOrders; ix++ ) {
+    if ( RiskManager::ECheck::Accept == rm.Check( *vOrder[ ix ] ) ) rm.Release( *vOrder[ ix ] );
+  }
+  std::cout
+    << "unpaced check+release "
+    << std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now() - startUnpaced ).count() / nOrders
+    << " ns/order"
+    << std::endl;
+
+  RiskManager::Snapshot snapshot;
+  rm.GetSnapshot( snapshot );
+  std::cout << "checks " << snapshot.nChecks << ", rejects " << snapshot.nRejects << std::endl;
+  for ( const auto& portfolio: snapshot.vPortfolio ) {
+    std::cout
+      << portfolio.idPortfolio
+      << ": notional " << portfolio.exposure.dblNotional
+      << ", delta " << portfolio.exposure.dblDelta
+      << ", margin " << portfolio.exposure.dblMargin
+      << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
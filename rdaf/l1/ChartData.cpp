@@ -48,11 +48,19 @@ ChartData::ChartData(
   pInstrument->SetAlternateName( ou::tf::Instrument::eidProvider_t::EProviderIQF, sIQFeedSymbol );
   m_pWatch = std::make_shared<ou::tf::Watch>( pInstrument, pProvider ); // will need to be iqfeed provider, check?
 
+  // every datum is recorded, so the provider thread waits, rather than drops, should the queue fill
+  m_pWorkEvent = std::make_unique<work_guard_t>( boost::asio::make_work_guard( m_contextEvent ) );
+  m_threadEvent = std::thread( [this](){ m_contextEvent.run(); } );
+  m_pAsyncEvent = AsyncEvent_t::Factory(
+    m_contextEvent.get_executor(), MakeDelegate( this, &ChartData::HandleEvent ), 16384, ou::EOverflow::Block );
+
   StartRdaf( sFilePrefix );
 }
 
 ChartData::~ChartData(void) {
   StopWatch();
+  m_pWorkEvent.reset(); // run returns once the queued events have been delivered
+  m_threadEvent.join();
   m_pFile->Flush();
   m_pFile->Close();
   if ( m_threadRdaf.joinable() ) {
@@ -141,6 +149,31 @@ void ChartData::StopWatch() {
 }
 
 void ChartData::HandleQuote( const ou::tf::Quote& quote ) {
+  Event event;
+  event.eType = Event::EType::Quote;
+  event.quote = quote;
+  m_pAsyncEvent->Dispatch( event );
+}
+
+void ChartData::HandleTrade( const ou::tf::Trade& trade ) {
+  Event event;
+  event.eType = Event::EType::Trade;
+  event.trade = trade;
+  m_pAsyncEvent->Dispatch( event );
+}
+
+void ChartData::HandleEvent( const Event& event ) {
+  switch ( event.eType ) {
+    case Event::EType::Quote:
+      ProcessQuote( event.quote );
+      break;
+    case Event::EType::Trade:
+      ProcessTrade( event.trade );
+      break;
+  }
+}
+
+void ChartData::ProcessQuote( const ou::tf::Quote& quote ) {
 
   m_quote = quote;
   ou::ChartDVBasics::HandleQuote( quote );
@@ -156,7 +189,7 @@ void ChartData::HandleQuote( const ou::tf::Quote& quote ) {
 
 }
 
-void ChartData::HandleTrade( const ou::tf::Trade& trade ) {
+void ChartData::ProcessTrade( const ou::tf::Trade& trade ) {
 
   ou::ChartDVBasics::HandleTrade( trade );
 
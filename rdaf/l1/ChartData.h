@@ -24,6 +24,11 @@
 
 #include <thread>
 
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+
+#include <OUCommon/AsyncDelegate.h>
+
 #include <OUCharting/ChartDVBasics.h>
 
 #include <TFTrading/Watch.h>
@@ -97,11 +102,30 @@ private:
   pTTree_t m_pTreeQuote;
   pTTree_t m_pTreeTrade;
 
+  // chart and tree updates run on m_threadEvent, off the provider thread
+  struct Event { // quotes and trades share one queue to keep their relative order
+    enum class EType { Quote, Trade } eType;
+    ou::tf::Quote quote;
+    ou::tf::Trade trade;
+    Event(): eType( EType::Quote ) {}
+  };
+  using AsyncEvent_t = ou::AsyncDelegate<const Event&>;
+
+  boost::asio::io_context m_contextEvent;
+  using work_guard_t = boost::asio::executor_work_guard<boost::asio::io_context::executor_type>;
+  std::unique_ptr<work_guard_t> m_pWorkEvent;
+  std::thread m_threadEvent;
+  AsyncEvent_t::pAsyncDelegate_t m_pAsyncEvent;
+
   void StartRdaf( const std::string& sFilePrefix );
   static void ThreadRdaf( ChartData*, const std::string& sFilePrefix );
 
-  void HandleQuote( const ou::tf::Quote& quote );
-  void HandleTrade( const ou::tf::Trade& trade );
+  void HandleQuote( const ou::tf::Quote& quote ); // provider thread
+  void HandleTrade( const ou::tf::Trade& trade ); // provider thread
+  void HandleEvent( const Event& ); // m_threadEvent
+
+  void ProcessQuote( const ou::tf::Quote& quote );
+  void ProcessTrade( const ou::tf::Trade& trade );
 
 };
 
@@ -58,6 +58,7 @@ BOOST_FUSION_ADAPT_STRUCT(
   (int, nStochastic2Periods)
   (int, nStochastic3Periods)
   (std::string, sTorchModelPath)
+  (int, nTorchCoalesce)
   (size_t, nPriceBins)
   (double, dblPriceUpper)
   (double, dblPriceLower)
@@ -295,6 +296,12 @@ struct ChoicesParser: qi::grammar<Iterator, ou::tf::config::choices_t()> {
       >> +( qi::char_( "0-9a-zA-Z/.") | qi::char_( '-') | qi::char_( '_' ) )
       >> *qi::lit(' ') >> qi::eol;
 
+    ruleTorchCoalesce
+      %= qi::lit("torch_coalesce")
+      >> *qi::lit(' ') >> qi::lit('=') >> *qi::lit(' ')
+      >> boost::spirit::int_
+      >> *qi::lit(' ') >> qi::eol;
+
     rulePriceBins
       %= qi::lit( "price_bins" )
       >> *qi::lit(' ') >> qi::lit('=') >> *qi::lit(' ')
@@ -347,6 +354,7 @@ struct ChoicesParser: qi::grammar<Iterator, ou::tf::config::choices_t()> {
       >>  ruleStochastic2Periods
       >>  ruleStochastic3Periods
       >> -ruleTorchModel
+      >> -ruleTorchCoalesce
       >>  rulePriceBins
       >>  rulePriceUpper
       >>  rulePriceLower
@@ -410,6 +418,7 @@ struct ChoicesParser: qi::grammar<Iterator, ou::tf::config::choices_t()> {
   qi::rule<Iterator, int()> ruleStochastic2Periods;
   qi::rule<Iterator, int()> ruleStochastic3Periods;
   qi::rule<Iterator, std::string()> ruleTorchModel;
+  qi::rule<Iterator, int()> ruleTorchCoalesce;
   qi::rule<Iterator, std::string()> ruleDateTime;
   qi::rule<Iterator, std::string()> ruleTimeUpper;
   qi::rule<Iterator, std::string()> ruleTimeLower;
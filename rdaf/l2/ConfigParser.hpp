@@ -92,6 +92,7 @@ struct symbol_t {
   // torch related
 
   std::string sTorchModelPath;
+  int nTorchCoalesce; // seconds, steps within this interval share a forward call
 
   // post parse - naming
 
@@ -121,6 +122,7 @@ struct symbol_t {
   , nStochastic1Periods {}
   , nStochastic2Periods {}
   , nStochastic3Periods {}
+  , nTorchCoalesce {}
   {} // optional for now
 
 };
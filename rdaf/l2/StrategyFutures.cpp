@@ -84,6 +84,7 @@ Futures::Futures(
 , m_dblStopDeltaProposed {}
 , m_dblStopActiveDelta {}, m_dblStopActiveActual {}
 , m_bfQuotes01Sec( 1 )
+, m_bFeatureSet( false )
 , m_nEmitted {}
 , m_nEmitSuppressed {}
 {
@@ -350,12 +351,21 @@ void Futures::StartDepthByOrder() {
 
   using EState = ou::tf::iqfeed::l2::OrderBased::EState;
 
+#if FVS
+  m_bFeatureSet = true;
+#else
+  m_bFeatureSet = m_config.bEmitFVS;
+#endif
+
   m_FeatureSet.Set( m_config.nFVSLevels );
+  m_pFeatureEngine = std::make_unique<ou::tf::iqfeed::l2::FeatureEngine>( m_config.nFVSLevels, Torch::Columns() );
   if ( 0 < m_config.vSentinel.size() ) {
     m_FeatureSet.Set( m_config.vSentinel );
+    m_pFeatureEngine->Set( m_config.vSentinel );
   }
 
-  m_pTorch = std::make_unique<Torch>( m_config.sTorchModelPath, m_FeatureSet );
+  m_pTorch = std::make_unique<Torch>( m_config.sTorchModelPath, *m_pFeatureEngine );
+  m_pTorch->SetCoalesce( boost::posix_time::seconds( m_config.nTorchCoalesce ) );
   m_opPosition = Torch::Op::Neutral;
 
   m_pOrderBased = ou::tf::iqfeed::l2::OrderBased::Factory();
@@ -372,7 +382,7 @@ void Futures::StartDepthByOrder() {
 
       if ( 0 != ix ) {
         //m_FeatureSet.IntegrityCheck();
-        m_FeatureSet.HandleBookChangesBid( op, ix, depth );
+        Features( [&]( auto& features ){ features.HandleBookChangesBid( op, ix, depth ); } );
         //m_FeatureSet.IntegrityCheck();
       }
 
@@ -383,7 +393,7 @@ void Futures::StartDepthByOrder() {
             case ou::tf::iqfeed::l2::EOp::Increase:
             case ou::tf::iqfeed::l2::EOp::Insert:
               if ( 0 != ix ) {
-                m_FeatureSet.Bid_IncLimit( ix, depth );
+                Features( [&]( auto& features ){ features.Bid_IncLimit( ix, depth ); } );
               }
               break;
             case ou::tf::iqfeed::l2::EOp::Decrease:
@@ -392,16 +402,16 @@ void Futures::StartDepthByOrder() {
                 uint32_t nTicks = m_nMarketOrdersBid.load();
                 // TODO: does arrival rate of deletions affect overall Market rate?
                 if ( 0 == nTicks ) {
-                  m_FeatureSet.Bid_IncCancel( 1, depth );
+                  Features( [&]( auto& features ){ features.Bid_IncCancel( 1, depth ); } );
                 }
                 else {
                   --m_nMarketOrdersBid;
-                  m_FeatureSet.Bid_IncMarket( 1, depth );
+                  Features( [&]( auto& features ){ features.Bid_IncMarket( 1, depth ); } );
                 }
               }
               else { // 1 < ix
                 if ( 0 != ix ) {
-                  m_FeatureSet.Bid_IncCancel( ix, depth );
+                  Features( [&]( auto& features ){ features.Bid_IncCancel( ix, depth ); } );
                 }
               }
               break;
@@ -433,7 +443,7 @@ void Futures::StartDepthByOrder() {
       }
 
       bool bChanged( false );
-      m_FeatureSet.Changed( bChanged );
+      m_pFeatureEngine->Changed( bChanged );
 
       if ( bChanged ) {
         m_nEmitted++;
@@ -464,7 +474,7 @@ void Futures::StartDepthByOrder() {
 
       if ( 0 != ix ) {
         //m_FeatureSet.IntegrityCheck();
-        m_FeatureSet.HandleBookChangesAsk( op, ix, depth );
+        Features( [&]( auto& features ){ features.HandleBookChangesAsk( op, ix, depth ); } );
         //m_FeatureSet.IntegrityCheck();
       }
 
@@ -475,7 +485,7 @@ void Futures::StartDepthByOrder() {
             case ou::tf::iqfeed::l2::EOp::Increase:
             case ou::tf::iqfeed::l2::EOp::Insert:
               if ( 0 != ix ) {
-                m_FeatureSet.Ask_IncLimit( ix, depth );
+                Features( [&]( auto& features ){ features.Ask_IncLimit( ix, depth ); } );
               }
               break;
             case ou::tf::iqfeed::l2::EOp::Decrease:
@@ -483,16 +493,16 @@ void Futures::StartDepthByOrder() {
               if ( 1 == ix ) {
                 uint32_t nTicks = m_nMarketOrdersAsk.load();
                 if ( 0 == nTicks ) {
-                  m_FeatureSet.Ask_IncCancel( 1, depth );
+                  Features( [&]( auto& features ){ features.Ask_IncCancel( 1, depth ); } );
                 }
                 else {
                   --m_nMarketOrdersAsk;
-                  m_FeatureSet.Ask_IncMarket( 1, depth );
+                  Features( [&]( auto& features ){ features.Ask_IncMarket( 1, depth ); } );
                 }
               }
               else { // 1 < ix
                 if ( 0 != ix ) {
-                  m_FeatureSet.Ask_IncCancel( ix, depth );
+                  Features( [&]( auto& features ){ features.Ask_IncCancel( ix, depth ); } );
                 }
               }
               break;
@@ -523,7 +533,7 @@ void Futures::StartDepthByOrder() {
       }
 
       bool bChanged( false );
-      m_FeatureSet.Changed( bChanged );
+      m_pFeatureEngine->Changed( bChanged );
 
       if ( bChanged ) {
         m_nEmitted++;
@@ -1488,6 +1498,18 @@ void Futures::SaveWatch( const std::string& sPrefix ) {
 
 void Futures::CloseAndDone() {
   std::cout << "Sending Close & Done" << std::endl;
+  if ( m_pTorch ) {
+    const Torch::Latency& latency( m_pTorch->GetLatency() );
+    BOOST_LOG_TRIVIAL(info)
+      << "Torch forward: "
+      << latency.nForward << " calls, "
+      << latency.nCoalesced << " coalesced, "
+      << "mean " << latency.Mean() << "us, "
+      << "p50 <" << latency.Percentile( 0.50 ) << "us, "
+      << "p99 <" << latency.Percentile( 0.99 ) << "us, "
+      << "max " << latency.dblMax << "us"
+      ;
+  }
   switch ( m_stateTrade ) {
     case EStateTrade::NoTrade:
       // do nothing
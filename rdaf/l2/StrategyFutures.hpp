@@ -47,6 +47,7 @@
 
 #include <TFIQFeed/Level2/Symbols.hpp>
 #include <TFIQFeed/Level2/FeatureSet.hpp>
+#include <TFIQFeed/Level2/FeatureEngine.hpp>
 
 #include <TFBitsNPieces/Stochastic.hpp>
 #include <TFBitsNPieces/MovingAverage.hpp>
@@ -259,10 +260,14 @@ private:
   pTH2D_t m_pHistVolumeDemo;
 #endif
 
+  bool m_bFeatureSet; // fed for emit_fvs and the FVS charts
   ou::tf::iqfeed::l2::FeatureSet m_FeatureSet;
   std::string m_sFVSPath;
   std::ofstream m_streamFVS;
 
+  using pFeatureEngine_t = std::unique_ptr<ou::tf::iqfeed::l2::FeatureEngine>;
+  pFeatureEngine_t m_pFeatureEngine; // the model columns, drives torch and the change test
+
   using pTorch_t = std::unique_ptr<Torch>;
   pTorch_t m_pTorch;
   Torch::Op m_opPosition;
@@ -273,6 +278,12 @@ private:
   void InitRdaf();
 
   void StartDepthByOrder();
+
+  template<typename F>
+  void Features( F&& f ) { // apply to the engine, and to the feature set when in use
+    f( *m_pFeatureEngine );
+    if ( m_bFeatureSet ) f( m_FeatureSet );
+  }
   void Imbalance( const ou::tf::Depth& );
 
   void HandleQuote( const ou::tf::Quote& );
@@ -24,14 +24,42 @@
 
 namespace Strategy {
 
-Torch::Torch( const std::string& sTorchModel, const ou::tf::iqfeed::l2::FeatureSet& fs ) {
-  m_pTorch_impl = std::make_unique<Torch_impl>( sTorchModel, fs );
+Torch::Torch( const std::string& sTorchModel, const ou::tf::iqfeed::l2::FeatureEngine& fe ) {
+  m_pTorch_impl = std::make_unique<Torch_impl>( sTorchModel, fe );
+}
+
+const Torch::vColumn_t& Torch::Columns() {
+  return Torch_impl::Columns();
 }
 
 Torch::~Torch() {
   m_pTorch_impl.reset();
 }
 
+void Torch::Latency::Add( double us ) {
+  size_t ix {};
+  for ( double bound = 2.0; ( bound <= us ) && ( ix < ( nBuckets - 1 ) ); bound *= 2.0 ) ix++;
+  rBucket[ ix ]++;
+  nForward++;
+  dblTotal += us;
+  if ( dblMax < us ) dblMax = us;
+}
+
+double Torch::Latency::Percentile( double fraction ) const {
+  const double target( fraction * nForward );
+  size_t sum {};
+  double bound( 2.0 );
+  for ( size_t ix = 0; ix < nBuckets; ix++, bound *= 2.0 ) {
+    sum += rBucket[ ix ];
+    if ( ( 0 < sum ) && ( target <= sum ) ) return bound;
+  }
+  return dblMax;
+}
+
+void Torch::SetCoalesce( boost::posix_time::time_duration interval ) {
+  m_pTorch_impl->SetCoalesce( interval );
+}
+
 void Torch::Accumulate() {
   m_pTorch_impl->Accumulate();
 }
@@ -40,4 +68,8 @@ Torch::Op Torch::StepModel( boost::posix_time::ptime dt, Torch::Op op, double un
   return m_pTorch_impl->StepModel( dt, op, unrealized, result );
 }
 
+const Torch::Latency& Torch::GetLatency() const {
+  return m_pTorch_impl->GetLatency();
+}
+
 }
\ No newline at end of file
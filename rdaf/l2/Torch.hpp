@@ -22,14 +22,18 @@
 #pragma once
 
 #include <boost/date_time/posix_time/ptime.hpp>
+#include <boost/date_time/posix_time/posix_time_duration.hpp>
 
+#include <array>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace ou {
 namespace tf {
 namespace iqfeed {
 namespace l2 {
-  class FeatureSet;
+  class FeatureEngine;
 } // namespace l2
 } // namespace iqfeed
 } // namespace tf
@@ -42,14 +46,39 @@ class Torch_impl;
 class Torch {
 public:
 
-  Torch( const std::string& sTorchModel, const ou::tf::iqfeed::l2::FeatureSet& );
+  // the engine is constructed with Columns(), its row is the model's step
+  Torch( const std::string& sTorchModel, const ou::tf::iqfeed::l2::FeatureEngine& );
   ~Torch();
 
+  using vColumn_t = std::vector<std::string>;
+  static const vColumn_t& Columns(); // FeatureEngine column names, in model order
+
   enum Op { Long, Neutral, Hold, Short };
 
+  // forward call timing, log2 buckets in microseconds
+  struct Latency {
+    static const size_t nBuckets = 24;
+    std::array<size_t, nBuckets> rBucket; // [ix] counts [2^ix, 2^(ix+1)) us, [0] includes < 1us
+    size_t nForward;   // forward calls
+    size_t nCoalesced; // steps folded into a later forward call
+    double dblMax;     // us
+    double dblTotal;   // us
+    Latency(): rBucket {}, nForward {}, nCoalesced {}, dblMax {}, dblTotal {} {}
+    void Add( double us );
+    double Mean() const { return ( 0 == nForward ) ? 0.0 : dblTotal / nForward; }
+    double Percentile( double ) const; // upper edge of the bucket holding the fraction, 0.0 < fraction <= 1.0
+  };
+
+  // steps arriving within interval of the last forward call only fill the window,
+  //   the next step beyond the interval submits the window with all of them in it.
+  //   default is zero, a forward call for each step
+  void SetCoalesce( boost::posix_time::time_duration interval );
+
   void Accumulate();
   Op StepModel( boost::posix_time::ptime, Torch::Op, double unrealized, float[3] );
 
+  const Latency& GetLatency() const;
+
 protected:
 private:
 
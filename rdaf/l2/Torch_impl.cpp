@@ -19,6 +19,11 @@
  * Created: 2023/05/16 18:00:31
  */
 
+#include <chrono>
+#include <stdexcept>
+
+#include <boost/preprocessor/stringize.hpp>
+
 #include "Torch_impl.hpp"
 
 // https://pytorch.org/cppdocs/
@@ -30,28 +35,54 @@
 
 namespace Strategy {
 
-#define FUSION_VECTOR_REFERENCES(z,n,level ) \
+#define COLUMN_NAME(z,n,data ) \
   BOOST_PP_COMMA_IF(n) \
-  Accumulator( level.BOOST_PP_ARRAY_ELEM(n,ARRAY_NAMES ) )
-
-Torch_impl::Torch_impl( const std::string& sTorchModel, const ou::tf::iqfeed::l2::FeatureSet& fs )
-: m_ixTimeStep {}
-, m_fvAccumulator_l1(
-    BOOST_PP_REPEAT( ARRAY_NAMES_SIZE, FUSION_VECTOR_REFERENCES, fs.FVS()[ 1 ] )
-  )
-, m_fvAccumulator_l2(
-    BOOST_PP_REPEAT( ARRAY_NAMES_SIZE, FUSION_VECTOR_REFERENCES, fs.FVS()[ 2 ] )
-  )
-, m_fvAccumulator_l3(
-    BOOST_PP_REPEAT( ARRAY_NAMES_SIZE, FUSION_VECTOR_REFERENCES, fs.FVS()[ 3 ] )
-  )
+  BOOST_PP_STRINGIZE( BOOST_PP_ARRAY_ELEM(n,ARRAY_NAMES ) )
+
+// level major, as the window was filled from the l1, l2, l3 accumulators
+const Torch::vColumn_t& Torch_impl::Columns() {
+  static const Torch::vColumn_t vColumn = [](){
+    static const std::array<const char*, ARRAY_NAMES_SIZE> rName = {
+      BOOST_PP_REPEAT( ARRAY_NAMES_SIZE, COLUMN_NAME, 0 )
+    };
+    Torch::vColumn_t v;
+    for ( size_t level = 1; level <= c_nLevels; level++ ) {
+      for ( const char* szName: rName ) {
+        v.emplace_back( std::string( szName ) + ".l" + std::to_string( level ) );
+      }
+    }
+    return v;
+  }();
+  return vColumn;
+}
+
+Torch_impl::Torch_impl( const std::string& sTorchModel, const ou::tf::iqfeed::l2::FeatureEngine& fe )
+: m_fe( fe )
+, m_rAccumulate {}
+, m_nAccumulate {}
+, m_pWindow( nullptr )
+, m_ixTimeStep {}
+, m_nTimeSteps {}
+, m_pState( nullptr )
+, m_tdCoalesce( boost::posix_time::time_duration( 0, 0, 0 ) )
+, m_rResult {}
 {
-  m_vTensor.reserve( c_nTimeSteps );
+  if ( m_fe.Columns() != Columns() ) {
+    throw std::runtime_error( "Torch: feature engine columns do not match the model" );
+  }
 
   try {
 
     torch::manual_seed( 0 );
 
+    static const auto options = torch::TensorOptions().dtype( torch::kFloat32 ).device( torch::kCPU, -1 ).requires_grad( false );
+
+    m_tensorWindow = torch::zeros( { 2 * c_nTimeSteps, c_nFeatures }, options );
+    m_pWindow = m_tensorWindow.data_ptr<float>();
+
+    m_tensorState = torch::zeros( { 1, 2 }, options );
+    m_pState = m_tensorState.data_ptr<float>();
+
     m_tensorCell = torch::zeros( { 1, 1, 64 } );
     m_tensorHidden = torch::zeros( { 1, 1, 64 } );
 
@@ -77,133 +108,95 @@ Torch_impl::Torch_impl( const std::string& sTorchModel, const ou::tf::iqfeed::l2
 Torch_impl::~Torch_impl() {}
 
 void Torch_impl::Accumulate() {
-  boost::fusion::for_each(
-    m_fvAccumulator_l1,
-    []( auto& accumulator ){
-      accumulator.accumulate += accumulator.feature;
-      accumulator.count++;
-    }
-  );
-  boost::fusion::for_each(
-    m_fvAccumulator_l2,
-    []( auto& accumulator ){
-      accumulator.accumulate += accumulator.feature;
-      accumulator.count++;
-    }
-  );
-  boost::fusion::for_each(
-    m_fvAccumulator_l3,
-    []( auto& accumulator ){
-      accumulator.accumulate += accumulator.feature;
-      accumulator.count++;
-    }
-  );
+  const float* pRow( m_fe.Data() );
+  for ( size_t ix = 0; ix < m_rAccumulate.size(); ix++ ) {
+    m_rAccumulate[ ix ] += pRow[ ix ];
+  }
+  m_nAccumulate++;
 }
 
 Torch::Op Torch_impl::StepModel( boost::posix_time::ptime dt, Torch::Op op_old_t, double unrealized, float result[3] ) {
 
   auto seconds = dt.time_of_day().total_seconds();
 
-  rTimeStep_Averages_t& step( m_rTimeSteps[ m_ixTimeStep ] );
-  rTimeStep_Averages_t::iterator iterTimeStep( step.begin() );
+  float* const pStep( m_pWindow + m_ixTimeStep * c_nFeatures );
 
-  boost::fusion::for_each(
-    m_fvAccumulator_l1,
-    [&iterTimeStep]( auto& accumulator ){
-      if ( 0 == accumulator.count ) {
-        *iterTimeStep = 0.0;
-      }
-      else {
-        *iterTimeStep = accumulator.accumulate / accumulator.count;
-        accumulator.Clear();
-      }
-      iterTimeStep++;
+  if ( 0 == m_nAccumulate ) {
+    std::fill( pStep, pStep + m_rAccumulate.size(), 0.0f );
+  }
+  else {
+    for ( size_t ix = 0; ix < m_rAccumulate.size(); ix++ ) {
+      pStep[ ix ] = m_rAccumulate[ ix ] / m_nAccumulate;
     }
-  );
+    m_rAccumulate.fill( 0.0 );
+    m_nAccumulate = 0;
+  }
 
-  boost::fusion::for_each(
-    m_fvAccumulator_l2,
-    [&iterTimeStep]( auto& accumulator ){
-      if ( 0 == accumulator.count ) {
-        *iterTimeStep = 0.0;
-      }
-      else {
-        *iterTimeStep = accumulator.accumulate / accumulator.count;
-        accumulator.Clear();
-      }
-      iterTimeStep++;
-    }
-  );
+  pStep[ c_nFeatures - 1 ] = seconds;
 
-  boost::fusion::for_each(
-    m_fvAccumulator_l3,
-    [&iterTimeStep]( auto& accumulator ){
-      if ( 0 == accumulator.count ) {
-        *iterTimeStep = 0.0;
-      }
-      else {
-        *iterTimeStep = accumulator.accumulate / accumulator.count;
-        accumulator.Clear();
-      }
-      iterTimeStep++;
-    }
-  );
+  std::copy( pStep, pStep + c_nFeatures, pStep + c_nTimeSteps * c_nFeatures ); // the mirror
 
-  *iterTimeStep = seconds;
+  if ( c_nTimeSteps > m_nTimeSteps ) m_nTimeSteps++;
 
-  // https://pytorch.org/cppdocs/api/structc10_1_1_i_value.html
-  // IValues contain their values as an IValue::Payload,
-  //    which holds primitive types (int64_t, bool, double, Device) and Tensor as values,
-  //    and all other types as a c10::intrusive_ptr.
-  // https://pytorch.org/cppdocs/notes/tensor_creation.html
-
-  if ( c_nTimeSteps == m_vTensor.size() ) {
-    m_vTensor.erase( m_vTensor.begin() );
+  m_ixTimeStep++;
+  assert( m_ixTimeStep <= c_nTimeSteps );
+  if ( c_nTimeSteps == m_ixTimeStep ) {
+    m_ixTimeStep = 0;
   }
 
-  std::vector<torch::jit::IValue> inputs;
-
-  static const auto options = torch::TensorOptions().dtype( torch::kFloat32 ).device( torch::kCPU, -1 );
-
-  m_vTensor.push_back( torch::from_blob( &step, { 1, c_nLevels * ARRAY_NAMES_SIZE + 1 }, options ).requires_grad_( false ) );
-  torch::Tensor steps = torch::stack( m_vTensor, 1 );
+  Torch::Op op { Torch::Op::Neutral };
 
-  assert( c_nTimeSteps >= m_vTensor.size() );
+  if ( c_nTimeSteps == m_nTimeSteps ) {
 
-  inputs.push_back( steps ); // or this one
+    if ( !m_dtForward.is_not_a_date_time() && ( dt < ( m_dtForward + m_tdCoalesce ) ) ) {
+      // coalesced: the step is in the window, submitted with the next forward call
+      m_latency.nCoalesced++;
+      std::copy( m_rResult.begin(), m_rResult.end(), result );
+      return op_old_t; // no change
+    }
 
-  double dblOpOld {};
-  switch ( op_old_t ) {
-    case Torch::Op::Hold:
-      break;
-    case Torch::Op::Long:
-      dblOpOld = +1.0;
-      break;
-    case Torch::Op::Neutral:
-      dblOpOld =  0.0;
-      break;
-    case Torch::Op::Short:
-      dblOpOld = -1.0;
-      break;
-  }
+    // https://pytorch.org/cppdocs/api/structc10_1_1_i_value.html
+    // IValues contain their values as an IValue::Payload,
+    //    which holds primitive types (int64_t, bool, double, Device) and Tensor as values,
+    //    and all other types as a c10::intrusive_ptr.
+    // https://pytorch.org/cppdocs/notes/tensor_creation.html
+
+    // oldest step is at m_ixTimeStep, the window runs through its mirror of the newest
+    torch::Tensor steps = m_tensorWindow.narrow( 0, m_ixTimeStep, c_nTimeSteps ).unsqueeze( 0 ); // [ 1, c_nTimeSteps, c_nFeatures ]
+
+    double dblOpOld {};
+    switch ( op_old_t ) {
+      case Torch::Op::Hold:
+        break;
+      case Torch::Op::Long:
+        dblOpOld = +1.0;
+        break;
+      case Torch::Op::Neutral:
+        dblOpOld =  0.0;
+        break;
+      case Torch::Op::Short:
+        dblOpOld = -1.0;
+        break;
+    }
 
-  float state[ 1 ][ 2 ];
-  state[ 0 ][ 0 ] = dblOpOld;
-  state[ 0 ][ 1 ] = unrealized;
-  torch::Tensor state_tensor = torch::from_blob( &state, { 1, 2 } ).requires_grad_( false );
-  inputs.push_back( state_tensor );
+    m_pState[ 0 ] = dblOpOld;
+    m_pState[ 1 ] = unrealized;
 
-  std::vector<torch::jit::IValue> tuple;
-  tuple.push_back( m_tensorHidden );
-  tuple.push_back( m_tensorCell );
-  inputs.push_back(torch::ivalue::Tuple::create( tuple ) );
+    std::vector<torch::jit::IValue> inputs;
+    inputs.reserve( 3 );
+    inputs.push_back( steps );
+    inputs.push_back( m_tensorState );
 
-  Torch::Op op { Torch::Op::Neutral };
+    std::vector<torch::jit::IValue> tuple;
+    tuple.push_back( m_tensorHidden );
+    tuple.push_back( m_tensorCell );
+    inputs.push_back( torch::ivalue::Tuple::create( tuple ) );
 
-  if ( c_nTimeSteps == m_vTensor.size() ) {
     // submit to torch
     // m_module.eval();
 
+    const std::chrono::steady_clock::time_point begin( std::chrono::steady_clock::now() );
+
     torch::NoGradGuard no_grad_;
 
     auto output = m_module.forward( inputs );
@@ -212,11 +205,15 @@ Torch::Op Torch_impl::StepModel( boost::posix_time::ptime dt, Torch::Op op_old_t
     m_tensorHidden = recycle.toTuple()->elements()[0].toTensor();
     m_tensorCell = recycle.toTuple()->elements()[1].toTensor();
 
-    torch::Tensor trade = output.toTuple()->elements()[ 0 ].toTensor();
+    // one copy out, rather than an item<float>() per element
+    torch::Tensor trade = output.toTuple()->elements()[ 0 ].toTensor().to( torch::kFloat32 ).contiguous();
+    const float* pTrade( trade.data_ptr<float>() );
+
+    m_latency.Add( std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - begin ).count() );
 
-    result[ 0 ] = trade[ 0 ][ 0 ].item<float>(); // short
-    result[ 1 ] = trade[ 0 ][ 1 ].item<float>(); // neutral
-    result[ 2 ] = trade[ 0 ][ 2 ].item<float>(); // long
+    result[ 0 ] = pTrade[ 0 ]; // short
+    result[ 1 ] = pTrade[ 1 ]; // neutral
+    result[ 2 ] = pTrade[ 2 ]; // long
 
     float& short_( result[ 0 ] );
     float& neutral_( result[ 1 ] );
@@ -252,12 +249,8 @@ Torch::Op Torch_impl::StepModel( boost::posix_time::ptime dt, Torch::Op op_old_t
       }
     }
 
-  }
-
-  m_ixTimeStep++;
-  assert( m_ixTimeStep <= c_nTimeSteps );
-  if ( c_nTimeSteps == m_ixTimeStep ) {
-    m_ixTimeStep = 0;
+    m_dtForward = dt;
+    std::copy( result, result + 3, m_rResult.begin() );
   }
 
   return op; // placeholder
@@ -31,15 +31,13 @@
 
 #include <boost/preprocessor/repetition/repeat.hpp>
 
-#include <boost/fusion/container/vector.hpp>
-
 #include <torch/script.h>
 
-#include <TFIQFeed/Level2/FeatureSet.hpp>
+#include <TFIQFeed/Level2/FeatureEngine.hpp>
 
 #include "Torch.hpp"
 
-// andrew's selection
+// andrew's selection, FeatureSet_Level names, levels 1 - 3 become the FeatureEngine columns
 #define TUPLE_NAMES ( \
     ask.v1.volume \
   , ask.v1.price \
@@ -94,55 +92,49 @@ namespace Strategy {
 class Torch_impl {
 public:
 
-  Torch_impl( const std::string& sTorchModel, const ou::tf::iqfeed::l2::FeatureSet& );
+  Torch_impl( const std::string& sTorchModel, const ou::tf::iqfeed::l2::FeatureEngine& );
   ~Torch_impl();
 
+  static const Torch::vColumn_t& Columns();
+
+  void SetCoalesce( boost::posix_time::time_duration interval ) { m_tdCoalesce = interval; }
+
   void Accumulate();
   Torch::Op StepModel( boost::posix_time::ptime, Torch::Op, double unrealized, float[3] );
 
+  const Torch::Latency& GetLatency() const { return m_latency; }
+
 protected:
 private:
 
-  template <typename type>
-  struct Accumulator {
-    const type& feature;
-    double accumulate;
-    double count;
-    // TODO: convert to exponential moving average?
-    //   ema lags less than ma
-    Accumulator( const type& feature_ )
-    : feature( feature_ )
-    , accumulate {}, count {}
-    {}
-    void Clear() {
-      accumulate = {};
-      count = 0;
-    }
-  };
-
-  #define FUSION_VECTOR_Accumulator(z,n,data ) \
-    BOOST_PP_COMMA_IF(n) \
-    Accumulator<decltype(ou::tf::iqfeed::l2::FeatureSet_Level::BOOST_PP_ARRAY_ELEM(n,ARRAY_NAMES))>
-
-  using fvAccumulator_t = boost::fusion::vector<
-    BOOST_PP_REPEAT( ARRAY_NAMES_SIZE, FUSION_VECTOR_Accumulator, 0 )
-  >;
-
-  fvAccumulator_t m_fvAccumulator_l1;
-  fvAccumulator_t m_fvAccumulator_l2;
-  fvAccumulator_t m_fvAccumulator_l3;
-
   static const size_t c_nLevels = 3;
   static const size_t c_nTimeSteps = 10 * 60; // seconds
 
-  using rTimeStep_Averages_t = std::array<float, c_nLevels * ARRAY_NAMES_SIZE + 1>; // last is seconds since midnight
-  using rTimeSteps_t = std::array<rTimeStep_Averages_t, c_nTimeSteps>;
-  using vTensor_t = std::vector<torch::Tensor>;
+  static const size_t c_nFeatures = c_nLevels * ARRAY_NAMES_SIZE + 1; // last is seconds since midnight
+
+  const ou::tf::iqfeed::l2::FeatureEngine& m_fe; // row is the first c_nFeatures - 1 of a step
+
+  // TODO: convert to exponential moving average?
+  //   ema lags less than ma
+  std::array<double, c_nFeatures - 1> m_rAccumulate; // row sums since the previous step
+  size_t m_nAccumulate;
+
+  // ring of time steps, each step is written to row ix and to its mirror at row ix + c_nTimeSteps,
+  //   so the window ending at any step is a contiguous run of rows: a view, rather than a stack of copies
+  torch::Tensor m_tensorWindow; // [ 2 * c_nTimeSteps, c_nFeatures ]
+  float* m_pWindow;
+
+  size_t m_ixTimeStep; // entry to be filled
+  size_t m_nTimeSteps; // entries filled, up to c_nTimeSteps
+
+  torch::Tensor m_tensorState; // [ 1, 2 ]: previous op, unrealized
+  float* m_pState;
 
-  rTimeSteps_t m_rTimeSteps;
-  vTensor_t m_vTensor;
+  boost::posix_time::time_duration m_tdCoalesce;
+  boost::posix_time::ptime m_dtForward; // step time of the last forward call
+  std::array<float, 3> m_rResult; // and its result
 
-  rTimeSteps_t::size_type m_ixTimeStep; // entry to be filled
+  Torch::Latency m_latency;
 
   torch::jit::script::Module m_module;
 
@@ -0,0 +1,81 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// Torch::StepModel over a session of one second steps, without and with coalescing
+//   usage: rdaf_l2_torch <model.pt> [steps [coalesce seconds]]
+
+#include <chrono>
+#include <string>
+#include <iostream>
+
+#include <TFIQFeed/Level2/FeatureEngine.hpp>
+
+#include "../Torch.hpp"
+
+namespace {
+
+void Run( const std::string& sModel, size_t nSteps, long nCoalesce ) {
+
+  ou::tf::iqfeed::l2::FeatureEngine fe( 10, Strategy::Torch::Columns() );
+
+  Strategy::Torch torch( sModel, fe );
+  torch.SetCoalesce( boost::posix_time::seconds( nCoalesce ) );
+
+  namespace pt = boost::posix_time;
+  pt::ptime dt( boost::gregorian::date( 2026, 10, 16 ), pt::time_duration( 13, 30, 0 ) );
+
+  float result[ 3 ];
+  Strategy::Torch::Op op( Strategy::Torch::Op::Neutral );
+
+  const auto start = std::chrono::steady_clock::now();
+  for ( size_t ix = 0; ix < nSteps; ++ix ) {
+    for ( size_t nEvents = 0; nEvents < 20; ++nEvents ) { // book events between steps
+      torch.Accumulate();
+    }
+    op = torch.StepModel( dt, op, 0.0, result );
+    dt += pt::seconds( 1 );
+  }
+  const auto us = std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - start ).count();
+
+  const Strategy::Torch::Latency& latency( torch.GetLatency() );
+  std::cout
+    << "coalesce " << nCoalesce << "s"
+    << ": " << us / nSteps << " us/step"
+    << ", forward " << latency.nForward
+    << ", coalesced " << latency.nCoalesced
+    << ", mean " << latency.Mean()
+    << ", p50 " << latency.Percentile( 0.50 )
+    << ", p99 " << latency.Percentile( 0.99 )
+    << ", max " << latency.dblMax
+    << std::endl;
+}
+
+} // namespace anonymous
+
+int main( int argc, char* argv[] ) {
+
+  if ( 2 > argc ) {
+    std::cout << "usage: " << argv[ 0 ] << " <model.pt> [steps [coalesce seconds]]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string sModel( argv[ 1 ] );
+  const size_t nSteps = ( 2 < argc ) ? std::stoul( argv[ 2 ] ) : 3600;
+  const long nCoalesce = ( 3 < argc ) ? std::stol( argv[ 3 ] ) : 5;
+
+  Run( sModel, nSteps, 0 );
+  if ( 0 != nCoalesce ) Run( sModel, nSteps, nCoalesce );
+
+  return EXIT_SUCCESS;
+}